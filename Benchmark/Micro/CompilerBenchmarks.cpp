@@ -0,0 +1,147 @@
+// Microbenchmarks for the compiler stages after parsing. The input is a synthetic AST built
+// in code, so the stages are measured on their own and the numbers don't move when the
+// grammar or ASTBuilder changes. range(0) is the number of generated functions.
+
+#include "AST/ASTNodes.h"
+#include "ErrorHandler/ErrorHandler.h"
+#include "IR/IRGenerator.h"
+#include "Semantic/SemanticAnalyzer.h"
+#include "VM/BytecodeGenerator.h"
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace Ryntra::Compiler;
+
+namespace {
+    std::shared_ptr<TypeSpecifierNode> type(const std::string &name) {
+        return std::make_shared<TypeSpecifierNode>(name);
+    }
+
+    std::shared_ptr<IdentifierNode> ident(const std::string &name) {
+        return std::make_shared<IdentifierNode>(name);
+    }
+
+    std::shared_ptr<ExpressionNode> var(const std::string &name) {
+        return std::make_shared<VariableNode>(ident(name));
+    }
+
+    std::shared_ptr<ExpressionNode> lit(int value) {
+        return std::make_shared<IntegerLiteralNode>(value);
+    }
+
+    std::shared_ptr<ExpressionNode> binary(std::shared_ptr<ExpressionNode> lhs, BinaryOpType op,
+                                           std::shared_ptr<ExpressionNode> rhs) {
+        return std::make_shared<BinaryOpNode>(std::move(lhs), op, std::move(rhs));
+    }
+
+    std::shared_ptr<StatementNode> assign(const std::string &name, std::shared_ptr<ExpressionNode> value) {
+        return std::make_shared<ExpressionStatementNode>(std::make_shared<AssignmentNode>(ident(name), std::move(value)));
+    }
+
+    std::shared_ptr<StatementNode> declare(const std::string &name, std::shared_ptr<ExpressionNode> init) {
+        return std::make_shared<VariableDeclarationNode>(type("int"), ident(name), std::move(init));
+    }
+
+    // public int f<index>() {
+    //     int a = <index>;
+    //     int b = 3;
+    //     for (int i = 0; i < 10; i++) {
+    //         a = (a * b + i) % 7;
+    //         if (a > 3) { b = b + 1; } else { b = b - 1; }
+    //     }
+    //     return a + b;
+    // }
+    std::shared_ptr<FunctionDefinitionNode> makeWorker(int index) {
+        auto ifNode = std::make_shared<IfNode>(
+            std::make_shared<ComparisonNode>(var("a"), ComparisonOpType::Gt, lit(3)),
+            std::make_shared<BlockNode>(std::vector<std::shared_ptr<StatementNode>>{
+                assign("b", binary(var("b"), BinaryOpType::Add, lit(1)))}),
+            std::make_shared<BlockNode>(std::vector<std::shared_ptr<StatementNode>>{
+                assign("b", binary(var("b"), BinaryOpType::Sub, lit(1)))}));
+
+        auto loop = std::make_shared<ForNode>(
+            declare("i", lit(0)),
+            std::make_shared<ComparisonNode>(var("i"), ComparisonOpType::Lt, lit(10)),
+            std::make_shared<PostfixOpNode>(IncDecOpType::Increment, var("i")),
+            std::make_shared<BlockNode>(std::vector<std::shared_ptr<StatementNode>>{
+                assign("a", binary(binary(binary(var("a"), BinaryOpType::Mul, var("b")), BinaryOpType::Add, var("i")),
+                                   BinaryOpType::Mod, lit(7))),
+                ifNode}));
+
+        auto body = std::make_shared<BlockNode>(std::vector<std::shared_ptr<StatementNode>>{
+            declare("a", lit(index)),
+            declare("b", lit(3)),
+            loop,
+            std::make_shared<ReturnNode>(binary(var("a"), BinaryOpType::Add, var("b")))});
+        return std::make_shared<FunctionDefinitionNode>(type("int"), ident("f" + std::to_string(index)), body);
+    }
+
+    // Worker functions plus a main that sums all of their results
+    std::shared_ptr<ProgramNode> makeProgram(int functionCount) {
+        std::vector<std::shared_ptr<FunctionDefinitionNode>> functions;
+        std::vector<std::shared_ptr<StatementNode>> mainBody{declare("sum", lit(0))};
+        for (int i = 0; i < functionCount; ++i) {
+            functions.push_back(makeWorker(i));
+            auto call = std::make_shared<FunctionCallNode>(ident("f" + std::to_string(i)),
+                                                           std::vector<std::shared_ptr<ExpressionNode>>{});
+            mainBody.push_back(assign("sum", binary(var("sum"), BinaryOpType::Add, call)));
+        }
+        functions.push_back(std::make_shared<FunctionDefinitionNode>(
+            type("void"), ident("main"), std::make_shared<BlockNode>(mainBody)));
+        return std::make_shared<ProgramNode>(functions);
+    }
+
+    std::shared_ptr<Semantic::TypedProgramNode> analyze(const std::shared_ptr<ProgramNode> &ast,
+                                                        benchmark::State &state) {
+        ErrorHandler::getInstance().clear();
+        Semantic::SemanticAnalyzer analyzer;
+        analyzer.analyze(ast);
+        if (ErrorHandler::getInstance().hasError()) {
+            state.SkipWithError("synthetic program failed semantic analysis");
+            return nullptr;
+        }
+        return analyzer.getTypedAST();
+    }
+
+    void BM_SemanticAnalyzer(benchmark::State &state) {
+        auto ast = makeProgram(static_cast<int>(state.range(0)));
+        for (auto _ : state) {
+            ErrorHandler::getInstance().clear();
+            Semantic::SemanticAnalyzer analyzer;
+            analyzer.analyze(ast);
+            benchmark::DoNotOptimize(analyzer.getTypedAST());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_SemanticAnalyzer)->ArgName("functions")->Arg(1)->Arg(16)->Arg(128);
+
+    void BM_IRGenerator(benchmark::State &state) {
+        auto ast = makeProgram(static_cast<int>(state.range(0)));
+        auto typedAST = analyze(ast, state);
+        if (!typedAST)
+            return;
+        for (auto _ : state) {
+            Ryntra::IR::IRGenerator irGen;
+            benchmark::DoNotOptimize(irGen.generate(*typedAST, "bench"));
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_IRGenerator)->ArgName("functions")->Arg(1)->Arg(16)->Arg(128);
+
+    void BM_BytecodeGenerator(benchmark::State &state) {
+        auto ast = makeProgram(static_cast<int>(state.range(0)));
+        auto typedAST = analyze(ast, state);
+        if (!typedAST)
+            return;
+        Ryntra::IR::IRGenerator irGen;
+        auto module = irGen.generate(*typedAST, "bench");
+        for (auto _ : state) {
+            Ryntra::VM::BytecodeGenerator bcGen;
+            benchmark::DoNotOptimize(bcGen.generate(module));
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_BytecodeGenerator)->ArgName("functions")->Arg(1)->Arg(16)->Arg(128);
+} // namespace
@@ -0,0 +1,260 @@
+// Microbenchmarks that drive VirtualMachine directly on hand-built bytecode, so dispatch,
+// call and memory costs are measured without the compiler in the way. Every benchmark runs
+// its body kTrips times inside one bytecode loop; items/s is the executed instruction rate.
+
+#include "PhaseTimer/PhaseTimer.h"
+#include "VM/Bytecode.h"
+#include "VM/Snapshot.h"
+#include "VM/VMValue.h"
+#include "VM/VirtualMachine.h"
+#include <benchmark/benchmark.h>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <vector>
+
+using namespace Ryntra::VM;
+
+namespace {
+    constexpr int32_t kTrips = 1000;
+
+    // Constant pool slots shared by every benchmark program
+    constexpr int32_t kConstTrips = 0;
+    constexpr int32_t kConstOne = 1;
+    constexpr int32_t kConstLhs = 2;
+    constexpr int32_t kConstRhs = 3;
+    constexpr int32_t kConstArraySize = 4;
+    constexpr int32_t kConstIndex = 5;
+
+    // Local slots: 0 is the loop counter, 1 / 2 hold operands, 3 holds an array
+    constexpr int32_t kLocalCounter = 0;
+    constexpr int32_t kLocalLhs = 1;
+    constexpr int32_t kLocalRhs = 2;
+    constexpr int32_t kLocalArray = 3;
+
+    struct BenchProgram {
+        std::vector<std::shared_ptr<BytecodeFunction>> functions;
+        std::vector<VMValue> constantPool;
+        size_t instructionsPerRun = 0;
+    };
+
+    // Builds "bench":
+    //   lhs = 1000; rhs = 7; array = new int[1024]; <prologue>
+    //   for (counter = kTrips; counter != 0; --counter) { <body> }
+    //   return
+    // Operands are int32, or int64 when wide is set.
+    BenchProgram makeLoopProgram(const std::function<void(BytecodeFunction &)> &body,
+                                 const std::function<void(BytecodeFunction &)> &prologue = {},
+                                 bool wide = false) {
+        BenchProgram program;
+        program.constantPool = {
+            VMValue(kTrips),
+            VMValue(static_cast<int32_t>(1)),
+            wide ? VMValue(static_cast<int64_t>(1000)) : VMValue(static_cast<int32_t>(1000)),
+            wide ? VMValue(static_cast<int64_t>(7)) : VMValue(static_cast<int32_t>(7)),
+            VMValue(static_cast<int32_t>(1024)),
+            VMValue(static_cast<int32_t>(511)),
+        };
+
+        auto func = std::make_shared<BytecodeFunction>("bench");
+        func->addInstruction(OpCode::LoadConst, kConstLhs);
+        func->addInstruction(OpCode::StoreLocal, kLocalLhs);
+        func->addInstruction(OpCode::LoadConst, kConstRhs);
+        func->addInstruction(OpCode::StoreLocal, kLocalRhs);
+        func->addInstruction(OpCode::LoadConst, kConstArraySize);
+        func->addInstruction(OpCode::NewArray);
+        func->addInstruction(OpCode::StoreLocal, kLocalArray);
+        if (prologue)
+            prologue(*func);
+        func->addInstruction(OpCode::LoadConst, kConstTrips);
+        func->addInstruction(OpCode::StoreLocal, kLocalCounter);
+        size_t setup = func->instructions.size();
+
+        auto loopHead = static_cast<int32_t>(func->instructions.size());
+        func->addInstruction(OpCode::LoadLocal, kLocalCounter);
+        size_t exitJump = func->instructions.size();
+        func->addInstruction(OpCode::Jz);
+        size_t bodyStart = func->instructions.size();
+        body(*func);
+        size_t bodySize = func->instructions.size() - bodyStart;
+        func->addInstruction(OpCode::LoadLocal, kLocalCounter);
+        func->addInstruction(OpCode::LoadConst, kConstOne);
+        func->addInstruction(OpCode::Sub);
+        func->addInstruction(OpCode::StoreLocal, kLocalCounter);
+        func->addInstruction(OpCode::Jmp, loopHead);
+        func->instructions[exitJump].operand = static_cast<int32_t>(func->instructions.size());
+        func->addInstruction(OpCode::Return);
+
+        // 7 loop-control instructions per trip, plus the final counter test, Jz and Return
+        program.instructionsPerRun = setup + static_cast<size_t>(kTrips) * (bodySize + 7) + 3;
+        program.functions.push_back(func);
+        return program;
+    }
+
+    void runProgram(benchmark::State &state, const BenchProgram &program, size_t extraInstructions = 0) {
+        VirtualMachine vm;
+        vm.load(program.functions, program.constantPool);
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(vm.execute("bench"));
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+                                static_cast<int64_t>(program.instructionsPerRun + extraInstructions));
+    }
+
+    void BM_LoopOverhead(benchmark::State &state) {
+        runProgram(state, makeLoopProgram([](BytecodeFunction &) {}));
+    }
+    BENCHMARK(BM_LoopOverhead);
+
+    // LoadLocal lhs; LoadLocal rhs; <op>; Pop -- unrolled 8 times
+    template <OpCode Op>
+    void BM_BinaryOp(benchmark::State &state) {
+        bool wide = state.range(0) != 0;
+        runProgram(state, makeLoopProgram([](BytecodeFunction &f) {
+            for (int i = 0; i < 8; ++i) {
+                f.addInstruction(OpCode::LoadLocal, kLocalLhs);
+                f.addInstruction(OpCode::LoadLocal, kLocalRhs);
+                f.addInstruction(Op);
+                f.addInstruction(OpCode::Pop);
+            } }, {}, wide));
+    }
+    BENCHMARK_TEMPLATE(BM_BinaryOp, OpCode::Add)->ArgName("i64")->Arg(0)->Arg(1);
+    BENCHMARK_TEMPLATE(BM_BinaryOp, OpCode::Sub)->ArgName("i64")->Arg(0)->Arg(1);
+    BENCHMARK_TEMPLATE(BM_BinaryOp, OpCode::Mul)->ArgName("i64")->Arg(0)->Arg(1);
+    BENCHMARK_TEMPLATE(BM_BinaryOp, OpCode::Div)->ArgName("i64")->Arg(0)->Arg(1);
+    BENCHMARK_TEMPLATE(BM_BinaryOp, OpCode::Mod)->ArgName("i64")->Arg(0)->Arg(1);
+    BENCHMARK_TEMPLATE(BM_BinaryOp, OpCode::BitAnd)->ArgName("i64")->Arg(0)->Arg(1);
+    BENCHMARK_TEMPLATE(BM_BinaryOp, OpCode::Shl)->ArgName("i64")->Arg(0)->Arg(1);
+    BENCHMARK_TEMPLATE(BM_BinaryOp, OpCode::Eq)->ArgName("i64")->Arg(0)->Arg(1);
+    BENCHMARK_TEMPLATE(BM_BinaryOp, OpCode::Lt)->ArgName("i64")->Arg(0)->Arg(1);
+
+    // LoadConst; Pop and LoadLocal; StoreLocal -- unrolled 8 times
+    void BM_LoadConst(benchmark::State &state) {
+        runProgram(state, makeLoopProgram([](BytecodeFunction &f) {
+            for (int i = 0; i < 8; ++i) {
+                f.addInstruction(OpCode::LoadConst, kConstLhs);
+                f.addInstruction(OpCode::Pop);
+            } }));
+    }
+    BENCHMARK(BM_LoadConst);
+
+    void BM_LocalCopy(benchmark::State &state) {
+        runProgram(state, makeLoopProgram([](BytecodeFunction &f) {
+            for (int i = 0; i < 8; ++i) {
+                f.addInstruction(OpCode::LoadLocal, kLocalLhs);
+                f.addInstruction(OpCode::StoreLocal, kLocalRhs);
+            } }));
+    }
+    BENCHMARK(BM_LocalCopy);
+
+    // Call a function that returns a constant; range(0) is the callee's local count,
+    // which shows what frame setup costs as frames get bigger.
+    void BM_Call(benchmark::State &state) {
+        auto calleeLocals = static_cast<int32_t>(state.range(0));
+        auto program = makeLoopProgram([](BytecodeFunction &f) {
+            f.addInstruction(OpCode::Call, 1);
+            f.addInstruction(OpCode::Pop);
+        });
+        auto callee = std::make_shared<BytecodeFunction>("callee");
+        for (int32_t i = 0; i < calleeLocals; ++i) {
+            callee->addInstruction(OpCode::LoadConst, kConstOne);
+            callee->addInstruction(OpCode::StoreLocal, i);
+        }
+        callee->addInstruction(OpCode::LoadConst, kConstLhs);
+        callee->addInstruction(OpCode::Return);
+        program.functions.push_back(callee);
+        runProgram(state, program, static_cast<size_t>(kTrips) * callee->instructions.size());
+    }
+    BENCHMARK(BM_Call)->ArgName("locals")->Arg(0)->Arg(4)->Arg(16);
+
+    void BM_ArrayGet(benchmark::State &state) {
+        runProgram(state, makeLoopProgram([](BytecodeFunction &f) {
+            f.addInstruction(OpCode::LoadLocal, kLocalArray);
+            f.addInstruction(OpCode::LoadConst, kConstIndex);
+            f.addInstruction(OpCode::ArrGet);
+            f.addInstruction(OpCode::Pop);
+        }));
+    }
+    BENCHMARK(BM_ArrayGet);
+
+    void BM_ArraySet(benchmark::State &state) {
+        runProgram(state, makeLoopProgram([](BytecodeFunction &f) {
+            f.addInstruction(OpCode::LoadLocal, kLocalArray);
+            f.addInstruction(OpCode::LoadConst, kConstIndex);
+            f.addInstruction(OpCode::LoadLocal, kLocalLhs);
+            f.addInstruction(OpCode::ArrSet);
+        }));
+    }
+    BENCHMARK(BM_ArraySet);
+
+    // new int(1000); store 7; load; delete. The VM never reuses freed heap slots, so a fresh
+    // VM is used per iteration to keep the heap from growing across the whole run.
+    void BM_HeapNewDelete(benchmark::State &state) {
+        auto program = makeLoopProgram([](BytecodeFunction &f) {
+            f.addInstruction(OpCode::LoadLocal, kLocalLhs);
+            f.addInstruction(OpCode::New);
+            f.addInstruction(OpCode::Dup);
+            f.addInstruction(OpCode::LoadLocal, kLocalRhs);
+            f.addInstruction(OpCode::PtrStore);
+            f.addInstruction(OpCode::Dup);
+            f.addInstruction(OpCode::PtrLoad);
+            f.addInstruction(OpCode::Pop);
+            f.addInstruction(OpCode::Delete);
+        });
+        for (auto _ : state) {
+            state.PauseTiming();
+            VirtualMachine vm;
+            vm.load(program.functions, program.constantPool);
+            state.ResumeTiming();
+            benchmark::DoNotOptimize(vm.execute("bench"));
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+                                static_cast<int64_t>(program.instructionsPerRun));
+    }
+    BENCHMARK(BM_HeapNewDelete);
+
+    // Restores a snapshot whose heap holds range(0) cells and loads the last one. Restored cells
+    // are only decoded when touched, so the time and the allocBytes counter must stay flat as
+    // the heap grows; the benchmark fails if the restore allocates in step with the heap.
+    void BM_RestoreTouchOneCell(benchmark::State &state) {
+        auto cells = static_cast<int32_t>(state.range(0));
+        // One trip per cell: rhs = new int(lhs). The Return is replaced by snapshot; *rhs; return
+        auto program = makeLoopProgram([](BytecodeFunction &f) {
+            f.addInstruction(OpCode::LoadLocal, kLocalLhs);
+            f.addInstruction(OpCode::New);
+            f.addInstruction(OpCode::StoreLocal, kLocalRhs);
+        });
+        program.constantPool[kConstTrips] = VMValue(cells);
+        auto &func = *program.functions.back();
+        func.instructions.pop_back();
+        func.addInstruction(OpCode::Snapshot);
+        func.addInstruction(OpCode::Pop);
+        func.addInstruction(OpCode::LoadLocal, kLocalRhs);
+        func.addInstruction(OpCode::PtrLoad);
+        func.addInstruction(OpCode::Pop);
+        func.addInstruction(OpCode::Return);
+
+        auto path = (std::filesystem::temp_directory_path() / "ryntra-bench-restore.snapshot").string();
+        {
+            VirtualMachine vm;
+            vm.load(program.functions, program.constantPool);
+            vm.getContext().setSnapshotPath(path);
+            vm.execute("bench");
+        }
+        auto snapshot = Snapshot::open(path);
+        std::filesystem::remove(path);
+
+        uint64_t allocatedBytes = 0;
+        for (auto _ : state) {
+            ExecutionContext context(snapshot->getProgram());
+            uint64_t before = Ryntra::Compiler::PhaseTimer::getAllocatedBytes();
+            benchmark::DoNotOptimize(context.resume(snapshot));
+            allocatedBytes = Ryntra::Compiler::PhaseTimer::getAllocatedBytes() - before;
+        }
+        state.counters["allocBytes"] = static_cast<double>(allocatedBytes);
+        // A VMValue per restored cell is far more than the frame and one decoded cell need
+        if (allocatedBytes >= static_cast<uint64_t>(cells) * sizeof(VMValue))
+            state.SkipWithError("restore allocated the whole heap");
+    }
+    BENCHMARK(BM_RestoreTouchOneCell)->ArgName("cells")->Arg(1 << 12)->Arg(1 << 18);
+} // namespace
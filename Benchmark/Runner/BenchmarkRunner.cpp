@@ -0,0 +1,246 @@
+// Runs every Ryntra program of the benchmark corpus N times in-process and reports the
+// median / p95 of each pipeline phase. Program output is captured (not printed) and checked
+// to be identical across iterations, so a benchmark that silently breaks is noticed.
+//
+// Usage: RyntraBenchmark [--iterations=N] [--warmup=N] [--json=<file>] [<file.rynt|directory>...]
+// With no path, Benchmark/Programs is used.
+
+#include "Driver/Driver.h"
+#include "ErrorHandler/ErrorHandler.h"
+#include "Json/Json.h"
+#include "PhaseTimer/PhaseTimer.h"
+#include "VM/VirtualMachine.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+    struct PhaseSamples {
+        std::string name;
+        std::vector<double> milliseconds;
+    };
+
+    struct BenchmarkResult {
+        std::string name;
+        bool ok = true;
+        std::string error;
+        size_t outputBytes = 0;
+        std::vector<PhaseSamples> phases; // in pipeline order, "total" last
+    };
+
+    // Nearest-rank percentile of an unsorted sample
+    double percentile(std::vector<double> values, double p) {
+        if (values.empty())
+            return 0.0;
+        std::sort(values.begin(), values.end());
+        auto rank = static_cast<size_t>(p / 100.0 * static_cast<double>(values.size()) + 0.999999);
+        return values[std::clamp<size_t>(rank, 1, values.size()) - 1];
+    }
+
+    // Redirects std::cout (which the VM builtins print to) into a string for the lifetime of the object
+    class CaptureStdout {
+    public:
+        CaptureStdout() : previous_(std::cout.rdbuf(buffer_.rdbuf())) {}
+        ~CaptureStdout() { std::cout.rdbuf(previous_); }
+
+        std::string str() const { return buffer_.str(); }
+
+    private:
+        std::ostringstream buffer_;
+        std::streambuf *previous_;
+    };
+
+    void addSample(BenchmarkResult &result, const std::string &phase, double ms) {
+        auto it = std::find_if(result.phases.begin(), result.phases.end(),
+                               [&](const PhaseSamples &s) { return s.name == phase; });
+        if (it == result.phases.end()) {
+            result.phases.push_back({phase, {}});
+            it = result.phases.end() - 1;
+        }
+        it->milliseconds.push_back(ms);
+    }
+
+    BenchmarkResult runBenchmark(const std::filesystem::path &path, int warmup, int iterations) {
+        BenchmarkResult result;
+        result.name = path.stem().string();
+
+        std::ifstream file(path);
+        std::string source((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+        std::string expectedOutput;
+        for (int i = 0; i < warmup + iterations; ++i) {
+            Ryntra::Compiler::ErrorHandler::getInstance().clear();
+            Ryntra::Compiler::PhaseTimer timer;
+            std::string output;
+
+            try {
+                CaptureStdout capture;
+                auto program = Ryntra::Compiler::compileSource(source, timer);
+                if (!program) {
+                    result.ok = false;
+                    result.error = "compilation failed";
+                    for (const auto &error : Ryntra::Compiler::ErrorHandler::getInstance().getErrorObjects()) {
+                        if (error.type == Ryntra::Compiler::kError) {
+                            result.error += ": " + error.description;
+                            break;
+                        }
+                    }
+                    break;
+                }
+
+                Ryntra::VM::VirtualMachine vm;
+                vm.load(program->functions, program->constantPool);
+                timer.begin("execute");
+                vm.execute("main");
+                timer.end();
+                output = capture.str();
+            } catch (const std::exception &e) {
+                result.ok = false;
+                result.error = e.what();
+                break;
+            }
+
+            if (i == 0) {
+                expectedOutput = output;
+            } else if (output != expectedOutput) {
+                result.ok = false;
+                result.error = "output differs between iterations";
+                break;
+            }
+
+            if (i < warmup)
+                continue;
+            double total = 0.0;
+            for (const auto &record : timer.getRecords()) {
+                addSample(result, record.name, record.wallMilliseconds);
+                total += record.wallMilliseconds;
+            }
+            addSample(result, "total", total);
+        }
+
+        if (!result.ok)
+            result.phases.clear();
+        result.outputBytes = expectedOutput.size();
+        return result;
+    }
+
+    void writeJson(std::ostream &os, const std::vector<BenchmarkResult> &results, int warmup, int iterations) {
+        os << std::fixed << std::setprecision(4);
+        os << "{\n  \"iterations\": " << iterations << ",\n  \"warmup\": " << warmup << ",\n  \"benchmarks\": [";
+        for (size_t i = 0; i < results.size(); ++i) {
+            const auto &result = results[i];
+            os << (i == 0 ? "\n" : ",\n");
+            os << "    {\"name\": " << Ryntra::Compiler::quoteJson(result.name) << ", \"ok\": " << (result.ok ? "true" : "false");
+            if (!result.ok)
+                os << ", \"error\": " << Ryntra::Compiler::quoteJson(result.error);
+            os << ", \"outputBytes\": " << result.outputBytes << ", \"phases\": [";
+            for (size_t j = 0; j < result.phases.size(); ++j) {
+                const auto &phase = result.phases[j];
+                os << (j == 0 ? "" : ", ") << "{\"name\": " << Ryntra::Compiler::quoteJson(phase.name)
+                   << ", \"medianMs\": " << percentile(phase.milliseconds, 50)
+                   << ", \"p95Ms\": " << percentile(phase.milliseconds, 95)
+                   << ", \"minMs\": " << *std::min_element(phase.milliseconds.begin(), phase.milliseconds.end()) << "}";
+            }
+            os << "]}";
+        }
+        os << "\n  ]\n}\n";
+    }
+
+    void printTable(std::ostream &os, const std::vector<BenchmarkResult> &results) {
+        auto flags = os.flags();
+        os << std::fixed << std::setprecision(3);
+        os << std::left << std::setw(20) << "benchmark" << std::setw(14) << "phase" << std::right
+           << std::setw(12) << "median ms" << std::setw(12) << "p95 ms" << std::setw(12) << "min ms" << "\n";
+        for (const auto &result : results) {
+            if (!result.ok) {
+                os << std::left << std::setw(20) << result.name << "FAILED: " << result.error << "\n";
+                continue;
+            }
+            for (const auto &phase : result.phases) {
+                os << std::left << std::setw(20) << result.name << std::setw(14) << phase.name << std::right
+                   << std::setw(12) << percentile(phase.milliseconds, 50)
+                   << std::setw(12) << percentile(phase.milliseconds, 95)
+                   << std::setw(12) << *std::min_element(phase.milliseconds.begin(), phase.milliseconds.end()) << "\n";
+            }
+        }
+        os.flags(flags);
+    }
+} // namespace
+
+int main(int argc, char **argv) {
+    int iterations = 10;
+    int warmup = 1;
+    std::string jsonPath;
+    std::vector<std::filesystem::path> inputs;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        if (arg.starts_with("--iterations=")) {
+            iterations = std::max(1, std::stoi(std::string(arg.substr(13))));
+        } else if (arg.starts_with("--warmup=")) {
+            warmup = std::max(0, std::stoi(std::string(arg.substr(9))));
+        } else if (arg.starts_with("--json=")) {
+            jsonPath = std::string(arg.substr(7));
+        } else {
+            inputs.emplace_back(arg);
+        }
+    }
+    if (inputs.empty())
+        inputs.emplace_back("Benchmark/Programs");
+
+    // Expand directories into their .rynt files, in a stable order
+    std::vector<std::filesystem::path> programs;
+    for (const auto &input : inputs) {
+        if (std::filesystem::is_directory(input)) {
+            std::vector<std::filesystem::path> found;
+            for (const auto &entry : std::filesystem::directory_iterator(input)) {
+                if (entry.path().extension() == ".rynt")
+                    found.push_back(entry.path());
+            }
+            std::sort(found.begin(), found.end());
+            programs.insert(programs.end(), found.begin(), found.end());
+        } else {
+            programs.push_back(input);
+        }
+    }
+    if (programs.empty()) {
+        std::cerr << "No benchmark programs found\n";
+        return 1;
+    }
+
+    // Opened before the (long) runs, so a bad --json path fails at once
+    std::ofstream jsonFile;
+    if (!jsonPath.empty()) {
+        jsonFile.open(jsonPath);
+        if (!jsonFile.is_open()) {
+            std::cerr << "Cannot write " << jsonPath << "\n";
+            return 1;
+        }
+    }
+
+    std::vector<BenchmarkResult> results;
+    for (const auto &program : programs) {
+        std::cerr << "running " << program.stem().string() << "...\n";
+        results.push_back(runBenchmark(program, warmup, iterations));
+    }
+
+    printTable(std::cout, results);
+    if (!jsonPath.empty()) {
+        writeJson(jsonFile, results, warmup, iterations);
+        jsonFile.close();
+        if (!jsonFile) {
+            std::cerr << "Cannot write " << jsonPath << "\n";
+            return 1;
+        }
+    }
+
+    bool allOk = std::all_of(results.begin(), results.end(), [](const BenchmarkResult &r) { return r.ok; });
+    return allOk ? 0 : 1;
+}
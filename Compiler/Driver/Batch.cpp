@@ -0,0 +1,334 @@
+#include "Batch.h"
+#include "Driver.h"
+#include "ErrorHandler/ErrorHandler.h"
+#include "Json/Json.h"
+#include "VM/ExecutionContext.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+namespace Ryntra::Compiler {
+    namespace {
+        std::string trim(const std::string &text) {
+            size_t begin = text.find_first_not_of(" \t\r\n\f\v");
+            if (begin == std::string::npos)
+                return {};
+            size_t end = text.find_last_not_of(" \t\r\n\f\v");
+            return text.substr(begin, end - begin + 1);
+        }
+
+        // Diagnostics written to a job's string stream carry no color codes, but an expectation
+        // recorded from the console may, and CheckTest.py strips them from both sides
+        std::string stripAnsi(const std::string &text) {
+            std::string out;
+            for (size_t i = 0; i < text.size(); ++i) {
+                if (text[i] == '\x1b' && i + 1 < text.size() && text[i + 1] == '[') {
+                    i += 2;
+                    while (i < text.size() && !(text[i] >= '@' && text[i] <= '~'))
+                        ++i;
+                    continue;
+                }
+                out += text[i];
+            }
+            return out;
+        }
+
+        std::vector<std::string> toLines(const JsonValue &value) {
+            if (value.isString())
+                return normalizeOutput(value.asString());
+            std::vector<std::string> lines;
+            if (value.isArray()) {
+                for (const auto &line : value.asArray()) {
+                    if (line.isString())
+                        lines.push_back(line.asString());
+                }
+            }
+            return lines;
+        }
+
+        VM::ResourceLimits toLimits(const JsonValue &value) {
+            VM::ResourceLimits limits;
+            auto read = [&value](const char *key, uint64_t &limit) {
+                if (const JsonValue *number = value.find(key); number && number->isNumber())
+                    limit = static_cast<uint64_t>(number->asNumber());
+            };
+            read("heapCells", limits.maxHeapCells);
+            read("arrayElements", limits.maxArrayElements);
+            read("callDepth", limits.maxCallDepth);
+            read("outputBytes", limits.maxOutputBytes);
+            return limits;
+        }
+
+        std::string readFile(const std::filesystem::path &path) {
+            std::ifstream file(path, std::ios::binary);
+            if (!file.is_open())
+                throw std::runtime_error("cannot open " + path.string());
+            return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+        }
+
+        // Instructions per slice when the manifest doesn't pick a budget, so a runaway script
+        // is noticed soon after its timeout
+        constexpr uint64_t kDefaultBudget = uint64_t{1} << 20;
+
+        // Runs main in budget slices, checking the job's timeout between them. Returns false if
+        // the script timed out; a trap is thrown the way execute() throws it.
+        bool runScript(VM::ExecutionContext &context, const BatchJob &job) {
+            if (job.budget == 0 && job.timeoutSeconds <= 0) {
+                context.execute("main");
+                return true;
+            }
+            uint64_t budget = job.budget != 0 ? job.budget : kDefaultBudget;
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::duration<double>(job.timeoutSeconds);
+            auto run = context.run("main", budget);
+            while (run.status == VM::ExecutionStatus::Suspended) {
+                if (job.timeoutSeconds > 0 && std::chrono::steady_clock::now() >= deadline)
+                    return false;
+                run = context.resume(budget);
+            }
+            if (run.trap)
+                throw VM::RuntimeError(run.trap->getMessage(), run.trap->functionName, run.trap->offset, run.trap->line);
+            return true;
+        }
+
+        // Same flow as the command line tool, with stdout / stdin replaced by strings
+        BatchResult runJob(const BatchJob &job) {
+            BatchResult result;
+            result.fileName = job.fileName;
+            result.input = job.input;
+
+            auto &errors = ErrorHandler::getInstance();
+            errors.clear();
+
+            std::ostringstream output;
+            std::string inputText;
+            for (const auto &line : job.input)
+                inputText += line + "\n";
+            std::istringstream input(inputText);
+            bool timedOut = false;
+
+            try {
+                std::string source = readFile(job.path);
+                PhaseTimer timer(false);
+                auto compiled = compileSource(source, timer);
+                errors.print(output);
+                if (errors.hasError()) {
+                    output << "Semantic Analysis Failed." << std::endl;
+                } else if (compiled) {
+                    VM::ExecutionContext context(
+                        std::make_shared<const VM::Program>(std::move(compiled->functions), std::move(compiled->constantPool)));
+                    context.setOutput(output);
+                    context.setInput(input);
+                    context.setLimits(job.limits);
+                    timedOut = !runScript(context, job);
+                }
+            } catch (const std::exception &e) {
+                result.exitCode = 1;
+                result.error = std::string("Error: ") + e.what();
+            }
+
+            // Like CheckTest.py, a script that runs too long fails whatever it printed so far
+            if (timedOut) {
+                std::ostringstream message;
+                message << "Timeout: ran longer than " << job.timeoutSeconds << " s";
+                result.exitCode = 1;
+                result.error = message.str();
+            }
+
+            result.output = normalizeOutput(output.str());
+            if (job.expectOutput || job.expectError) {
+                result.passed = !timedOut && (!job.expectOutput || result.output == *job.expectOutput) &&
+                                (!job.expectError || result.error == *job.expectError);
+            }
+            return result;
+        }
+    } // namespace
+
+    std::vector<std::string> normalizeOutput(const std::string &output) {
+        std::string text = trim(stripAnsi(output));
+        std::vector<std::string> lines;
+        if (text.empty())
+            return lines;
+        std::istringstream stream(text);
+        std::string line;
+        while (std::getline(stream, line))
+            lines.push_back(trim(line));
+        return lines;
+    }
+
+    std::vector<BatchJob> collectBatchJobs(const BatchOptions &options) {
+        std::filesystem::path root = options.root;
+        std::filesystem::path manifestPath = options.manifest;
+        if (manifestPath.empty() && !root.empty() && std::filesystem::is_regular_file(root / "Result" / "Result.json"))
+            manifestPath = root / "Result" / "Result.json";
+        if (root.empty() && !manifestPath.empty()) {
+            auto manifestDirectory = std::filesystem::absolute(manifestPath).lexically_normal().parent_path();
+            if (manifestDirectory.filename() == "Result")
+                root = manifestDirectory.parent_path();
+        }
+
+        std::map<std::string, BatchJob> manifestJobs;
+        if (!manifestPath.empty()) {
+            JsonValue manifest = JsonValue::parse(readFile(manifestPath));
+            const JsonValue *cases = manifest.find("Result");
+            if (!cases || !cases->isArray())
+                throw std::runtime_error(manifestPath.string() + ": expected a \"Result\" array");
+            for (const auto &entry : cases->asArray()) {
+                const JsonValue *fileName = entry.find("fileName");
+                if (!fileName || !fileName->isString())
+                    continue;
+                BatchJob job;
+                job.fileName = fileName->asString();
+                job.path = manifestPath.parent_path() / job.fileName;
+                job.timeoutSeconds = options.timeoutSeconds;
+                if (const JsonValue *input = entry.find("input"))
+                    job.input = toLines(*input);
+                if (const JsonValue *expect = entry.find("expectOutput"))
+                    job.expectOutput = toLines(*expect);
+                if (const JsonValue *budget = entry.find("budget"); budget && budget->isNumber())
+                    job.budget = static_cast<uint64_t>(budget->asNumber());
+                if (const JsonValue *timeout = entry.find("timeout"); timeout && timeout->isNumber())
+                    job.timeoutSeconds = timeout->asNumber();
+                if (const JsonValue *error = entry.find("expectError"); error && error->isString())
+                    job.expectError = error->asString();
+                if (const JsonValue *limits = entry.find("limits"))
+                    job.limits = toLimits(*limits);
+                manifestJobs[job.fileName] = std::move(job);
+            }
+        }
+
+        std::vector<BatchJob> jobs;
+        if (root.empty()) {
+            for (auto &[name, job] : manifestJobs)
+                jobs.push_back(std::move(job));
+            return jobs;
+        }
+
+        // Scripts found under the root are matched to manifest entries by file name, like CheckTest.py
+        for (const auto &entry : std::filesystem::recursive_directory_iterator(root)) {
+            if (!entry.is_regular_file() || entry.path().extension() != ".rynt")
+                continue;
+            BatchJob job;
+            job.timeoutSeconds = options.timeoutSeconds;
+            auto it = manifestJobs.find(entry.path().filename().string());
+            if (it != manifestJobs.end())
+                job = it->second;
+            job.fileName = entry.path().filename().string();
+            job.path = entry.path();
+            jobs.push_back(std::move(job));
+        }
+        std::sort(jobs.begin(), jobs.end(), [](const BatchJob &a, const BatchJob &b) { return a.path < b.path; });
+        return jobs;
+    }
+
+    std::vector<BatchResult> runBatchJobs(const std::vector<BatchJob> &jobs, unsigned threadCount) {
+        std::vector<BatchResult> results(jobs.size());
+        if (threadCount == 0)
+            threadCount = std::max(1u, std::thread::hardware_concurrency());
+        threadCount = std::min<unsigned>(threadCount, static_cast<unsigned>(std::max<size_t>(jobs.size(), 1)));
+
+        std::atomic<size_t> next{0};
+        auto worker = [&] {
+            for (size_t i = next.fetch_add(1); i < jobs.size(); i = next.fetch_add(1))
+                results[i] = runJob(jobs[i]);
+        };
+
+        std::vector<std::thread> threads;
+        for (unsigned i = 1; i < threadCount; ++i)
+            threads.emplace_back(worker);
+        worker();
+        for (auto &thread : threads)
+            thread.join();
+        return results;
+    }
+
+    void writeBatchResults(std::ostream &os, const std::vector<BatchResult> &results) {
+        auto writeLines = [&os](const std::vector<std::string> &lines) {
+            // Same shape as Result.json: "" for no output, a string for one line
+            if (lines.size() <= 1) {
+                os << quoteJson(lines.empty() ? std::string() : lines[0]);
+                return;
+            }
+            os << "[";
+            for (size_t i = 0; i < lines.size(); ++i)
+                os << (i == 0 ? "" : ", ") << quoteJson(lines[i]);
+            os << "]";
+        };
+
+        os << "{\n    \"Result\": [";
+        for (size_t i = 0; i < results.size(); ++i) {
+            const auto &result = results[i];
+            os << (i == 0 ? "\n" : ",\n") << "        {\n";
+            os << "            \"fileName\": " << quoteJson(result.fileName) << ",\n";
+            if (!result.input.empty()) {
+                os << "            \"input\": ";
+                os << "[";
+                for (size_t j = 0; j < result.input.size(); ++j)
+                    os << (j == 0 ? "" : ", ") << quoteJson(result.input[j]);
+                os << "],\n";
+            }
+            if (result.exitCode != 0) {
+                os << "            \"exitCode\": " << result.exitCode << ",\n";
+                os << "            \"error\": " << quoteJson(result.error) << ",\n";
+            }
+            if (result.passed)
+                os << "            \"passed\": " << (*result.passed ? "true" : "false") << ",\n";
+            os << "            \"expectOutput\": ";
+            writeLines(result.output);
+            os << "\n        }";
+        }
+        os << "\n    ]\n}\n";
+    }
+
+    int runBatch(const BatchOptions &options) {
+        auto start = std::chrono::steady_clock::now();
+        // Opened before anything runs, so a bad path fails at once instead of losing the results
+        std::ofstream file;
+        if (!options.output.empty()) {
+            file.open(options.output);
+            if (!file.is_open())
+                throw std::runtime_error("cannot write " + options.output.string());
+        }
+        auto jobs = collectBatchJobs(options);
+        unsigned threadCount = options.jobs != 0 ? options.jobs : std::max(1u, std::thread::hardware_concurrency());
+        threadCount = std::min<unsigned>(threadCount, static_cast<unsigned>(std::max<size_t>(jobs.size(), 1)));
+        auto results = runBatchJobs(jobs, threadCount);
+        double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        if (options.output.empty()) {
+            writeBatchResults(std::cout, results);
+        } else {
+            writeBatchResults(file, results);
+            file.close();
+            if (!file)
+                throw std::runtime_error("cannot write " + options.output.string());
+        }
+
+        size_t checked = 0;
+        size_t passed = 0;
+        size_t errors = 0;
+        for (const auto &result : results) {
+            if (result.exitCode != 0)
+                ++errors;
+            if (!result.passed)
+                continue;
+            ++checked;
+            if (*result.passed) {
+                ++passed;
+            } else {
+                std::cerr << "Fail: " << result.fileName << "\n";
+            }
+        }
+        std::cerr << "Ran " << results.size() << " scripts on " << threadCount << " threads in "
+                  << static_cast<long long>(elapsed) << " ms; " << errors << " runtime errors";
+        if (checked != 0)
+            std::cerr << "; passed " << passed << " / " << checked;
+        std::cerr << "\n";
+        return passed == checked ? 0 : 1;
+    }
+} // namespace Ryntra::Compiler
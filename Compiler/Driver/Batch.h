@@ -0,0 +1,62 @@
+#pragma once
+
+#include "VM/ExecutionContext.h"
+#include <cstdint>
+#include <filesystem>
+#include <iosfwd>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace Ryntra::Compiler {
+    // One script of a batch. Input and expected output come from the manifest, which has the
+    // shape of Test/Compilation/Result/Result.json: {"Result": [{"fileName", "input", "expectOutput"}]}.
+    // An entry may also set "budget" (instructions per run slice), "timeout" (seconds, 0 for none),
+    // "limits" ({"heapCells", "arrayElements", "callDepth", "outputBytes"}, any subset) and
+    // "expectError" (the error line the script must end with, e.g. for a trap).
+    struct BatchJob {
+        std::string fileName;
+        std::filesystem::path path;
+        std::vector<std::string> input;                        // stdin, one entry per line
+        std::optional<std::vector<std::string>> expectOutput; // normalized lines
+        std::optional<std::string> expectError;
+        VM::ResourceLimits limits;
+        uint64_t budget = 0;       // the run is resumed every `budget` instructions; 0 picks a default
+        double timeoutSeconds = 0; // checked between slices; 0 runs the script in one execute() call
+    };
+
+    struct BatchResult {
+        std::string fileName;
+        std::vector<std::string> input;
+        std::vector<std::string> output; // normalized stdout lines
+        int exitCode = 0;
+        std::string error; // what the command line tool would print to stderr
+        std::optional<bool> passed; // set when the manifest has an expectOutput or expectError for this script
+    };
+
+    // A root without a manifest picks up root/Result/Result.json when there is one. A manifest
+    // without a root that lives in a directory named Result (the test suite's layout) searches
+    // that directory's parent; any other manifest's entries are resolved against its directory.
+    struct BatchOptions {
+        std::filesystem::path root;     // directory searched recursively for .rynt files; may be empty
+        std::filesystem::path manifest; // optional
+        std::filesystem::path output;   // results file; empty means stdout
+        unsigned jobs = 0;              // worker threads; 0 means one per hardware thread
+        double timeoutSeconds = 10;     // per script unless its entry says otherwise, as in CheckTest.py
+    };
+
+    std::vector<BatchJob> collectBatchJobs(const BatchOptions &options);
+
+    // Compiles and runs every job on a pool of `jobs` threads; results keep the job order
+    std::vector<BatchResult> runBatchJobs(const std::vector<BatchJob> &jobs, unsigned threadCount);
+
+    // Writes the results in Result.json shape, the actual output taking the place of expectOutput
+    void writeBatchResults(std::ostream &os, const std::vector<BatchResult> &results);
+
+    // The whole --batch mode: collect, run, write results and print a summary to stderr.
+    // Returns 1 if any script had an expectation that it failed, 0 otherwise.
+    int runBatch(const BatchOptions &options);
+
+    // CheckTest.py's comparison rules: strip ANSI escapes, trim the output and every line
+    std::vector<std::string> normalizeOutput(const std::string &output);
+} // namespace Ryntra::Compiler
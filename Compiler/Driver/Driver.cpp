@@ -0,0 +1,46 @@
+#include "Driver.h"
+#include "ErrorHandler/ErrorHandler.h"
+#include "IR/IRGenerator.h"
+#include "IR/PassManager.h"
+#include "Semantic/SemanticAnalyzer.h"
+#include "VM/BytecodeGenerator.h"
+#include <iostream>
+
+namespace Ryntra::Compiler {
+    std::optional<CompiledProgram> compileProgram(const std::shared_ptr<ProgramNode> &ast, PhaseTimer &timer,
+                                                  const std::string &moduleName, const CompileOptions &options) {
+        timer.begin("sema");
+        Semantic::SemanticAnalyzer analyzer;
+        analyzer.analyze(ast);
+        timer.end();
+
+        auto typedAST = analyzer.getTypedAST();
+        if (ErrorHandler::getInstance().hasError() || !typedAST) {
+            return std::nullopt;
+        }
+
+        timer.begin("IRGen");
+        IR::IRGenerator irGen;
+        auto module = irGen.generate(*typedAST, moduleName);
+        timer.end();
+
+        auto passes = IR::PassManager::createPipeline(options.optimizationLevel);
+        for (const auto &name : options.printAfter)
+            passes.printAfter(name, std::cerr);
+        passes.run(*module, timer);
+
+        timer.begin("BytecodeGen");
+        VM::BytecodeGenerator bcGen;
+        CompiledProgram program;
+        program.functions = bcGen.generate(module);
+        program.constantPool = bcGen.getConstantPool();
+        timer.end();
+
+        return program;
+    }
+
+    std::optional<CompiledProgram> compileSource(const std::string &source, PhaseTimer &timer,
+                                                 const std::string &moduleName, const CompileOptions &options) {
+        return compileProgram(parseSource(source, timer), timer, moduleName, options);
+    }
+} // namespace Ryntra::Compiler
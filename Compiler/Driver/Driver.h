@@ -0,0 +1,42 @@
+#pragma once
+
+#include "AST/ASTNodes.h"
+#include "IR/PassManager.h"
+#include "PhaseTimer/PhaseTimer.h"
+#include "VM/Bytecode.h"
+#include "VM/VMValue.h"
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace Ryntra::Compiler {
+    // Everything the VM needs to run a compiled source file
+    struct CompiledProgram {
+        std::vector<std::shared_ptr<VM::BytecodeFunction>> functions;
+        std::vector<VM::VMValue> constantPool;
+    };
+
+    struct CompileOptions {
+        IR::OptimizationLevel optimizationLevel = IR::OptimizationLevel::O2;
+        std::vector<std::string> printAfter; // passes whose resulting IR is dumped to stderr
+    };
+
+    // The source -> bytecode pipeline shared by the command line tool and the benchmark runner.
+    // Each stage is timed through `timer` as lex, parse, ASTBuilder, sema, IRGen, every pass of
+    // the -O pipeline (see IR/PassManager.h) and BytecodeGen.
+    // Diagnostics are collected in ErrorHandler; the caller decides when to print or clear them.
+
+    // Lex, parse and build the AST (Driver/Parse.cpp, the only part that depends on ANTLR)
+    std::shared_ptr<ProgramNode> parseSource(const std::string &source, PhaseTimer &timer);
+
+    // Semantic analysis, IR and bytecode generation. Returns nullopt if sema reported an error.
+    // Throws std::invalid_argument if options.printAfter names a pass the pipeline doesn't run.
+    std::optional<CompiledProgram> compileProgram(const std::shared_ptr<ProgramNode> &ast, PhaseTimer &timer,
+                                                  const std::string &moduleName = "HelloWorld",
+                                                  const CompileOptions &options = {});
+
+    std::optional<CompiledProgram> compileSource(const std::string &source, PhaseTimer &timer,
+                                                 const std::string &moduleName = "HelloWorld",
+                                                 const CompileOptions &options = {});
+} // namespace Ryntra::Compiler
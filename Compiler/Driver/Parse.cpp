@@ -0,0 +1,33 @@
+#include "AST/ASTBuilder.h"
+#include "Driver.h"
+#include "ErrorHandler/LexParseErrorHandler.h"
+#include <antlr/RyntraLexer.h>
+#include <antlr/RyntraParser.h>
+#include <antlr4-runtime.h>
+
+namespace Ryntra::Compiler {
+    std::shared_ptr<ProgramNode> parseSource(const std::string &source, PhaseTimer &timer) {
+        timer.begin("lex");
+        antlr4::ANTLRInputStream input(source);
+        antlr::RyntraLexer lexer(&input);
+        antlr4::CommonTokenStream tokens(&lexer);
+        tokens.fill();
+        timer.end();
+
+        LexParseErrorHandler errorListener;
+        antlr::RyntraParser parser(&tokens);
+        parser.removeErrorListeners();
+        parser.addErrorListener(&errorListener);
+
+        timer.begin("parse");
+        auto tree = parser.program();
+        timer.end();
+
+        timer.begin("ASTBuilder");
+        ASTBuilder builder;
+        auto ast = builder.visitProgram(tree);
+        timer.end();
+
+        return ast;
+    }
+} // namespace Ryntra::Compiler
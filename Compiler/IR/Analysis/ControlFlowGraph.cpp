@@ -0,0 +1,90 @@
+#include "ControlFlowGraph.h"
+#include "../ImmediateValue.h"
+#include <utility>
+
+namespace Ryntra::IR {
+    namespace {
+        const std::string &labelOf(Value *operand) {
+            return static_cast<const ImmediateValue &>(*operand).getLiteralValue();
+        }
+    } // namespace
+
+    size_t ControlFlowGraph::getTerminatorIndex(const BasicBlock &block) {
+        const auto &instructions = block.getInstructions();
+        for (size_t i = 0; i < instructions.size(); ++i) {
+            if (instructions[i]->isTerminator())
+                return i;
+        }
+        return instructions.size();
+    }
+
+    std::vector<std::string> ControlFlowGraph::getSuccessorNames(const Function &function, size_t blockIndex) {
+        const auto &blocks = function.getBasicBlocks();
+        const auto &block = *blocks[blockIndex];
+        size_t terminator = getTerminatorIndex(block);
+        if (terminator == block.getInstructions().size()) {
+            if (blockIndex + 1 < blocks.size())
+                return {blocks[blockIndex + 1]->getName()};
+            return {};
+        }
+
+        const auto &inst = block.getInstructions()[terminator];
+        const auto &operands = inst->getOperands();
+        switch (inst->getOpcode()) {
+        case Instruction::Opcode::Br:
+            return {labelOf(operands[0])};
+        case Instruction::Opcode::CondBr:
+            return {labelOf(operands[1]), labelOf(operands[2])};
+        default:
+            return {};
+        }
+    }
+
+    ControlFlowGraph::ControlFlowGraph(const Function &function)
+        : blocks_(function.getBasicBlocks()) {
+        for (size_t i = 0; i < blocks_.size(); ++i)
+            indices_.emplace(blocks_[i]->getName(), i);
+
+        successors_.resize(blocks_.size());
+        predecessors_.resize(blocks_.size());
+        for (size_t i = 0; i < blocks_.size(); ++i) {
+            for (const auto &name : getSuccessorNames(function, i)) {
+                size_t target = getIndex(name);
+                if (target == None)
+                    continue;
+                successors_[i].push_back(target);
+                predecessors_[target].push_back(i);
+            }
+        }
+
+        // Iterative depth-first search from the entry block
+        postOrderNumber_.assign(blocks_.size(), None);
+        if (blocks_.empty())
+            return;
+        std::vector<bool> visited(blocks_.size(), false);
+        std::vector<std::pair<size_t, size_t>> stack; // (block, next successor to visit)
+        std::vector<size_t> postOrder;
+        stack.emplace_back(0, 0);
+        visited[0] = true;
+        while (!stack.empty()) {
+            auto &[block, next] = stack.back();
+            if (next < successors_[block].size()) {
+                size_t successor = successors_[block][next++];
+                if (!visited[successor]) {
+                    visited[successor] = true;
+                    stack.emplace_back(successor, 0);
+                }
+                continue;
+            }
+            postOrderNumber_[block] = postOrder.size();
+            postOrder.push_back(block);
+            stack.pop_back();
+        }
+        reversePostOrder_.assign(postOrder.rbegin(), postOrder.rend());
+    }
+
+    size_t ControlFlowGraph::getIndex(const std::string &blockName) const {
+        auto it = indices_.find(blockName);
+        return it != indices_.end() ? it->second : None;
+    }
+} // namespace Ryntra::IR
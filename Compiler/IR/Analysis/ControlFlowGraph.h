@@ -0,0 +1,48 @@
+#pragma once
+
+#include "../Function.h"
+#include <limits>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Ryntra::IR {
+    // Successor / predecessor lists of one function's blocks, numbered in layout order. A block
+    // ends at its first terminator (anything after it never runs); a block without one falls
+    // through to the next block in layout, or leaves the function if it is the last.
+    // Edges are kept with multiplicity, so a condbr with equal targets adds two.
+    class ControlFlowGraph {
+    public:
+        static constexpr size_t None = std::numeric_limits<size_t>::max();
+
+        explicit ControlFlowGraph(const Function &function);
+
+        size_t size() const { return blocks_.size(); }
+        BasicBlock *getBlock(size_t index) const { return blocks_[index]; }
+
+        // None if the function has no block of that name
+        size_t getIndex(const std::string &blockName) const;
+
+        const std::vector<size_t> &getSuccessors(size_t index) const { return successors_[index]; }
+        const std::vector<size_t> &getPredecessors(size_t index) const { return predecessors_[index]; }
+
+        // Reachable blocks only, entry first
+        const std::vector<size_t> &getReversePostOrder() const { return reversePostOrder_; }
+        bool isReachable(size_t index) const { return postOrderNumber_[index] != None; }
+
+        // Index of the block's first terminator, or the instruction count if it has none
+        static size_t getTerminatorIndex(const BasicBlock &block);
+
+        // Block names the terminator (or fallthrough) at the end of block transfers to
+        static std::vector<std::string> getSuccessorNames(const Function &function, size_t blockIndex);
+
+    private:
+        std::vector<BasicBlock *> blocks_;
+        std::unordered_map<std::string, size_t> indices_;
+        std::vector<std::vector<size_t>> successors_;
+        std::vector<std::vector<size_t>> predecessors_;
+        std::vector<size_t> reversePostOrder_;
+        std::vector<size_t> postOrderNumber_; // None for unreachable blocks
+    };
+} // namespace Ryntra::IR
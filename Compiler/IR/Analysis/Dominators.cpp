@@ -0,0 +1,86 @@
+#include "Dominators.h"
+#include <algorithm>
+
+namespace Ryntra::IR {
+    DominatorTree::DominatorTree(const ControlFlowGraph &cfg) : cfg_(cfg) {
+        constexpr size_t None = ControlFlowGraph::None;
+        size_t count = cfg.size();
+        idom_.assign(count, None);
+        children_.resize(count);
+        frontier_.resize(count);
+        depth_.assign(count, 0);
+
+        const auto &rpo = cfg.getReversePostOrder();
+        if (rpo.empty())
+            return;
+
+        // Post-order numbers order the intersection walk: a dominator always has the higher one
+        std::vector<size_t> order(count, 0);
+        for (size_t i = 0; i < rpo.size(); ++i)
+            order[rpo[i]] = rpo.size() - 1 - i;
+
+        auto intersect = [&](size_t a, size_t b) {
+            while (a != b) {
+                while (order[a] < order[b])
+                    a = idom_[a];
+                while (order[b] < order[a])
+                    b = idom_[b];
+            }
+            return a;
+        };
+
+        size_t entry = rpo.front();
+        idom_[entry] = entry;
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            for (size_t i = 1; i < rpo.size(); ++i) {
+                size_t block = rpo[i];
+                size_t newIdom = None;
+                for (size_t pred : cfg.getPredecessors(block)) {
+                    if (idom_[pred] == None)
+                        continue; // unreachable, or not processed yet
+                    newIdom = newIdom == None ? pred : intersect(pred, newIdom);
+                }
+                if (newIdom != idom_[block]) {
+                    idom_[block] = newIdom;
+                    changed = true;
+                }
+            }
+        }
+        idom_[entry] = None;
+
+        for (size_t block : rpo) {
+            if (idom_[block] == None)
+                continue;
+            children_[idom_[block]].push_back(block);
+            depth_[block] = depth_[idom_[block]] + 1; // the idom comes earlier in reverse post-order
+        }
+
+        // A join point is in the frontier of every block on the way up from each predecessor to its idom
+        for (size_t block : rpo) {
+            const auto &preds = cfg.getPredecessors(block);
+            if (preds.size() < 2)
+                continue;
+            for (size_t pred : preds) {
+                if (!cfg.isReachable(pred))
+                    continue;
+                for (size_t runner = pred; runner != idom_[block]; runner = idom_[runner]) {
+                    auto &frontier = frontier_[runner];
+                    if (std::find(frontier.begin(), frontier.end(), block) == frontier.end())
+                        frontier.push_back(block);
+                    if (runner == entry)
+                        break;
+                }
+            }
+        }
+    }
+
+    bool DominatorTree::dominates(size_t a, size_t b) const {
+        if (!cfg_.isReachable(a) || !cfg_.isReachable(b))
+            return false;
+        while (depth_[b] > depth_[a])
+            b = idom_[b];
+        return a == b;
+    }
+} // namespace Ryntra::IR
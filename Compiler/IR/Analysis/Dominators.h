@@ -0,0 +1,30 @@
+#pragma once
+
+#include "ControlFlowGraph.h"
+#include <vector>
+
+namespace Ryntra::IR {
+    // Dominator tree and dominance frontiers over the reachable blocks of a ControlFlowGraph
+    // (Cooper, Harvey & Kennedy, "A Simple, Fast Dominance Algorithm"). Unreachable blocks
+    // have no immediate dominator, no children and an empty frontier.
+    class DominatorTree {
+    public:
+        explicit DominatorTree(const ControlFlowGraph &cfg);
+
+        // ControlFlowGraph::None for the entry block and for unreachable blocks
+        size_t getImmediateDominator(size_t block) const { return idom_[block]; }
+        const std::vector<size_t> &getChildren(size_t block) const { return children_[block]; }
+
+        // Every block dominates itself; an unreachable block dominates and is dominated by nothing
+        bool dominates(size_t a, size_t b) const;
+
+        const std::vector<size_t> &getFrontier(size_t block) const { return frontier_[block]; }
+
+    private:
+        const ControlFlowGraph &cfg_;
+        std::vector<size_t> idom_;
+        std::vector<std::vector<size_t>> children_;
+        std::vector<std::vector<size_t>> frontier_;
+        std::vector<size_t> depth_; // in the dominator tree, for dominates()
+    };
+} // namespace Ryntra::IR
@@ -0,0 +1,28 @@
+#include "FunctionAnalyses.h"
+
+namespace Ryntra::IR {
+    const ControlFlowGraph &FunctionAnalyses::getControlFlowGraph() {
+        if (!cfg_)
+            cfg_ = std::make_unique<ControlFlowGraph>(function_);
+        return *cfg_;
+    }
+
+    const DominatorTree &FunctionAnalyses::getDominatorTree() {
+        if (!domTree_)
+            domTree_ = std::make_unique<DominatorTree>(getControlFlowGraph());
+        return *domTree_;
+    }
+
+    const LoopInfo &FunctionAnalyses::getLoopInfo() {
+        if (!loopInfo_)
+            loopInfo_ = std::make_unique<LoopInfo>(getControlFlowGraph(), getDominatorTree());
+        return *loopInfo_;
+    }
+
+    void FunctionAnalyses::invalidate() {
+        // The dominator tree refers to the graph, so it goes first
+        loopInfo_.reset();
+        domTree_.reset();
+        cfg_.reset();
+    }
+} // namespace Ryntra::IR
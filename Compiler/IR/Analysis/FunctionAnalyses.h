@@ -0,0 +1,27 @@
+#pragma once
+
+#include "LoopInfo.h"
+#include <memory>
+
+namespace Ryntra::IR {
+    // The analyses of one function, each computed on first use and kept until invalidate(). They
+    // describe the blocks and terminators as they were then, so whoever adds, removes or
+    // retargets a block must invalidate before asking again; instruction changes inside blocks
+    // leave them valid. The PassManager invalidates after every pass that may have done so.
+    class FunctionAnalyses {
+    public:
+        explicit FunctionAnalyses(const Function &function) : function_(function) {}
+
+        const ControlFlowGraph &getControlFlowGraph();
+        const DominatorTree &getDominatorTree();
+        const LoopInfo &getLoopInfo();
+
+        void invalidate();
+
+    private:
+        const Function &function_;
+        std::unique_ptr<ControlFlowGraph> cfg_;
+        std::unique_ptr<DominatorTree> domTree_;
+        std::unique_ptr<LoopInfo> loopInfo_;
+    };
+} // namespace Ryntra::IR
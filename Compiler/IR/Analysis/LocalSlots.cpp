@@ -0,0 +1,18 @@
+#include "LocalSlots.h"
+
+namespace Ryntra::IR {
+    bool hasComputedSlotPointers(const Function &function) {
+        for (const auto &block : function.getBasicBlocks()) {
+            for (const auto &inst : block->getInstructions()) {
+                if (inst->getOpcode() != Instruction::Opcode::PtrCreate)
+                    continue;
+                for (const auto &operand : inst->getOperands()) {
+                    auto *source = dynamic_cast<const Instruction *>(operand);
+                    if (!source || source->getOpcode() != Instruction::Opcode::Alloca)
+                        return true;
+                }
+            }
+        }
+        return false;
+    }
+} // namespace Ryntra::IR
@@ -0,0 +1,11 @@
+#pragma once
+
+#include "../Function.h"
+
+namespace Ryntra::IR {
+    // Whether the function builds a pointer from a computed slot (pointer arithmetic on locals).
+    // Every alloca and every value-producing instruction gets a slot in layout order, and such a
+    // pointer can reach any of them, so the slot layout of the function is observable: passes
+    // that drop or add slotted instructions leave it alone.
+    bool hasComputedSlotPointers(const Function &function);
+} // namespace Ryntra::IR
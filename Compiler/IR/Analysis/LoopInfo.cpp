@@ -0,0 +1,52 @@
+#include "LoopInfo.h"
+#include <algorithm>
+
+namespace Ryntra::IR {
+    std::vector<size_t> Loop::getEntries(const ControlFlowGraph &cfg) const {
+        std::vector<size_t> entries;
+        for (size_t pred : cfg.getPredecessors(header)) {
+            if (!contains[pred] && cfg.isReachable(pred))
+                entries.push_back(pred);
+        }
+        return entries;
+    }
+
+    LoopInfo::LoopInfo(const ControlFlowGraph &cfg, const DominatorTree &domTree) {
+        for (size_t header : cfg.getReversePostOrder()) {
+            Loop loop;
+            loop.header = header;
+            for (size_t pred : cfg.getPredecessors(header)) {
+                if (domTree.dominates(header, pred) &&
+                    std::find(loop.latches.begin(), loop.latches.end(), pred) == loop.latches.end())
+                    loop.latches.push_back(pred);
+            }
+            if (loop.latches.empty())
+                continue;
+
+            // Walk back from the latches; the header dominates all of them, so this stops there
+            loop.contains.assign(cfg.size(), false);
+            loop.contains[header] = true;
+            std::vector<size_t> worklist = loop.latches;
+            while (!worklist.empty()) {
+                size_t b = worklist.back();
+                worklist.pop_back();
+                if (loop.contains[b])
+                    continue;
+                loop.contains[b] = true;
+                for (size_t pred : cfg.getPredecessors(b)) {
+                    if (cfg.isReachable(pred))
+                        worklist.push_back(pred);
+                }
+            }
+            for (size_t b : cfg.getReversePostOrder()) {
+                if (loop.contains[b])
+                    loop.blocks.push_back(b);
+            }
+            loops_.push_back(std::move(loop));
+        }
+
+        // A loop nested in another has fewer blocks
+        std::stable_sort(loops_.begin(), loops_.end(),
+                         [](const Loop &a, const Loop &b) { return a.blocks.size() < b.blocks.size(); });
+    }
+} // namespace Ryntra::IR
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "Dominators.h"
+#include <vector>
+
+namespace Ryntra::IR {
+    // A natural loop: the header plus every block that reaches one of its latches (blocks
+    // with a back edge to the header) without passing through the header. Back edges sharing
+    // a header form a single loop.
+    struct Loop {
+        size_t header = 0;
+        std::vector<size_t> blocks;  // in reverse post-order, header first
+        std::vector<size_t> latches;
+        std::vector<bool> contains;  // by block index
+
+        // Predecessors of the header from outside the loop, with multiplicity
+        std::vector<size_t> getEntries(const ControlFlowGraph &cfg) const;
+    };
+
+    // The natural loops of a function, from its ControlFlowGraph and DominatorTree
+    class LoopInfo {
+    public:
+        LoopInfo(const ControlFlowGraph &cfg, const DominatorTree &domTree);
+
+        // Inner loops come before the loops that contain them
+        const std::vector<Loop> &getLoops() const { return loops_; }
+
+    private:
+        std::vector<Loop> loops_;
+    };
+} // namespace Ryntra::IR
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Ryntra::IR {
+    // Bump allocator owning the IR objects of one module. Objects are never freed one at a time:
+    // when the arena dies they are destroyed newest first and their memory is released in one go,
+    // so their destructors must not look at other objects of the arena.
+    class Arena {
+    public:
+        Arena() = default;
+
+        ~Arena() {
+            for (auto it = destructors_.rbegin(); it != destructors_.rend(); ++it)
+                it->destroy(it->object);
+        }
+
+        Arena(const Arena &) = delete;
+        Arena &operator=(const Arena &) = delete;
+
+        template <typename T, typename... Args>
+        T *create(Args &&...args) {
+            void *memory = resource_.allocate(sizeof(T), alignof(T));
+            allocatedBytes_ += sizeof(T);
+            T *object = new (memory) T(std::forward<Args>(args)...);
+            if constexpr (!std::is_trivially_destructible_v<T>)
+                destructors_.push_back({object, [](void *p) { static_cast<T *>(p)->~T(); }});
+            return object;
+        }
+
+        // Bytes of objects created so far, not counting what they allocate themselves
+        size_t getAllocatedBytes() const { return allocatedBytes_; }
+
+    private:
+        struct Destructor {
+            void *object;
+            void (*destroy)(void *);
+        };
+
+        static constexpr size_t InitialChunkSize = 16 * 1024;
+
+        std::pmr::monotonic_buffer_resource resource_{InitialChunkSize};
+        std::vector<Destructor> destructors_;
+        size_t allocatedBytes_ = 0;
+    };
+} // namespace Ryntra::IR
@@ -2,25 +2,69 @@
 
 #include "Instruction.h"
 #include "Type.h"
-#include <memory>
+#include <algorithm>
 #include <string>
 #include <vector>
 
 namespace Ryntra::IR {
+    class Function;
     class Value;
 
     class BasicBlock {
     public:
         BasicBlock(const std::string &name) : name_(name) {}
 
+        BasicBlock(const BasicBlock &) = delete;
+        BasicBlock &operator=(const BasicBlock &) = delete;
+
         const std::string &getName() const { return name_; }
         void setName(const std::string &name) { name_ = name; }
 
-        void addInstruction(std::shared_ptr<Instruction> instruction) {
+        // The function this block is in, or null once it has been taken out
+        Function *getParent() const { return parent_; }
+
+        void addInstruction(Instruction *instruction) {
+            instruction->parent_ = this;
             instructions_.push_back(instruction);
         }
 
-        const std::vector<std::shared_ptr<Instruction>> &getInstructions() const {
+        void insertInstruction(size_t index, Instruction *instruction) {
+            instruction->parent_ = this;
+            instructions_.insert(instructions_.begin() + index, instruction);
+        }
+
+        // Takes the matching instructions out of the block, e.g. to move them to another one
+        template <typename Predicate>
+        void removeInstructions(Predicate predicate) {
+            std::erase_if(instructions_, [&](Instruction *inst) {
+                if (!predicate(inst))
+                    return false;
+                if (inst->parent_ == this)
+                    inst->parent_ = nullptr;
+                return true;
+            });
+        }
+
+        // Removes the matching instructions for good: like removeInstructions, but their
+        // operands are dropped too, so they stop being users (see Instruction::eraseFromParent)
+        template <typename Predicate>
+        void eraseInstructions(Predicate predicate) {
+            std::vector<Instruction *> erased;
+            removeInstructions([&](Instruction *inst) {
+                if (!predicate(inst))
+                    return false;
+                erased.push_back(inst);
+                return true;
+            });
+            for (Instruction *inst : erased)
+                inst->dropAllReferences();
+        }
+
+        // Drops the operands of every instruction and removes the block from its function.
+        // Branches to it and phi operands naming it must be gone already.
+        void eraseFromParent();
+
+        const std::vector<Instruction *> &getInstructions() const {
             return instructions_;
         }
 
@@ -33,7 +77,16 @@ namespace Ryntra::IR {
         }
 
     private:
+        friend class Function;
+
         std::string name_;
-        std::vector<std::shared_ptr<Instruction>> instructions_;
+        std::vector<Instruction *> instructions_;
+        Function *parent_ = nullptr;
     };
+
+    inline void Instruction::eraseFromParent() {
+        dropAllReferences();
+        if (parent_)
+            parent_->removeInstructions([this](Instruction *inst) { return inst == this; });
+    }
 } // namespace Ryntra::IR
\ No newline at end of file
@@ -12,7 +12,7 @@ namespace Ryntra::IR {
     public:
         using ValueType = std::variant<int32_t, int64_t, bool, std::string>;
 
-        Constant(std::shared_ptr<Type> type, ValueType value, const std::string &name = "")
+        Constant(Type *type, ValueType value, const std::string &name = "")
             : Value(type, name), value_(value) {}
 
         virtual ~Constant() = default;
@@ -37,22 +37,6 @@ namespace Ryntra::IR {
             return result;
         }
 
-        static std::shared_ptr<Constant> createInt32Constant(int32_t value, const std::string &name = "") {
-            return std::make_shared<Constant>(Type::getInt32Type(), value, name);
-        }
-
-        static std::shared_ptr<Constant> createStringConstant(const std::string &value, const std::string &name = "") {
-            return std::make_shared<Constant>(Type::getStringType(), value, name);
-        }
-
-        static std::shared_ptr<Constant> createInt64Constant(int64_t value, const std::string &name = "") {
-            return std::make_shared<Constant>(Type::getInt64Type(), value, name);
-        }
-
-        static std::shared_ptr<Constant> createBoolConstant(bool value, const std::string &name = "") {
-            return std::make_shared<Constant>(Type::getBoolType(), value, name);
-        }
-
     private:
         static std::string escapeString(const std::string &str) {
             std::string result;
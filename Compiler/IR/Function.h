@@ -8,38 +8,61 @@
 #include <vector>
 
 namespace Ryntra::IR {
+    class Module;
+
     class Function : public Value {
     public:
         struct Parameter {
             std::string name;
-            std::shared_ptr<Type> type;
+            Type *type;
 
-            Parameter(const std::string &name, std::shared_ptr<Type> type)
+            Parameter(const std::string &name, Type *type)
                 : name(name), type(type) {}
         };
 
+        // type comes from the module's TypeTable and must match the parameters
         Function(const std::string &name,
-                 std::shared_ptr<Type> returnType,
+                 FunctionType *type,
                  const std::vector<Parameter> &parameters = {},
                  bool isExternal = false)
-            : Value(std::make_shared<FunctionType>(returnType, extractParamTypes(parameters)), name),
-              returnType_(returnType),
+            : Value(type, name),
+              returnType_(type->getReturnType()),
               parameters_(parameters),
               isExternal_(isExternal) {}
 
-        std::shared_ptr<Type> getReturnType() const { return returnType_; }
+        Type *getReturnType() const { return returnType_; }
         const std::vector<Parameter> &getParameters() const { return parameters_; }
         bool isExternal() const { return isExternal_; }
 
-        void addBasicBlock(std::shared_ptr<BasicBlock> block) {
+        // The module this function was added to; new IR for it is allocated there
+        Module *getParent() const { return parent_; }
+
+        void addBasicBlock(BasicBlock *block) {
+            block->parent_ = this;
             basicBlocks_.push_back(block);
         }
 
-        const std::vector<std::shared_ptr<BasicBlock>> &getBasicBlocks() const {
+        void insertBasicBlock(size_t index, BasicBlock *block) {
+            block->parent_ = this;
+            basicBlocks_.insert(basicBlocks_.begin() + index, block);
+        }
+
+        template <typename Predicate>
+        void removeBasicBlocks(Predicate predicate) {
+            std::erase_if(basicBlocks_, [&](BasicBlock *block) {
+                if (!predicate(block))
+                    return false;
+                if (block->parent_ == this)
+                    block->parent_ = nullptr;
+                return true;
+            });
+        }
+
+        const std::vector<BasicBlock *> &getBasicBlocks() const {
             return basicBlocks_;
         }
 
-        std::shared_ptr<BasicBlock> getEntryBlock() const {
+        BasicBlock *getEntryBlock() const {
             return basicBlocks_.empty() ? nullptr : basicBlocks_[0];
         }
 
@@ -72,18 +95,19 @@ namespace Ryntra::IR {
         }
 
     private:
-        static std::vector<std::shared_ptr<Type>> extractParamTypes(const std::vector<Parameter> &params) {
-            std::vector<std::shared_ptr<Type>> types;
-            for (const auto &param : params) {
-                types.push_back(param.type);
-            }
-            return types;
-        }
+        friend class Module;
 
-    private:
-        std::shared_ptr<Type> returnType_;
+        Type *returnType_;
         std::vector<Parameter> parameters_;
-        std::vector<std::shared_ptr<BasicBlock>> basicBlocks_;
+        std::vector<BasicBlock *> basicBlocks_;
         bool isExternal_;
+        Module *parent_ = nullptr;
     };
+
+    inline void BasicBlock::eraseFromParent() {
+        for (Instruction *inst : instructions_)
+            inst->dropAllReferences();
+        if (parent_)
+            parent_->removeBasicBlocks([this](BasicBlock *block) { return block == this; });
+    }
 } // namespace Ryntra::IR
@@ -16,6 +16,7 @@ namespace Ryntra::IR {
     }
 
     void IRGenerator::visit(Sem::TypedFunctionDefinitionNode &node) {
+        LocationScope location(builder_, node);
         auto irFunc = functionMap_[node.getName()];
         if (!irFunc)
             return;
@@ -39,6 +40,7 @@ namespace Ryntra::IR {
     }
 
     void IRGenerator::visit(Sem::TypedIfNode &node) {
+        LocationScope location(builder_, node);
         auto currentFunc = functionMap_[currentFunctionName_];
         if (!currentFunc)
             return;
@@ -104,6 +106,7 @@ namespace Ryntra::IR {
     }
 
     void IRGenerator::visit(Sem::TypedWhileNode &node) {
+        LocationScope location(builder_, node);
         auto currentFunc = functionMap_[currentFunctionName_];
         if (!currentFunc)
             return;
@@ -147,6 +150,7 @@ namespace Ryntra::IR {
     }
 
     void IRGenerator::visit(Sem::TypedForNode &node) {
+        LocationScope location(builder_, node);
         auto currentFunc = functionMap_[currentFunctionName_];
         if (!currentFunc)
             return;
@@ -166,12 +170,12 @@ namespace Ryntra::IR {
         currentFunc->addBasicBlock(condBlock);
         builder_.setInsertPoint(condBlock);
 
-        std::shared_ptr<Value> condVal;
+        Value *condVal = nullptr;
         if (node.getCondition()) {
             node.getCondition()->accept(*this);
             condVal = lastValue_;
         } else {
-            condVal = std::make_shared<ImmediateValue>(Type::getBoolType(), "1");
+            condVal = builder_.createImmediate(Type::getBoolType(), "1");
         }
 
         if (!condVal) {
@@ -216,6 +220,7 @@ namespace Ryntra::IR {
     }
 
     void IRGenerator::visit(Sem::TypedBreakNode &node) {
+        LocationScope location(builder_, node);
         if (loopStack_.empty())
             return;
         auto curBlock = builder_.getInsertPoint();
@@ -229,6 +234,7 @@ namespace Ryntra::IR {
     }
 
     void IRGenerator::visit(Sem::TypedContinueNode &node) {
+        LocationScope location(builder_, node);
         if (loopStack_.empty())
             return;
         auto curBlock = builder_.getInsertPoint();
@@ -248,10 +254,12 @@ namespace Ryntra::IR {
     }
 
     void IRGenerator::visit(Sem::TypedExpressionStatementNode &node) {
+        LocationScope location(builder_, node);
         node.getExpression()->accept(*this);
     }
 
     void IRGenerator::visit(Sem::TypedReturnNode &node) {
+        LocationScope location(builder_, node);
         node.getValue()->accept(*this);
         auto retVal = lastValue_;
         builder_.createReturn("", retVal);
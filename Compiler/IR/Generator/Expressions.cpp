@@ -5,6 +5,7 @@ namespace Ryntra::IR {
     namespace Sem = Compiler::Semantic;
 
     void IRGenerator::visit(Sem::TypedStringLiteralNode &node) {
+        LocationScope location(builder_, node);
         auto constant = builder_.createGlobalConstant(
             Type::getStringType(),
             node.getValue());
@@ -13,29 +14,34 @@ namespace Ryntra::IR {
     }
 
     void IRGenerator::visit(Sem::TypedBoolLiteralNode &node) {
-        lastValue_ = std::make_shared<ImmediateValue>(
+        LocationScope location(builder_, node);
+        lastValue_ = builder_.createImmediate(
             Type::getBoolType(),
             node.getValue() ? "1" : "0");
     }
 
     void IRGenerator::visit(Sem::TypedIntegerLiteralNode &node) {
-        lastValue_ = std::make_shared<ImmediateValue>(
+        LocationScope location(builder_, node);
+        lastValue_ = builder_.createImmediate(
             Type::getInt32Type(),
             std::to_string(node.getValue()));
     }
 
     void IRGenerator::visit(Sem::TypedLongLiteralNode &node) {
-        lastValue_ = std::make_shared<ImmediateValue>(
+        LocationScope location(builder_, node);
+        lastValue_ = builder_.createImmediate(
             Type::getInt64Type(),
             std::to_string(node.getValue()));
     }
 
     void IRGenerator::visit(Sem::TypedNullLiteralNode &node) {
-        lastValue_ = std::make_shared<ImmediateValue>(
+        LocationScope location(builder_, node);
+        lastValue_ = builder_.createImmediate(
             Type::getInt32Type(), "-1");
     }
 
     void IRGenerator::visit(Sem::TypedIdentifierNode &node) {
+        LocationScope location(builder_, node);
         auto funcIt = functionMap_.find(node.getName());
         if (funcIt != functionMap_.end()) {
             lastValue_ = funcIt->second;
@@ -56,9 +62,10 @@ namespace Ryntra::IR {
     }
 
     void IRGenerator::visit(Sem::TypedFunctionCallNode &node) {
+        LocationScope location(builder_, node);
         const std::string &calleeName = node.getFunctionName()->getName();
 
-        std::vector<std::shared_ptr<Value>> argValues;
+        std::vector<Value *> argValues;
         for (const auto &arg : node.getArguments()) {
             arg->accept(*this);
             if (lastValue_)
@@ -82,18 +89,18 @@ namespace Ryntra::IR {
             } else if (calleeName == "__builtin_scan") {
                 std::string suffix;
                 auto retType = node.getType();
-                if (retType->toString() == "int")
+                if (retType == Sem::TypeFactory::getInt())
                     suffix = "i32";
-                else if (retType->toString() == "long")
+                else if (retType == Sem::TypeFactory::getLong())
                     suffix = "i64";
-                else if (retType->toString() == "bool")
+                else if (retType == Sem::TypeFactory::getBool())
                     suffix = "bool";
                 actualName = calleeName + "_" + suffix;
             }
         }
 
         auto it = functionMap_.find(actualName);
-        std::shared_ptr<Function> callee;
+        Function *callee = nullptr;
         if (it != functionMap_.end()) {
             callee = it->second;
         } else {
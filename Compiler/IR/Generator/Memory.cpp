@@ -5,6 +5,7 @@ namespace Ryntra::IR {
     namespace Sem = Compiler::Semantic;
 
     void IRGenerator::visit(Compiler::Semantic::TypedRefCreateNode &node) {
+        LocationScope location(builder_, node);
         auto varName = node.getVariableName();
         auto it = allocaMap_.find(varName);
         if (it == allocaMap_.end()) {
@@ -18,6 +19,7 @@ namespace Ryntra::IR {
     }
 
     void IRGenerator::visit(Compiler::Semantic::TypedRefLoadNode &node) {
+        LocationScope location(builder_, node);
         auto varName = node.getVariableName();
         auto it = allocaMap_.find(varName);
         if (it == allocaMap_.end()) {
@@ -25,7 +27,7 @@ namespace Ryntra::IR {
             return;
         }
 
-        auto refIRType = std::make_shared<IR::RefType>(toIRType(node.getType()));
+        auto refIRType = builder_.getTypes().getRefType(toIRType(node.getType()));
         auto refVal = builder_.createLoad(
             builder_.generateUniqueName(""), it->second, refIRType);
 
@@ -35,6 +37,7 @@ namespace Ryntra::IR {
     }
 
     void IRGenerator::visit(Compiler::Semantic::TypedRefAssignNode &node) {
+        LocationScope location(builder_, node);
         auto varName = node.getVariableName();
         auto it = allocaMap_.find(varName);
         if (it == allocaMap_.end()) {
@@ -42,7 +45,7 @@ namespace Ryntra::IR {
             return;
         }
 
-        auto refIRType = std::make_shared<IR::RefType>(toIRType(node.getType()));
+        auto refIRType = builder_.getTypes().getRefType(toIRType(node.getType()));
         auto refVal = builder_.createLoad(
             builder_.generateUniqueName(""), it->second, refIRType);
 
@@ -52,8 +55,8 @@ namespace Ryntra::IR {
             return;
         }
 
-        std::shared_ptr<Value> storeVal = lastValue_;
-        if (auto imm = std::dynamic_pointer_cast<ImmediateValue>(lastValue_)) {
+        Value *storeVal = lastValue_;
+        if (auto imm = dynamic_cast<ImmediateValue *>(lastValue_)) {
             storeVal = builder_.createConstant(
                 builder_.generateUniqueName(""), imm->getType(), imm);
         }
@@ -63,6 +66,7 @@ namespace Ryntra::IR {
     }
 
     void IRGenerator::visit(Compiler::Semantic::TypedPtrCreateNode &node) {
+        LocationScope location(builder_, node);
         auto varName = node.getVariableName();
         auto it = allocaMap_.find(varName);
         if (it == allocaMap_.end()) {
@@ -76,6 +80,7 @@ namespace Ryntra::IR {
     }
 
     void IRGenerator::visit(Compiler::Semantic::TypedPtrLoadNode &node) {
+        LocationScope location(builder_, node);
         auto ptrVarName = node.getPtrVarName();
         auto it = allocaMap_.find(ptrVarName);
         if (it == allocaMap_.end()) {
@@ -83,7 +88,7 @@ namespace Ryntra::IR {
             return;
         }
 
-        auto ptrIRType = std::make_shared<IR::PtrType>(toIRType(node.getType()));
+        auto ptrIRType = builder_.getTypes().getPtrType(toIRType(node.getType()));
         auto ptrVal = builder_.createLoad(
             builder_.generateUniqueName(""), it->second, ptrIRType);
 
@@ -93,6 +98,7 @@ namespace Ryntra::IR {
     }
 
     void IRGenerator::visit(Compiler::Semantic::TypedPtrStoreNode &node) {
+        LocationScope location(builder_, node);
         auto ptrVarName = node.getPtrVarName();
         auto it = allocaMap_.find(ptrVarName);
         if (it == allocaMap_.end()) {
@@ -100,7 +106,7 @@ namespace Ryntra::IR {
             return;
         }
 
-        auto ptrIRType = std::make_shared<IR::PtrType>(toIRType(node.getType()));
+        auto ptrIRType = builder_.getTypes().getPtrType(toIRType(node.getType()));
         auto ptrVal = builder_.createLoad(
             builder_.generateUniqueName(""), it->second, ptrIRType);
 
@@ -110,8 +116,8 @@ namespace Ryntra::IR {
             return;
         }
 
-        std::shared_ptr<Value> storeVal = lastValue_;
-        if (auto imm = std::dynamic_pointer_cast<ImmediateValue>(lastValue_)) {
+        Value *storeVal = lastValue_;
+        if (auto imm = dynamic_cast<ImmediateValue *>(lastValue_)) {
             storeVal = builder_.createConstant(
                 builder_.generateUniqueName(""), imm->getType(), imm);
         }
@@ -121,6 +127,7 @@ namespace Ryntra::IR {
     }
 
     void IRGenerator::visit(Compiler::Semantic::TypedPtrOffsetNode &node) {
+        LocationScope location(builder_, node);
         auto ptrVarName = node.getPtrVarName();
         auto it = allocaMap_.find(ptrVarName);
         if (it == allocaMap_.end()) {
@@ -128,12 +135,12 @@ namespace Ryntra::IR {
             return;
         }
 
-        auto ptrIRType = std::make_shared<IR::PtrType>(Type::getInt32Type());
+        auto ptrIRType = builder_.getTypes().getPtrType(Type::getInt32Type());
         auto ptrVal = builder_.createLoad(
             builder_.generateUniqueName(""), it->second, ptrIRType);
 
-        std::shared_ptr<Value> ptrForArith = ptrVal;
-        if (auto imm = std::dynamic_pointer_cast<ImmediateValue>(ptrVal)) {
+        Value *ptrForArith = ptrVal;
+        if (auto imm = dynamic_cast<ImmediateValue *>(ptrVal)) {
             ptrForArith = builder_.createConstant(
                 builder_.generateUniqueName(""), Type::getInt32Type(), imm);
         }
@@ -144,21 +151,21 @@ namespace Ryntra::IR {
             lastValue_ = nullptr;
             return;
         }
-        if (auto imm = std::dynamic_pointer_cast<ImmediateValue>(offsetVal)) {
+        if (auto imm = dynamic_cast<ImmediateValue *>(offsetVal)) {
             offsetVal = builder_.createConstant(
                 builder_.generateUniqueName(""), imm->getType(), imm);
         }
 
         auto arithOp = node.getIsAdd() ? Instruction::Opcode::Add : Instruction::Opcode::Sub;
-        std::vector<std::shared_ptr<Value>> arithOperands = {ptrForArith, offsetVal};
-        auto newSlotInst = std::make_shared<Instruction>(
+        std::vector<Value *> arithOperands = {ptrForArith, offsetVal};
+        auto newSlotInst = builder_.getModule()->create<Instruction>(
             arithOp, Type::getInt32Type(), arithOperands,
             builder_.generateUniqueName(""));
         builder_.addInstruction(newSlotInst);
 
         auto ptrResultType = toIRType(node.getType());
-        std::vector<std::shared_ptr<Value>> createOperands = {newSlotInst};
-        auto ptrResult = std::make_shared<Instruction>(
+        std::vector<Value *> createOperands = {newSlotInst};
+        auto ptrResult = builder_.getModule()->create<Instruction>(
             Instruction::Opcode::PtrCreate, ptrResultType, createOperands,
             builder_.generateUniqueName(""));
         builder_.addInstruction(ptrResult);
@@ -166,6 +173,7 @@ namespace Ryntra::IR {
     }
 
     void IRGenerator::visit(Compiler::Semantic::TypedPtrDiffNode &node) {
+        LocationScope location(builder_, node);
         auto leftIt = allocaMap_.find(node.getLeftPtrName());
         auto rightIt = allocaMap_.find(node.getRightPtrName());
         if (leftIt == allocaMap_.end() || rightIt == allocaMap_.end()) {
@@ -173,25 +181,25 @@ namespace Ryntra::IR {
             return;
         }
 
-        auto ptrIRType = std::make_shared<IR::PtrType>(Type::getInt32Type());
+        auto ptrIRType = builder_.getTypes().getPtrType(Type::getInt32Type());
         auto leftPtrVal = builder_.createLoad(
             builder_.generateUniqueName(""), leftIt->second, ptrIRType);
         auto rightPtrVal = builder_.createLoad(
             builder_.generateUniqueName(""), rightIt->second, ptrIRType);
 
-        std::shared_ptr<Value> leftForArith = leftPtrVal;
-        if (auto imm = std::dynamic_pointer_cast<ImmediateValue>(leftPtrVal)) {
+        Value *leftForArith = leftPtrVal;
+        if (auto imm = dynamic_cast<ImmediateValue *>(leftPtrVal)) {
             leftForArith = builder_.createConstant(
                 builder_.generateUniqueName(""), Type::getInt32Type(), imm);
         }
-        std::shared_ptr<Value> rightForArith = rightPtrVal;
-        if (auto imm = std::dynamic_pointer_cast<ImmediateValue>(rightPtrVal)) {
+        Value *rightForArith = rightPtrVal;
+        if (auto imm = dynamic_cast<ImmediateValue *>(rightPtrVal)) {
             rightForArith = builder_.createConstant(
                 builder_.generateUniqueName(""), Type::getInt32Type(), imm);
         }
 
-        std::vector<std::shared_ptr<Value>> operands = {leftForArith, rightForArith};
-        auto result = std::make_shared<Instruction>(
+        std::vector<Value *> operands = {leftForArith, rightForArith};
+        auto result = builder_.getModule()->create<Instruction>(
             Instruction::Opcode::Sub, Type::getInt32Type(), operands,
             builder_.generateUniqueName(""));
         builder_.addInstruction(result);
@@ -199,6 +207,7 @@ namespace Ryntra::IR {
     }
 
     void IRGenerator::visit(Compiler::Semantic::TypedPtrFromArrayNode &node) {
+        LocationScope location(builder_, node);
         auto varName = node.getArrayName();
         auto it = allocaMap_.find(varName);
         if (it == allocaMap_.end()) {
@@ -210,7 +219,7 @@ namespace Ryntra::IR {
         auto elemIRType = toIRType(semPtrType.getElementType());
 
         auto arrAlloca = it->second;
-        auto arrIRType = std::make_shared<IR::ArrayType>(elemIRType);
+        auto arrIRType = builder_.getTypes().getArrayType(elemIRType);
         auto arrayVal = builder_.createLoad(
             builder_.generateUniqueName(""), arrAlloca, arrIRType);
 
@@ -224,7 +233,8 @@ namespace Ryntra::IR {
     }
 
     void IRGenerator::visit(Sem::TypedNewNode &node) {
-        std::shared_ptr<Value> initVal;
+        LocationScope location(builder_, node);
+        Value *initVal = nullptr;
         if (node.getInitializer()) {
             node.getInitializer()->accept(*this);
             initVal = lastValue_;
@@ -235,19 +245,19 @@ namespace Ryntra::IR {
         } else {
             auto elemIRType = toIRType(node.getElementType());
             if (elemIRType->isInt32()) {
-                initVal = std::make_shared<ImmediateValue>(Type::getInt32Type(), "0");
+                initVal = builder_.createImmediate(Type::getInt32Type(), "0");
             } else if (elemIRType->isInt64()) {
-                initVal = std::make_shared<ImmediateValue>(Type::getInt64Type(), "0");
+                initVal = builder_.createImmediate(Type::getInt64Type(), "0");
             } else if (elemIRType->isBool()) {
-                initVal = std::make_shared<ImmediateValue>(Type::getBoolType(), "0");
+                initVal = builder_.createImmediate(Type::getBoolType(), "0");
             } else {
                 lastValue_ = nullptr;
                 return;
             }
         }
 
-        std::shared_ptr<Value> materialized = initVal;
-        if (auto imm = std::dynamic_pointer_cast<ImmediateValue>(initVal)) {
+        Value *materialized = initVal;
+        if (auto imm = dynamic_cast<ImmediateValue *>(initVal)) {
             materialized = builder_.createConstant(
                 builder_.generateUniqueName(""), imm->getType(), imm);
         }
@@ -258,6 +268,7 @@ namespace Ryntra::IR {
     }
 
     void IRGenerator::visit(Sem::TypedDeleteNode &node) {
+        LocationScope location(builder_, node);
         node.getPtrExpr()->accept(*this);
         auto ptrVal = lastValue_;
         if (!ptrVal) {
@@ -265,8 +276,8 @@ namespace Ryntra::IR {
             return;
         }
 
-        std::shared_ptr<Value> materialized = ptrVal;
-        if (auto imm = std::dynamic_pointer_cast<ImmediateValue>(ptrVal)) {
+        Value *materialized = ptrVal;
+        if (auto imm = dynamic_cast<ImmediateValue *>(ptrVal)) {
             materialized = builder_.createConstant(
                 builder_.generateUniqueName(""), imm->getType(), imm);
         }
@@ -276,6 +287,7 @@ namespace Ryntra::IR {
     }
 
     void IRGenerator::visit(Sem::TypedFixedNode &node) {
+        LocationScope location(builder_, node);
         node.getInitExpr()->accept(*this);
         auto initVal = lastValue_;
         if (!initVal) {
@@ -283,8 +295,8 @@ namespace Ryntra::IR {
             return;
         }
 
-        std::shared_ptr<Value> materialized = initVal;
-        if (auto imm = std::dynamic_pointer_cast<ImmediateValue>(initVal)) {
+        Value *materialized = initVal;
+        if (auto imm = dynamic_cast<ImmediateValue *>(initVal)) {
             materialized = builder_.createConstant(
                 builder_.generateUniqueName(""), imm->getType(), imm);
         }
@@ -306,6 +318,7 @@ namespace Ryntra::IR {
     }
 
     void IRGenerator::visit(Sem::TypedPtrIndexAccessNode &node) {
+        LocationScope location(builder_, node);
         node.getPtrExpr()->accept(*this);
         auto ptrVal = lastValue_;
         if (!ptrVal) {
@@ -313,8 +326,8 @@ namespace Ryntra::IR {
             return;
         }
 
-        std::shared_ptr<Value> ptrMaterialized = ptrVal;
-        if (auto imm = std::dynamic_pointer_cast<ImmediateValue>(ptrVal)) {
+        Value *ptrMaterialized = ptrVal;
+        if (auto imm = dynamic_cast<ImmediateValue *>(ptrVal)) {
             ptrMaterialized = builder_.createConstant(
                 builder_.generateUniqueName(""), imm->getType(), imm);
         }
@@ -325,13 +338,13 @@ namespace Ryntra::IR {
             lastValue_ = nullptr;
             return;
         }
-        if (auto imm = std::dynamic_pointer_cast<ImmediateValue>(indexVal)) {
+        if (auto imm = dynamic_cast<ImmediateValue *>(indexVal)) {
             indexVal = builder_.createConstant(
                 builder_.generateUniqueName(""), imm->getType(), imm);
         }
 
         auto elemIRType = toIRType(node.getType());
-        auto refType = std::make_shared<IR::RefType>(elemIRType);
+        auto refType = builder_.getTypes().getRefType(elemIRType);
 
         auto ptrIndexRef = builder_.createPtrIndexRef(
             builder_.generateUniqueName(""), ptrMaterialized, indexVal, refType);
@@ -341,6 +354,7 @@ namespace Ryntra::IR {
     }
 
     void IRGenerator::visit(Sem::TypedPtrIndexAssignmentNode &node) {
+        LocationScope location(builder_, node);
         node.getPtrExpr()->accept(*this);
         auto ptrVal = lastValue_;
         if (!ptrVal) {
@@ -348,8 +362,8 @@ namespace Ryntra::IR {
             return;
         }
 
-        std::shared_ptr<Value> ptrMaterialized = ptrVal;
-        if (auto imm = std::dynamic_pointer_cast<ImmediateValue>(ptrVal)) {
+        Value *ptrMaterialized = ptrVal;
+        if (auto imm = dynamic_cast<ImmediateValue *>(ptrVal)) {
             ptrMaterialized = builder_.createConstant(
                 builder_.generateUniqueName(""), imm->getType(), imm);
         }
@@ -360,7 +374,7 @@ namespace Ryntra::IR {
             lastValue_ = nullptr;
             return;
         }
-        if (auto imm = std::dynamic_pointer_cast<ImmediateValue>(indexVal)) {
+        if (auto imm = dynamic_cast<ImmediateValue *>(indexVal)) {
             indexVal = builder_.createConstant(
                 builder_.generateUniqueName(""), imm->getType(), imm);
         }
@@ -371,13 +385,13 @@ namespace Ryntra::IR {
             lastValue_ = nullptr;
             return;
         }
-        std::shared_ptr<Value> storeVal = valueVal;
-        if (auto imm = std::dynamic_pointer_cast<ImmediateValue>(valueVal)) {
+        Value *storeVal = valueVal;
+        if (auto imm = dynamic_cast<ImmediateValue *>(valueVal)) {
             storeVal = builder_.createConstant(
                 builder_.generateUniqueName(""), imm->getType(), imm);
         }
 
-        auto refType = std::make_shared<IR::RefType>(Type::getInt32Type());
+        auto refType = builder_.getTypes().getRefType(Type::getInt32Type());
         auto ptrIndexRef = builder_.createPtrIndexRef(
             builder_.generateUniqueName(""), ptrMaterialized, indexVal, refType);
 
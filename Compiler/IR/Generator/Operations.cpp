@@ -5,6 +5,7 @@ namespace Ryntra::IR {
     namespace Sem = Compiler::Semantic;
 
     void IRGenerator::visit(Compiler::Semantic::TypedUnaryOpNode &node) {
+        LocationScope location(builder_, node);
         node.getOperand()->accept(*this);
         auto operand = lastValue_;
         if (!operand) {
@@ -21,7 +22,7 @@ namespace Ryntra::IR {
             irOp = Instruction::Opcode::LogicalNot;
             break;
         case Compiler::UnaryOpType::Negate: {
-            auto zeroImm = std::make_shared<ImmediateValue>(operand->getType(), "0");
+            auto zeroImm = builder_.createImmediate(operand->getType(), "0");
             auto zeroConst = builder_.createConstant(
                 builder_.generateUniqueName(""), operand->getType(), zeroImm);
             auto result = builder_.createBinaryOp(
@@ -39,6 +40,7 @@ namespace Ryntra::IR {
     }
 
     void IRGenerator::visit(Compiler::Semantic::TypedBinaryOpNode &node) {
+        LocationScope location(builder_, node);
         node.getLeft()->accept(*this);
         auto lhs = lastValue_;
 
@@ -50,18 +52,18 @@ namespace Ryntra::IR {
             return;
         }
 
-        if (!lhs->getType()->isEqual(rhs->getType().get())) {
+        if (lhs->getType() != rhs->getType()) {
             if (lhs->getType()->isInt64() && rhs->getType()->isInt32()) {
-                if (auto rhsImm = std::dynamic_pointer_cast<ImmediateValue>(rhs)) {
-                    rhs = std::make_shared<ImmediateValue>(
+                if (auto rhsImm = dynamic_cast<ImmediateValue *>(rhs)) {
+                    rhs = builder_.createImmediate(
                         Type::getInt64Type(), rhsImm->getLiteralValue());
                 } else {
                     rhs = builder_.createSExt(
                         builder_.generateUniqueName(""), rhs, Type::getInt64Type());
                 }
             } else if (lhs->getType()->isInt32() && rhs->getType()->isInt64()) {
-                if (auto lhsImm = std::dynamic_pointer_cast<ImmediateValue>(lhs)) {
-                    lhs = std::make_shared<ImmediateValue>(
+                if (auto lhsImm = dynamic_cast<ImmediateValue *>(lhs)) {
+                    lhs = builder_.createImmediate(
                         Type::getInt64Type(), lhsImm->getLiteralValue());
                 } else {
                     lhs = builder_.createSExt(
@@ -109,6 +111,7 @@ namespace Ryntra::IR {
     }
 
     void IRGenerator::visit(Compiler::Semantic::TypedCastNode &node) {
+        LocationScope location(builder_, node);
         node.getOperand()->accept(*this);
         auto operand = lastValue_;
         if (!operand) {
@@ -119,8 +122,8 @@ namespace Ryntra::IR {
         auto targetIRType = toIRType(node.getType());
         auto operandIRType = operand->getType();
 
-        std::shared_ptr<Value> castOperand = operand;
-        if (auto imm = std::dynamic_pointer_cast<ImmediateValue>(operand)) {
+        Value *castOperand = operand;
+        if (auto imm = dynamic_cast<ImmediateValue *>(operand)) {
             auto constInst = builder_.createConstant(
                 builder_.generateUniqueName(""), imm->getType(), imm);
             castOperand = constInst;
@@ -138,6 +141,7 @@ namespace Ryntra::IR {
     }
 
     void IRGenerator::visit(Compiler::Semantic::TypedComparisonNode &node) {
+        LocationScope location(builder_, node);
         node.getLeft()->accept(*this);
         auto lhs = lastValue_;
 
@@ -149,15 +153,15 @@ namespace Ryntra::IR {
             return;
         }
 
-        if (!lhs->getType()->isEqual(rhs->getType().get())) {
+        if (lhs->getType() != rhs->getType()) {
             if (lhs->getType()->isInt64() && rhs->getType()->isInt32()) {
-                if (auto rhsImm = std::dynamic_pointer_cast<ImmediateValue>(rhs))
-                    rhs = std::make_shared<ImmediateValue>(Type::getInt64Type(), rhsImm->getLiteralValue());
+                if (auto rhsImm = dynamic_cast<ImmediateValue *>(rhs))
+                    rhs = builder_.createImmediate(Type::getInt64Type(), rhsImm->getLiteralValue());
                 else
                     rhs = builder_.createSExt(builder_.generateUniqueName(""), rhs, Type::getInt64Type());
             } else if (lhs->getType()->isInt32() && rhs->getType()->isInt64()) {
-                if (auto lhsImm = std::dynamic_pointer_cast<ImmediateValue>(lhs))
-                    lhs = std::make_shared<ImmediateValue>(Type::getInt64Type(), lhsImm->getLiteralValue());
+                if (auto lhsImm = dynamic_cast<ImmediateValue *>(lhs))
+                    lhs = builder_.createImmediate(Type::getInt64Type(), lhsImm->getLiteralValue());
                 else
                     lhs = builder_.createSExt(builder_.generateUniqueName(""), lhs, Type::getInt64Type());
             }
@@ -177,6 +181,7 @@ namespace Ryntra::IR {
     }
 
     void IRGenerator::visit(Compiler::Semantic::TypedPrefixOpNode &node) {
+        LocationScope location(builder_, node);
         auto varName = node.getVariableName();
         auto it = allocaMap_.find(varName);
         if (it == allocaMap_.end()) {
@@ -189,7 +194,7 @@ namespace Ryntra::IR {
         auto loadInst = builder_.createLoad(
             builder_.generateUniqueName(""), it->second, varIRType);
 
-        auto oneImm = std::make_shared<ImmediateValue>(varIRType, "1");
+        auto oneImm = builder_.createImmediate(varIRType, "1");
         auto oneConst = builder_.createConstant(
             builder_.generateUniqueName(""), varIRType, oneImm);
 
@@ -205,6 +210,7 @@ namespace Ryntra::IR {
     }
 
     void IRGenerator::visit(Compiler::Semantic::TypedPostfixOpNode &node) {
+        LocationScope location(builder_, node);
         auto varName = node.getVariableName();
         auto it = allocaMap_.find(varName);
         if (it == allocaMap_.end()) {
@@ -217,7 +223,7 @@ namespace Ryntra::IR {
         auto loadInst = builder_.createLoad(
             builder_.generateUniqueName(""), it->second, varIRType);
 
-        auto oneImm = std::make_shared<ImmediateValue>(varIRType, "1");
+        auto oneImm = builder_.createImmediate(varIRType, "1");
         auto oneConst = builder_.createConstant(
             builder_.generateUniqueName(""), varIRType, oneImm);
 
@@ -233,6 +239,7 @@ namespace Ryntra::IR {
     }
 
     void IRGenerator::visit(Compiler::Semantic::TypedAssignmentNode &node) {
+        LocationScope location(builder_, node);
         auto varName = node.getVariableName();
         auto it = allocaMap_.find(varName);
         if (it == allocaMap_.end()) {
@@ -242,8 +249,8 @@ namespace Ryntra::IR {
 
         node.getRHS()->accept(*this);
         if (lastValue_) {
-            std::shared_ptr<Value> storeVal = lastValue_;
-            if (auto imm = std::dynamic_pointer_cast<ImmediateValue>(lastValue_)) {
+            Value *storeVal = lastValue_;
+            if (auto imm = dynamic_cast<ImmediateValue *>(lastValue_)) {
                 storeVal = builder_.createConstant(
                     builder_.generateUniqueName(""),
                     imm->getType(), imm);
@@ -5,6 +5,7 @@ namespace Ryntra::IR {
     namespace Sem = Compiler::Semantic;
 
     void IRGenerator::visit(Compiler::Semantic::TypedConditionalAndNode &node) {
+        LocationScope location(builder_, node);
         auto currentFunc = functionMap_[currentFunctionName_];
         if (!currentFunc)
             return;
@@ -21,8 +22,8 @@ namespace Ryntra::IR {
             return;
         }
 
-        auto materialize = [&](std::shared_ptr<Value> v) -> std::shared_ptr<Value> {
-            if (auto imm = std::dynamic_pointer_cast<ImmediateValue>(v)) {
+        auto materialize = [&](Value *v) -> Value *{
+            if (auto imm = dynamic_cast<ImmediateValue *>(v)) {
                 return builder_.createConstant(
                     builder_.generateUniqueName(""), imm->getType(), imm);
             }
@@ -52,7 +53,7 @@ namespace Ryntra::IR {
 
         currentFunc->addBasicBlock(trueBlock);
         builder_.setInsertPoint(trueBlock);
-        auto trueImm = std::make_shared<ImmediateValue>(Type::getBoolType(), "1");
+        auto trueImm = builder_.createImmediate(Type::getBoolType(), "1");
         auto trueConst = builder_.createConstant(
             builder_.generateUniqueName(""), Type::getBoolType(), trueImm);
         builder_.createStore(trueConst, resultAlloca);
@@ -60,7 +61,7 @@ namespace Ryntra::IR {
 
         currentFunc->addBasicBlock(falseBlock);
         builder_.setInsertPoint(falseBlock);
-        auto falseImm = std::make_shared<ImmediateValue>(Type::getBoolType(), "0");
+        auto falseImm = builder_.createImmediate(Type::getBoolType(), "0");
         auto falseConst = builder_.createConstant(
             builder_.generateUniqueName(""), Type::getBoolType(), falseImm);
         builder_.createStore(falseConst, resultAlloca);
@@ -73,6 +74,7 @@ namespace Ryntra::IR {
     }
 
     void IRGenerator::visit(Compiler::Semantic::TypedConditionalOrNode &node) {
+        LocationScope location(builder_, node);
         auto currentFunc = functionMap_[currentFunctionName_];
         if (!currentFunc)
             return;
@@ -89,8 +91,8 @@ namespace Ryntra::IR {
             return;
         }
 
-        auto materialize = [&](std::shared_ptr<Value> v) -> std::shared_ptr<Value> {
-            if (auto imm = std::dynamic_pointer_cast<ImmediateValue>(v)) {
+        auto materialize = [&](Value *v) -> Value *{
+            if (auto imm = dynamic_cast<ImmediateValue *>(v)) {
                 return builder_.createConstant(
                     builder_.generateUniqueName(""), imm->getType(), imm);
             }
@@ -120,7 +122,7 @@ namespace Ryntra::IR {
 
         currentFunc->addBasicBlock(trueBlock);
         builder_.setInsertPoint(trueBlock);
-        auto trueImm = std::make_shared<ImmediateValue>(Type::getBoolType(), "1");
+        auto trueImm = builder_.createImmediate(Type::getBoolType(), "1");
         auto trueConst = builder_.createConstant(
             builder_.generateUniqueName(""), Type::getBoolType(), trueImm);
         builder_.createStore(trueConst, resultAlloca);
@@ -128,7 +130,7 @@ namespace Ryntra::IR {
 
         currentFunc->addBasicBlock(falseBlock);
         builder_.setInsertPoint(falseBlock);
-        auto falseImm = std::make_shared<ImmediateValue>(Type::getBoolType(), "0");
+        auto falseImm = builder_.createImmediate(Type::getBoolType(), "0");
         auto falseConst = builder_.createConstant(
             builder_.generateUniqueName(""), Type::getBoolType(), falseImm);
         builder_.createStore(falseConst, resultAlloca);
@@ -5,6 +5,7 @@ namespace Ryntra::IR {
     namespace Sem = Compiler::Semantic;
 
     void IRGenerator::visit(Compiler::Semantic::TypedVariableDeclarationNode &node) {
+        LocationScope location(builder_, node);
         auto varName = node.getName();
         auto varIRType = toIRType(node.getType());
 
@@ -15,8 +16,8 @@ namespace Ryntra::IR {
         if (node.getInitializer()) {
             node.getInitializer()->accept(*this);
             if (lastValue_) {
-                std::shared_ptr<Value> storeVal = lastValue_;
-                if (auto imm = std::dynamic_pointer_cast<ImmediateValue>(lastValue_)) {
+                Value *storeVal = lastValue_;
+                if (auto imm = dynamic_cast<ImmediateValue *>(lastValue_)) {
                     storeVal = builder_.createConstant(
                         builder_.generateUniqueName(""),
                         imm->getType(), imm);
@@ -28,6 +29,7 @@ namespace Ryntra::IR {
     }
 
     void IRGenerator::visit(Compiler::Semantic::TypedArrayDeclarationNode &node) {
+        LocationScope location(builder_, node);
         auto varName = node.getName();
         auto elementIRType = toIRType(node.getElementType());
 
@@ -38,7 +40,7 @@ namespace Ryntra::IR {
             return;
         }
 
-        if (auto imm = std::dynamic_pointer_cast<ImmediateValue>(sizeVal)) {
+        if (auto imm = dynamic_cast<ImmediateValue *>(sizeVal)) {
             sizeVal = builder_.createConstant(
                 builder_.generateUniqueName(""), imm->getType(), imm);
         }
@@ -47,7 +49,7 @@ namespace Ryntra::IR {
             builder_.generateUniqueName("arr." + varName + "."),
             elementIRType, sizeVal);
 
-        auto arrIRType = std::make_shared<IR::ArrayType>(elementIRType);
+        auto arrIRType = builder_.getTypes().getArrayType(elementIRType);
         auto allocaInst = builder_.createAlloca(
             builder_.generateUniqueName(varName + "."), arrIRType);
         allocaMap_[varName] = allocaInst;
@@ -57,6 +59,7 @@ namespace Ryntra::IR {
     }
 
     void IRGenerator::visit(Compiler::Semantic::TypedVariableNode &node) {
+        LocationScope location(builder_, node);
         auto it = allocaMap_.find(node.getName());
         if (it != allocaMap_.end()) {
             auto loadType = toIRType(node.getType());
@@ -70,6 +73,7 @@ namespace Ryntra::IR {
     }
 
     void IRGenerator::visit(Compiler::Semantic::TypedArrayIndexAccessNode &node) {
+        LocationScope location(builder_, node);
         auto it = allocaMap_.find(node.getArrayName());
         if (it == allocaMap_.end()) {
             lastValue_ = nullptr;
@@ -79,7 +83,7 @@ namespace Ryntra::IR {
         auto elemIRType = toIRType(node.getType());
 
         auto allocaInst = it->second;
-        auto arrIRType = std::make_shared<IR::ArrayType>(elemIRType);
+        auto arrIRType = builder_.getTypes().getArrayType(elemIRType);
         auto arrayVal = builder_.createLoad(
             builder_.generateUniqueName(""), allocaInst, arrIRType);
 
@@ -90,12 +94,12 @@ namespace Ryntra::IR {
             return;
         }
 
-        if (auto imm = std::dynamic_pointer_cast<ImmediateValue>(indexVal)) {
+        if (auto imm = dynamic_cast<ImmediateValue *>(indexVal)) {
             indexVal = builder_.createConstant(
                 builder_.generateUniqueName(""), imm->getType(), imm);
         }
 
-        auto refType = std::make_shared<IR::RefType>(elemIRType);
+        auto refType = builder_.getTypes().getRefType(elemIRType);
         auto arrRef = builder_.createArrRef(
             builder_.generateUniqueName(""), arrayVal, indexVal, refType);
         lastValue_ = builder_.createRefLoad(
@@ -103,6 +107,7 @@ namespace Ryntra::IR {
     }
 
     void IRGenerator::visit(Compiler::Semantic::TypedArrayIndexAssignmentNode &node) {
+        LocationScope location(builder_, node);
         auto it = allocaMap_.find(node.getArrayName());
         if (it == allocaMap_.end()) {
             lastValue_ = nullptr;
@@ -112,7 +117,7 @@ namespace Ryntra::IR {
         auto elemIRType = toIRType(node.getType());
 
         auto allocaInst = it->second;
-        auto arrIRType = std::make_shared<IR::ArrayType>(elemIRType);
+        auto arrIRType = builder_.getTypes().getArrayType(elemIRType);
         auto arrayVal = builder_.createLoad(
             builder_.generateUniqueName(""), allocaInst, arrIRType);
 
@@ -123,7 +128,7 @@ namespace Ryntra::IR {
             return;
         }
 
-        if (auto imm = std::dynamic_pointer_cast<ImmediateValue>(indexVal)) {
+        if (auto imm = dynamic_cast<ImmediateValue *>(indexVal)) {
             indexVal = builder_.createConstant(
                 builder_.generateUniqueName(""), imm->getType(), imm);
         }
@@ -135,13 +140,13 @@ namespace Ryntra::IR {
             return;
         }
 
-        std::shared_ptr<Value> storeVal = valueVal;
-        if (auto imm = std::dynamic_pointer_cast<ImmediateValue>(valueVal)) {
+        Value *storeVal = valueVal;
+        if (auto imm = dynamic_cast<ImmediateValue *>(valueVal)) {
             storeVal = builder_.createConstant(
                 builder_.generateUniqueName(""), imm->getType(), imm);
         }
 
-        auto refType = std::make_shared<IR::RefType>(elemIRType);
+        auto refType = builder_.getTypes().getRefType(elemIRType);
         auto arrRef = builder_.createArrRef(
             builder_.generateUniqueName(""), arrayVal, indexVal, refType);
 
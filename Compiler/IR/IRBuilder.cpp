@@ -9,37 +9,42 @@ namespace Ryntra::IR {
         return currentModule_;
     }
 
-    std::shared_ptr<Function> IRBuilder::createFunction(const std::string &name,
-                                                        std::shared_ptr<Type> returnType,
-                                                        const std::vector<Function::Parameter> &parameters,
-                                                        bool isExternal) {
+    Function *IRBuilder::createFunction(const std::string &name,
+                                        Type *returnType,
+                                        const std::vector<Function::Parameter> &parameters,
+                                        bool isExternal) {
         if (!currentModule_) {
             return nullptr;
         }
 
-        auto function = std::make_shared<Function>(name, returnType, parameters, isExternal);
+        std::vector<Type *> paramTypes;
+        for (const auto &param : parameters)
+            paramTypes.push_back(param.type);
+        auto type = currentModule_->getTypes().getFunctionType(returnType, paramTypes);
+
+        auto function = currentModule_->create<Function>(name, type, parameters, isExternal);
         currentModule_->addFunction(function);
         return function;
     }
 
-    std::shared_ptr<BasicBlock> IRBuilder::createBasicBlock(const std::string &name) {
-        return std::make_shared<BasicBlock>(name);
+    BasicBlock *IRBuilder::createBasicBlock(const std::string &name) {
+        return currentModule_->create<BasicBlock>(name);
     }
 
-    std::shared_ptr<Constant> IRBuilder::createGlobalConstant(const std::string &name,
-                                                              std::shared_ptr<Type> type,
-                                                              Constant::ValueType value) {
+    Constant *IRBuilder::createGlobalConstant(const std::string &name,
+                                              Type *type,
+                                              Constant::ValueType value) {
         if (!currentModule_) {
             return nullptr;
         }
 
-        auto constant = std::make_shared<Constant>(type, value, name);
+        auto constant = currentModule_->create<Constant>(type, value, name);
         currentModule_->addConstant(constant);
         return constant;
     }
 
-    std::shared_ptr<Constant> IRBuilder::createGlobalConstant(std::shared_ptr<Type> type,
-                                                              Constant::ValueType value) {
+    Constant *IRBuilder::createGlobalConstant(Type *type,
+                                              Constant::ValueType value) {
         if (!currentModule_) {
             return nullptr;
         }
@@ -49,134 +54,134 @@ namespace Ryntra::IR {
         return createGlobalConstant(name, type, value);
     }
 
-    std::shared_ptr<Instruction> IRBuilder::createLoadConstant(const std::string &name,
-                                                               std::shared_ptr<Constant> constant) {
+    Instruction *IRBuilder::createLoadConstant(const std::string &name,
+                                               Constant *constant) {
         if (!constant) {
             return nullptr;
         }
 
-        std::vector<std::shared_ptr<Value>> operands;
+        std::vector<Value *> operands;
         operands.push_back(constant);
 
-        auto instruction = std::make_shared<Instruction>(
+        auto instruction = currentModule_->create<Instruction>(
             Instruction::Opcode::LoadConstant,
             constant->getType(),
             operands,
             name);
 
         if (currentBlock_) {
-            currentBlock_->addInstruction(instruction);
+            addInstruction(instruction);
         }
 
         return instruction;
     }
 
-    std::shared_ptr<Instruction> IRBuilder::createConstant(const std::string &name,
-                                                           std::shared_ptr<Type> type,
-                                                           std::shared_ptr<Value> value) {
-        std::vector<std::shared_ptr<Value>> operands;
+    Instruction *IRBuilder::createConstant(const std::string &name,
+                                           Type *type,
+                                           Value *value) {
+        std::vector<Value *> operands;
         if (value)
             operands.push_back(value);
 
-        auto instruction = std::make_shared<Instruction>(
+        auto instruction = currentModule_->create<Instruction>(
             Instruction::Opcode::Constant,
             type,
             operands,
             name);
 
         if (currentBlock_) {
-            currentBlock_->addInstruction(instruction);
+            addInstruction(instruction);
         }
 
         return instruction;
     }
 
-    std::shared_ptr<Instruction> IRBuilder::createAlloca(const std::string &name,
-                                                          std::shared_ptr<Type> elementType) {
-        auto instruction = std::make_shared<Instruction>(
+    Instruction *IRBuilder::createAlloca(const std::string &name,
+                                         Type *elementType) {
+        auto instruction = currentModule_->create<Instruction>(
             Instruction::Opcode::Alloca,
             Type::getVoidType(),
-            std::vector<std::shared_ptr<Value>>{},
+            std::vector<Value *>{},
             name);
 
         if (currentBlock_)
-            currentBlock_->addInstruction(instruction);
+            addInstruction(instruction);
 
         return instruction;
     }
 
-    std::shared_ptr<Instruction> IRBuilder::createLoad(const std::string &name,
-                                                        std::shared_ptr<Instruction> allocaInst,
-                                                        std::shared_ptr<Type> loadType) {
+    Instruction *IRBuilder::createLoad(const std::string &name,
+                                       Instruction *allocaInst,
+                                       Type *loadType) {
         if (!allocaInst)
             return nullptr;
 
-        std::vector<std::shared_ptr<Value>> operands = {allocaInst};
+        std::vector<Value *> operands = {allocaInst};
 
-        auto instruction = std::make_shared<Instruction>(
+        auto instruction = currentModule_->create<Instruction>(
             Instruction::Opcode::Load,
             loadType ? loadType : Type::getVoidType(),
             operands,
             name);
 
         if (currentBlock_)
-            currentBlock_->addInstruction(instruction);
+            addInstruction(instruction);
 
         return instruction;
     }
 
-    std::shared_ptr<Instruction> IRBuilder::createStore(std::shared_ptr<Value> value,
-                                                         std::shared_ptr<Instruction> allocaInst) {
+    Instruction *IRBuilder::createStore(Value *value,
+                                        Instruction *allocaInst) {
         if (!value || !allocaInst)
             return nullptr;
 
-        std::vector<std::shared_ptr<Value>> operands = {value, allocaInst};
+        std::vector<Value *> operands = {value, allocaInst};
 
-        auto instruction = std::make_shared<Instruction>(
+        auto instruction = currentModule_->create<Instruction>(
             Instruction::Opcode::Store,
             Type::getVoidType(),
             operands,
             "");
 
         if (currentBlock_)
-            currentBlock_->addInstruction(instruction);
+            addInstruction(instruction);
 
         return instruction;
     }
 
-    std::shared_ptr<Instruction> IRBuilder::createCall(const std::string &name,
-                                                       std::shared_ptr<Function> function,
-                                                       const std::vector<std::shared_ptr<Value>> &args) {
+    Instruction *IRBuilder::createCall(const std::string &name,
+                                       Function *function,
+                                       const std::vector<Value *> &args) {
         if (!function) {
             return nullptr;
         }
 
-        auto funcType = std::dynamic_pointer_cast<FunctionType>(function->getType());
+        auto funcType = dynamic_cast<FunctionType *>(function->getType());
         if (!funcType) {
             return nullptr;
         }
 
-        std::vector<std::shared_ptr<Value>> operands;
+        std::vector<Value *> operands;
         operands.push_back(function);
         operands.insert(operands.end(), args.begin(), args.end());
 
-        auto instruction = std::make_shared<Instruction>(
+        auto instruction = currentModule_->create<Instruction>(
             Instruction::Opcode::Call,
             funcType->getReturnType(),
             operands,
             name);
 
         if (currentBlock_) {
-            currentBlock_->addInstruction(instruction);
+            addInstruction(instruction);
         }
 
         return instruction;
     }
 
-    std::shared_ptr<Instruction> IRBuilder::createReturn(const std::string &name,
-                                                         std::shared_ptr<Value> value) {
-        std::shared_ptr<Type> returnType;
-        std::vector<std::shared_ptr<Value>> operands;
+    Instruction *IRBuilder::createReturn(const std::string &name,
+                                         Value *value) {
+        Type *returnType;
+        std::vector<Value *> operands;
 
         if (value) {
             returnType = value->getType();
@@ -185,467 +190,471 @@ namespace Ryntra::IR {
             returnType = Type::getVoidType();
         }
 
-        auto instruction = std::make_shared<Instruction>(
+        auto instruction = currentModule_->create<Instruction>(
             Instruction::Opcode::Return,
             returnType,
             operands,
             name);
 
         if (currentBlock_) {
-            currentBlock_->addInstruction(instruction);
+            addInstruction(instruction);
         }
 
         return instruction;
     }
 
-    std::shared_ptr<Instruction> IRBuilder::createReturnInt32(const std::string &name,
-                                                              int32_t value) {
-        auto immediate = std::make_shared<ImmediateValue>(
-            Type::getInt32Type(),
-            std::to_string(value));
+    ImmediateValue *IRBuilder::createImmediate(Type *type, const std::string &literalValue) {
+        return currentModule_->create<ImmediateValue>(type, literalValue);
+    }
+
+    Instruction *IRBuilder::createReturnInt32(const std::string &name,
+                                              int32_t value) {
+        auto immediate = createImmediate(Type::getInt32Type(), std::to_string(value));
 
         return createReturn(name, immediate);
     }
 
-    std::shared_ptr<Instruction> IRBuilder::createUnaryOp(Instruction::Opcode opcode,
-                                                          const std::string &name,
-                                                          std::shared_ptr<Value> operand) {
+    Instruction *IRBuilder::createUnaryOp(Instruction::Opcode opcode,
+                                          const std::string &name,
+                                          Value *operand) {
         if (!operand) {
             return nullptr;
         }
 
-        std::vector<std::shared_ptr<Value>> operands = {operand};
+        std::vector<Value *> operands = {operand};
 
-        auto instruction = std::make_shared<Instruction>(
+        auto instruction = currentModule_->create<Instruction>(
             opcode,
             operand->getType(),
             operands,
             name);
 
         if (currentBlock_) {
-            currentBlock_->addInstruction(instruction);
+            addInstruction(instruction);
         }
 
         return instruction;
     }
 
-    std::shared_ptr<Instruction> IRBuilder::createBinaryOp(Instruction::Opcode opcode,
-                                                           const std::string &name,
-                                                           std::shared_ptr<Value> lhs,
-                                                           std::shared_ptr<Value> rhs) {
+    Instruction *IRBuilder::createBinaryOp(Instruction::Opcode opcode,
+                                           const std::string &name,
+                                           Value *lhs,
+                                           Value *rhs) {
         if (!lhs || !rhs) {
             return nullptr;
         }
 
-        if (!lhs->getType()->isEqual(rhs->getType().get())) {
+        if (lhs->getType() != rhs->getType()) {
             return nullptr;
         }
 
-        std::vector<std::shared_ptr<Value>> operands = {lhs, rhs};
+        std::vector<Value *> operands = {lhs, rhs};
 
-        auto instruction = std::make_shared<Instruction>(
+        auto instruction = currentModule_->create<Instruction>(
             opcode,
             lhs->getType(),
             operands,
             name);
 
         if (currentBlock_) {
-            currentBlock_->addInstruction(instruction);
+            addInstruction(instruction);
         }
 
         return instruction;
     }
 
-    std::shared_ptr<Instruction> IRBuilder::createSExt(const std::string &name,
-                                                       std::shared_ptr<Value> operand,
-                                                       std::shared_ptr<Type> targetType) {
+    Instruction *IRBuilder::createSExt(const std::string &name,
+                                       Value *operand,
+                                       Type *targetType) {
         if (!operand || !targetType)
             return nullptr;
 
-        std::vector<std::shared_ptr<Value>> operands = {operand};
-        auto instruction = std::make_shared<Instruction>(
+        std::vector<Value *> operands = {operand};
+        auto instruction = currentModule_->create<Instruction>(
             Instruction::Opcode::SExt,
             targetType,
             operands,
             name);
 
         if (currentBlock_) {
-            currentBlock_->addInstruction(instruction);
+            addInstruction(instruction);
         }
 
         return instruction;
     }
 
-    std::shared_ptr<Instruction> IRBuilder::createTrunc(const std::string &name,
-                                                        std::shared_ptr<Value> operand,
-                                                        std::shared_ptr<Type> targetType) {
+    Instruction *IRBuilder::createTrunc(const std::string &name,
+                                        Value *operand,
+                                        Type *targetType) {
         if (!operand || !targetType)
             return nullptr;
 
-        std::vector<std::shared_ptr<Value>> operands = {operand};
-        auto instruction = std::make_shared<Instruction>(
+        std::vector<Value *> operands = {operand};
+        auto instruction = currentModule_->create<Instruction>(
             Instruction::Opcode::Trunc,
             targetType,
             operands,
             name);
 
         if (currentBlock_) {
-            currentBlock_->addInstruction(instruction);
+            addInstruction(instruction);
         }
 
         return instruction;
     }
 
-    std::shared_ptr<Instruction> IRBuilder::createCompare(Instruction::Opcode opcode,
-                                                           const std::string &name,
-                                                           std::shared_ptr<Value> lhs,
-                                                           std::shared_ptr<Value> rhs) {
+    Instruction *IRBuilder::createCompare(Instruction::Opcode opcode,
+                                          const std::string &name,
+                                          Value *lhs,
+                                          Value *rhs) {
         if (!lhs || !rhs)
             return nullptr;
 
-        std::vector<std::shared_ptr<Value>> operands = {lhs, rhs};
+        std::vector<Value *> operands = {lhs, rhs};
 
-        auto instruction = std::make_shared<Instruction>(
+        auto instruction = currentModule_->create<Instruction>(
             opcode,
             Type::getBoolType(),
             operands,
             name);
 
         if (currentBlock_)
-            currentBlock_->addInstruction(instruction);
+            addInstruction(instruction);
 
         return instruction;
     }
 
-    std::shared_ptr<Instruction> IRBuilder::createBr(const std::string &targetBlockName) {
-        auto label = std::make_shared<ImmediateValue>(Type::getVoidType(), targetBlockName);
-        std::vector<std::shared_ptr<Value>> operands = {label};
-        auto instruction = std::make_shared<Instruction>(
+    Instruction *IRBuilder::createBr(const std::string &targetBlockName) {
+        auto label = currentModule_->createLabel(targetBlockName);
+        std::vector<Value *> operands = {label};
+        auto instruction = currentModule_->create<Instruction>(
             Instruction::Opcode::Br,
             Type::getVoidType(),
             operands,
             "");
         if (currentBlock_)
-            currentBlock_->addInstruction(instruction);
+            addInstruction(instruction);
         return instruction;
     }
 
-    std::shared_ptr<Instruction> IRBuilder::createCondBr(std::shared_ptr<Value> condition,
-                                                          const std::string &trueBlockName,
-                                                          const std::string &falseBlockName) {
-        auto trueLabel = std::make_shared<ImmediateValue>(Type::getVoidType(), trueBlockName);
-        auto falseLabel = std::make_shared<ImmediateValue>(Type::getVoidType(), falseBlockName);
-        std::vector<std::shared_ptr<Value>> operands = {condition, trueLabel, falseLabel};
-        auto instruction = std::make_shared<Instruction>(
+    Instruction *IRBuilder::createCondBr(Value *condition,
+                                         const std::string &trueBlockName,
+                                         const std::string &falseBlockName) {
+        auto trueLabel = currentModule_->createLabel(trueBlockName);
+        auto falseLabel = currentModule_->createLabel(falseBlockName);
+        std::vector<Value *> operands = {condition, trueLabel, falseLabel};
+        auto instruction = currentModule_->create<Instruction>(
             Instruction::Opcode::CondBr,
             Type::getVoidType(),
             operands,
             "");
         if (currentBlock_)
-            currentBlock_->addInstruction(instruction);
+            addInstruction(instruction);
         return instruction;
     }
 
-    std::shared_ptr<Instruction> IRBuilder::createNewArray(const std::string &name,
-                                                            std::shared_ptr<Type> elementType,
-                                                            std::shared_ptr<Value> size) {
+    Instruction *IRBuilder::createNewArray(const std::string &name,
+                                           Type *elementType,
+                                           Value *size) {
         if (!size)
             return nullptr;
 
-        std::vector<std::shared_ptr<Value>> operands = {size};
-        auto arrayType = std::make_shared<ArrayType>(elementType);
+        std::vector<Value *> operands = {size};
+        auto arrayType = currentModule_->getTypes().getArrayType(elementType);
 
-        auto instruction = std::make_shared<Instruction>(
+        auto instruction = currentModule_->create<Instruction>(
             Instruction::Opcode::NewArray,
             arrayType,
             operands,
             name);
 
         if (currentBlock_)
-            currentBlock_->addInstruction(instruction);
+            addInstruction(instruction);
 
         return instruction;
     }
 
-    std::shared_ptr<Instruction> IRBuilder::createArrLoad(const std::string &name,
-                                                           std::shared_ptr<Value> array,
-                                                           std::shared_ptr<Value> index,
-                                                           std::shared_ptr<Type> elementType) {
+    Instruction *IRBuilder::createArrLoad(const std::string &name,
+                                          Value *array,
+                                          Value *index,
+                                          Type *elementType) {
         if (!array || !index)
             return nullptr;
 
-        std::vector<std::shared_ptr<Value>> operands = {array, index};
+        std::vector<Value *> operands = {array, index};
 
-        auto instruction = std::make_shared<Instruction>(
+        auto instruction = currentModule_->create<Instruction>(
             Instruction::Opcode::ArrLoad,
             elementType,
             operands,
             name);
 
         if (currentBlock_)
-            currentBlock_->addInstruction(instruction);
+            addInstruction(instruction);
 
         return instruction;
     }
 
-    std::shared_ptr<Instruction> IRBuilder::createArrStore(std::shared_ptr<Value> array,
-                                                            std::shared_ptr<Value> index,
-                                                            std::shared_ptr<Value> value) {
+    Instruction *IRBuilder::createArrStore(Value *array,
+                                           Value *index,
+                                           Value *value) {
         if (!array || !index || !value)
             return nullptr;
 
-        std::vector<std::shared_ptr<Value>> operands = {array, index, value};
+        std::vector<Value *> operands = {array, index, value};
 
-        auto instruction = std::make_shared<Instruction>(
+        auto instruction = currentModule_->create<Instruction>(
             Instruction::Opcode::ArrStore,
             Type::getVoidType(),
             operands,
             "");
 
         if (currentBlock_)
-            currentBlock_->addInstruction(instruction);
+            addInstruction(instruction);
 
         return instruction;
     }
 
-    std::shared_ptr<Instruction> IRBuilder::createRefCreate(const std::string &name,
-                                                            std::shared_ptr<Type> refType,
-                                                            std::shared_ptr<Value> alloca) {
+    Instruction *IRBuilder::createRefCreate(const std::string &name,
+                                            Type *refType,
+                                            Value *alloca) {
         if (!alloca)
             return nullptr;
 
-        std::vector<std::shared_ptr<Value>> operands = {alloca};
-        auto instruction = std::make_shared<Instruction>(
+        std::vector<Value *> operands = {alloca};
+        auto instruction = currentModule_->create<Instruction>(
             Instruction::Opcode::RefCreate,
             refType,
             operands,
             name);
 
         if (currentBlock_)
-            currentBlock_->addInstruction(instruction);
+            addInstruction(instruction);
         return instruction;
     }
 
-    std::shared_ptr<Instruction> IRBuilder::createRefLoad(const std::string &name,
-                                                           std::shared_ptr<Value> refValue,
-                                                           std::shared_ptr<Type> loadType) {
+    Instruction *IRBuilder::createRefLoad(const std::string &name,
+                                          Value *refValue,
+                                          Type *loadType) {
         if (!refValue)
             return nullptr;
 
-        std::vector<std::shared_ptr<Value>> operands = {refValue};
-        auto instruction = std::make_shared<Instruction>(
+        std::vector<Value *> operands = {refValue};
+        auto instruction = currentModule_->create<Instruction>(
             Instruction::Opcode::RefLoad,
             loadType,
             operands,
             name);
 
         if (currentBlock_)
-            currentBlock_->addInstruction(instruction);
+            addInstruction(instruction);
         return instruction;
     }
 
-    std::shared_ptr<Instruction> IRBuilder::createRefStore(std::shared_ptr<Value> refValue,
-                                                             std::shared_ptr<Value> value) {
+    Instruction *IRBuilder::createRefStore(Value *refValue,
+                                           Value *value) {
         if (!refValue || !value)
             return nullptr;
 
-        std::vector<std::shared_ptr<Value>> operands = {refValue, value};
-        auto instruction = std::make_shared<Instruction>(
+        std::vector<Value *> operands = {refValue, value};
+        auto instruction = currentModule_->create<Instruction>(
             Instruction::Opcode::RefStore,
             Type::getVoidType(),
             operands,
             "");
 
         if (currentBlock_)
-            currentBlock_->addInstruction(instruction);
+            addInstruction(instruction);
         return instruction;
     }
 
-    std::shared_ptr<Instruction> IRBuilder::createPtrCreate(const std::string &name,
-                                                             std::shared_ptr<Type> ptrType,
-                                                             std::shared_ptr<Value> alloca) {
+    Instruction *IRBuilder::createPtrCreate(const std::string &name,
+                                            Type *ptrType,
+                                            Value *alloca) {
         if (!alloca)
             return nullptr;
 
-        std::vector<std::shared_ptr<Value>> operands = {alloca};
-        auto instruction = std::make_shared<Instruction>(
+        std::vector<Value *> operands = {alloca};
+        auto instruction = currentModule_->create<Instruction>(
             Instruction::Opcode::PtrCreate,
             ptrType,
             operands,
             name);
 
         if (currentBlock_)
-            currentBlock_->addInstruction(instruction);
+            addInstruction(instruction);
         return instruction;
     }
 
-    std::shared_ptr<Instruction> IRBuilder::createPtrLoad(const std::string &name,
-                                                           std::shared_ptr<Value> ptrValue,
-                                                           std::shared_ptr<Type> loadType) {
+    Instruction *IRBuilder::createPtrLoad(const std::string &name,
+                                          Value *ptrValue,
+                                          Type *loadType) {
         if (!ptrValue)
             return nullptr;
 
-        std::vector<std::shared_ptr<Value>> operands = {ptrValue};
-        auto instruction = std::make_shared<Instruction>(
+        std::vector<Value *> operands = {ptrValue};
+        auto instruction = currentModule_->create<Instruction>(
             Instruction::Opcode::PtrLoad,
             loadType,
             operands,
             name);
 
         if (currentBlock_)
-            currentBlock_->addInstruction(instruction);
+            addInstruction(instruction);
         return instruction;
     }
 
-    std::shared_ptr<Instruction> IRBuilder::createPtrStore(std::shared_ptr<Value> ptrValue,
-                                                             std::shared_ptr<Value> value) {
+    Instruction *IRBuilder::createPtrStore(Value *ptrValue,
+                                           Value *value) {
         if (!ptrValue || !value)
             return nullptr;
 
-        std::vector<std::shared_ptr<Value>> operands = {ptrValue, value};
-        auto instruction = std::make_shared<Instruction>(
+        std::vector<Value *> operands = {ptrValue, value};
+        auto instruction = currentModule_->create<Instruction>(
             Instruction::Opcode::PtrStore,
             Type::getVoidType(),
             operands,
             "");
 
         if (currentBlock_)
-            currentBlock_->addInstruction(instruction);
+            addInstruction(instruction);
         return instruction;
     }
 
-    std::shared_ptr<Instruction> IRBuilder::createNewHeap(const std::string &name,
-                                                           std::shared_ptr<Type> ptrType,
-                                                           std::shared_ptr<Value> initializer) {
+    Instruction *IRBuilder::createNewHeap(const std::string &name,
+                                          Type *ptrType,
+                                          Value *initializer) {
         if (!initializer)
             return nullptr;
 
-        std::vector<std::shared_ptr<Value>> operands = {initializer};
-        auto instruction = std::make_shared<Instruction>(
+        std::vector<Value *> operands = {initializer};
+        auto instruction = currentModule_->create<Instruction>(
             Instruction::Opcode::NewHeap,
             ptrType,
             operands,
             name);
 
         if (currentBlock_)
-            currentBlock_->addInstruction(instruction);
+            addInstruction(instruction);
         return instruction;
     }
 
-    std::shared_ptr<Instruction> IRBuilder::createDeleteHeap(std::shared_ptr<Value> ptrValue) {
+    Instruction *IRBuilder::createDeleteHeap(Value *ptrValue) {
         if (!ptrValue)
             return nullptr;
 
-        std::vector<std::shared_ptr<Value>> operands = {ptrValue};
-        auto instruction = std::make_shared<Instruction>(
+        std::vector<Value *> operands = {ptrValue};
+        auto instruction = currentModule_->create<Instruction>(
             Instruction::Opcode::DeleteHeap,
             Type::getVoidType(),
             operands,
             "");
 
         if (currentBlock_)
-            currentBlock_->addInstruction(instruction);
+            addInstruction(instruction);
         return instruction;
     }
 
-    std::shared_ptr<Instruction> IRBuilder::createArrRef(const std::string &name,
-                                                          std::shared_ptr<Value> array,
-                                                          std::shared_ptr<Value> index,
-                                                          std::shared_ptr<Type> refType) {
+    Instruction *IRBuilder::createArrRef(const std::string &name,
+                                         Value *array,
+                                         Value *index,
+                                         Type *refType) {
         if (!array || !index)
             return nullptr;
 
-        std::vector<std::shared_ptr<Value>> operands = {array, index};
-        auto instruction = std::make_shared<Instruction>(
+        std::vector<Value *> operands = {array, index};
+        auto instruction = currentModule_->create<Instruction>(
             Instruction::Opcode::ArrRef,
             refType,
             operands,
             name);
 
         if (currentBlock_)
-            currentBlock_->addInstruction(instruction);
+            addInstruction(instruction);
         return instruction;
     }
 
-    std::shared_ptr<Instruction> IRBuilder::createPtrIndexRef(const std::string &name,
-                                                               std::shared_ptr<Value> ptrValue,
-                                                               std::shared_ptr<Value> index,
-                                                               std::shared_ptr<Type> refType) {
+    Instruction *IRBuilder::createPtrIndexRef(const std::string &name,
+                                              Value *ptrValue,
+                                              Value *index,
+                                              Type *refType) {
         if (!ptrValue || !index)
             return nullptr;
 
-        std::vector<std::shared_ptr<Value>> operands = {ptrValue, index};
-        auto instruction = std::make_shared<Instruction>(
+        std::vector<Value *> operands = {ptrValue, index};
+        auto instruction = currentModule_->create<Instruction>(
             Instruction::Opcode::PtrIndexRef,
             refType,
             operands,
             name);
 
         if (currentBlock_)
-            currentBlock_->addInstruction(instruction);
+            addInstruction(instruction);
         return instruction;
     }
 
-    std::shared_ptr<Instruction> IRBuilder::createPinArray(std::shared_ptr<Value> ptrValue) {
+    Instruction *IRBuilder::createPinArray(Value *ptrValue) {
         if (!ptrValue)
             return nullptr;
 
-        std::vector<std::shared_ptr<Value>> operands = {ptrValue};
-        auto instruction = std::make_shared<Instruction>(
+        std::vector<Value *> operands = {ptrValue};
+        auto instruction = currentModule_->create<Instruction>(
             Instruction::Opcode::PinArray,
             Type::getVoidType(),
             operands,
             "");
 
         if (currentBlock_)
-            currentBlock_->addInstruction(instruction);
+            addInstruction(instruction);
         return instruction;
     }
 
-    std::shared_ptr<Instruction> IRBuilder::createUnpinArray(std::shared_ptr<Value> ptrValue) {
+    Instruction *IRBuilder::createUnpinArray(Value *ptrValue) {
         if (!ptrValue)
             return nullptr;
 
-        std::vector<std::shared_ptr<Value>> operands = {ptrValue};
-        auto instruction = std::make_shared<Instruction>(
+        std::vector<Value *> operands = {ptrValue};
+        auto instruction = currentModule_->create<Instruction>(
             Instruction::Opcode::UnpinArray,
             Type::getVoidType(),
             operands,
             "");
 
         if (currentBlock_)
-            currentBlock_->addInstruction(instruction);
+            addInstruction(instruction);
         return instruction;
     }
 
-    std::shared_ptr<Instruction> IRBuilder::createPtrFromArray(const std::string &name,
-                                                                std::shared_ptr<Type> ptrType,
-                                                                std::shared_ptr<Value> arrayValue) {
+    Instruction *IRBuilder::createPtrFromArray(const std::string &name,
+                                               Type *ptrType,
+                                               Value *arrayValue) {
         if (!arrayValue)
             return nullptr;
 
-        std::vector<std::shared_ptr<Value>> operands = {arrayValue};
-        auto instruction = std::make_shared<Instruction>(
+        std::vector<Value *> operands = {arrayValue};
+        auto instruction = currentModule_->create<Instruction>(
             Instruction::Opcode::PtrFromArray,
             ptrType,
             operands,
             name);
 
         if (currentBlock_)
-            currentBlock_->addInstruction(instruction);
+            addInstruction(instruction);
         return instruction;
     }
 
-    void IRBuilder::setInsertPoint(std::shared_ptr<BasicBlock> block) {
+    void IRBuilder::setInsertPoint(BasicBlock *block) {
         currentBlock_ = block;
     }
 
-    std::shared_ptr<BasicBlock> IRBuilder::getInsertPoint() const {
+    BasicBlock *IRBuilder::getInsertPoint() const {
         return currentBlock_;
     }
 
-    void IRBuilder::addInstruction(std::shared_ptr<Instruction> instruction) {
+    void IRBuilder::addInstruction(Instruction *instruction) {
         if (currentBlock_ && instruction) {
+            if (instruction->getLocation().line == 0)
+                instruction->setLocation(currentLocation_);
             currentBlock_->addInstruction(instruction);
         }
     }
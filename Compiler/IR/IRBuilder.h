@@ -15,146 +15,154 @@ namespace Ryntra::IR {
 
         std::shared_ptr<Module> createModule(const std::string &name);
 
-        std::shared_ptr<Function> createFunction(const std::string &name,
-                                                 std::shared_ptr<Type> returnType,
-                                                 const std::vector<Function::Parameter> &parameters = {},
-                                                 bool isExternal = false);
+        Function *createFunction(const std::string &name,
+                                 Type *returnType,
+                                 const std::vector<Function::Parameter> &parameters = {},
+                                 bool isExternal = false);
 
-        std::shared_ptr<BasicBlock> createBasicBlock(const std::string &name);
+        BasicBlock *createBasicBlock(const std::string &name);
 
-        std::shared_ptr<Constant> createGlobalConstant(const std::string &name,
-                                                       std::shared_ptr<Type> type,
-                                                       Constant::ValueType value);
+        Constant *createGlobalConstant(const std::string &name,
+                                       Type *type,
+                                       Constant::ValueType value);
 
-        std::shared_ptr<Constant> createGlobalConstant(std::shared_ptr<Type> type,
-                                                       Constant::ValueType value);
+        Constant *createGlobalConstant(Type *type,
+                                       Constant::ValueType value);
 
-        std::shared_ptr<Instruction> createLoadConstant(const std::string &name,
-                                                        std::shared_ptr<Constant> constant);
+        Instruction *createLoadConstant(const std::string &name,
+                                        Constant *constant);
 
-        std::shared_ptr<Instruction> createConstant(const std::string &name,
-                                                    std::shared_ptr<Type> type,
-                                                    std::shared_ptr<Value> value);
+        Instruction *createConstant(const std::string &name,
+                                    Type *type,
+                                    Value *value);
 
-        std::shared_ptr<Instruction> createAlloca(const std::string &name,
-                                                   std::shared_ptr<Type> elementType);
+        Instruction *createAlloca(const std::string &name,
+                                  Type *elementType);
 
-        std::shared_ptr<Instruction> createLoad(const std::string &name,
-                                                 std::shared_ptr<Instruction> allocaInst,
-                                                 std::shared_ptr<Type> loadType);
+        Instruction *createLoad(const std::string &name,
+                                Instruction *allocaInst,
+                                Type *loadType);
 
-        std::shared_ptr<Instruction> createStore(std::shared_ptr<Value> value,
-                                                  std::shared_ptr<Instruction> allocaInst);
+        Instruction *createStore(Value *value,
+                                 Instruction *allocaInst);
 
-        std::shared_ptr<Instruction> createCall(const std::string &name,
-                                                 std::shared_ptr<Function> function,
-                                                 const std::vector<std::shared_ptr<Value>> &args);
+        Instruction *createCall(const std::string &name,
+                                Function *function,
+                                const std::vector<Value *> &args);
 
-        std::shared_ptr<Instruction> createReturn(const std::string &name,
-                                                  std::shared_ptr<Value> value = nullptr);
+        Instruction *createReturn(const std::string &name,
+                                  Value *value = nullptr);
 
-        std::shared_ptr<Instruction> createReturnInt32(const std::string &name,
-                                                       int32_t value);
+        ImmediateValue *createImmediate(Type *type, const std::string &literalValue);
 
-        std::shared_ptr<Instruction> createUnaryOp(Instruction::Opcode opcode,
-                                                   const std::string &name,
-                                                   std::shared_ptr<Value> operand);
+        Instruction *createReturnInt32(const std::string &name,
+                                       int32_t value);
 
-        std::shared_ptr<Instruction> createSExt(const std::string &name,
-                                                std::shared_ptr<Value> operand,
-                                                std::shared_ptr<Type> targetType);
+        Instruction *createUnaryOp(Instruction::Opcode opcode,
+                                   const std::string &name,
+                                   Value *operand);
 
-        std::shared_ptr<Instruction> createTrunc(const std::string &name,
-                                                 std::shared_ptr<Value> operand,
-                                                 std::shared_ptr<Type> targetType);
+        Instruction *createSExt(const std::string &name,
+                                Value *operand,
+                                Type *targetType);
 
-        std::shared_ptr<Instruction> createBinaryOp(Instruction::Opcode opcode,
-                                                    const std::string &name,
-                                                    std::shared_ptr<Value> lhs,
-                                                    std::shared_ptr<Value> rhs);
+        Instruction *createTrunc(const std::string &name,
+                                 Value *operand,
+                                 Type *targetType);
 
-        std::shared_ptr<Instruction> createCompare(Instruction::Opcode opcode,
-                                                    const std::string &name,
-                                                    std::shared_ptr<Value> lhs,
-                                                    std::shared_ptr<Value> rhs);
+        Instruction *createBinaryOp(Instruction::Opcode opcode,
+                                    const std::string &name,
+                                    Value *lhs,
+                                    Value *rhs);
 
-        std::shared_ptr<Instruction> createBr(const std::string &targetBlockName);
+        Instruction *createCompare(Instruction::Opcode opcode,
+                                   const std::string &name,
+                                   Value *lhs,
+                                   Value *rhs);
 
-        std::shared_ptr<Instruction> createCondBr(std::shared_ptr<Value> condition,
-                                                   const std::string &trueBlockName,
-                                                   const std::string &falseBlockName);
+        Instruction *createBr(const std::string &targetBlockName);
 
-        std::shared_ptr<Instruction> createNewArray(const std::string &name,
-                                                     std::shared_ptr<Type> elementType,
-                                                     std::shared_ptr<Value> size);
+        Instruction *createCondBr(Value *condition,
+                                  const std::string &trueBlockName,
+                                  const std::string &falseBlockName);
 
-        std::shared_ptr<Instruction> createArrLoad(const std::string &name,
-                                                    std::shared_ptr<Value> array,
-                                                    std::shared_ptr<Value> index,
-                                                    std::shared_ptr<Type> elementType);
+        Instruction *createNewArray(const std::string &name,
+                                    Type *elementType,
+                                    Value *size);
 
-        std::shared_ptr<Instruction> createArrStore(std::shared_ptr<Value> array,
-                                                      std::shared_ptr<Value> index,
-                                                      std::shared_ptr<Value> value);
+        Instruction *createArrLoad(const std::string &name,
+                                   Value *array,
+                                   Value *index,
+                                   Type *elementType);
 
-        std::shared_ptr<Instruction> createRefCreate(const std::string &name,
-                                                      std::shared_ptr<Type> refType,
-                                                      std::shared_ptr<Value> alloca);
+        Instruction *createArrStore(Value *array,
+                                    Value *index,
+                                    Value *value);
 
-        std::shared_ptr<Instruction> createRefLoad(const std::string &name,
-                                                    std::shared_ptr<Value> refValue,
-                                                    std::shared_ptr<Type> loadType);
+        Instruction *createRefCreate(const std::string &name,
+                                     Type *refType,
+                                     Value *alloca);
 
-        std::shared_ptr<Instruction> createRefStore(std::shared_ptr<Value> refValue,
-                                                      std::shared_ptr<Value> value);
+        Instruction *createRefLoad(const std::string &name,
+                                   Value *refValue,
+                                   Type *loadType);
 
-        std::shared_ptr<Instruction> createPtrCreate(const std::string &name,
-                                                      std::shared_ptr<Type> ptrType,
-                                                      std::shared_ptr<Value> alloca);
+        Instruction *createRefStore(Value *refValue,
+                                    Value *value);
 
-        std::shared_ptr<Instruction> createPtrLoad(const std::string &name,
-                                                     std::shared_ptr<Value> ptrValue,
-                                                     std::shared_ptr<Type> loadType);
+        Instruction *createPtrCreate(const std::string &name,
+                                     Type *ptrType,
+                                     Value *alloca);
 
-        std::shared_ptr<Instruction> createPtrStore(std::shared_ptr<Value> ptrValue,
-                                                       std::shared_ptr<Value> value);
+        Instruction *createPtrLoad(const std::string &name,
+                                   Value *ptrValue,
+                                   Type *loadType);
 
-        std::shared_ptr<Instruction> createNewHeap(const std::string &name,
-                                                     std::shared_ptr<Type> ptrType,
-                                                     std::shared_ptr<Value> initializer);
+        Instruction *createPtrStore(Value *ptrValue,
+                                    Value *value);
 
-        std::shared_ptr<Instruction> createDeleteHeap(std::shared_ptr<Value> ptrValue);
+        Instruction *createNewHeap(const std::string &name,
+                                   Type *ptrType,
+                                   Value *initializer);
 
-        std::shared_ptr<Instruction> createArrRef(const std::string &name,
-                                                   std::shared_ptr<Value> array,
-                                                   std::shared_ptr<Value> index,
-                                                   std::shared_ptr<Type> refType);
+        Instruction *createDeleteHeap(Value *ptrValue);
 
-        std::shared_ptr<Instruction> createPtrIndexRef(const std::string &name,
-                                                        std::shared_ptr<Value> ptrValue,
-                                                        std::shared_ptr<Value> index,
-                                                        std::shared_ptr<Type> refType);
+        Instruction *createArrRef(const std::string &name,
+                                  Value *array,
+                                  Value *index,
+                                  Type *refType);
 
-        std::shared_ptr<Instruction> createPinArray(std::shared_ptr<Value> ptrValue);
+        Instruction *createPtrIndexRef(const std::string &name,
+                                       Value *ptrValue,
+                                       Value *index,
+                                       Type *refType);
 
-        std::shared_ptr<Instruction> createUnpinArray(std::shared_ptr<Value> ptrValue);
+        Instruction *createPinArray(Value *ptrValue);
 
-        std::shared_ptr<Instruction> createPtrFromArray(const std::string &name,
-                                                         std::shared_ptr<Type> ptrType,
-                                                         std::shared_ptr<Value> arrayValue);
+        Instruction *createUnpinArray(Value *ptrValue);
 
-        void setInsertPoint(std::shared_ptr<BasicBlock> block);
-        std::shared_ptr<BasicBlock> getInsertPoint() const;
+        Instruction *createPtrFromArray(const std::string &name,
+                                        Type *ptrType,
+                                        Value *arrayValue);
 
-        void addInstruction(std::shared_ptr<Instruction> instruction);
+        void setInsertPoint(BasicBlock *block);
+        BasicBlock *getInsertPoint() const;
+
+        void addInstruction(Instruction *instruction);
+
+        // Location stamped onto every instruction inserted from now on
+        void setCurrentLocation(Compiler::SourceLocation location) { currentLocation_ = location; }
+        Compiler::SourceLocation getCurrentLocation() const { return currentLocation_; }
 
         std::shared_ptr<Module> getModule() const { return currentModule_; }
+        TypeTable &getTypes() const { return currentModule_->getTypes(); }
 
         std::string generateUniqueName(const std::string &base = "temp");
 
     private:
         std::shared_ptr<Module> currentModule_;
-        std::shared_ptr<BasicBlock> currentBlock_;
+        BasicBlock *currentBlock_ = nullptr;
+        Compiler::SourceLocation currentLocation_;
         int unnamedCounter_;
     };
 } // namespace Ryntra::IR
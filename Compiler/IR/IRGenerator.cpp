@@ -14,7 +14,7 @@ namespace Ryntra::IR {
         return builder_.getModule();
     }
 
-    std::shared_ptr<Type> IRGenerator::toIRType(const std::shared_ptr<Sem::Type> &semType) {
+    Type *IRGenerator::toIRType(Sem::TypePtr semType) {
         if (!semType)
             return Type::getVoidType();
 
@@ -22,41 +22,37 @@ namespace Ryntra::IR {
         case Sem::TypeKind::VOID:
             return Type::getVoidType();
 
-        case Sem::TypeKind::PRIMITIVE: {
-            const auto &name = static_cast<const Sem::PrimitiveType &>(*semType).getName();
-            if (name == "i32" || name == "int")
-                return Type::getInt32Type();
-            if (name == "i64" || name == "long")
+        case Sem::TypeKind::PRIMITIVE:
+            if (semType == Sem::TypeFactory::getLong())
                 return Type::getInt64Type();
-            if (name == "string" || name == "str")
+            if (semType == Sem::TypeFactory::getString())
                 return Type::getStringType();
-            if (name == "bool")
+            if (semType == Sem::TypeFactory::getBool())
                 return Type::getBoolType();
             return Type::getInt32Type();
-        }
 
         case Sem::TypeKind::FUNCTION: {
             const auto &ft = static_cast<const Sem::FunctionType &>(*semType);
             auto retIR = toIRType(ft.getReturnType());
-            std::vector<std::shared_ptr<Type>> params;
+            std::vector<Type *> params;
             for (const auto &p : ft.getParamTypes())
                 params.push_back(toIRType(p));
-            return std::make_shared<IR::FunctionType>(retIR, params);
+            return builder_.getTypes().getFunctionType(retIR, params);
         }
 
         case Sem::TypeKind::ARRAY: {
             const auto &arrType = static_cast<const Sem::ArrayType &>(*semType);
-            return std::make_shared<IR::ArrayType>(toIRType(arrType.getElementType()));
+            return builder_.getTypes().getArrayType(toIRType(arrType.getElementType()));
         }
 
         case Sem::TypeKind::REFERENCE: {
             const auto &refType = static_cast<const Sem::ReferenceType &>(*semType);
-            return std::make_shared<IR::RefType>(toIRType(refType.getElementType()));
+            return builder_.getTypes().getRefType(toIRType(refType.getElementType()));
         }
 
         case Sem::TypeKind::POINTER: {
             const auto &ptrType = static_cast<const Sem::PointerType &>(*semType);
-            return std::make_shared<IR::PtrType>(toIRType(ptrType.getElementType()));
+            return builder_.getTypes().getPtrType(toIRType(ptrType.getElementType()));
         }
 
         default:
@@ -65,10 +65,10 @@ namespace Ryntra::IR {
         IRBuilder builder_;
 
         // Last expression value produced by visiting an expression node
-        std::shared_ptr<Value> lastValue_;
+        Value *lastValue_ = nullptr;
 
         // Map from function name -> IR Function (for call resolution)
-        std::unordered_map<std::string, std::shared_ptr<Function>> functionMap_;
+        std::unordered_map<std::string, Function *> functionMap_;
 
         // Current function name being generated (for adding basic blocks)
         std::string currentFunctionName_;
@@ -89,10 +89,26 @@ namespace Ryntra::IR {
         };
         std::vector<LoopInfo> loopStack_;
 
+        // Stamps instructions emitted while visiting a node with the node's source location,
+        // and restores the enclosing node's location when the visit returns
+        class LocationScope {
+        public:
+            LocationScope(IRBuilder &builder, const Compiler::Semantic::ITypedASTNode &node)
+                : builder_(builder), saved_(builder.getCurrentLocation()) {
+                if (node.getLocation().line != 0)
+                    builder_.setCurrentLocation(node.getLocation());
+            }
+            ~LocationScope() { builder_.setCurrentLocation(saved_); }
+
+        private:
+            IRBuilder &builder_;
+            Compiler::SourceLocation saved_;
+        };
+
         // Map from variable name -> Alloca instruction (for load/store)
-        std::unordered_map<std::string, std::shared_ptr<Instruction>> allocaMap_;
+        std::unordered_map<std::string, Instruction *> allocaMap_;
 
         // Convert a Semantic::Type to an IR::Type
-        static std::shared_ptr<Type> toIRType(const std::shared_ptr<Compiler::Semantic::Type> &semType);
+        Type *toIRType(Compiler::Semantic::TypePtr semType);
     };
 } // namespace Ryntra::IR
\ No newline at end of file
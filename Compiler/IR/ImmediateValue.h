@@ -6,7 +6,7 @@
 namespace Ryntra::IR {
     class ImmediateValue : public Value {
     public:
-        ImmediateValue(std::shared_ptr<Type> type, const std::string &literalValue)
+        ImmediateValue(Type *type, const std::string &literalValue)
             : Value(type, ""), literalValue_(literalValue) {}
 
         std::string toString() const override {
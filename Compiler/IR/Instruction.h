@@ -1,11 +1,14 @@
 #pragma once
 
 #include "ImmediateValue.h"
+#include "SourceLocation/SourceLocation.h"
 #include "Value.h"
 #include <memory>
 #include <vector>
 
 namespace Ryntra::IR {
+    class BasicBlock;
+
     class Instruction : public Value {
     public:
         // clang-format off
@@ -54,17 +57,68 @@ namespace Ryntra::IR {
             PtrIndexRef,       // create ref to pointer + index (for p[i] returning ref<T>)
             PinArray,          // pin an array for fixed statement
             UnpinArray,        // unpin an array for fixed statement
-            PtrFromArray       // create a pointer to array element 0 from an array value
+            PtrFromArray,      // create a pointer to array element 0 from an array value
+            Phi                // value chosen by the predecessor control came from (mem2reg)
         };
         // clang-format on
 
-        Instruction(Opcode opcode, std::shared_ptr<Type> type,
-                    const std::vector<std::shared_ptr<Value>> &operands = {},
+        // Operands are not owned: they live in the module's arena like the instruction itself
+        Instruction(Opcode opcode, Type *type,
+                    const std::vector<Value *> &operands = {},
                     const std::string &name = "")
-            : Value(type, name), opcode_(opcode), operands_(operands) {}
+            : Value(type, name), opcode_(opcode), operands_(operands) {
+            for (Value *operand : operands_)
+                track(operand);
+        }
 
         Opcode getOpcode() const { return opcode_; }
-        const std::vector<std::shared_ptr<Value>> &getOperands() const { return operands_; }
+        const std::vector<Value *> &getOperands() const { return operands_; }
+        void setOperand(size_t index, Value *value) {
+            untrack(operands_[index]);
+            operands_[index] = value;
+            track(value);
+        }
+
+        // The block this instruction is in, or null once it has been taken out
+        BasicBlock *getParent() const { return parent_; }
+
+        // Clears the operands, so this instruction no longer counts as a user of anything
+        void dropAllReferences() {
+            for (Value *operand : operands_)
+                untrack(operand);
+            operands_.clear();
+        }
+
+        // Drops the operands and removes this instruction from its block. Its memory stays with
+        // the module; whatever still uses its result should be replaced or erased first.
+        void eraseFromParent();
+
+        bool isTerminator() const {
+            return opcode_ == Opcode::Return || opcode_ == Opcode::Br || opcode_ == Opcode::CondBr;
+        }
+
+        // Phi operands are (value, block label) pairs, one per incoming edge (see Module::createLabel)
+        void addIncoming(Value *value, ImmediateValue *label) {
+            operands_.push_back(value);
+            operands_.push_back(label);
+            track(value);
+            track(label);
+        }
+        void removeIncoming(size_t index) {
+            untrack(operands_[index * 2]);
+            untrack(operands_[index * 2 + 1]);
+            operands_.erase(operands_.begin() + index * 2, operands_.begin() + index * 2 + 2);
+        }
+        void setIncomingBlock(size_t index, ImmediateValue *label) { setOperand(index * 2 + 1, label); }
+        size_t getIncomingCount() const { return operands_.size() / 2; }
+        Value *getIncomingValue(size_t index) const { return operands_[index * 2]; }
+        const std::string &getIncomingBlock(size_t index) const {
+            return static_cast<const ImmediateValue &>(*operands_[index * 2 + 1]).getLiteralValue();
+        }
+
+        // Source position this instruction was generated from (line 0 if unknown)
+        Compiler::SourceLocation getLocation() const { return location_; }
+        void setLocation(Compiler::SourceLocation location) { location_ = location; }
 
         // SSA instructions are local values — reference with %
         std::string getReferenceName() const override {
@@ -258,7 +312,7 @@ namespace Ryntra::IR {
             case Opcode::Br: {
                 result += "br label ";
                 if (!operands_.empty()) {
-                    if (auto *imm = dynamic_cast<ImmediateValue *>(operands_[0].get()))
+                    if (auto *imm = dynamic_cast<ImmediateValue *>(operands_[0]))
                         result += imm->getLiteralValue();
                 }
                 break;
@@ -272,12 +326,12 @@ namespace Ryntra::IR {
                 }
                 if (operands_.size() >= 2) {
                     result += ", label ";
-                    if (auto *imm = dynamic_cast<ImmediateValue *>(operands_[1].get()))
+                    if (auto *imm = dynamic_cast<ImmediateValue *>(operands_[1]))
                         result += imm->getLiteralValue();
                 }
                 if (operands_.size() >= 3) {
                     result += ", label ";
-                    if (auto *imm = dynamic_cast<ImmediateValue *>(operands_[2].get()))
+                    if (auto *imm = dynamic_cast<ImmediateValue *>(operands_[2]))
                         result += imm->getLiteralValue();
                 }
                 break;
@@ -428,6 +482,16 @@ namespace Ryntra::IR {
                 break;
             }
 
+            case Opcode::Phi: {
+                result += "phi " + type_->toString() + " ";
+                for (size_t i = 0; i < getIncomingCount(); ++i) {
+                    if (i > 0)
+                        result += ", ";
+                    result += "[" + getIncomingValue(i)->getReferenceName() + ", " + getIncomingBlock(i) + "]";
+                }
+                break;
+            }
+
             default:
                 break;
             }
@@ -436,7 +500,36 @@ namespace Ryntra::IR {
         }
 
     private:
+        friend class BasicBlock;
+
+        void track(Value *operand) {
+            if (operand)
+                operand->addUser(this);
+        }
+        void untrack(Value *operand) {
+            if (operand)
+                operand->removeUser(this);
+        }
+
         Opcode opcode_;
-        std::vector<std::shared_ptr<Value>> operands_;
+        std::vector<Value *> operands_;
+        Compiler::SourceLocation location_;
+        BasicBlock *parent_ = nullptr;
     };
+
+    inline void Value::replaceAllUsesWith(Value *replacement) {
+        if (replacement == this)
+            return;
+        // Each setOperand takes one entry off users_, so this ends once every slot has moved
+        while (!users_.empty()) {
+            Instruction *user = users_.back();
+            const auto &operands = user->getOperands();
+            for (size_t i = 0; i < operands.size(); ++i) {
+                if (operands[i] == this) {
+                    user->setOperand(i, replacement);
+                    break;
+                }
+            }
+        }
+    }
 } // namespace Ryntra::IR
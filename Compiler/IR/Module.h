@@ -1,7 +1,10 @@
 #pragma once
 
+#include "Arena.h"
 #include "Constant.h"
 #include "Function.h"
+#include "ImmediateValue.h"
+#include "TypeTable.h"
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -12,37 +15,58 @@ namespace Ryntra::IR {
     public:
         Module(const std::string &name) : name_(name) {}
 
+        Module(const Module &) = delete;
+        Module &operator=(const Module &) = delete;
+
         const std::string &getName() const { return name_; }
         void setName(const std::string &name) { name_ = name; }
 
-        void addFunction(std::shared_ptr<Function> function) {
+        // Allocates an IR object (value, block or function) that lives as long as the module.
+        // Everything reachable from the module is created here; nothing is freed before it dies.
+        template <typename T, typename... Args>
+        T *create(Args &&...args) {
+            return arena_.template create<T>(std::forward<Args>(args)...);
+        }
+
+        // A branch target or phi operand naming a block
+        ImmediateValue *createLabel(const std::string &blockName) {
+            return create<ImmediateValue>(Type::getVoidType(), blockName);
+        }
+
+        size_t getAllocatedBytes() const { return arena_.getAllocatedBytes(); }
+
+        // Array, ref, ptr and function types used by this module's IR
+        TypeTable &getTypes() { return types_; }
+
+        void addFunction(Function *function) {
+            function->parent_ = this;
             functions_.push_back(function);
             if (!function->getName().empty()) {
                 functionMap_[function->getName()] = function;
             }
         }
 
-        void addConstant(std::shared_ptr<Constant> constant) {
+        void addConstant(Constant *constant) {
             constants_.push_back(constant);
             if (!constant->getName().empty()) {
                 constantMap_[constant->getName()] = constant;
             }
         }
 
-        const std::vector<std::shared_ptr<Function>> &getFunctions() const {
+        const std::vector<Function *> &getFunctions() const {
             return functions_;
         }
 
-        const std::vector<std::shared_ptr<Constant>> &getConstants() const {
+        const std::vector<Constant *> &getConstants() const {
             return constants_;
         }
 
-        std::shared_ptr<Function> getFunction(const std::string &name) const {
+        Function *getFunction(const std::string &name) const {
             auto it = functionMap_.find(name);
             return it != functionMap_.end() ? it->second : nullptr;
         }
 
-        std::shared_ptr<Constant> getConstant(const std::string &name) const {
+        Constant *getConstant(const std::string &name) const {
             auto it = constantMap_.find(name);
             return it != constantMap_.end() ? it->second : nullptr;
         }
@@ -79,10 +103,12 @@ namespace Ryntra::IR {
         }
 
     private:
+        Arena arena_;
+        TypeTable types_;
         std::string name_;
-        std::vector<std::shared_ptr<Function>> functions_;
-        std::vector<std::shared_ptr<Constant>> constants_;
-        std::unordered_map<std::string, std::shared_ptr<Function>> functionMap_;
-        std::unordered_map<std::string, std::shared_ptr<Constant>> constantMap_;
+        std::vector<Function *> functions_;
+        std::vector<Constant *> constants_;
+        std::unordered_map<std::string, Function *> functionMap_;
+        std::unordered_map<std::string, Constant *> constantMap_;
     };
 } // namespace Ryntra::IR
\ No newline at end of file
@@ -0,0 +1,98 @@
+#include "PassManager.h"
+#include "Transforms/DeadCodeElimination.h"
+#include "Transforms/GVN.h"
+#include "Transforms/Inliner.h"
+#include "Transforms/LICM.h"
+#include "Transforms/Mem2Reg.h"
+#include "Transforms/SCCP.h"
+#include "Transforms/SimplifyCFG.h"
+#include "Transforms/StrengthReduction.h"
+#include <algorithm>
+#include <ostream>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace Ryntra::IR {
+    PassManager PassManager::createPipeline(OptimizationLevel level) {
+        PassManager passes;
+        if (level == OptimizationLevel::O0)
+            return passes;
+
+        auto mem2reg = [](Function &function, FunctionAnalyses &analyses) { return promoteAllocas(function, analyses); };
+        auto sccp = [](Function &function, FunctionAnalyses &analyses) { return propagateConstants(function, analyses); };
+        auto gvn = [](Function &function, FunctionAnalyses &analyses) {
+            return eliminateCommonSubexpressions(function, analyses);
+        };
+        auto licm = [](Function &function, FunctionAnalyses &analyses) { return hoistLoopInvariants(function, analyses); };
+        auto strength = [](Function &function, FunctionAnalyses &analyses) { return reduceStrength(function, analyses); };
+        auto dce = [](Function &function, FunctionAnalyses &) { return eliminateDeadCode(function); };
+        auto simplify = [](Function &function, FunctionAnalyses &) { return simplifyControlFlow(function); };
+
+        passes.addFunctionPass("Mem2Reg", mem2reg, Preserves::ControlFlow);
+        if (level == OptimizationLevel::O2)
+            passes.addModulePass("Inline", [](Module &module) { return inlineFunctions(module); });
+        passes.addFunctionPass("SCCP", sccp);
+        if (level == OptimizationLevel::O2) {
+            passes.addFunctionPass("GVN", gvn, Preserves::ControlFlow);
+            // LICM refreshes the analyses itself after inserting preheaders
+            passes.addFunctionPass("LICM", licm, Preserves::ControlFlow);
+            passes.addFunctionPass("StrengthReduction", strength, Preserves::ControlFlow);
+        }
+        passes.addFunctionPass("DCE", dce);
+        passes.addFunctionPass("SimplifyCFG", simplify);
+        return passes;
+    }
+
+    void PassManager::addFunctionPass(const std::string &name, FunctionPass pass, Preserves preserves) {
+        passes_.push_back({name, std::move(pass), nullptr, preserves});
+    }
+
+    void PassManager::addModulePass(const std::string &name, ModulePass pass) {
+        passes_.push_back({name, nullptr, std::move(pass), Preserves::Nothing});
+    }
+
+    bool PassManager::hasPass(const std::string &name) const {
+        return std::any_of(passes_.begin(), passes_.end(), [&](const Entry &entry) { return entry.name == name; });
+    }
+
+    void PassManager::printAfter(const std::string &name, std::ostream &os) {
+        if (!hasPass(name)) {
+            std::string known;
+            for (const auto &entry : passes_)
+                known += (known.empty() ? "" : ", ") + entry.name;
+            throw std::invalid_argument("No pass named '" + name + "' in this pipeline" +
+                                        (known.empty() ? std::string(" (it is empty)") : " (it runs " + known + ")"));
+        }
+        printAfter_.insert(name);
+        printStream_ = &os;
+    }
+
+    bool PassManager::run(Module &module, Compiler::PhaseTimer &timer) {
+        std::unordered_map<const Function *, FunctionAnalyses> analyses;
+        bool changed = false;
+        for (const auto &pass : passes_) {
+            timer.begin(pass.name);
+            bool passChanged = false;
+            if (pass.modulePass) {
+                passChanged = pass.modulePass(module);
+                if (passChanged)
+                    analyses.clear();
+            } else {
+                for (const auto &function : module.getFunctions()) {
+                    auto &cached = analyses.try_emplace(function, *function).first->second;
+                    if (pass.functionPass(*function, cached)) {
+                        passChanged = true;
+                        if (pass.preserves == Preserves::Nothing)
+                            cached.invalidate();
+                    }
+                }
+            }
+            timer.end();
+            changed |= passChanged;
+
+            if (printAfter_.count(pass.name))
+                *printStream_ << "*** IR after " << pass.name << " ***\n" << module.toString() << "\n";
+        }
+        return changed;
+    }
+} // namespace Ryntra::IR
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "Analysis/FunctionAnalyses.h"
+#include "Module.h"
+#include "PhaseTimer/PhaseTimer.h"
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace Ryntra::IR {
+    enum class OptimizationLevel { O0, O1, O2 };
+
+    // Runs a pipeline of IR passes over a module, timing each pass as a phase of its own.
+    // Function passes share one FunctionAnalyses per function, kept across passes until one
+    // changes the function without preserving its control flow, or a module pass changes
+    // anything.
+    class PassManager {
+    public:
+        // What a function pass leaves valid when it reports a change
+        enum class Preserves { Nothing, ControlFlow };
+
+        using FunctionPass = std::function<bool(Function &, FunctionAnalyses &)>;
+        using ModulePass = std::function<bool(Module &)>;
+
+        // -O0 runs no pass, -O1 the cheap cleanups (Mem2Reg, SCCP, DCE, SimplifyCFG) and -O2
+        // the whole pipeline
+        static PassManager createPipeline(OptimizationLevel level);
+
+        void addFunctionPass(const std::string &name, FunctionPass pass, Preserves preserves = Preserves::Nothing);
+        void addModulePass(const std::string &name, ModulePass pass);
+
+        bool hasPass(const std::string &name) const;
+
+        // Dumps the module to os after every run of the named pass. Throws
+        // std::invalid_argument if the pipeline has no such pass.
+        void printAfter(const std::string &name, std::ostream &os);
+
+        // Returns whether any pass changed the module
+        bool run(Module &module, Compiler::PhaseTimer &timer);
+
+    private:
+        struct Entry {
+            std::string name;
+            FunctionPass functionPass; // exactly one of the two is set
+            ModulePass modulePass;
+            Preserves preserves = Preserves::Nothing;
+        };
+
+        std::vector<Entry> passes_;
+        std::unordered_set<std::string> printAfter_;
+        std::ostream *printStream_ = nullptr;
+    };
+} // namespace Ryntra::IR
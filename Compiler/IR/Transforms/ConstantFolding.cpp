@@ -0,0 +1,122 @@
+#include "ConstantFolding.h"
+#include <charconv>
+#include <limits>
+#include <string>
+
+namespace Ryntra::IR {
+    std::optional<ConstantInt> getConstantInt(const Value &value) {
+        if (auto *imm = dynamic_cast<const ImmediateValue *>(&value)) {
+            const auto &type = *imm->getType();
+            if (!type.isInt32() && !type.isInt64() && !type.isBool())
+                return std::nullopt;
+            const std::string &literal = imm->getLiteralValue();
+            int64_t parsed = 0;
+            auto [end, ec] = std::from_chars(literal.data(), literal.data() + literal.size(), parsed);
+            if (ec != std::errc() || end != literal.data() + literal.size())
+                return std::nullopt;
+            if (type.isInt64())
+                return ConstantInt{parsed, true};
+            return ConstantInt{static_cast<int32_t>(parsed), false};
+        }
+        if (auto *inst = dynamic_cast<const Instruction *>(&value)) {
+            if (inst->getOpcode() == Instruction::Opcode::Constant && !inst->getOperands().empty())
+                return getConstantInt(*inst->getOperands()[0]);
+        }
+        return std::nullopt;
+    }
+
+    namespace {
+        template <typename T>
+        std::optional<T> foldTyped(Instruction::Opcode opcode, T a, T b) {
+            using U = std::make_unsigned_t<T>;
+            constexpr T shiftMask = sizeof(T) * 8 - 1;
+            switch (opcode) {
+            case Instruction::Opcode::Add:
+                return static_cast<T>(static_cast<U>(a) + static_cast<U>(b));
+            case Instruction::Opcode::Sub:
+                return static_cast<T>(static_cast<U>(a) - static_cast<U>(b));
+            case Instruction::Opcode::Mul:
+                return static_cast<T>(static_cast<U>(a) * static_cast<U>(b));
+            case Instruction::Opcode::Div:
+                if (b == 0 || (a == std::numeric_limits<T>::min() && b == -1))
+                    return std::nullopt;
+                return static_cast<T>(a / b);
+            case Instruction::Opcode::Mod:
+                if (b == 0 || (a == std::numeric_limits<T>::min() && b == -1))
+                    return std::nullopt;
+                return static_cast<T>(a % b);
+            case Instruction::Opcode::BitAnd:
+                return static_cast<T>(a & b);
+            case Instruction::Opcode::BitOr:
+                return static_cast<T>(a | b);
+            case Instruction::Opcode::BitXor:
+                return static_cast<T>(a ^ b);
+            case Instruction::Opcode::Shl:
+                return static_cast<T>(static_cast<U>(a) << (b & shiftMask));
+            case Instruction::Opcode::Shr:
+                return static_cast<T>(a >> (b & shiftMask));
+            default:
+                return std::nullopt;
+            }
+        }
+
+        std::optional<bool> compare(Instruction::Opcode opcode, int64_t a, int64_t b) {
+            switch (opcode) {
+            case Instruction::Opcode::Eq:
+                return a == b;
+            case Instruction::Opcode::Ne:
+                return a != b;
+            case Instruction::Opcode::Lt:
+                return a < b;
+            case Instruction::Opcode::Gt:
+                return a > b;
+            case Instruction::Opcode::Le:
+                return a <= b;
+            case Instruction::Opcode::Ge:
+                return a >= b;
+            default:
+                return std::nullopt;
+            }
+        }
+    } // namespace
+
+    std::optional<ConstantInt> foldInstruction(Instruction::Opcode opcode, const std::vector<ConstantInt> &operands) {
+        using Opcode = Instruction::Opcode;
+        if (operands.size() == 1) {
+            const auto &a = operands[0];
+            switch (opcode) {
+            case Opcode::Constant:
+                return a;
+            case Opcode::SExt:
+                return ConstantInt{a.value, true};
+            case Opcode::Trunc:
+                return ConstantInt{static_cast<int32_t>(a.value), false};
+            case Opcode::BitNot:
+                return a.isLong ? ConstantInt{~a.value, true} : ConstantInt{~static_cast<int32_t>(a.value), false};
+            case Opcode::LogicalNot:
+                return ConstantInt{a.value == 0 ? 1 : 0, false};
+            default:
+                return std::nullopt;
+            }
+        }
+
+        if (operands.size() != 2 || operands[0].isLong != operands[1].isLong)
+            return std::nullopt;
+        const auto &a = operands[0];
+        const auto &b = operands[1];
+        if (auto result = compare(opcode, a.value, b.value))
+            return ConstantInt{*result ? 1 : 0, false};
+        if (a.isLong) {
+            if (auto result = foldTyped<int64_t>(opcode, a.value, b.value))
+                return ConstantInt{*result, true};
+        } else if (auto result = foldTyped<int32_t>(opcode, static_cast<int32_t>(a.value), static_cast<int32_t>(b.value))) {
+            return ConstantInt{*result, false};
+        }
+        return std::nullopt;
+    }
+
+    ImmediateValue *makeImmediate(Module &module, const ConstantInt &constant, Type *resultType) {
+        auto type = constant.isLong ? Type::getInt64Type() : resultType->isBool() ? Type::getBoolType() : Type::getInt32Type();
+        return module.create<ImmediateValue>(type, std::to_string(constant.value));
+    }
+} // namespace Ryntra::IR
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "../ImmediateValue.h"
+#include "../Instruction.h"
+#include "../Module.h"
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace Ryntra::IR {
+    // An integer as the VM holds it: ints and bools are int32, longs int64
+    struct ConstantInt {
+        int64_t value = 0;
+        bool isLong = false;
+
+        bool operator==(const ConstantInt &) const = default;
+    };
+
+    // The integer an immediate or a `constant` instruction stands for
+    std::optional<ConstantInt> getConstantInt(const Value &value);
+
+    // Evaluates opcode on constant operands exactly as the VM would: int and long arithmetic
+    // wraps, shift counts are masked to 31 / 63, comparisons and logicalnot yield an int 0 / 1.
+    // Returns nullopt where the VM would not produce a value (mixed int / long operands,
+    // division by zero) or would trap (INT_MIN / -1), so those stay runtime operations.
+    std::optional<ConstantInt> foldInstruction(Instruction::Opcode opcode, const std::vector<ConstantInt> &operands);
+
+    // An immediate for constant, typed i64 for longs and otherwise after resultType (i1 or i32),
+    // allocated in module
+    ImmediateValue *makeImmediate(Module &module, const ConstantInt &constant, Type *resultType);
+} // namespace Ryntra::IR
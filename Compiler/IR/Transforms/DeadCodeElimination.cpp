@@ -0,0 +1,154 @@
+#include "DeadCodeElimination.h"
+#include "../Analysis/ControlFlowGraph.h"
+#include "../Analysis/LocalSlots.h"
+#include "ConstantFolding.h"
+#include "ReplaceUses.h"
+#include <unordered_map>
+#include <unordered_set>
+
+namespace Ryntra::IR {
+    namespace {
+        using Opcode = Instruction::Opcode;
+
+        // Whether dropping an unused inst can't change what the program does. Loads through
+        // refs, pointers and arrays stay since they can fault, and so do divisions unless the
+        // divisor is a constant they can't trap on.
+        bool isSideEffectFree(const Instruction &inst) {
+            switch (inst.getOpcode()) {
+            case Opcode::LoadConstant:
+            case Opcode::Constant:
+            case Opcode::Add:
+            case Opcode::Sub:
+            case Opcode::Mul:
+            case Opcode::BitNot:
+            case Opcode::LogicalNot:
+            case Opcode::BitAnd:
+            case Opcode::BitOr:
+            case Opcode::BitXor:
+            case Opcode::Shl:
+            case Opcode::Shr:
+            case Opcode::SExt:
+            case Opcode::Trunc:
+            case Opcode::Eq:
+            case Opcode::Ne:
+            case Opcode::Lt:
+            case Opcode::Gt:
+            case Opcode::Le:
+            case Opcode::Ge:
+            case Opcode::Alloca:
+            case Opcode::Load:
+            case Opcode::RefCreate:
+            case Opcode::PtrCreate:
+            case Opcode::Phi:
+                return true;
+            case Opcode::Div:
+            case Opcode::Mod: {
+                auto divisor = getConstantInt(*inst.getOperands()[1]);
+                return divisor && divisor->value != 0 && divisor->value != -1;
+            }
+            default:
+                return false;
+            }
+        }
+
+        bool removeUnreachableBlocks(Function &function) {
+            ControlFlowGraph cfg(function);
+            bool changed = false;
+
+            std::unordered_set<std::string> removed;
+            for (size_t b = 0; b < cfg.size(); ++b) {
+                if (cfg.isReachable(b))
+                    continue;
+                removed.insert(cfg.getBlock(b)->getName());
+                for (const auto &inst : cfg.getBlock(b)->getInstructions())
+                    inst->dropAllReferences();
+            }
+            if (!removed.empty()) {
+                function.removeBasicBlocks([&](BasicBlock *block) {
+                    return removed.count(block->getName()) > 0;
+                });
+                changed = true;
+            }
+
+            ReplacementMap replacements;
+            for (const auto &block : function.getBasicBlocks()) {
+                const auto &instructions = block->getInstructions();
+                size_t end = ControlFlowGraph::getTerminatorIndex(*block);
+                if (end + 1 < instructions.size()) {
+                    std::unordered_set<const Instruction *> tail;
+                    for (size_t i = end + 1; i < instructions.size(); ++i)
+                        tail.insert(instructions[i]);
+                    block->eraseInstructions([&](Instruction *inst) {
+                        return tail.count(inst) > 0;
+                    });
+                    changed = true;
+                }
+
+                for (const auto &inst : block->getInstructions()) {
+                    if (inst->getOpcode() != Opcode::Phi)
+                        break;
+                    for (size_t i = inst->getIncomingCount(); i-- > 0;) {
+                        if (removed.count(inst->getIncomingBlock(i)))
+                            inst->removeIncoming(i);
+                    }
+                    if (inst->getIncomingCount() == 1 && inst->getIncomingValue(0) != inst)
+                        replacements[inst] = inst->getIncomingValue(0);
+                }
+            }
+
+            // Single-operand phis are plain copies of their operand
+            replaceAllUses(replacements);
+            removeReplaced(function, replacements);
+            return changed || !replacements.empty();
+        }
+
+        bool removeDeadInstructions(Function &function) {
+            std::vector<Instruction *> worklist;
+            for (const auto &block : function.getBasicBlocks()) {
+                for (const auto &inst : block->getInstructions()) {
+                    if (!inst->hasUsers() && isSideEffectFree(*inst))
+                        worklist.push_back(inst);
+                }
+            }
+
+            // An instruction is dead once every one of its uses is in a dead instruction
+            std::unordered_map<const Instruction *, size_t> deadUses;
+            std::unordered_set<const Instruction *> dead;
+            while (!worklist.empty()) {
+                Instruction *inst = worklist.back();
+                worklist.pop_back();
+                if (!dead.insert(inst).second)
+                    continue;
+                for (const auto &operand : inst->getOperands()) {
+                    auto *source = dynamic_cast<Instruction *>(operand);
+                    if (source && ++deadUses[source] == source->getUsers().size() && isSideEffectFree(*source))
+                        worklist.push_back(source);
+                }
+            }
+            if (dead.empty())
+                return false;
+
+            for (const auto &block : function.getBasicBlocks()) {
+                block->eraseInstructions([&](Instruction *inst) {
+                    return dead.count(inst) > 0;
+                });
+            }
+            return true;
+        }
+    } // namespace
+
+    bool eliminateDeadCode(Function &function) {
+        if (function.isExternal() || function.getBasicBlocks().empty() || hasComputedSlotPointers(function))
+            return false;
+        bool changed = removeUnreachableBlocks(function);
+        changed |= removeDeadInstructions(function);
+        return changed;
+    }
+
+    bool eliminateDeadCode(Module &module) {
+        bool changed = false;
+        for (const auto &function : module.getFunctions())
+            changed |= eliminateDeadCode(*function);
+        return changed;
+    }
+} // namespace Ryntra::IR
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "../Module.h"
+
+namespace Ryntra::IR {
+    // Removes the blocks control can never reach, the instructions behind a block's first
+    // terminator and, driven by use counts, every side-effect-free instruction whose result is
+    // never used (along with operands that become unused in turn). Phi operands of removed
+    // edges are dropped and a phi left with a single operand is replaced by it. Functions that
+    // do pointer arithmetic on locals are skipped (see LocalSlots.h). Returns whether anything
+    // changed.
+    bool eliminateDeadCode(Function &function);
+    bool eliminateDeadCode(Module &module);
+} // namespace Ryntra::IR
@@ -0,0 +1,214 @@
+#include "GVN.h"
+#include "../Analysis/FunctionAnalyses.h"
+#include "../Analysis/LocalSlots.h"
+#include "ReplaceUses.h"
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+
+namespace Ryntra::IR {
+    namespace {
+        using Opcode = Instruction::Opcode;
+
+        // Instructions whose result depends on nothing but their operands. A repeat that traps
+        // (division, an out-of-bounds arrref) would already have trapped at the original.
+        bool isPure(Opcode opcode) {
+            switch (opcode) {
+            case Opcode::LoadConstant:
+            case Opcode::Constant:
+            case Opcode::Add:
+            case Opcode::Sub:
+            case Opcode::Mul:
+            case Opcode::Div:
+            case Opcode::Mod:
+            case Opcode::BitNot:
+            case Opcode::LogicalNot:
+            case Opcode::BitAnd:
+            case Opcode::BitOr:
+            case Opcode::BitXor:
+            case Opcode::Shl:
+            case Opcode::Shr:
+            case Opcode::SExt:
+            case Opcode::Trunc:
+            case Opcode::Eq:
+            case Opcode::Ne:
+            case Opcode::Lt:
+            case Opcode::Gt:
+            case Opcode::Le:
+            case Opcode::Ge:
+            case Opcode::RefCreate:
+            case Opcode::PtrCreate:
+            case Opcode::ArrRef:
+            case Opcode::PtrFromArray:
+                return true;
+            default:
+                return false;
+            }
+        }
+
+        bool isCommutative(Opcode opcode) {
+            switch (opcode) {
+            case Opcode::Add:
+            case Opcode::Mul:
+            case Opcode::BitAnd:
+            case Opcode::BitOr:
+            case Opcode::BitXor:
+            case Opcode::Eq:
+            case Opcode::Ne:
+                return true;
+            default:
+                return false;
+            }
+        }
+
+        // Instructions that may write a local other than through a plain store
+        bool mayWriteLocals(Opcode opcode) {
+            return opcode == Opcode::RefStore || opcode == Opcode::PtrStore || opcode == Opcode::Call;
+        }
+
+        struct ExpressionKey {
+            Opcode opcode;
+            const Type *type; // types are uniqued, so the pointer identifies the type
+            std::vector<const Value *> operands;
+
+            bool operator==(const ExpressionKey &) const = default;
+        };
+
+        struct ExpressionKeyHash {
+            size_t operator()(const ExpressionKey &key) const {
+                size_t hash = std::hash<int>()(static_cast<int>(key.opcode)) ^ std::hash<const Type *>()(key.type);
+                for (const auto *operand : key.operands)
+                    hash = hash * 31 + std::hash<const Value *>()(operand);
+                return hash;
+            }
+        };
+
+        class ValueNumbering {
+        public:
+            ValueNumbering(Function &function, FunctionAnalyses &analyses)
+                : function_(function), cfg_(analyses.getControlFlowGraph()), domTree_(analyses.getDominatorTree()) {}
+
+            bool run() {
+                if (cfg_.size() > 0)
+                    visit(0);
+                replaceAllUses(replacements_);
+                removeReplaced(function_, replacements_);
+                return !replacements_.empty();
+            }
+
+        private:
+            void visit(size_t root) {
+                // Explicit stack of (block, keys it added) so deep dominator trees can't overflow
+                struct Scope {
+                    size_t block;
+                    std::vector<ExpressionKey> added;
+                    size_t nextChild = 0;
+                };
+                std::vector<Scope> stack;
+                stack.push_back({root, numberBlock(root)});
+                while (!stack.empty()) {
+                    auto &scope = stack.back();
+                    const auto &children = domTree_.getChildren(scope.block);
+                    if (scope.nextChild < children.size()) {
+                        size_t child = children[scope.nextChild++];
+                        stack.push_back({child, numberBlock(child)});
+                        continue;
+                    }
+                    for (const auto &key : scope.added)
+                        available_.erase(key);
+                    stack.pop_back();
+                }
+            }
+
+            // Numbers the block's instructions, returning the expressions it made available
+            std::vector<ExpressionKey> numberBlock(size_t b) {
+                std::vector<ExpressionKey> added;
+                std::unordered_map<const Value *, Instruction *> loads; // by alloca
+                const auto &block = *cfg_.getBlock(b);
+                const auto &instructions = block.getInstructions();
+                size_t end = ControlFlowGraph::getTerminatorIndex(block);
+                for (size_t i = 0; i < end; ++i) {
+                    const auto &inst = instructions[i];
+                    resolveOperands(*inst);
+                    const auto &operands = inst->getOperands();
+                    switch (inst->getOpcode()) {
+                    case Opcode::Load: {
+                        auto [it, inserted] = loads.emplace(operands[0], inst);
+                        if (!inserted)
+                            replacements_[inst] = it->second;
+                        continue;
+                    }
+                    case Opcode::Store:
+                        loads.erase(operands[1]);
+                        continue;
+                    default:
+                        if (mayWriteLocals(inst->getOpcode()))
+                            loads.clear();
+                        break;
+                    }
+                    if (!isPure(inst->getOpcode()))
+                        continue;
+
+                    ExpressionKey key = keyOf(*inst);
+                    auto [it, inserted] = available_.emplace(key, inst);
+                    if (inserted)
+                        added.push_back(std::move(key));
+                    else
+                        replacements_[inst] = it->second;
+                }
+                return added;
+            }
+
+            void resolveOperands(Instruction &inst) {
+                const auto &operands = inst.getOperands();
+                for (size_t i = 0; i < operands.size(); ++i) {
+                    auto it = replacements_.find(operands[i]);
+                    if (it != replacements_.end())
+                        inst.setOperand(i, it->second);
+                }
+            }
+
+            ExpressionKey keyOf(const Instruction &inst) {
+                ExpressionKey key{inst.getOpcode(), inst.getType(), {}};
+                for (const auto &operand : inst.getOperands())
+                    key.operands.push_back(identityOf(operand));
+                if (isCommutative(inst.getOpcode()))
+                    std::sort(key.operands.begin(), key.operands.end(), std::less<const Value *>());
+                return key;
+            }
+
+            // Equal immediates are distinct objects; the first one seen stands for all of them
+            const Value *identityOf(Value *operand) {
+                if (!dynamic_cast<const ImmediateValue *>(operand))
+                    return operand;
+                return immediates_.emplace(operand->toString(), operand).first->second;
+            }
+
+            Function &function_;
+            const ControlFlowGraph &cfg_;
+            const DominatorTree &domTree_;
+
+            std::unordered_map<ExpressionKey, Instruction *, ExpressionKeyHash> available_;
+            std::unordered_map<std::string, const Value *> immediates_;
+            ReplacementMap replacements_;
+        };
+    } // namespace
+
+    bool eliminateCommonSubexpressions(Function &function, FunctionAnalyses &analyses) {
+        if (function.isExternal() || function.getBasicBlocks().empty() || hasComputedSlotPointers(function))
+            return false;
+        return ValueNumbering(function, analyses).run();
+    }
+
+    bool eliminateCommonSubexpressions(Function &function) {
+        FunctionAnalyses analyses(function);
+        return eliminateCommonSubexpressions(function, analyses);
+    }
+
+    bool eliminateCommonSubexpressions(Module &module) {
+        bool changed = false;
+        for (const auto &function : module.getFunctions())
+            changed |= eliminateCommonSubexpressions(*function);
+        return changed;
+    }
+} // namespace Ryntra::IR
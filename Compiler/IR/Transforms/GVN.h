@@ -0,0 +1,17 @@
+#pragma once
+
+#include "../Module.h"
+
+namespace Ryntra::IR {
+    class FunctionAnalyses;
+
+    // Global value numbering: walks the dominator tree with a scoped table of the pure
+    // instructions seen so far, keyed by opcode, type and operand identity (operands of
+    // commutative operators in a fixed order), and replaces each repeat by the dominating
+    // original. A load is reused within its block until a store to the same alloca, or anything
+    // that could write a local through a ref or pointer. Functions that do pointer arithmetic
+    // on locals are skipped (see LocalSlots.h). Returns whether anything changed.
+    bool eliminateCommonSubexpressions(Function &function, FunctionAnalyses &analyses);
+    bool eliminateCommonSubexpressions(Function &function);
+    bool eliminateCommonSubexpressions(Module &module);
+} // namespace Ryntra::IR
@@ -0,0 +1,273 @@
+#include "Inliner.h"
+#include "../Analysis/ControlFlowGraph.h"
+#include "../Analysis/LocalSlots.h"
+#include "../UndefValue.h"
+#include "ReplaceUses.h"
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace Ryntra::IR {
+    namespace {
+        using Opcode = Instruction::Opcode;
+
+        constexpr size_t InlineThreshold = 40;
+        constexpr size_t CallerSizeLimit = 2000;
+
+        Function *calleeOf(const Instruction &inst) {
+            if (inst.getOpcode() != Opcode::Call || inst.getOperands().empty())
+                return nullptr;
+            return dynamic_cast<Function *>(inst.getOperands()[0]);
+        }
+
+        size_t sizeOf(const Function &function) {
+            size_t size = 0;
+            for (const auto &block : function.getBasicBlocks())
+                size += block->getInstructions().size();
+            return size;
+        }
+
+        // Tarjan's algorithm over the user functions; components come out callees first
+        class CallGraph {
+        public:
+            explicit CallGraph(const Module &module) {
+                for (const auto &function : module.getFunctions()) {
+                    if (!function->isExternal() && !indices_.count(function))
+                        visit(function);
+                }
+            }
+
+            const std::vector<std::vector<Function *>> &getComponents() const { return components_; }
+            size_t getComponent(const Function *function) const { return componentOf_.at(function); }
+
+        private:
+            void visit(Function *function) {
+                size_t index = indices_.size();
+                indices_[function] = index;
+                lowLinks_[function] = index;
+                stack_.push_back(function);
+                onStack_[function] = true;
+
+                for (const auto &block : function->getBasicBlocks()) {
+                    for (const auto &inst : block->getInstructions()) {
+                        Function *callee = calleeOf(*inst);
+                        if (!callee || callee->isExternal())
+                            continue;
+                        if (!indices_.count(callee)) {
+                            visit(callee);
+                            lowLinks_[function] = std::min(lowLinks_[function], lowLinks_[callee]);
+                        } else if (onStack_[callee]) {
+                            lowLinks_[function] = std::min(lowLinks_[function], indices_[callee]);
+                        }
+                    }
+                }
+
+                if (lowLinks_[function] != indices_[function])
+                    return;
+                std::vector<Function *> component;
+                Function *member = nullptr;
+                do {
+                    member = stack_.back();
+                    stack_.pop_back();
+                    onStack_[member] = false;
+                    componentOf_[member] = components_.size();
+                    component.push_back(member);
+                } while (member != function);
+                components_.push_back(std::move(component));
+            }
+
+            std::unordered_map<const Function *, size_t> indices_, lowLinks_, componentOf_;
+            std::unordered_map<const Function *, bool> onStack_;
+            std::vector<Function *> stack_;
+            std::vector<std::vector<Function *>> components_;
+        };
+
+        class Inliner {
+        public:
+            explicit Inliner(Module &module) : module_(module), callGraph_(module) {}
+
+            bool run() {
+                bool changed = false;
+                for (const auto &component : callGraph_.getComponents()) {
+                    for (Function *function : component)
+                        changed |= inlineCalls(*function);
+                }
+                return changed;
+            }
+
+        private:
+            bool inlineCalls(Function &caller) {
+                if (hasComputedSlotPointers(caller))
+                    return false;
+                bool changed = false;
+                for (size_t b = 0; b < caller.getBasicBlocks().size(); ++b) {
+                    auto block = caller.getBasicBlocks()[b];
+                    size_t end = ControlFlowGraph::getTerminatorIndex(*block);
+                    for (size_t i = 0; i < end; ++i) {
+                        Function *callee = calleeOf(*block->getInstructions()[i]);
+                        if (callee && canInline(caller, *callee)) {
+                            // Carry on in the continuation. The cloned blocks are not scanned again:
+                            // their calls were considered when the callee itself was visited, and
+                            // inlining a recursive callee's own calls would unroll it
+                            b = inlineCall(caller, b, i, *callee) - 1;
+                            changed = true;
+                            break;
+                        }
+                    }
+                }
+                return changed;
+            }
+
+            bool canInline(const Function &caller, const Function &callee) const {
+                if (callee.isExternal() || callee.getBasicBlocks().empty() || !callee.getParameters().empty() ||
+                    callGraph_.getComponent(&caller) == callGraph_.getComponent(&callee))
+                    return false;
+                size_t calleeSize = sizeOf(callee);
+                if (calleeSize > InlineThreshold || sizeOf(caller) + calleeSize > CallerSizeLimit ||
+                    hasComputedSlotPointers(callee))
+                    return false;
+
+                // A value function falling off its end has no value to hand to the phi
+                const auto &last = *callee.getBasicBlocks().back();
+                return callee.getReturnType()->isVoid() ||
+                       ControlFlowGraph::getTerminatorIndex(last) != last.getInstructions().size();
+            }
+
+            // Returns the index of the continuation block
+            size_t inlineCall(Function &caller, size_t blockIndex, size_t callIndex, const Function &callee) {
+                auto block = caller.getBasicBlocks()[blockIndex];
+                auto call = block->getInstructions()[callIndex];
+                std::string suffix = ".i" + std::to_string(counter_++);
+
+                // Split the block after the call; its successors are now entered from the continuation
+                auto successors = ControlFlowGraph::getSuccessorNames(caller, blockIndex);
+                auto continuation = module_.create<BasicBlock>(block->getName() + suffix + ".cont");
+                const auto &instructions = block->getInstructions();
+                std::unordered_set<const Instruction *> moved;
+                for (size_t i = callIndex + 1; i < instructions.size(); ++i) {
+                    continuation->addInstruction(instructions[i]);
+                    moved.insert(instructions[i]);
+                }
+                block->removeInstructions([&](Instruction *inst) { return moved.count(inst) > 0; });
+                call->eraseFromParent();
+                for (const auto &name : successors)
+                    renameIncoming(caller, name, block->getName(), continuation->getName());
+
+                // Clone the callee's blocks, up to each one's first terminator. The copies run as part of
+                // the caller's bytecode, so they take the call's location: an error or sample in them is
+                // attributed to the caller's line, never to a line of another function.
+                std::unordered_map<std::string, std::string> labels;
+                for (const auto &calleeBlock : callee.getBasicBlocks())
+                    labels[calleeBlock->getName()] = calleeBlock->getName() + suffix;
+                std::unordered_map<const Value *, Value *> values;
+                std::vector<BasicBlock *> clones;
+                for (const auto &calleeBlock : callee.getBasicBlocks()) {
+                    auto clone = module_.create<BasicBlock>(labels.at(calleeBlock->getName()));
+                    const auto &body = calleeBlock->getInstructions();
+                    size_t end = std::min(ControlFlowGraph::getTerminatorIndex(*calleeBlock) + 1, body.size());
+                    for (size_t i = 0; i < end; ++i) {
+                        const auto &inst = body[i];
+                        auto copy = module_.create<Instruction>(inst->getOpcode(), inst->getType(), inst->getOperands(),
+                                                                inst->getName().empty() ? "" : inst->getName() + suffix);
+                        copy->setLocation(call->getLocation());
+                        values[inst] = copy;
+                        clone->addInstruction(copy);
+                    }
+                    clones.push_back(clone);
+                }
+
+                // Point operands at the copies and returns at the continuation
+                std::vector<std::pair<Value *, std::string>> returned;
+                for (const auto &clone : clones) {
+                    for (const auto &inst : clone->getInstructions())
+                        remapOperands(*inst, values, labels);
+                    const auto &body = clone->getInstructions();
+                    if (body.empty() || body.back()->getOpcode() != Opcode::Return)
+                        continue;
+                    auto ret = body.back();
+                    if (!ret->getOperands().empty())
+                        returned.emplace_back(ret->getOperands()[0], clone->getName());
+                    ret->eraseFromParent();
+                    clone->addInstruction(makeBr(continuation->getName(), call->getLocation()));
+                }
+
+                block->addInstruction(makeBr(clones.front()->getName(), call->getLocation()));
+                size_t at = blockIndex + 1;
+                for (const auto &clone : clones)
+                    caller.insertBasicBlock(at++, clone);
+                caller.insertBasicBlock(at, continuation);
+
+                if (callee.getReturnType()->isVoid())
+                    return at;
+                Value *result = nullptr;
+                if (returned.empty()) {
+                    result = module_.create<UndefValue>(call->getType()); // the callee never returns
+                } else if (returned.size() == 1) {
+                    result = returned.front().first;
+                } else {
+                    auto phi = module_.create<Instruction>(Opcode::Phi, call->getType(), std::vector<Value *>{},
+                                                           call->getName());
+                    phi->setLocation(call->getLocation());
+                    for (const auto &[value, from] : returned)
+                        phi->addIncoming(value, module_.createLabel(from));
+                    continuation->insertInstruction(0, phi);
+                    result = phi;
+                }
+                call->replaceAllUsesWith(result);
+                return at;
+            }
+
+            void remapOperands(Instruction &inst, const std::unordered_map<const Value *, Value *> &values,
+                               const std::unordered_map<std::string, std::string> &labels) {
+                auto relabel = [&](size_t index) {
+                    const auto &label = static_cast<const ImmediateValue &>(*inst.getOperands()[index]).getLiteralValue();
+                    inst.setOperand(index, module_.createLabel(labels.at(label)));
+                };
+                const auto &operands = inst.getOperands();
+                for (size_t i = 0; i < operands.size(); ++i) {
+                    bool isLabel = (inst.getOpcode() == Opcode::Br && i == 0) ||
+                                   (inst.getOpcode() == Opcode::CondBr && i > 0) ||
+                                   (inst.getOpcode() == Opcode::Phi && i % 2 == 1);
+                    if (isLabel) {
+                        relabel(i);
+                        continue;
+                    }
+                    auto it = values.find(operands[i]);
+                    if (it != values.end())
+                        inst.setOperand(i, it->second);
+                }
+            }
+
+            void renameIncoming(Function &function, const std::string &blockName, const std::string &from,
+                                const std::string &to) {
+                for (const auto &block : function.getBasicBlocks()) {
+                    if (block->getName() != blockName)
+                        continue;
+                    for (const auto &inst : block->getInstructions()) {
+                        if (inst->getOpcode() != Opcode::Phi)
+                            break;
+                        for (size_t i = 0; i < inst->getIncomingCount(); ++i) {
+                            if (inst->getIncomingBlock(i) == from)
+                                inst->setIncomingBlock(i, module_.createLabel(to));
+                        }
+                    }
+                }
+            }
+
+            Instruction *makeBr(const std::string &target, Compiler::SourceLocation location) {
+                auto br = module_.create<Instruction>(Opcode::Br, Type::getVoidType(),
+                                                      std::vector<Value *>{module_.createLabel(target)});
+                br->setLocation(location);
+                return br;
+            }
+
+            Module &module_;
+            CallGraph callGraph_;
+            size_t counter_ = 0;
+        };
+    } // namespace
+
+    bool inlineFunctions(Module &module) {
+        return Inliner(module).run();
+    }
+} // namespace Ryntra::IR
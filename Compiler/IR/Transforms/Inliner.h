@@ -0,0 +1,14 @@
+#pragma once
+
+#include "../Module.h"
+
+namespace Ryntra::IR {
+    // Inlines calls to small user functions into their callers. Functions are visited callees
+    // first over the call graph's strongly connected components, and a call is never inlined
+    // within its own component, so recursion is left as calls. A callee is inlined when it is
+    // at most InlineThreshold instructions and the caller stays under CallerSizeLimit; its
+    // blocks, allocas and values are cloned under a fresh ".i<N>" suffix, its returns branch to
+    // a continuation block and their values meet in a phi there. Functions that do pointer
+    // arithmetic on locals are never inlined. Returns whether anything changed.
+    bool inlineFunctions(Module &module);
+} // namespace Ryntra::IR
@@ -0,0 +1,227 @@
+#include "LICM.h"
+#include "../Analysis/FunctionAnalyses.h"
+#include "../Analysis/LocalSlots.h"
+#include "ConstantFolding.h"
+#include <algorithm>
+#include <unordered_set>
+
+namespace Ryntra::IR {
+    namespace {
+        using Opcode = Instruction::Opcode;
+
+        // Safe to execute even on iterations (or loop entries) where it would not have run
+        bool isSpeculatable(const Instruction &inst) {
+            switch (inst.getOpcode()) {
+            case Opcode::Add:
+            case Opcode::Sub:
+            case Opcode::Mul:
+            case Opcode::BitNot:
+            case Opcode::LogicalNot:
+            case Opcode::BitAnd:
+            case Opcode::BitOr:
+            case Opcode::BitXor:
+            case Opcode::Shl:
+            case Opcode::Shr:
+            case Opcode::SExt:
+            case Opcode::Trunc:
+            case Opcode::Eq:
+            case Opcode::Ne:
+            case Opcode::Lt:
+            case Opcode::Gt:
+            case Opcode::Le:
+            case Opcode::Ge:
+            case Opcode::RefCreate:
+            case Opcode::PtrCreate:
+                return true;
+            case Opcode::Div:
+            case Opcode::Mod: {
+                auto divisor = getConstantInt(*inst.getOperands()[1]);
+                return divisor && divisor->value != 0 && divisor->value != -1;
+            }
+            default:
+                return false;
+            }
+        }
+
+        Instruction *makeBr(Module &module, const std::string &target) {
+            return module.create<Instruction>(Opcode::Br, Type::getVoidType(),
+                                              std::vector<Value *>{module.createLabel(target)});
+        }
+
+        bool hasPreheader(const ControlFlowGraph &cfg, const Loop &loop) {
+            auto entries = loop.getEntries(cfg);
+            return entries.size() == 1 && cfg.getSuccessors(entries[0]).size() == 1;
+        }
+
+        // Inserts a block between the loop and the blocks entering it from outside
+        void insertPreheader(Function &function, const ControlFlowGraph &cfg, const Loop &loop) {
+            auto &module = *function.getParent();
+            auto &header = *cfg.getBlock(loop.header);
+            const std::string &headerName = header.getName();
+            auto preheader = module.create<BasicBlock>(headerName + ".preheader");
+            const std::string &preheaderName = preheader->getName();
+
+            // The preheader goes right before the header: a loop block falling through into the
+            // header now needs a branch, an entry falling through reaches the preheader instead
+            size_t before = loop.header - 1;
+            auto &previous = *cfg.getBlock(before);
+            if (loop.contains[before] &&
+                ControlFlowGraph::getTerminatorIndex(previous) == previous.getInstructions().size())
+                previous.addInstruction(makeBr(module, headerName));
+
+            std::unordered_set<std::string> entryNames;
+            for (size_t entry : loop.getEntries(cfg)) {
+                auto &block = *cfg.getBlock(entry);
+                entryNames.insert(block.getName());
+                size_t end = ControlFlowGraph::getTerminatorIndex(block);
+                if (end == block.getInstructions().size())
+                    continue;
+                const auto &terminator = block.getInstructions()[end];
+                const auto &operands = terminator->getOperands();
+                size_t firstLabel = terminator->getOpcode() == Opcode::CondBr ? 1 : 0;
+                for (size_t i = firstLabel; i < operands.size(); ++i) {
+                    const auto &label = static_cast<const ImmediateValue &>(*operands[i]);
+                    if (label.getLiteralValue() == headerName)
+                        terminator->setOperand(i, module.createLabel(preheaderName));
+                }
+            }
+
+            for (const auto &phi : header.getInstructions()) {
+                if (phi->getOpcode() != Opcode::Phi)
+                    break;
+                std::vector<std::pair<Value *, std::string>> outside;
+                for (size_t i = phi->getIncomingCount(); i-- > 0;) {
+                    if (entryNames.count(phi->getIncomingBlock(i))) {
+                        outside.emplace_back(phi->getIncomingValue(i), phi->getIncomingBlock(i));
+                        phi->removeIncoming(i);
+                    }
+                }
+                if (outside.empty())
+                    continue;
+
+                bool same = std::all_of(outside.begin(), outside.end(),
+                                        [&](const auto &in) { return in.first == outside.front().first; });
+                if (same) {
+                    phi->addIncoming(outside.front().first, module.createLabel(preheaderName));
+                    continue;
+                }
+                auto merged = module.create<Instruction>(Opcode::Phi, phi->getType(), std::vector<Value *>{},
+                                                         phi->getName() + ".pre");
+                merged->setLocation(phi->getLocation());
+                for (auto it = outside.rbegin(); it != outside.rend(); ++it)
+                    merged->addIncoming(it->first, module.createLabel(it->second));
+                preheader->addInstruction(merged);
+                phi->addIncoming(merged, module.createLabel(preheaderName));
+            }
+
+            preheader->addInstruction(makeBr(module, headerName));
+            function.insertBasicBlock(loop.header, preheader);
+        }
+
+        // One preheader at a time, since each insertion renumbers the blocks
+        bool insertPreheaders(Function &function, FunctionAnalyses &analyses) {
+            bool changed = false;
+            while (true) {
+                const auto &cfg = analyses.getControlFlowGraph();
+                const auto &loops = analyses.getLoopInfo();
+                auto it = std::find_if(loops.getLoops().begin(), loops.getLoops().end(), [&](const Loop &loop) {
+                    return loop.header != 0 && !hasPreheader(cfg, loop);
+                });
+                if (it == loops.getLoops().end())
+                    return changed;
+                insertPreheader(function, cfg, *it);
+                analyses.invalidate();
+                changed = true;
+            }
+        }
+
+        // Moves instructions only, so the analyses stay valid
+        bool hoistInvariants(FunctionAnalyses &analyses) {
+            const auto &cfg = analyses.getControlFlowGraph();
+            const auto &loops = analyses.getLoopInfo();
+            bool changed = false;
+
+            for (const auto &loop : loops.getLoops()) {
+                if (!hasPreheader(cfg, loop))
+                    continue;
+                auto &preheader = *cfg.getBlock(loop.getEntries(cfg).front());
+
+                std::unordered_set<const Value *> definedInLoop, storedAllocas;
+                bool writesThroughRefs = false;
+                for (size_t b : loop.blocks) {
+                    for (const auto &inst : cfg.getBlock(b)->getInstructions()) {
+                        definedInLoop.insert(inst);
+                        if (inst->getOpcode() == Opcode::Store)
+                            storedAllocas.insert(inst->getOperands()[1]);
+                        else if (inst->getOpcode() == Opcode::RefStore || inst->getOpcode() == Opcode::PtrStore ||
+                                 inst->getOpcode() == Opcode::Call)
+                            writesThroughRefs = true;
+                    }
+                }
+
+                auto isInvariant = [&](const Instruction &inst) {
+                    if (inst.getOpcode() == Opcode::Load) {
+                        const auto &address = inst.getOperands()[0];
+                        if (writesThroughRefs || storedAllocas.count(address) || definedInLoop.count(address))
+                            return false;
+                        auto *alloca = dynamic_cast<const Instruction *>(address);
+                        return alloca && alloca->getOpcode() == Opcode::Alloca;
+                    }
+                    if (!isSpeculatable(inst))
+                        return false;
+                    return std::none_of(inst.getOperands().begin(), inst.getOperands().end(),
+                                        [&](const auto &operand) { return definedInLoop.count(operand) > 0; });
+                };
+
+                // Reverse post-order visits definitions before their uses, so operands hoisted
+                // earlier no longer count as defined in the loop
+                std::vector<Instruction *> hoisted;
+                for (size_t b : loop.blocks) {
+                    auto &block = *cfg.getBlock(b);
+                    size_t end = ControlFlowGraph::getTerminatorIndex(block);
+                    std::unordered_set<const Instruction *> moved;
+                    for (size_t i = 0; i < end; ++i) {
+                        const auto &inst = block.getInstructions()[i];
+                        if (!isInvariant(*inst))
+                            continue;
+                        hoisted.push_back(inst);
+                        moved.insert(inst);
+                        definedInLoop.erase(inst);
+                    }
+                    if (!moved.empty()) {
+                        block.removeInstructions(
+                            [&](Instruction *inst) { return moved.count(inst) > 0; });
+                    }
+                }
+                if (hoisted.empty())
+                    continue;
+
+                size_t at = ControlFlowGraph::getTerminatorIndex(preheader);
+                for (const auto &inst : hoisted)
+                    preheader.insertInstruction(at++, inst);
+                changed = true;
+            }
+            return changed;
+        }
+    } // namespace
+
+    bool hoistLoopInvariants(Function &function, FunctionAnalyses &analyses) {
+        if (function.isExternal() || function.getBasicBlocks().empty() || hasComputedSlotPointers(function))
+            return false;
+        bool changed = insertPreheaders(function, analyses);
+        changed |= hoistInvariants(analyses);
+        return changed;
+    }
+
+    bool hoistLoopInvariants(Function &function) {
+        FunctionAnalyses analyses(function);
+        return hoistLoopInvariants(function, analyses);
+    }
+
+    bool hoistLoopInvariants(Module &module) {
+        bool changed = false;
+        for (const auto &function : module.getFunctions())
+            changed |= hoistLoopInvariants(*function);
+        return changed;
+    }
+} // namespace Ryntra::IR
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "../Module.h"
+
+namespace Ryntra::IR {
+    class FunctionAnalyses;
+
+    // Loop-invariant code motion. Every natural loop first gets a preheader: a block the loop is
+    // only entered from, inserted right before its header, with the header's phi operands from
+    // outside the loop merged there. Then, innermost loop first, instructions that can't trap
+    // and whose operands are all defined outside the loop move to the preheader, as do loads
+    // of allocas the loop never stores to (unless it also writes through a ref or pointer, or
+    // calls). Functions that do pointer arithmetic on locals are skipped (see LocalSlots.h).
+    // Returns whether anything changed.
+    bool hoistLoopInvariants(Function &function, FunctionAnalyses &analyses);
+    bool hoistLoopInvariants(Function &function);
+    bool hoistLoopInvariants(Module &module);
+} // namespace Ryntra::IR
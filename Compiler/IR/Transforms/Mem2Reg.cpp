@@ -0,0 +1,334 @@
+#include "Mem2Reg.h"
+#include "../Analysis/FunctionAnalyses.h"
+#include "../Analysis/LocalSlots.h"
+#include "../UndefValue.h"
+#include "ReplaceUses.h"
+#include <unordered_map>
+
+namespace Ryntra::IR {
+    namespace {
+        using Opcode = Instruction::Opcode;
+
+        struct PromotedAlloca {
+            Instruction *alloca = nullptr;
+            Type *type; // of its loads; null if it is never loaded
+        };
+
+        // Allocas whose every use is the address of a load or store, by position in the result
+        std::vector<PromotedAlloca> findPromotable(const Function &function) {
+            std::vector<PromotedAlloca> allocas;
+            std::unordered_map<const Value *, size_t> indices;
+            for (const auto &block : function.getBasicBlocks()) {
+                for (const auto &inst : block->getInstructions()) {
+                    if (inst->getOpcode() == Opcode::Alloca) {
+                        indices[inst] = allocas.size();
+                        allocas.push_back({inst, nullptr});
+                    }
+                }
+            }
+
+            std::vector<bool> escaped(allocas.size(), false);
+            for (const auto &block : function.getBasicBlocks()) {
+                for (const auto &inst : block->getInstructions()) {
+                    const auto &operands = inst->getOperands();
+                    for (size_t i = 0; i < operands.size(); ++i) {
+                        auto it = indices.find(operands[i]);
+                        if (it == indices.end())
+                            continue;
+                        if (inst->getOpcode() == Opcode::Load && i == 0) {
+                            if (!allocas[it->second].type)
+                                allocas[it->second].type = inst->getType();
+                        } else if (!(inst->getOpcode() == Opcode::Store && i == 1)) {
+                            escaped[it->second] = true;
+                        }
+                    }
+                }
+            }
+
+            std::vector<PromotedAlloca> promotable;
+            for (size_t i = 0; i < allocas.size(); ++i) {
+                if (!escaped[i])
+                    promotable.push_back(allocas[i]);
+            }
+            return promotable;
+        }
+
+        class Promoter {
+        public:
+            Promoter(Function &function, FunctionAnalyses &analyses, std::vector<PromotedAlloca> allocas)
+                : function_(function), cfg_(analyses.getControlFlowGraph()), domTree_(analyses.getDominatorTree()),
+                  allocas_(std::move(allocas)) {
+                for (size_t i = 0; i < allocas_.size(); ++i)
+                    allocaIndices_[allocas_[i].alloca] = i;
+            }
+
+            void run() {
+                placePhis();
+                rename();
+                simplifyPhis();
+                removeMemoryOperations();
+            }
+
+        private:
+            // Index into allocas_ of a promoted alloca operand, or npos
+            size_t allocaIndex(Value *operand) const {
+                auto it = allocaIndices_.find(operand);
+                return it != allocaIndices_.end() ? it->second : npos;
+            }
+
+            void placePhis() {
+                size_t blockCount = cfg_.size();
+                std::vector<std::vector<size_t>> defBlocks(allocas_.size());
+                std::vector<std::vector<size_t>> exposedBlocks(allocas_.size()); // loaded before any store
+                for (size_t b = 0; b < blockCount; ++b) {
+                    if (!cfg_.isReachable(b))
+                        continue;
+                    const auto &instructions = cfg_.getBlock(b)->getInstructions();
+                    size_t end = ControlFlowGraph::getTerminatorIndex(*cfg_.getBlock(b));
+                    std::vector<bool> stored(allocas_.size(), false), seen(allocas_.size(), false);
+                    for (size_t i = 0; i < end; ++i) {
+                        const auto &inst = instructions[i];
+                        if (inst->getOpcode() == Opcode::Store) {
+                            size_t a = allocaIndex(inst->getOperands()[1]);
+                            if (a != npos && !stored[a]) {
+                                stored[a] = true;
+                                defBlocks[a].push_back(b);
+                            }
+                        } else if (inst->getOpcode() == Opcode::Load) {
+                            size_t a = allocaIndex(inst->getOperands()[0]);
+                            if (a != npos && !stored[a] && !seen[a]) {
+                                seen[a] = true;
+                                exposedBlocks[a].push_back(b);
+                            }
+                        }
+                    }
+                }
+
+                phiAllocas_.resize(blockCount);
+                for (size_t a = 0; a < allocas_.size(); ++a) {
+                    if (!allocas_[a].type)
+                        continue; // never loaded: its stores are simply dropped
+
+                    // Blocks the variable is live into: walk back from each exposed load to the stores
+                    std::vector<bool> isDef(blockCount, false), liveIn(blockCount, false);
+                    for (size_t b : defBlocks[a])
+                        isDef[b] = true;
+                    std::vector<size_t> worklist = exposedBlocks[a];
+                    while (!worklist.empty()) {
+                        size_t b = worklist.back();
+                        worklist.pop_back();
+                        if (liveIn[b])
+                            continue;
+                        liveIn[b] = true;
+                        for (size_t pred : cfg_.getPredecessors(b)) {
+                            if (!isDef[pred] && cfg_.isReachable(pred))
+                                worklist.push_back(pred);
+                        }
+                    }
+
+                    // Iterated dominance frontier of the defining blocks, pruned to where it is live
+                    std::vector<bool> hasPhi(blockCount, false);
+                    worklist = defBlocks[a];
+                    while (!worklist.empty()) {
+                        size_t b = worklist.back();
+                        worklist.pop_back();
+                        for (size_t frontier : domTree_.getFrontier(b)) {
+                            if (hasPhi[frontier] || !liveIn[frontier])
+                                continue;
+                            hasPhi[frontier] = true;
+                            auto phi = function_.getParent()->create<Instruction>(
+                                Opcode::Phi, allocas_[a].type, std::vector<Value *>{},
+                                allocas_[a].alloca->getName() + ".phi" + std::to_string(phiCounter_++));
+                            auto &block = *cfg_.getBlock(frontier);
+                            if (!block.getInstructions().empty())
+                                phi->setLocation(block.getInstructions().front()->getLocation());
+                            block.insertInstruction(phiAllocas_[frontier].size(), phi);
+                            phiAllocas_[frontier].push_back(a);
+                            phiOwners_[phi] = a;
+                            if (!isDef[frontier]) {
+                                isDef[frontier] = true;
+                                worklist.push_back(frontier);
+                            }
+                        }
+                    }
+                }
+            }
+
+            // Walks the CFG from the entry carrying each variable's current value, filling in phi
+            // operands on every edge and recording what each load reads
+            void rename() {
+                struct Item {
+                    size_t block;
+                    size_t pred; // ControlFlowGraph::None for the entry
+                    std::vector<Value *> values;
+                };
+
+                std::vector<Value *> initial(allocas_.size());
+                for (size_t a = 0; a < allocas_.size(); ++a)
+                    initial[a] = undefOf(a);
+
+                std::vector<bool> visited(cfg_.size(), false);
+                std::vector<Item> worklist;
+                if (cfg_.size() > 0)
+                    worklist.push_back({0, ControlFlowGraph::None, std::move(initial)});
+
+                while (!worklist.empty()) {
+                    Item item = std::move(worklist.back());
+                    worklist.pop_back();
+                    auto &block = *cfg_.getBlock(item.block);
+                    const auto &instructions = block.getInstructions();
+                    size_t phiCount = phiAllocas_[item.block].size();
+
+                    if (item.pred != ControlFlowGraph::None) {
+                        const auto &predName = cfg_.getBlock(item.pred)->getName();
+                        for (size_t i = 0; i < phiCount; ++i)
+                            instructions[i]->addIncoming(item.values[phiAllocas_[item.block][i]],
+                                                         function_.getParent()->createLabel(predName));
+                    }
+                    if (visited[item.block])
+                        continue;
+                    visited[item.block] = true;
+
+                    for (size_t i = 0; i < phiCount; ++i)
+                        item.values[phiAllocas_[item.block][i]] = instructions[i];
+
+                    size_t end = ControlFlowGraph::getTerminatorIndex(block);
+                    for (size_t i = phiCount; i < end; ++i) {
+                        const auto &inst = instructions[i];
+                        if (inst->getOpcode() == Opcode::Load) {
+                            size_t a = allocaIndex(inst->getOperands()[0]);
+                            if (a != npos)
+                                replacements_[inst] = item.values[a];
+                        } else if (inst->getOpcode() == Opcode::Store) {
+                            size_t a = allocaIndex(inst->getOperands()[1]);
+                            if (a != npos)
+                                item.values[a] = inst->getOperands()[0];
+                        }
+                    }
+
+                    const auto &successors = cfg_.getSuccessors(item.block);
+                    for (size_t s = 0; s < successors.size(); ++s) {
+                        if (s + 1 == successors.size())
+                            worklist.push_back({successors[s], item.block, std::move(item.values)});
+                        else
+                            worklist.push_back({successors[s], item.block, item.values});
+                    }
+                }
+            }
+
+            // Replaces phis that merge a single value (besides themselves and undef) by that value
+            void simplifyPhis() {
+                bool changed = true;
+                while (changed) {
+                    changed = false;
+                    for (size_t b = 0; b < cfg_.size(); ++b) {
+                        const auto &instructions = cfg_.getBlock(b)->getInstructions();
+                        for (size_t i = 0; i < phiAllocas_[b].size(); ++i) {
+                            const auto &phi = instructions[i];
+                            if (replacements_.count(phi))
+                                continue;
+                            Value *unique = nullptr;
+                            bool trivial = true;
+                            for (size_t in = 0; in < phi->getIncomingCount(); ++in) {
+                                auto value = resolve(phi->getIncomingValue(in));
+                                if (value == phi || dynamic_cast<UndefValue *>(value))
+                                    continue;
+                                if (unique && unique != value) {
+                                    trivial = false;
+                                    break;
+                                }
+                                unique = value;
+                            }
+                            if (trivial) {
+                                replacements_[phi] = unique ? unique : undefOf(phiOwners_.at(phi));
+                                changed = true;
+                            }
+                        }
+                    }
+                }
+            }
+
+            Value *resolve(Value *value) const {
+                for (auto it = replacements_.find(value); it != replacements_.end();
+                     it = replacements_.find(value))
+                    value = it->second;
+                return value;
+            }
+
+            // Drops the promoted allocas with their loads, stores and the phis that became trivial.
+            // Loads the renaming never reached (unreachable code) read undef.
+            void removeMemoryOperations() {
+                for (const auto &block : function_.getBasicBlocks()) {
+                    for (const auto &inst : block->getInstructions()) {
+                        if (inst->getOpcode() != Opcode::Load || replacements_.count(inst))
+                            continue;
+                        size_t a = allocaIndex(inst->getOperands()[0]);
+                        if (a != npos)
+                            replacements_[inst] = undefOf(a);
+                    }
+                }
+                replaceAllUses(replacements_);
+
+                for (const auto &block : function_.getBasicBlocks()) {
+                    block->eraseInstructions([&](Instruction *inst) {
+                        switch (inst->getOpcode()) {
+                        case Opcode::Alloca:
+                            return allocaIndex(inst) != npos;
+                        case Opcode::Load:
+                            return allocaIndex(inst->getOperands()[0]) != npos;
+                        case Opcode::Store:
+                            return allocaIndex(inst->getOperands()[1]) != npos;
+                        case Opcode::Phi:
+                            return replacements_.count(inst) > 0;
+                        default:
+                            return false;
+                        }
+                    });
+                }
+            }
+
+            Value *undefOf(size_t a) {
+                auto type = allocas_[a].type ? allocas_[a].type : Type::getVoidType();
+                return function_.getParent()->create<UndefValue>(type);
+            }
+
+            static constexpr size_t npos = static_cast<size_t>(-1);
+
+            Function &function_;
+            const ControlFlowGraph &cfg_;
+            const DominatorTree &domTree_;
+            std::vector<PromotedAlloca> allocas_;
+            std::unordered_map<const Value *, size_t> allocaIndices_;
+
+            std::vector<std::vector<size_t>> phiAllocas_; // per block: the alloca of each leading phi
+            std::unordered_map<const Value *, size_t> phiOwners_;
+            size_t phiCounter_ = 0;
+
+            // Value each removed load or trivial phi stands for
+            ReplacementMap replacements_;
+        };
+    } // namespace
+
+    bool promoteAllocas(Function &function, FunctionAnalyses &analyses) {
+        // A pointer built from a computed slot can reach any local
+        if (function.isExternal() || function.getBasicBlocks().empty() || hasComputedSlotPointers(function))
+            return false;
+        auto allocas = findPromotable(function);
+        if (allocas.empty())
+            return false;
+        Promoter(function, analyses, std::move(allocas)).run();
+        return true;
+    }
+
+    bool promoteAllocas(Function &function) {
+        FunctionAnalyses analyses(function);
+        return promoteAllocas(function, analyses);
+    }
+
+    bool promoteAllocas(Module &module) {
+        bool changed = false;
+        for (const auto &function : module.getFunctions())
+            changed |= promoteAllocas(*function);
+        return changed;
+    }
+} // namespace Ryntra::IR
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "../Module.h"
+
+namespace Ryntra::IR {
+    class FunctionAnalyses;
+
+    // Promotes allocas that are only ever loaded and stored to SSA values, inserting phi
+    // instructions at the iterated dominance frontier of their stores where the variable is
+    // live. Allocas used by ref.create / ptr.create stay in memory, and a function that builds
+    // a pointer from a computed slot (pointer arithmetic) is left alone entirely, since such a
+    // pointer may reach any of its locals. Returns whether anything was promoted.
+    bool promoteAllocas(Function &function, FunctionAnalyses &analyses);
+    bool promoteAllocas(Function &function);
+    bool promoteAllocas(Module &module);
+} // namespace Ryntra::IR
@@ -0,0 +1,23 @@
+#include "ReplaceUses.h"
+
+namespace Ryntra::IR {
+    void replaceAllUses(const ReplacementMap &replacements) {
+        auto resolve = [&](Value *value) {
+            for (auto it = replacements.find(value); it != replacements.end(); it = replacements.find(value))
+                value = it->second;
+            return value;
+        };
+        for (const auto &[value, replacement] : replacements)
+            value->replaceAllUsesWith(resolve(replacement));
+    }
+
+    void removeReplaced(Function &function, const ReplacementMap &replacements) {
+        if (replacements.empty())
+            return;
+        for (const auto &block : function.getBasicBlocks()) {
+            block->eraseInstructions([&](Instruction *inst) {
+                return replacements.count(inst) > 0;
+            });
+        }
+    }
+} // namespace Ryntra::IR
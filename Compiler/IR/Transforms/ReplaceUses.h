@@ -0,0 +1,16 @@
+#pragma once
+
+#include "../Function.h"
+#include <memory>
+#include <unordered_map>
+
+namespace Ryntra::IR {
+    // Value each replaced instruction stands for; a replacement may itself be replaced
+    using ReplacementMap = std::unordered_map<Value *, Value *>;
+
+    // Points every use of a value that has an entry in replacements at its final replacement
+    void replaceAllUses(const ReplacementMap &replacements);
+
+    // Erases the instructions that have an entry in replacements from their blocks
+    void removeReplaced(Function &function, const ReplacementMap &replacements);
+} // namespace Ryntra::IR
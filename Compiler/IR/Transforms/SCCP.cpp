@@ -0,0 +1,300 @@
+#include "SCCP.h"
+#include "../Analysis/FunctionAnalyses.h"
+#include "ConstantFolding.h"
+#include "ReplaceUses.h"
+#include <algorithm>
+#include <set>
+#include <unordered_map>
+#include <utility>
+
+namespace Ryntra::IR {
+    namespace {
+        using Opcode = Instruction::Opcode;
+
+        bool isFoldable(Opcode opcode) {
+            switch (opcode) {
+            case Opcode::Constant:
+            case Opcode::Add:
+            case Opcode::Sub:
+            case Opcode::Mul:
+            case Opcode::Div:
+            case Opcode::Mod:
+            case Opcode::BitNot:
+            case Opcode::LogicalNot:
+            case Opcode::BitAnd:
+            case Opcode::BitOr:
+            case Opcode::BitXor:
+            case Opcode::Shl:
+            case Opcode::Shr:
+            case Opcode::SExt:
+            case Opcode::Trunc:
+            case Opcode::Eq:
+            case Opcode::Ne:
+            case Opcode::Lt:
+            case Opcode::Gt:
+            case Opcode::Le:
+            case Opcode::Ge:
+                return true;
+            default:
+                return false;
+            }
+        }
+
+        // Unknown: no executable definition seen yet; Overdefined: not a compile-time constant
+        struct LatticeValue {
+            enum class State { Unknown, Constant, Overdefined };
+
+            State state = State::Unknown;
+            ConstantInt constant;
+
+            bool isUnknown() const { return state == State::Unknown; }
+            bool isConstant() const { return state == State::Constant; }
+            bool isOverdefined() const { return state == State::Overdefined; }
+
+            bool operator==(const LatticeValue &) const = default;
+
+            static LatticeValue overdefined() { return {State::Overdefined, {}}; }
+            static LatticeValue of(const ConstantInt &constant) { return {State::Constant, constant}; }
+
+            void meet(const LatticeValue &other) {
+                if (isOverdefined() || other.isUnknown())
+                    return;
+                if (isUnknown())
+                    *this = other;
+                else if (other.isOverdefined() || other.constant != constant)
+                    *this = overdefined();
+            }
+        };
+
+        class Solver {
+        public:
+            Solver(Function &function, const ControlFlowGraph &cfg)
+                : function_(function), cfg_(cfg), executableBlocks_(cfg_.size(), false) {
+                for (size_t b = 0; b < cfg_.size(); ++b) {
+                    const auto &instructions = cfg_.getBlock(b)->getInstructions();
+                    size_t end = std::min(ControlFlowGraph::getTerminatorIndex(*cfg_.getBlock(b)) + 1,
+                                          instructions.size());
+                    for (size_t i = 0; i < end; ++i)
+                        blockOf_[instructions[i]] = b;
+                }
+            }
+
+            bool run() {
+                solve();
+                return rewrite();
+            }
+
+        private:
+            void solve() {
+                if (cfg_.size() == 0)
+                    return;
+                executableBlocks_[0] = true;
+                blockWorklist_.push_back(0);
+
+                while (!blockWorklist_.empty() || !instWorklist_.empty()) {
+                    while (!blockWorklist_.empty()) {
+                        size_t b = blockWorklist_.back();
+                        blockWorklist_.pop_back();
+                        visitBlock(b);
+                    }
+                    while (!instWorklist_.empty()) {
+                        Instruction *inst = instWorklist_.back();
+                        instWorklist_.pop_back();
+                        if (executableBlocks_[blockOf_.at(inst)])
+                            visit(*inst);
+                    }
+                }
+            }
+
+            void visitBlock(size_t b) {
+                const auto &block = *cfg_.getBlock(b);
+                size_t end = ControlFlowGraph::getTerminatorIndex(block);
+                const auto &instructions = block.getInstructions();
+                for (size_t i = 0; i < end; ++i)
+                    visit(*instructions[i]);
+                if (end < instructions.size())
+                    visit(*instructions[end]);
+                else if (b + 1 < cfg_.size())
+                    markEdge(b, b + 1); // fallthrough
+            }
+
+            void visit(Instruction &inst) {
+                size_t b = blockOf_.at(&inst);
+                const auto &operands = inst.getOperands();
+                switch (inst.getOpcode()) {
+                case Opcode::Br:
+                    markEdge(b, targetOf(*operands[0]));
+                    return;
+                case Opcode::CondBr: {
+                    auto condition = valueOf(*operands[0]);
+                    if (condition.isConstant()) {
+                        markEdge(b, targetOf(*operands[condition.constant.value != 0 ? 1 : 2]));
+                    } else if (condition.isOverdefined()) {
+                        markEdge(b, targetOf(*operands[1]));
+                        markEdge(b, targetOf(*operands[2]));
+                    }
+                    return;
+                }
+                case Opcode::Return:
+                    return;
+                case Opcode::Phi: {
+                    LatticeValue result;
+                    for (size_t i = 0; i < inst.getIncomingCount(); ++i) {
+                        size_t pred = cfg_.getIndex(inst.getIncomingBlock(i));
+                        if (pred != ControlFlowGraph::None && executableEdges_.count({pred, b}))
+                            result.meet(valueOf(*inst.getIncomingValue(i)));
+                    }
+                    update(inst, result);
+                    return;
+                }
+                default:
+                    break;
+                }
+
+                if (!isFoldable(inst.getOpcode())) {
+                    update(inst, LatticeValue::overdefined());
+                    return;
+                }
+
+                std::vector<ConstantInt> constants;
+                for (const auto &operand : operands) {
+                    auto value = valueOf(*operand);
+                    if (value.isOverdefined()) {
+                        update(inst, value);
+                        return;
+                    }
+                    if (value.isUnknown())
+                        return;
+                    constants.push_back(value.constant);
+                }
+                auto folded = foldInstruction(inst.getOpcode(), constants);
+                update(inst, folded ? LatticeValue::of(*folded) : LatticeValue::overdefined());
+            }
+
+            LatticeValue valueOf(const Value &value) const {
+                if (auto *inst = dynamic_cast<const Instruction *>(&value)) {
+                    auto it = values_.find(inst);
+                    return it != values_.end() ? it->second : LatticeValue{};
+                }
+                if (auto constant = getConstantInt(value))
+                    return LatticeValue::of(*constant);
+                return LatticeValue::overdefined(); // undef, strings, globals
+            }
+
+            void update(Instruction &inst, const LatticeValue &value) {
+                auto &current = values_[&inst];
+                if (current == value || current.isOverdefined())
+                    return;
+                current = value;
+                for (Instruction *user : inst.getUsers()) {
+                    if (blockOf_.count(user))
+                        instWorklist_.push_back(user);
+                }
+            }
+
+            size_t targetOf(const Value &label) const {
+                return cfg_.getIndex(static_cast<const ImmediateValue &>(label).getLiteralValue());
+            }
+
+            void markEdge(size_t from, size_t to) {
+                if (to == ControlFlowGraph::None || !executableEdges_.insert({from, to}).second)
+                    return;
+                if (!executableBlocks_[to]) {
+                    executableBlocks_[to] = true;
+                    blockWorklist_.push_back(to);
+                    return;
+                }
+                // Already visited: only its phis see the new edge
+                for (const auto &inst : cfg_.getBlock(to)->getInstructions()) {
+                    if (inst->getOpcode() != Opcode::Phi)
+                        break;
+                    instWorklist_.push_back(inst);
+                }
+            }
+
+            bool rewrite() {
+                ReplacementMap replacements;
+                for (size_t b = 0; b < cfg_.size(); ++b) {
+                    for (const auto &inst : cfg_.getBlock(b)->getInstructions()) {
+                        auto it = values_.find(inst);
+                        if (it != values_.end() && it->second.isConstant())
+                            replacements[inst] = makeImmediate(*function_.getParent(), it->second.constant, inst->getType());
+                    }
+                }
+                replaceAllUses(replacements);
+                removeReplaced(function_, replacements);
+                bool changed = !replacements.empty();
+
+                for (size_t b = 0; b < cfg_.size(); ++b) {
+                    if (executableBlocks_[b])
+                        changed |= foldBranch(*cfg_.getBlock(b));
+                }
+                return changed;
+            }
+
+            // Replaces the block's condbr on a constant by a br to the edge it always takes
+            bool foldBranch(BasicBlock &block) {
+                const auto &instructions = block.getInstructions();
+                size_t end = ControlFlowGraph::getTerminatorIndex(block);
+                if (end == instructions.size() || instructions[end]->getOpcode() != Opcode::CondBr)
+                    return false;
+                auto condBr = instructions[end];
+                auto condition = getConstantInt(*condBr->getOperands()[0]);
+                if (!condition)
+                    return false;
+
+                auto *taken = condBr->getOperands()[condition->value != 0 ? 1 : 2];
+                auto *notTaken = condBr->getOperands()[condition->value != 0 ? 2 : 1];
+                auto br = function_.getParent()->create<Instruction>(Opcode::Br, Type::getVoidType(),
+                                                                     std::vector<Value *>{taken});
+                br->setLocation(condBr->getLocation());
+                block.insertInstruction(end, br);
+                condBr->eraseFromParent();
+
+                size_t dropped = targetOf(*notTaken);
+                if (dropped == ControlFlowGraph::None || dropped == targetOf(*taken))
+                    return true;
+                for (const auto &inst : cfg_.getBlock(dropped)->getInstructions()) {
+                    if (inst->getOpcode() != Opcode::Phi)
+                        break;
+                    for (size_t i = 0; i < inst->getIncomingCount(); ++i) {
+                        if (inst->getIncomingBlock(i) == block.getName()) {
+                            inst->removeIncoming(i);
+                            break;
+                        }
+                    }
+                }
+                return true;
+            }
+
+            Function &function_;
+            const ControlFlowGraph &cfg_;
+
+            std::unordered_map<const Instruction *, size_t> blockOf_; // up to each block's terminator
+            std::unordered_map<const Instruction *, LatticeValue> values_;
+
+            std::vector<bool> executableBlocks_;
+            std::set<std::pair<size_t, size_t>> executableEdges_;
+            std::vector<size_t> blockWorklist_;
+            std::vector<Instruction *> instWorklist_;
+        };
+    } // namespace
+
+    bool propagateConstants(Function &function, FunctionAnalyses &analyses) {
+        if (function.isExternal() || function.getBasicBlocks().empty())
+            return false;
+        return Solver(function, analyses.getControlFlowGraph()).run();
+    }
+
+    bool propagateConstants(Function &function) {
+        FunctionAnalyses analyses(function);
+        return propagateConstants(function, analyses);
+    }
+
+    bool propagateConstants(Module &module) {
+        bool changed = false;
+        for (const auto &function : module.getFunctions())
+            changed |= propagateConstants(*function);
+        return changed;
+    }
+} // namespace Ryntra::IR
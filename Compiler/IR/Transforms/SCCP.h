@@ -0,0 +1,17 @@
+#pragma once
+
+#include "../Module.h"
+
+namespace Ryntra::IR {
+    class FunctionAnalyses;
+
+    // Sparse conditional constant propagation: finds the values that are constant on every path
+    // control can actually take (following a condbr only along the edge its known condition
+    // selects), replaces them by immediates and turns condbrs on a constant into brs, dropping
+    // the phi operands of the edge that is never taken. Folding follows the VM exactly (see
+    // ConstantFolding.h). Blocks that become unreachable are left in place. Returns whether
+    // anything changed.
+    bool propagateConstants(Function &function, FunctionAnalyses &analyses);
+    bool propagateConstants(Function &function);
+    bool propagateConstants(Module &module);
+} // namespace Ryntra::IR
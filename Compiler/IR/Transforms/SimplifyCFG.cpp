@@ -0,0 +1,198 @@
+#include "SimplifyCFG.h"
+#include "../Analysis/ControlFlowGraph.h"
+#include "../Analysis/LocalSlots.h"
+#include "ReplaceUses.h"
+#include <algorithm>
+#include <unordered_set>
+
+namespace Ryntra::IR {
+    namespace {
+        using Opcode = Instruction::Opcode;
+
+        Instruction *makeBr(Module &module, const std::string &target) {
+            return module.create<Instruction>(Opcode::Br, Type::getVoidType(),
+                                              std::vector<Value *>{module.createLabel(target)});
+        }
+
+        Instruction *getTerminator(const BasicBlock &block) {
+            size_t end = ControlFlowGraph::getTerminatorIndex(block);
+            return end == block.getInstructions().size() ? nullptr : block.getInstructions()[end];
+        }
+
+        bool hasPhis(const BasicBlock &block) {
+            const auto &instructions = block.getInstructions();
+            return !instructions.empty() && instructions.front()->getOpcode() == Opcode::Phi;
+        }
+
+        void retarget(Module &module, Instruction &terminator, const std::string &from, const std::string &to) {
+            const auto &operands = terminator.getOperands();
+            size_t firstLabel = terminator.getOpcode() == Opcode::CondBr ? 1 : 0;
+            for (size_t i = firstLabel; i < operands.size(); ++i) {
+                if (static_cast<const ImmediateValue &>(*operands[i]).getLiteralValue() == from)
+                    terminator.setOperand(i, module.createLabel(to));
+            }
+        }
+
+        void renameIncoming(Module &module, const BasicBlock &block, const std::string &from, const std::string &to) {
+            for (const auto &inst : block.getInstructions()) {
+                if (inst->getOpcode() != Opcode::Phi)
+                    break;
+                for (size_t i = 0; i < inst->getIncomingCount(); ++i) {
+                    if (inst->getIncomingBlock(i) == from)
+                        inst->setIncomingBlock(i, module.createLabel(to));
+                }
+            }
+        }
+
+        void removeBlock(Function &function, const BasicBlock *block) {
+            function.removeBasicBlocks([&](BasicBlock *candidate) {
+                return candidate == block;
+            });
+        }
+
+        bool makeFallthroughsExplicit(Function &function) {
+            const auto &blocks = function.getBasicBlocks();
+            bool changed = false;
+            for (size_t b = 0; b + 1 < blocks.size(); ++b) {
+                if (!getTerminator(*blocks[b])) {
+                    blocks[b]->addInstruction(makeBr(*function.getParent(), blocks[b + 1]->getName()));
+                    changed = true;
+                }
+            }
+            return changed;
+        }
+
+        // condbr c, X, X is br X. Left alone when X has phis, which hold an operand per edge.
+        bool foldSameTargetBranches(Function &function) {
+            bool changed = false;
+            for (const auto &block : function.getBasicBlocks()) {
+                auto *terminator = getTerminator(*block);
+                if (!terminator || terminator->getOpcode() != Opcode::CondBr)
+                    continue;
+                const auto &operands = terminator->getOperands();
+                const auto &target = static_cast<const ImmediateValue &>(*operands[1]).getLiteralValue();
+                if (target != static_cast<const ImmediateValue &>(*operands[2]).getLiteralValue())
+                    continue;
+                auto targetBlock = std::find_if(function.getBasicBlocks().begin(), function.getBasicBlocks().end(),
+                                                 [&](const auto &candidate) { return candidate->getName() == target; });
+                if (targetBlock == function.getBasicBlocks().end() || hasPhis(**targetBlock))
+                    continue;
+                auto br = makeBr(*function.getParent(), target);
+                br->setLocation(terminator->getLocation());
+                terminator->eraseFromParent();
+                block->addInstruction(br);
+                changed = true;
+            }
+            return changed;
+        }
+
+        // Appends the block at index to its only predecessor when that only branches to it
+        bool mergeIntoPredecessor(Function &function, const ControlFlowGraph &cfg, size_t index) {
+            const auto &predecessors = cfg.getPredecessors(index);
+            if (predecessors.size() != 1 || predecessors[0] == index || cfg.getSuccessors(predecessors[0]).size() != 1)
+                return false;
+            const auto &block = cfg.getBlock(index);
+            const auto &predecessor = cfg.getBlock(predecessors[0]);
+            // Without a terminator the block is the last one and returns by falling off the end
+            if (!getTerminator(*block))
+                return false;
+
+            // With one predecessor a phi is a copy of its only operand
+            ReplacementMap replacements;
+            for (const auto &inst : block->getInstructions()) {
+                if (inst->getOpcode() != Opcode::Phi)
+                    break;
+                replacements[inst] = inst->getIncomingValue(0);
+            }
+            replaceAllUses(replacements);
+            removeReplaced(function, replacements);
+
+            size_t end = ControlFlowGraph::getTerminatorIndex(*predecessor);
+            std::unordered_set<const Instruction *> dropped;
+            for (size_t i = end; i < predecessor->getInstructions().size(); ++i)
+                dropped.insert(predecessor->getInstructions()[i]);
+            predecessor->eraseInstructions([&](Instruction *inst) {
+                return dropped.count(inst) > 0;
+            });
+            for (const auto &inst : block->getInstructions())
+                predecessor->addInstruction(inst);
+
+            for (size_t successor : cfg.getSuccessors(index))
+                renameIncoming(*function.getParent(), *cfg.getBlock(successor), block->getName(), predecessor->getName());
+            removeBlock(function, block);
+            return true;
+        }
+
+        // Sends the predecessors of a block holding only a br straight to its target
+        bool bypassForwardingBlock(Function &function, const ControlFlowGraph &cfg, size_t index) {
+            const auto &block = cfg.getBlock(index);
+            const auto &instructions = block->getInstructions();
+            if (instructions.empty() || instructions[0]->getOpcode() != Opcode::Br)
+                return false;
+            const auto &targetName = static_cast<const ImmediateValue &>(*instructions[0]->getOperands()[0]).getLiteralValue();
+            size_t target = cfg.getIndex(targetName);
+            const auto &predecessors = cfg.getPredecessors(index);
+            if (target == ControlFlowGraph::None || target == index || predecessors.empty())
+                return false;
+
+            const auto &targetBlock = cfg.getBlock(target);
+            if (hasPhis(*targetBlock)) {
+                // One operand per edge: a predecessor can't reach the target twice
+                std::unordered_set<size_t> seen;
+                for (size_t predecessor : predecessors) {
+                    if (!seen.insert(predecessor).second)
+                        return false;
+                    const auto &targetPredecessors = cfg.getPredecessors(target);
+                    if (std::find(targetPredecessors.begin(), targetPredecessors.end(), predecessor) !=
+                        targetPredecessors.end())
+                        return false;
+                }
+                for (const auto &phi : targetBlock->getInstructions()) {
+                    if (phi->getOpcode() != Opcode::Phi)
+                        break;
+                    for (size_t i = 0; i < phi->getIncomingCount(); ++i) {
+                        if (phi->getIncomingBlock(i) != block->getName())
+                            continue;
+                        auto value = phi->getIncomingValue(i);
+                        phi->removeIncoming(i);
+                        for (size_t predecessor : predecessors)
+                            phi->addIncoming(value, function.getParent()->createLabel(cfg.getBlock(predecessor)->getName()));
+                        break;
+                    }
+                }
+            }
+
+            for (size_t predecessor : predecessors) {
+                if (auto *terminator = getTerminator(*cfg.getBlock(predecessor)))
+                    retarget(*function.getParent(), *terminator, block->getName(), targetName);
+            }
+            removeBlock(function, block);
+            return true;
+        }
+    } // namespace
+
+    bool simplifyControlFlow(Function &function) {
+        if (function.isExternal() || function.getBasicBlocks().empty() || hasComputedSlotPointers(function))
+            return false;
+        bool changed = makeFallthroughsExplicit(function);
+        changed |= foldSameTargetBranches(function);
+
+        // Every change invalidates the graph, so rebuild it and look again
+        bool progress = true;
+        while (progress) {
+            progress = false;
+            ControlFlowGraph cfg(function);
+            for (size_t b = 1; b < cfg.size() && !progress; ++b)
+                progress = mergeIntoPredecessor(function, cfg, b) || bypassForwardingBlock(function, cfg, b);
+            changed |= progress;
+        }
+        return changed;
+    }
+
+    bool simplifyControlFlow(Module &module) {
+        bool changed = false;
+        for (const auto &function : module.getFunctions())
+            changed |= simplifyControlFlow(*function);
+        return changed;
+    }
+} // namespace Ryntra::IR
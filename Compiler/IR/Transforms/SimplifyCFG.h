@@ -0,0 +1,16 @@
+#pragma once
+
+#include "../Module.h"
+
+namespace Ryntra::IR {
+    // Control flow cleanup. A block falling through to the next one gets an explicit br, so
+    // blocks can then be laid out in any order (the last block, which returns by falling off
+    // the end, keeps its place). A condbr whose targets are the same block becomes a br, a
+    // block is merged into its predecessor when each is the other's only neighbour, and a block
+    // holding nothing but a br is bypassed: its predecessors jump straight to its target. Phis
+    // of the target take one operand per bypassing predecessor, so a block is kept when one of
+    // its predecessors already reaches the target. Functions that do pointer arithmetic on
+    // locals are skipped (see LocalSlots.h). Returns whether anything changed.
+    bool simplifyControlFlow(Function &function);
+    bool simplifyControlFlow(Module &module);
+} // namespace Ryntra::IR
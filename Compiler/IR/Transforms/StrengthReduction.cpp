@@ -0,0 +1,388 @@
+#include "StrengthReduction.h"
+#include "../Analysis/FunctionAnalyses.h"
+#include "../Analysis/LocalSlots.h"
+#include "ConstantFolding.h"
+#include "ReplaceUses.h"
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <unordered_set>
+
+namespace Ryntra::IR {
+    namespace {
+        using Opcode = Instruction::Opcode;
+
+        int64_t maxOf(bool isLong) {
+            return isLong ? std::numeric_limits<int64_t>::max() : std::numeric_limits<int32_t>::max();
+        }
+        int64_t minOf(bool isLong) {
+            return isLong ? std::numeric_limits<int64_t>::min() : std::numeric_limits<int32_t>::min();
+        }
+
+        // a * b, or nullopt if it doesn't fit an int (or a long)
+        std::optional<int64_t> multiplyExact(int64_t a, int64_t b, bool isLong) {
+            if (a == 0 || b == 0)
+                return 0;
+            if ((a == -1 && b == minOf(isLong)) || (b == -1 && a == minOf(isLong)))
+                return std::nullopt;
+            auto product = static_cast<int64_t>(static_cast<uint64_t>(a) * static_cast<uint64_t>(b));
+            if (product / b != a || product < minOf(isLong) || product > maxOf(isLong))
+                return std::nullopt;
+            return product;
+        }
+
+        std::optional<int64_t> addExact(int64_t a, int64_t b, bool isLong) {
+            if ((b > 0 && a > maxOf(isLong) - b) || (b < 0 && a < minOf(isLong) - b))
+                return std::nullopt;
+            return a + b;
+        }
+
+        std::optional<ConstantInt> constantOfKind(const Value &value, bool isLong) {
+            auto constant = getConstantInt(value);
+            if (!constant || constant->isLong != isLong)
+                return std::nullopt;
+            return constant;
+        }
+
+        Instruction *makeBinary(Module &module, Opcode opcode, Type *type, Value *lhs, Value *rhs,
+                                const std::string &name) {
+            return module.create<Instruction>(opcode, type, std::vector<Value *>{lhs, rhs}, name);
+        }
+
+        // A header phi that starts at a constant and moves by a constant step on the latch edge
+        struct InductionVariable {
+            Instruction *phi = nullptr;
+            Instruction *next = nullptr; // phi + step, the latch edge's operand
+            bool isLong = false;
+            int64_t start = 0;
+            int64_t step = 0;
+
+            // The header's `phi < bound` / `phi <= bound` test when the loop is left as soon as it
+            // fails; the phi then stays within [start, max] without wrapping
+            Instruction *test = nullptr;
+            int64_t bound = 0;
+            int64_t max = 0;
+        };
+
+        class Reducer {
+        public:
+            Reducer(Function &function, FunctionAnalyses &analyses)
+                : function_(function), module_(*function.getParent()), analyses_(analyses) {}
+
+            bool run() {
+                bool changed = reduceInductionVariables();
+                changed |= reduceOperators();
+                return changed;
+            }
+
+        private:
+            // Adds and replaces instructions only, so the analyses stay valid
+            bool reduceInductionVariables() {
+                const auto &cfg = analyses_.getControlFlowGraph();
+                const auto &loops = analyses_.getLoopInfo();
+
+                bool changed = false;
+                for (const auto &loop : loops.getLoops()) {
+                    auto entries = loop.getEntries(cfg);
+                    if (entries.size() != 1 || cfg.getSuccessors(entries[0]).size() != 1 || loop.latches.size() != 1)
+                        continue;
+                    const auto &preheaderName = cfg.getBlock(entries[0])->getName();
+                    const auto &latch = *cfg.getBlock(loop.latches[0]);
+
+                    for (auto &iv : findInductionVariables(cfg, loop, preheaderName, latch.getName())) {
+                        if (iv.test && iv.start >= 0) {
+                            nonNegative_.insert(iv.phi);
+                            nonNegative_.insert(iv.next);
+                        }
+                        changed |= replaceInductionVariable(cfg, loop, iv, preheaderName, latch.getName());
+                    }
+                }
+                return changed;
+            }
+
+            std::vector<InductionVariable> findInductionVariables(const ControlFlowGraph &cfg, const Loop &loop,
+                                                                  const std::string &preheaderName,
+                                                                  const std::string &latchName) const {
+                std::vector<InductionVariable> ivs;
+                auto &header = *cfg.getBlock(loop.header);
+                for (const auto &phi : header.getInstructions()) {
+                    if (phi->getOpcode() != Opcode::Phi)
+                        break;
+                    if (phi->getIncomingCount() != 2 || (!phi->getType()->isInt32() && !phi->getType()->isInt64()))
+                        continue;
+
+                    InductionVariable iv;
+                    iv.phi = phi;
+                    iv.isLong = phi->getType()->isInt64();
+                    size_t fromPreheader = phi->getIncomingBlock(0) == preheaderName ? 0 : 1;
+                    if (phi->getIncomingBlock(fromPreheader) != preheaderName || phi->getIncomingBlock(1 - fromPreheader) != latchName)
+                        continue;
+                    auto start = constantOfKind(*phi->getIncomingValue(fromPreheader), iv.isLong);
+                    iv.next = dynamic_cast<Instruction *>(phi->getIncomingValue(1 - fromPreheader));
+                    if (!start || !iv.next)
+                        continue;
+                    iv.start = start->value;
+
+                    const auto &operands = iv.next->getOperands();
+                    if (iv.next->getOpcode() == Opcode::Add && operands[0] == phi) {
+                        auto step = constantOfKind(*operands[1], iv.isLong);
+                        iv.step = step ? step->value : 0;
+                    } else if (iv.next->getOpcode() == Opcode::Add && operands[1] == phi) {
+                        auto step = constantOfKind(*operands[0], iv.isLong);
+                        iv.step = step ? step->value : 0;
+                    } else if (iv.next->getOpcode() == Opcode::Sub && operands[0] == phi) {
+                        auto step = constantOfKind(*operands[1], iv.isLong);
+                        iv.step = step && step->value != minOf(iv.isLong) ? -step->value : 0;
+                    }
+                    if (iv.step == 0)
+                        continue;
+                    findExitTest(cfg, loop, iv);
+                    ivs.push_back(std::move(iv));
+                }
+                return ivs;
+            }
+
+            void findExitTest(const ControlFlowGraph &cfg, const Loop &loop, InductionVariable &iv) const {
+                const auto &header = *cfg.getBlock(loop.header);
+                size_t end = ControlFlowGraph::getTerminatorIndex(header);
+                if (iv.step < 0 || end == header.getInstructions().size())
+                    return;
+                const auto &condBr = header.getInstructions()[end];
+                if (condBr->getOpcode() != Opcode::CondBr)
+                    return;
+                auto test = dynamic_cast<Instruction *>(condBr->getOperands()[0]);
+                if (!test || (test->getOpcode() != Opcode::Lt && test->getOpcode() != Opcode::Le) ||
+                    test->getOperands()[0] != iv.phi)
+                    return;
+                auto bound = constantOfKind(*test->getOperands()[1], iv.isLong);
+                auto labelOf = [&](size_t i) {
+                    return cfg.getIndex(static_cast<const ImmediateValue &>(*condBr->getOperands()[i]).getLiteralValue());
+                };
+                size_t stays = labelOf(1), leaves = labelOf(2);
+                if (!bound || stays == ControlFlowGraph::None || leaves == ControlFlowGraph::None ||
+                    !loop.contains[stays] || loop.contains[leaves])
+                    return;
+
+                // The latch only runs after the test passed, so next <= largest passing value + step
+                int64_t largestPassing = test->getOpcode() == Opcode::Lt ? bound->value - 1 : bound->value;
+                if (test->getOpcode() == Opcode::Lt && bound->value == minOf(iv.isLong))
+                    return;
+                auto max = addExact(largestPassing, iv.step, iv.isLong);
+                if (!max)
+                    return;
+                iv.test = test;
+                iv.bound = bound->value;
+                iv.max = std::max(*max, iv.start);
+            }
+
+            // Turns each `iv * c` into its own recurrence and rewrites the exit test against one
+            // of them. Only done when the phi has no other uses, so it can be dropped.
+            bool replaceInductionVariable(const ControlFlowGraph &cfg, const Loop &loop, const InductionVariable &iv,
+                                          const std::string &preheaderName, const std::string &latchName) {
+                if (!iv.test)
+                    return false;
+                const auto &nextUsers = iv.next->getUsers();
+                const auto &testUsers = iv.test->getUsers();
+                if (nextUsers.size() != 1 || nextUsers[0] != iv.phi || testUsers.size() != 1)
+                    return false;
+
+                struct Product {
+                    Instruction *mul;
+                    int64_t factor;
+                };
+                std::vector<Product> products;
+                for (Instruction *user : iv.phi->getUsers()) {
+                    if (user == iv.next || user == iv.test)
+                        continue;
+                    const auto &operands = user->getOperands();
+                    if (user->getOpcode() != Opcode::Mul)
+                        return false;
+                    auto factor = constantOfKind(*operands[operands[0] == iv.phi ? 1 : 0], iv.isLong);
+                    if (!factor || (operands[0] == iv.phi && operands[1] == iv.phi))
+                        return false;
+                    products.push_back({user, factor->value});
+                }
+                // Each recurrence costs about as much as the phi it replaces, so more than two
+                // products would make the loop slower
+                if (products.empty() || products.size() > 2)
+                    return false;
+
+                // The test can move to a product whose factor is positive and whose scaled range
+                // (every value the test sees, and the bound) doesn't overflow
+                const Product *scaledTest = nullptr;
+                int64_t scaledBound = 0;
+                for (const auto &product : products) {
+                    if (product.factor <= 0)
+                        continue;
+                    auto low = multiplyExact(std::min(iv.start, iv.bound), product.factor, iv.isLong);
+                    auto high = multiplyExact(iv.max, product.factor, iv.isLong);
+                    auto bound = multiplyExact(iv.bound, product.factor, iv.isLong);
+                    if (low && high && bound) {
+                        scaledTest = &product;
+                        scaledBound = *bound;
+                        break;
+                    }
+                }
+                if (!scaledTest)
+                    return false;
+
+                auto &header = *cfg.getBlock(loop.header);
+                BasicBlock *nextBlock = nullptr;
+                for (size_t b : loop.blocks) {
+                    for (const auto &inst : cfg.getBlock(b)->getInstructions()) {
+                        if (inst == iv.next)
+                            nextBlock = cfg.getBlock(b);
+                    }
+                }
+                if (!nextBlock)
+                    return false;
+
+                ReplacementMap replacements;
+                for (const auto &product : products) {
+                    auto type = iv.phi->getType();
+                    auto factor = ConstantInt{product.factor, iv.isLong};
+                    auto start = *foldInstruction(Opcode::Mul, {ConstantInt{iv.start, iv.isLong}, factor});
+                    auto step = *foldInstruction(Opcode::Mul, {ConstantInt{iv.step, iv.isLong}, factor});
+
+                    auto phi = module_.create<Instruction>(Opcode::Phi, type, std::vector<Value *>{},
+                                                           product.mul->getName() + ".iv");
+                    auto next = makeBinary(module_, Opcode::Add, type, phi, makeImmediate(module_, step, type),
+                                           phi->getName() + ".next");
+                    phi->setLocation(iv.phi->getLocation());
+                    next->setLocation(iv.next->getLocation());
+                    phi->addIncoming(makeImmediate(module_, start, type), module_.createLabel(preheaderName));
+                    phi->addIncoming(next, module_.createLabel(latchName));
+                    header.insertInstruction(0, phi);
+                    const auto &instructions = nextBlock->getInstructions();
+                    size_t at = std::find(instructions.begin(), instructions.end(), iv.next) - instructions.begin();
+                    nextBlock->insertInstruction(at + 1, next);
+
+                    if (iv.start >= 0) {
+                        nonNegative_.insert(phi);
+                        nonNegative_.insert(next);
+                    }
+                    if (&product == scaledTest) {
+                        iv.test->setOperand(0, phi);
+                        iv.test->setOperand(1, makeImmediate(module_, {scaledBound, iv.isLong}, type));
+                    }
+                    replacements[product.mul] = phi;
+                }
+
+                replaceAllUses(replacements);
+                removeReplaced(function_, replacements);
+
+                // Only the phi and its step still use each other
+                iv.phi->eraseFromParent();
+                iv.next->eraseFromParent();
+                nonNegative_.erase(iv.phi);
+                nonNegative_.erase(iv.next);
+                return true;
+            }
+
+            bool isNonNegative(const Value &value, int depth = 0) const {
+                if (auto constant = getConstantInt(value))
+                    return constant->value >= 0;
+                auto *inst = dynamic_cast<const Instruction *>(&value);
+                if (!inst || depth > 8)
+                    return false;
+                if (nonNegative_.count(inst))
+                    return true;
+                const auto &operands = inst->getOperands();
+                switch (inst->getOpcode()) {
+                case Opcode::BitAnd:
+                    return isNonNegative(*operands[0], depth + 1) || isNonNegative(*operands[1], depth + 1);
+                case Opcode::Shr:
+                case Opcode::Mod: // the remainder takes the dividend's sign
+                case Opcode::SExt:
+                    return isNonNegative(*operands[0], depth + 1);
+                case Opcode::Div: {
+                    auto divisor = getConstantInt(*operands[1]);
+                    return divisor && divisor->value > 0 && isNonNegative(*operands[0], depth + 1);
+                }
+                default:
+                    return false;
+                }
+            }
+
+            // log2 of a positive power of two, or nullopt
+            static std::optional<int> exponentOf(const Value &value) {
+                auto constant = getConstantInt(value);
+                if (!constant || constant->value <= 1 || !std::has_single_bit(static_cast<uint64_t>(constant->value)))
+                    return std::nullopt;
+                return std::countr_zero(static_cast<uint64_t>(constant->value));
+            }
+
+            bool reduceOperators() {
+                ReplacementMap replacements;
+                for (const auto &block : function_.getBasicBlocks()) {
+                    const auto &instructions = block->getInstructions();
+                    for (size_t i = 0; i < instructions.size(); ++i) {
+                        auto reduced = reduceOperator(*instructions[i]);
+                        if (!reduced)
+                            continue;
+                        reduced->setLocation(instructions[i]->getLocation());
+                        replacements[instructions[i]] = reduced;
+                        block->insertInstruction(i + 1, reduced);
+                        ++i;
+                    }
+                }
+                replaceAllUses(replacements);
+                removeReplaced(function_, replacements);
+                return !replacements.empty();
+            }
+
+            Instruction *reduceOperator(const Instruction &inst) const {
+                const auto &operands = inst.getOperands();
+                auto shiftBy = [&](int exponent, const Value &power) {
+                    return makeImmediate(module_, {exponent, getConstantInt(power)->isLong}, Type::getInt32Type());
+                };
+                switch (inst.getOpcode()) {
+                case Opcode::Mul:
+                    for (size_t i = 0; i < 2; ++i) {
+                        if (auto exponent = exponentOf(*operands[i]))
+                            return makeBinary(module_, Opcode::Shl, inst.getType(), operands[1 - i],
+                                              shiftBy(*exponent, *operands[i]), inst.getName());
+                    }
+                    return nullptr;
+                case Opcode::Div:
+                    if (auto exponent = exponentOf(*operands[1]); exponent && isNonNegative(*operands[0]))
+                        return makeBinary(module_, Opcode::Shr, inst.getType(), operands[0],
+                                          shiftBy(*exponent, *operands[1]), inst.getName());
+                    return nullptr;
+                case Opcode::Mod:
+                    if (auto exponent = exponentOf(*operands[1]); exponent && isNonNegative(*operands[0])) {
+                        auto divisor = *getConstantInt(*operands[1]);
+                        auto mask = makeImmediate(module_, {divisor.value - 1, divisor.isLong}, Type::getInt32Type());
+                        return makeBinary(module_, Opcode::BitAnd, inst.getType(), operands[0], mask, inst.getName());
+                    }
+                    return nullptr;
+                default:
+                    return nullptr;
+                }
+            }
+
+            Function &function_;
+            Module &module_;
+            FunctionAnalyses &analyses_;
+            std::unordered_set<const Value *> nonNegative_; // induction variables that stay >= 0
+        };
+    } // namespace
+
+    bool reduceStrength(Function &function, FunctionAnalyses &analyses) {
+        if (function.isExternal() || function.getBasicBlocks().empty() || hasComputedSlotPointers(function))
+            return false;
+        return Reducer(function, analyses).run();
+    }
+
+    bool reduceStrength(Function &function) {
+        FunctionAnalyses analyses(function);
+        return reduceStrength(function, analyses);
+    }
+
+    bool reduceStrength(Module &module) {
+        bool changed = false;
+        for (const auto &function : module.getFunctions())
+            changed |= reduceStrength(*function);
+        return changed;
+    }
+} // namespace Ryntra::IR
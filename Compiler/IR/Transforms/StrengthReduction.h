@@ -0,0 +1,23 @@
+#pragma once
+
+#include "../Module.h"
+
+namespace Ryntra::IR {
+    class FunctionAnalyses;
+
+    // Replaces expensive arithmetic by cheaper arithmetic that computes the same values under
+    // the VM's wrapping int / long semantics:
+    //  - an induction variable i (a header phi stepped by a constant) multiplied by constants is
+    //    turned into additive recurrences, and the loop's exit test on i is rewritten against
+    //    one of them, so i itself disappears. This is only done when that rewrite is exact (a
+    //    constant start and bound whose scaled values can't overflow); otherwise i stays live
+    //    and the extra recurrence would cost more bytecode than the multiplication it saves.
+    //  - mul by 2^k becomes shl, and div / mod by 2^k become shr / bitand where the dividend is
+    //    known to be non-negative (signed division rounds toward zero, an arithmetic shift
+    //    toward negative infinity).
+    // Loops need a preheader and a single latch (see LICM.h). Functions that do pointer
+    // arithmetic on locals are skipped (see LocalSlots.h). Returns whether anything changed.
+    bool reduceStrength(Function &function, FunctionAnalyses &analyses);
+    bool reduceStrength(Function &function);
+    bool reduceStrength(Module &module);
+} // namespace Ryntra::IR
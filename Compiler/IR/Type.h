@@ -1,10 +1,13 @@
 #pragma once
 
-#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace Ryntra::IR {
+    // Types are uniqued: the primitive types below are process-wide singletons and structural types
+    // are created once per module by its TypeTable, so two types are equal exactly when their
+    // pointers are. Nothing else should construct a Type.
     class Type {
     public:
         enum class Kind {
@@ -22,10 +25,12 @@ namespace Ryntra::IR {
         Type(Kind kind) : kind_(kind) {}
         virtual ~Type() = default;
 
+        Type(const Type &) = delete;
+        Type &operator=(const Type &) = delete;
+
         Kind getKind() const { return kind_; }
 
         virtual std::string toString() const = 0;
-        virtual bool isEqual(const Type *other) const = 0;
 
         bool isVoid() const { return kind_ == Kind::Void; }
         bool isInt32() const { return kind_ == Kind::Int32; }
@@ -37,11 +42,11 @@ namespace Ryntra::IR {
         bool isRef() const { return kind_ == Kind::Ref; }
         bool isPtr() const { return kind_ == Kind::Ptr; }
 
-        static std::shared_ptr<Type> getVoidType();
-        static std::shared_ptr<Type> getInt32Type();
-        static std::shared_ptr<Type> getInt64Type();
-        static std::shared_ptr<Type> getBoolType();
-        static std::shared_ptr<Type> getStringType();
+        static Type *getVoidType();
+        static Type *getInt32Type();
+        static Type *getInt64Type();
+        static Type *getBoolType();
+        static Type *getStringType();
 
     private:
         Kind kind_;
@@ -54,10 +59,6 @@ namespace Ryntra::IR {
         std::string toString() const override {
             return "void";
         }
-
-        bool isEqual(const Type *other) const override {
-            return other->isVoid();
-        }
     };
 
     class Int32Type : public Type {
@@ -67,10 +68,6 @@ namespace Ryntra::IR {
         std::string toString() const override {
             return "i32";
         }
-
-        bool isEqual(const Type *other) const override {
-            return other->isInt32();
-        }
     };
 
     class Int64Type : public Type {
@@ -80,10 +77,6 @@ namespace Ryntra::IR {
         std::string toString() const override {
             return "i64";
         }
-
-        bool isEqual(const Type *other) const override {
-            return other->isInt64();
-        }
     };
 
     class BoolType : public Type {
@@ -93,10 +86,6 @@ namespace Ryntra::IR {
         std::string toString() const override {
             return "i1";
         }
-
-        bool isEqual(const Type *other) const override {
-            return other->isBool();
-        }
     };
 
     class StringType : public Type {
@@ -106,88 +95,63 @@ namespace Ryntra::IR {
         std::string toString() const override {
             return "string";
         }
-
-        bool isEqual(const Type *other) const override {
-            return other->isString();
-        }
     };
 
     class ArrayType : public Type {
     public:
-        ArrayType(std::shared_ptr<Type> elementType)
-            : Type(Kind::Array), elementType_(std::move(elementType)) {}
+        ArrayType(Type *elementType)
+            : Type(Kind::Array), elementType_(elementType) {}
 
-        std::shared_ptr<Type> getElementType() const { return elementType_; }
+        Type *getElementType() const { return elementType_; }
 
         std::string toString() const override {
             return elementType_->toString() + "[]";
         }
 
-        bool isEqual(const Type *other) const override {
-            if (!other->isArray())
-                return false;
-            auto *arrType = static_cast<const ArrayType *>(other);
-            return elementType_->isEqual(arrType->elementType_.get());
-        }
-
     private:
-        std::shared_ptr<Type> elementType_;
+        Type *elementType_;
     };
 
     class RefType : public Type {
     public:
-        RefType(std::shared_ptr<Type> elementType)
-            : Type(Kind::Ref), elementType_(std::move(elementType)) {}
+        RefType(Type *elementType)
+            : Type(Kind::Ref), elementType_(elementType) {}
 
-        std::shared_ptr<Type> getElementType() const { return elementType_; }
+        Type *getElementType() const { return elementType_; }
 
         std::string toString() const override {
             return "ref<" + elementType_->toString() + ">";
         }
 
-        bool isEqual(const Type *other) const override {
-            if (!other->isRef())
-                return false;
-            auto *refType = static_cast<const RefType *>(other);
-            return elementType_->isEqual(refType->elementType_.get());
-        }
-
     private:
-        std::shared_ptr<Type> elementType_;
+        Type *elementType_;
     };
 
     class PtrType : public Type {
     public:
-        PtrType(std::shared_ptr<Type> elementType)
-            : Type(Kind::Ptr), elementType_(std::move(elementType)) {}
+        PtrType(Type *elementType)
+            : Type(Kind::Ptr), elementType_(elementType) {}
 
-        std::shared_ptr<Type> getElementType() const { return elementType_; }
+        Type *getElementType() const { return elementType_; }
 
         std::string toString() const override {
             return "ptr<" + elementType_->toString() + ">";
         }
 
-        bool isEqual(const Type *other) const override {
-            if (!other->isPtr())
-                return false;
-            auto *ptrType = static_cast<const PtrType *>(other);
-            return elementType_->isEqual(ptrType->elementType_.get());
-        }
-
     private:
-        std::shared_ptr<Type> elementType_;
+        Type *elementType_;
     };
 
     class FunctionType : public Type {
     public:
-        FunctionType(std::shared_ptr<Type> returnType,
-                     std::vector<std::shared_ptr<Type>> paramTypes)
+        FunctionType(Type *returnType,
+                     std::vector<Type *> paramTypes)
             : Type(Kind::Function),
               returnType_(returnType),
-              paramTypes_(paramTypes) {}
+              paramTypes_(std::move(paramTypes)) {}
 
-        std::shared_ptr<Type> getReturnType() const { return returnType_; }
-        const std::vector<std::shared_ptr<Type>> &getParamTypes() const { return paramTypes_; }
+        Type *getReturnType() const { return returnType_; }
+        const std::vector<Type *> &getParamTypes() const { return paramTypes_; }
 
         std::string toString() const override {
             std::string result = "(";
@@ -200,50 +164,33 @@ namespace Ryntra::IR {
             return result;
         }
 
-        bool isEqual(const Type *other) const override {
-            if (!other->isFunction())
-                return false;
-            const FunctionType *funcType = static_cast<const FunctionType *>(other);
-
-            if (!returnType_->isEqual(funcType->returnType_.get()))
-                return false;
-            if (paramTypes_.size() != funcType->paramTypes_.size())
-                return false;
-
-            for (size_t i = 0; i < paramTypes_.size(); ++i) {
-                if (!paramTypes_[i]->isEqual(funcType->paramTypes_[i].get()))
-                    return false;
-            }
-            return true;
-        }
-
     private:
-        std::shared_ptr<Type> returnType_;
-        std::vector<std::shared_ptr<Type>> paramTypes_;
+        Type *returnType_;
+        std::vector<Type *> paramTypes_;
     };
 
-    inline std::shared_ptr<Type> Type::getVoidType() {
-        static std::shared_ptr<Type> voidType = std::make_shared<VoidType>();
-        return voidType;
+    inline Type *Type::getVoidType() {
+        static VoidType voidType;
+        return &voidType;
     }
 
-    inline std::shared_ptr<Type> Type::getInt32Type() {
-        static std::shared_ptr<Type> int32Type = std::make_shared<Int32Type>();
-        return int32Type;
+    inline Type *Type::getInt32Type() {
+        static Int32Type int32Type;
+        return &int32Type;
     }
 
-    inline std::shared_ptr<Type> Type::getStringType() {
-        static std::shared_ptr<Type> stringType = std::make_shared<StringType>();
-        return stringType;
+    inline Type *Type::getStringType() {
+        static StringType stringType;
+        return &stringType;
     }
 
-    inline std::shared_ptr<Type> Type::getInt64Type() {
-        static std::shared_ptr<Type> int64Type = std::make_shared<Int64Type>();
-        return int64Type;
+    inline Type *Type::getInt64Type() {
+        static Int64Type int64Type;
+        return &int64Type;
     }
 
-    inline std::shared_ptr<Type> Type::getBoolType() {
-        static std::shared_ptr<Type> boolType = std::make_shared<BoolType>();
-        return boolType;
+    inline Type *Type::getBoolType() {
+        static BoolType boolType;
+        return &boolType;
     }
 } // namespace Ryntra::IR
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Arena.h"
+#include "Type.h"
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace Ryntra::IR {
+    // Owns the structural types of one module. Each one is created on first request and handed out
+    // again afterwards, so types built from the same parts are the same pointer.
+    class TypeTable {
+    public:
+        TypeTable() = default;
+
+        TypeTable(const TypeTable &) = delete;
+        TypeTable &operator=(const TypeTable &) = delete;
+
+        ArrayType *getArrayType(Type *elementType) { return intern(arrayTypes_, elementType); }
+        RefType *getRefType(Type *elementType) { return intern(refTypes_, elementType); }
+        PtrType *getPtrType(Type *elementType) { return intern(ptrTypes_, elementType); }
+
+        FunctionType *getFunctionType(Type *returnType, const std::vector<Type *> &paramTypes) {
+            std::vector<Type *> key;
+            key.reserve(paramTypes.size() + 1);
+            key.push_back(returnType);
+            key.insert(key.end(), paramTypes.begin(), paramTypes.end());
+
+            auto it = functionTypes_.find(key);
+            if (it != functionTypes_.end())
+                return it->second;
+            auto type = arena_.create<FunctionType>(returnType, paramTypes);
+            functionTypes_.emplace(std::move(key), type);
+            return type;
+        }
+
+    private:
+        template <typename T>
+        T *intern(std::unordered_map<Type *, T *> &types, Type *elementType) {
+            auto [it, inserted] = types.try_emplace(elementType, nullptr);
+            if (inserted)
+                it->second = arena_.create<T>(elementType);
+            return it->second;
+        }
+
+        Arena arena_;
+        std::unordered_map<Type *, ArrayType *> arrayTypes_;
+        std::unordered_map<Type *, RefType *> refTypes_;
+        std::unordered_map<Type *, PtrType *> ptrTypes_;
+        // Keyed by the return type followed by the parameter types
+        std::map<std::vector<Type *>, FunctionType *> functionTypes_;
+    };
+} // namespace Ryntra::IR
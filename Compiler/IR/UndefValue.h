@@ -0,0 +1,15 @@
+#pragma once
+
+#include "Value.h"
+#include <string>
+
+namespace Ryntra::IR {
+    // The value of a promoted variable read before any store reaches it
+    class UndefValue : public Value {
+    public:
+        explicit UndefValue(Type *type) : Value(type, "") {}
+
+        std::string toString() const override { return type_->toString() + " undef"; }
+        std::string getReferenceName() const override { return "undef"; }
+    };
+} // namespace Ryntra::IR
@@ -1,18 +1,26 @@
 #pragma once
 
 #include "Type.h"
+#include <algorithm>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace Ryntra::IR {
+    class Instruction;
+
     class Value {
     public:
-        Value(std::shared_ptr<Type> type, const std::string &name = "")
+        Value(Type *type, const std::string &name = "")
             : type_(type), name_(name) {}
 
         virtual ~Value() = default;
 
-        std::shared_ptr<Type> getType() const { return type_; }
+        // A value's users are tied to its identity, so values aren't copied
+        Value(const Value &) = delete;
+        Value &operator=(const Value &) = delete;
+
+        Type *getType() const { return type_; }
         const std::string &getName() const { return name_; }
         void setName(const std::string &name) { name_ = name; }
 
@@ -25,8 +33,32 @@ namespace Ryntra::IR {
 
         virtual bool isLocal() const { return false; }
 
+        // Instructions that have this value as an operand, once per operand slot, in no
+        // particular order. Kept up to date by Instruction; an instruction taken out of its block
+        // stays a user until it is erased (see Instruction::eraseFromParent).
+        const std::vector<Instruction *> &getUsers() const { return users_; }
+        bool hasUsers() const { return !users_.empty(); }
+
+        // Points every operand referring to this value at replacement (defined in Instruction.h)
+        void replaceAllUsesWith(Value *replacement);
+
     protected:
-        std::shared_ptr<Type> type_;
+        Type *type_;
         std::string name_;
+
+    private:
+        friend class Instruction;
+
+        void addUser(Instruction *user) { users_.push_back(user); }
+        // Searches from the back: the user going away is most often the latest one
+        void removeUser(Instruction *user) {
+            auto it = std::find(users_.rbegin(), users_.rend(), user);
+            if (it != users_.rend()) {
+                *it = users_.back();
+                users_.pop_back();
+            }
+        }
+
+        std::vector<Instruction *> users_;
     };
 } // namespace Ryntra::IR
@@ -33,11 +33,11 @@ namespace Ryntra::Compiler::Semantic {
             return;
         }
 
-        auto varType = toTypedType(varSym->getType());
-        auto intType = TypeFactory::getPrimitive("int");
-        auto longType = TypeFactory::getPrimitive("long");
+        auto varType = varSym->getType();
+        auto intType = TypeFactory::getInt();
+        auto longType = TypeFactory::getLong();
 
-        if (!varType->equals(*intType) && !varType->equals(*longType)) {
+        if (varType != intType && varType != longType) {
             ErrorHandler::getInstance().makeError(
                 "[RCE028]: Prefix '++'/'--' requires 'int' or 'long' variable, but got '" +
                     varType->toString() + "'.",
@@ -82,11 +82,11 @@ namespace Ryntra::Compiler::Semantic {
             return;
         }
 
-        auto varType = toTypedType(varSym->getType());
-        auto intType = TypeFactory::getPrimitive("int");
-        auto longType = TypeFactory::getPrimitive("long");
+        auto varType = varSym->getType();
+        auto intType = TypeFactory::getInt();
+        auto longType = TypeFactory::getLong();
 
-        if (!varType->equals(*intType) && !varType->equals(*longType)) {
+        if (varType != intType && varType != longType) {
             ErrorHandler::getInstance().makeError(
                 "[RCE030]: Postfix '++'/'--' requires 'int' or 'long' variable, but got '" +
                     varType->toString() + "'.",
@@ -129,45 +129,43 @@ namespace Ryntra::Compiler::Semantic {
             return;
         }
 
-        auto varSTType = varSym->getType();
+        auto varType = varSym->getType();
 
-        if (varSTType->getKind() == STType::TypeKind::Reference) {
-            auto &refSTType = dynamic_cast<const STType::ReferenceType &>(*varSTType);
-            auto elemTyped = toTypedType(refSTType.getElementType());
+        if (varType->getKind() == TypeKind::REFERENCE) {
+            auto elemType = static_cast<const ReferenceType *>(varType)->getElementType();
             auto rhsType = typedRHS->getType();
 
-            bool isAssignable = elemTyped->equals(*rhsType) ||
-                                (rhsType->toString() == "int" && elemTyped->toString() == "long");
-            if (!isAssignable && rhsType->toString() != "unknown") {
+            bool isAssignable = elemType == rhsType ||
+                                (rhsType == TypeFactory::getInt() && elemType == TypeFactory::getLong());
+            if (!isAssignable && rhsType != TypeFactory::getUnknown()) {
                 ErrorHandler::getInstance().makeError(
                     "[RCE045]: Cannot assign value of type '" + rhsType->toString() +
-                        "' to ref<" + elemTyped->toString() + "> variable '" + varName + "'.",
+                        "' to ref<" + elemType->toString() + "> variable '" + varName + "'.",
                     node.getRHS()->getLocation());
             }
 
-            auto resultType = isAssignable ? elemTyped : TypeFactory::getPrimitive("unknown");
+            auto resultType = isAssignable ? elemType : TypeFactory::getUnknown();
             auto typedRefAssign = std::make_shared<TypedRefAssignNode>(varName, typedRHS, resultType);
             typedRefAssign->setLocation(node.getLocation());
             lastNode = typedRefAssign;
             return;
         }
 
-        auto varType = toTypedType(varSTType);
         auto rhsType = typedRHS->getType();
 
-        bool isAssignable = varType->equals(*rhsType) ||
-                            (rhsType->toString() == "int" && varType->toString() == "long");
-        if (!isAssignable && rhsType->toString() == "null" && varType->getKind() == TypeKind::POINTER) {
+        bool isAssignable = varType == rhsType ||
+                            (rhsType == TypeFactory::getInt() && varType == TypeFactory::getLong());
+        if (!isAssignable && rhsType == TypeFactory::getNull() && varType->getKind() == TypeKind::POINTER) {
             isAssignable = true;
         }
-        if (!isAssignable && rhsType->toString() != "unknown") {
+        if (!isAssignable && rhsType != TypeFactory::getUnknown()) {
             ErrorHandler::getInstance().makeError(
                 "[RCE018]: Cannot assign value of type '" + rhsType->toString() +
                     "' to variable '" + varName + "' of type '" + varType->toString() + "'.",
                 node.getRHS()->getLocation());
         }
 
-        auto resultType = isAssignable ? varType : TypeFactory::getPrimitive("unknown");
+        auto resultType = isAssignable ? varType : TypeFactory::getUnknown();
         auto typedAssign = std::make_shared<TypedAssignmentNode>(varName, typedRHS, resultType);
         typedAssign->setLocation(node.getLocation());
         lastNode = typedAssign;
@@ -175,14 +173,12 @@ namespace Ryntra::Compiler::Semantic {
 
     void SemanticAnalyzer::visit(NewExpressionNode &node) {
         node.getElementType()->accept(*this);
-        auto elemSTType = lastType;
-        if (!elemSTType) {
+        auto elemType = lastType;
+        if (!elemType) {
             lastNode = nullptr;
             return;
         }
 
-        auto elemType = toTypedType(elemSTType);
-
         std::shared_ptr<TypedExpressionNode> typedInit = nullptr;
         if (node.getInitializer()) {
             node.getInitializer()->accept(*this);
@@ -191,7 +187,7 @@ namespace Ryntra::Compiler::Semantic {
                 lastNode = nullptr;
                 return;
             }
-            if (!typedInit->getType()->equals(*elemType)) {
+            if (typedInit->getType() != elemType) {
                 ErrorHandler::getInstance().makeError(
                     "[RCE056]: Initializer type '" + typedInit->getType()->toString() +
                         "' does not match element type '" + elemType->toString() + "'.",
@@ -224,7 +220,7 @@ namespace Ryntra::Compiler::Semantic {
         }
 
         auto exprType = typedExpr->getType();
-        if (exprType->getKind() != TypeKind::POINTER && exprType->toString() != "unknown") {
+        if (exprType->getKind() != TypeKind::POINTER && exprType != TypeFactory::getUnknown()) {
             ErrorHandler::getInstance().makeError(
                 "[RCE058]: 'delete' requires a pointer expression, but got '" +
                     exprType->toString() + "'.",
@@ -255,9 +251,9 @@ namespace Ryntra::Compiler::Semantic {
             return;
         }
 
-        auto intType = TypeFactory::getPrimitive("int");
-        auto longType = TypeFactory::getPrimitive("long");
-        if (!typedIndex->getType()->equals(*intType) && !typedIndex->getType()->equals(*longType) && typedIndex->getType()->toString() != "unknown") {
+        auto intType = TypeFactory::getInt();
+        auto longType = TypeFactory::getLong();
+        if (typedIndex->getType() != intType && typedIndex->getType() != longType && typedIndex->getType() != TypeFactory::getUnknown()) {
             ErrorHandler::getInstance().makeError(
                 "[RCE038]: Index must be 'int' or 'long', but got '" +
                     typedIndex->getType()->toString() + "'.",
@@ -319,9 +315,9 @@ namespace Ryntra::Compiler::Semantic {
             return;
         }
 
-        auto intType = TypeFactory::getPrimitive("int");
-        auto longType = TypeFactory::getPrimitive("long");
-        if (!typedIndex->getType()->equals(*intType) && !typedIndex->getType()->equals(*longType) && typedIndex->getType()->toString() != "unknown") {
+        auto intType = TypeFactory::getInt();
+        auto longType = TypeFactory::getLong();
+        if (typedIndex->getType() != intType && typedIndex->getType() != longType && typedIndex->getType() != TypeFactory::getUnknown()) {
             ErrorHandler::getInstance().makeError(
                 "[RCE042]: Index must be 'int' or 'long', but got '" +
                     typedIndex->getType()->toString() + "'.",
@@ -350,16 +346,16 @@ namespace Ryntra::Compiler::Semantic {
             auto &arrType = static_cast<const ArrayType &>(*exprType);
             auto elemType = arrType.getElementType();
 
-            bool isAssignable = elemType->equals(*typedValue->getType()) ||
-                                (typedValue->getType()->toString() == "int" && elemType->toString() == "long");
-            if (!isAssignable && typedValue->getType()->toString() != "unknown") {
+            bool isAssignable = elemType == typedValue->getType() ||
+                                (typedValue->getType() == TypeFactory::getInt() && elemType == TypeFactory::getLong());
+            if (!isAssignable && typedValue->getType() != TypeFactory::getUnknown()) {
                 ErrorHandler::getInstance().makeError(
                     "[RCE043]: Cannot assign value of type '" + typedValue->getType()->toString() +
                         "' to array element of type '" + elemType->toString() + "'.",
                     node.getValue()->getLocation());
             }
 
-            auto resultType = isAssignable ? elemType : TypeFactory::getPrimitive("unknown");
+            auto resultType = isAssignable ? elemType : TypeFactory::getUnknown();
             auto typedAssign = std::make_shared<TypedArrayIndexAssignmentNode>(arrayName, typedIndex, typedValue, resultType);
             typedAssign->setLocation(node.getLocation());
             lastNode = typedAssign;
@@ -370,16 +366,16 @@ namespace Ryntra::Compiler::Semantic {
             auto &ptrType = static_cast<const PointerType &>(*exprType);
             auto elemType = ptrType.getElementType();
 
-            bool isAssignable = elemType->equals(*typedValue->getType()) ||
-                                (typedValue->getType()->toString() == "int" && elemType->toString() == "long");
-            if (!isAssignable && typedValue->getType()->toString() != "unknown") {
+            bool isAssignable = elemType == typedValue->getType() ||
+                                (typedValue->getType() == TypeFactory::getInt() && elemType == TypeFactory::getLong());
+            if (!isAssignable && typedValue->getType() != TypeFactory::getUnknown()) {
                 ErrorHandler::getInstance().makeError(
                     "[RCE060]: Cannot assign value of type '" + typedValue->getType()->toString() +
                         "' to pointer element of type '" + elemType->toString() + "'.",
                     node.getValue()->getLocation());
             }
 
-            auto resultType = isAssignable ? elemType : TypeFactory::getPrimitive("unknown");
+            auto resultType = isAssignable ? elemType : TypeFactory::getUnknown();
             auto typedAssign = std::make_shared<TypedPtrIndexAssignmentNode>(typedExpr, typedIndex, typedValue, resultType);
             typedAssign->setLocation(node.getLocation());
             lastNode = typedAssign;
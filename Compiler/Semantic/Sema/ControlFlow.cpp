@@ -20,8 +20,8 @@ namespace Ryntra::Compiler::Semantic {
         auto typedCond = std::dynamic_pointer_cast<TypedExpressionNode>(lastNode);
 
         if (typedCond) {
-            auto boolType = TypeFactory::getPrimitive("bool");
-            if (!typedCond->getType()->equals(*boolType) && typedCond->getType()->toString() != "unknown") {
+            auto boolType = TypeFactory::getBool();
+            if (typedCond->getType() != boolType && typedCond->getType() != TypeFactory::getUnknown()) {
                 ErrorHandler::getInstance().makeError(
                     "[RCE023]: If condition must be 'bool', but got '" +
                         typedCond->getType()->toString() + "'.",
@@ -48,8 +48,8 @@ namespace Ryntra::Compiler::Semantic {
         auto typedCond = std::dynamic_pointer_cast<TypedExpressionNode>(lastNode);
 
         if (typedCond) {
-            auto boolType = TypeFactory::getPrimitive("bool");
-            if (!typedCond->getType()->equals(*boolType) && typedCond->getType()->toString() != "unknown") {
+            auto boolType = TypeFactory::getBool();
+            if (typedCond->getType() != boolType && typedCond->getType() != TypeFactory::getUnknown()) {
                 ErrorHandler::getInstance().makeError(
                     "[RCE024]: While condition must be 'bool', but got '" +
                         typedCond->getType()->toString() + "'.",
@@ -82,8 +82,8 @@ namespace Ryntra::Compiler::Semantic {
             typedCond = std::dynamic_pointer_cast<TypedExpressionNode>(lastNode);
 
             if (typedCond) {
-                auto boolType = TypeFactory::getPrimitive("bool");
-                if (!typedCond->getType()->equals(*boolType) && typedCond->getType()->toString() != "unknown") {
+                auto boolType = TypeFactory::getBool();
+                if (typedCond->getType() != boolType && typedCond->getType() != TypeFactory::getUnknown()) {
                     ErrorHandler::getInstance().makeError(
                         "[RCE031]: For-loop condition must be 'bool', but got '" +
                             typedCond->getType()->toString() + "'.",
@@ -138,7 +138,7 @@ namespace Ryntra::Compiler::Semantic {
         node.getExpression()->accept(*this);
         if (auto typedExpr = std::dynamic_pointer_cast<TypedExpressionNode>(lastNode)) {
             auto exprType = typedExpr->getType();
-            if (exprType && exprType->getKind() != TypeKind::VOID && exprType->toString() != "unknown") {
+            if (exprType && exprType->getKind() != TypeKind::VOID && exprType != TypeFactory::getUnknown()) {
                 auto rawExpr = node.getExpression();
             if (!std::dynamic_pointer_cast<AssignmentNode>(rawExpr) &&
                 !std::dynamic_pointer_cast<ArrayIndexAssignmentNode>(rawExpr) &&
@@ -6,7 +6,7 @@ namespace Ryntra::Compiler::Semantic {
         for (const auto &func : node.getFunctions()) {
             auto funcName = func->getName()->getName();
             auto returnTypeName = func->getReturnType()->getName();
-            auto returnType = makeSTType(returnTypeName);
+            auto returnType = makeType(returnTypeName);
 
             if (symbolTable.resolve(funcName)) {
                 ErrorHandler::getInstance().makeError(
@@ -24,24 +24,24 @@ namespace Ryntra::Compiler::Semantic {
             auto overloadSet = std::make_shared<OverloadSet>("__builtin_print");
 
             {
-                std::vector<TypePtr> params{std::make_shared<STType::StringType>()};
+                std::vector<TypePtr> params{TypeFactory::getString()};
                 overloadSet->addFunction(std::make_shared<FunctionSymbol>("__builtin_print",
-                                                                           std::make_shared<STType::VoidType>(), std::move(params)));
+                                                                          TypeFactory::getVoid(), std::move(params)));
             }
             {
-                std::vector<TypePtr> params{std::make_shared<STType::Int32Type>()};
+                std::vector<TypePtr> params{TypeFactory::getInt()};
                 overloadSet->addFunction(std::make_shared<FunctionSymbol>("__builtin_print",
-                                                                           std::make_shared<STType::VoidType>(), std::move(params)));
+                                                                          TypeFactory::getVoid(), std::move(params)));
             }
             {
-                std::vector<TypePtr> params{std::make_shared<STType::Int64Type>()};
+                std::vector<TypePtr> params{TypeFactory::getLong()};
                 overloadSet->addFunction(std::make_shared<FunctionSymbol>("__builtin_print",
-                                                                           std::make_shared<STType::VoidType>(), std::move(params)));
+                                                                          TypeFactory::getVoid(), std::move(params)));
             }
             {
-                std::vector<TypePtr> params{std::make_shared<STType::BoolType>()};
+                std::vector<TypePtr> params{TypeFactory::getBool()};
                 overloadSet->addFunction(std::make_shared<FunctionSymbol>("__builtin_print",
-                                                                           std::make_shared<STType::VoidType>(), std::move(params)));
+                                                                          TypeFactory::getVoid(), std::move(params)));
             }
 
             symbolTable.define(overloadSet, SourceLocation{0, 0});
@@ -53,17 +53,17 @@ namespace Ryntra::Compiler::Semantic {
             {
                 std::vector<TypePtr> params{};
                 overloadSet->addFunction(std::make_shared<FunctionSymbol>("__builtin_scan",
-                                                                           std::make_shared<STType::Int32Type>(), std::move(params)));
+                                                                          TypeFactory::getInt(), std::move(params)));
             }
             {
                 std::vector<TypePtr> params{};
                 overloadSet->addFunction(std::make_shared<FunctionSymbol>("__builtin_scan",
-                                                                           std::make_shared<STType::Int64Type>(), std::move(params)));
+                                                                          TypeFactory::getLong(), std::move(params)));
             }
             {
                 std::vector<TypePtr> params{};
                 overloadSet->addFunction(std::make_shared<FunctionSymbol>("__builtin_scan",
-                                                                           std::make_shared<STType::BoolType>(), std::move(params)));
+                                                                          TypeFactory::getBool(), std::move(params)));
             }
 
             symbolTable.define(overloadSet, SourceLocation{0, 0});
@@ -73,29 +73,36 @@ namespace Ryntra::Compiler::Semantic {
             auto overloadSet = std::make_shared<OverloadSet>("print");
 
             {
-                std::vector<TypePtr> params{std::make_shared<STType::StringType>()};
+                std::vector<TypePtr> params{TypeFactory::getString()};
                 overloadSet->addFunction(std::make_shared<FunctionSymbol>("print",
-                                                                           std::make_shared<STType::VoidType>(), std::move(params)));
+                                                                          TypeFactory::getVoid(), std::move(params)));
             }
             {
-                std::vector<TypePtr> params{std::make_shared<STType::Int32Type>()};
+                std::vector<TypePtr> params{TypeFactory::getInt()};
                 overloadSet->addFunction(std::make_shared<FunctionSymbol>("print",
-                                                                           std::make_shared<STType::VoidType>(), std::move(params)));
+                                                                          TypeFactory::getVoid(), std::move(params)));
             }
             {
-                std::vector<TypePtr> params{std::make_shared<STType::Int64Type>()};
+                std::vector<TypePtr> params{TypeFactory::getLong()};
                 overloadSet->addFunction(std::make_shared<FunctionSymbol>("print",
-                                                                           std::make_shared<STType::VoidType>(), std::move(params)));
+                                                                          TypeFactory::getVoid(), std::move(params)));
             }
             {
-                std::vector<TypePtr> params{std::make_shared<STType::BoolType>()};
+                std::vector<TypePtr> params{TypeFactory::getBool()};
                 overloadSet->addFunction(std::make_shared<FunctionSymbol>("print",
-                                                                           std::make_shared<STType::VoidType>(), std::move(params)));
+                                                                          TypeFactory::getVoid(), std::move(params)));
             }
 
             symbolTable.define(overloadSet, SourceLocation{0, 0});
         }
 
+        // bool __builtin_snapshot(): false on a normal run, true in a run restored from the snapshot
+        if (!symbolTable.resolve("__builtin_snapshot")) {
+            symbolTable.define(std::make_shared<FunctionSymbol>("__builtin_snapshot",
+                                                                TypeFactory::getBool(), std::vector<TypePtr>{}),
+                               SourceLocation{0, 0});
+        }
+
         auto mainSym = symbolTable.resolve("main");
         if (!mainSym) {
             ErrorHandler::getInstance().makeError(
@@ -108,7 +115,7 @@ namespace Ryntra::Compiler::Semantic {
             } else if (!mainFuncSym->getReturnType()) {
                 ErrorHandler::getInstance().makeError(
                     "[RCE004]: 'main' function must have a return type.", node.getLocation());
-            } else if (mainFuncSym->getReturnType()->getKind() != STType::TypeKind::Void) {
+            } else if (mainFuncSym->getReturnType()->getKind() != TypeKind::VOID) {
                 ErrorHandler::getInstance().makeError(
                     "[RCE005]: 'main' function must return 'void'.", node.getLocation());
             }
@@ -129,7 +136,7 @@ namespace Ryntra::Compiler::Semantic {
 
     void SemanticAnalyzer::visit(FunctionDefinitionNode &node) {
         node.getReturnType()->accept(*this);
-        auto returnType = lastType ? lastType : makeSTType("void");
+        auto returnType = lastType ? lastType : makeType("void");
         currentFunctionReturnType = returnType;
 
         auto funcName = node.getName()->getName();
@@ -141,7 +148,7 @@ namespace Ryntra::Compiler::Semantic {
 
         if (typedBody) {
             auto typedFunc = std::make_shared<TypedFunctionDefinitionNode>(
-                funcName, toTypedType(returnType), typedBody);
+                funcName, returnType, typedBody);
             typedFunc->setLocation(node.getLocation());
             lastNode = typedFunc;
         } else {
@@ -156,13 +163,13 @@ namespace Ryntra::Compiler::Semantic {
 
         if (typedExpr) {
             if (currentFunctionReturnType) {
-                auto expectedTyped = toTypedType(currentFunctionReturnType);
+                auto expectedType = currentFunctionReturnType;
                 auto actualType = typedExpr->getType();
 
-                if (!expectedTyped->equals(*actualType) && actualType->toString() != "unknown") {
+                if (expectedType != actualType && actualType != TypeFactory::getUnknown()) {
                     ErrorHandler::getInstance().makeError(
                         "[RCE006]: Return type mismatch. Expected '" +
-                            expectedTyped->toString() + "', but got '" +
+                            expectedType->toString() + "', but got '" +
                             actualType->toString() + "'.",
                         node.getLocation());
                 }
@@ -176,14 +183,14 @@ namespace Ryntra::Compiler::Semantic {
     }
 
     void SemanticAnalyzer::visit(TypeSpecifierNode &node) {
-        lastType = makeSTType(node.getName());
+        lastType = makeType(node.getName());
     }
 
     void SemanticAnalyzer::visit(ArrayTypeNode &node) {
         node.getElementType()->accept(*this);
         auto elemType = lastType;
         if (elemType) {
-            lastType = std::make_shared<STType::ArrayType>(elemType);
+            lastType = TypeFactory::getArray(elemType);
         } else {
             lastType = nullptr;
         }
@@ -193,7 +200,7 @@ namespace Ryntra::Compiler::Semantic {
         node.getElementType()->accept(*this);
         auto elemType = lastType;
         if (elemType) {
-            lastType = std::make_shared<STType::ReferenceType>(elemType);
+            lastType = TypeFactory::getReference(elemType);
         } else {
             lastType = nullptr;
         }
@@ -203,27 +210,26 @@ namespace Ryntra::Compiler::Semantic {
         auto varName = node.getName()->getName();
 
         node.getType()->accept(*this);
-        auto varType = lastType ? lastType : makeSTType("unknown");
+        auto varType = lastType ? lastType : makeType("unknown");
 
         std::shared_ptr<TypedExpressionNode> typedInit = nullptr;
         if (node.getInitializer()) {
-            expectedReturnType = toTypedType(varType);
+            expectedReturnType = varType;
             node.getInitializer()->accept(*this);
             expectedReturnType = nullptr;
             typedInit = std::dynamic_pointer_cast<TypedExpressionNode>(lastNode);
 
             if (typedInit) {
-                auto expectedTyped = toTypedType(varType);
                 auto actualType = typedInit->getType();
-                bool isAssignable = expectedTyped->equals(*actualType) ||
-                                    (actualType->toString() == "int" && expectedTyped->toString() == "long");
-                if (!isAssignable && actualType->toString() == "null" && expectedTyped->getKind() == TypeKind::POINTER) {
+                bool isAssignable = varType == actualType ||
+                                    (actualType == TypeFactory::getInt() && varType == TypeFactory::getLong());
+                if (!isAssignable && actualType == TypeFactory::getNull() && varType->getKind() == TypeKind::POINTER) {
                     isAssignable = true;
                 }
-                if (!isAssignable && actualType->toString() != "unknown") {
+                if (!isAssignable && actualType != TypeFactory::getUnknown()) {
                     ErrorHandler::getInstance().makeError(
                         "[RCE013]: Variable '" + varName + "' expects type '" +
-                            expectedTyped->toString() + "', but initializer has type '" +
+                            varType->toString() + "', but initializer has type '" +
                             actualType->toString() + "'.",
                         node.getLocation());
                 }
@@ -233,7 +239,7 @@ namespace Ryntra::Compiler::Semantic {
         auto varSym = std::make_shared<VariableSymbol>(varName, varType);
         symbolTable.define(varSym, node.getLocation());
 
-        auto typedDecl = std::make_shared<TypedVariableDeclarationNode>(varName, toTypedType(varType), typedInit);
+        auto typedDecl = std::make_shared<TypedVariableDeclarationNode>(varName, varType, typedInit);
         typedDecl->setLocation(node.getLocation());
         lastNode = typedDecl;
     }
@@ -255,25 +261,25 @@ namespace Ryntra::Compiler::Semantic {
             return;
         }
 
-        auto declElemType = std::dynamic_pointer_cast<STType::ArrayType>(arrayType)->getElementType();
-        if (declElemType->getKind() != newElemType->getKind()) {
+        auto declElemType = static_cast<const ArrayType *>(arrayType)->getElementType();
+        if (declElemType != newElemType) {
             ErrorHandler::getInstance().makeError(
                 "[RCE033]: Array element type mismatch. Declaration has '" +
-                    toTypedType(declElemType)->toString() + "', but 'new' has '" +
-                    toTypedType(newElemType)->toString() + "'.",
+                    declElemType->toString() + "', but 'new' has '" +
+                    newElemType->toString() + "'.",
                 node.getLocation());
         }
 
-        expectedReturnType = TypeFactory::getPrimitive("int");
+        expectedReturnType = TypeFactory::getInt();
         node.getSize()->accept(*this);
         expectedReturnType = nullptr;
         auto typedSize = std::dynamic_pointer_cast<TypedExpressionNode>(lastNode);
 
         if (typedSize) {
-            auto intType = TypeFactory::getPrimitive("int");
-            auto longType = TypeFactory::getPrimitive("long");
+            auto intType = TypeFactory::getInt();
+            auto longType = TypeFactory::getLong();
             auto sizeType = typedSize->getType();
-            if (!sizeType->equals(*intType) && !sizeType->equals(*longType) && sizeType->toString() != "unknown") {
+            if (sizeType != intType && sizeType != longType && sizeType != TypeFactory::getUnknown()) {
                 ErrorHandler::getInstance().makeError(
                     "[RCE034]: Array size must be 'int' or 'long', but got '" +
                         sizeType->toString() + "'.",
@@ -284,7 +290,7 @@ namespace Ryntra::Compiler::Semantic {
         auto varSym = std::make_shared<VariableSymbol>(varName, arrayType);
         symbolTable.define(varSym, node.getLocation());
 
-        auto typedDecl = std::make_shared<TypedArrayDeclarationNode>(varName, toTypedType(declElemType), typedSize);
+        auto typedDecl = std::make_shared<TypedArrayDeclarationNode>(varName, declElemType, typedSize);
         typedDecl->setLocation(node.getLocation());
         lastNode = typedDecl;
     }
@@ -293,28 +299,27 @@ namespace Ryntra::Compiler::Semantic {
         auto varName = node.getName()->getName();
         auto sym = symbolTable.resolve(varName);
 
-        std::shared_ptr<Type> type;
+        TypePtr type;
         if (!sym) {
             ErrorHandler::getInstance().makeError(
                 "[RCE014]: Variable '" + varName + "' is not defined.",
                 node.getLocation());
-            type = TypeFactory::getPrimitive("unknown");
+            type = TypeFactory::getUnknown();
         } else if (auto varSym = std::dynamic_pointer_cast<VariableSymbol>(sym)) {
-            auto varSTType = varSym->getType();
-            if (varSTType->getKind() == STType::TypeKind::Reference) {
-                auto &refSTType = static_cast<const STType::ReferenceType &>(*varSTType);
-                auto derefType = toTypedType(refSTType.getElementType());
+            auto varType = varSym->getType();
+            if (varType->getKind() == TypeKind::REFERENCE) {
+                auto derefType = static_cast<const ReferenceType *>(varType)->getElementType();
                 auto typedRefLoad = std::make_shared<TypedRefLoadNode>(varName, derefType);
                 typedRefLoad->setLocation(node.getLocation());
                 lastNode = typedRefLoad;
                 return;
             }
-            type = toTypedType(varSTType);
+            type = varType;
         } else {
             ErrorHandler::getInstance().makeError(
                 "[RCE015]: '" + varName + "' is not a variable.",
                 node.getLocation());
-            type = TypeFactory::getPrimitive("unknown");
+            type = TypeFactory::getUnknown();
         }
 
         auto typedVar = std::make_shared<TypedVariableNode>(varName, type);
@@ -326,27 +331,21 @@ namespace Ryntra::Compiler::Semantic {
         auto name = node.getName();
         auto sym = symbolTable.resolve(name);
 
-        std::shared_ptr<Type> type;
+        TypePtr type;
         if (!sym) {
             ErrorHandler::getInstance().makeError(
                 "[RCE007]: Identifier '" + name + "' is not defined.",
                 node.getLocation());
-            type = TypeFactory::getPrimitive("unknown");
+            type = TypeFactory::getUnknown();
         } else if (auto funcSym = std::dynamic_pointer_cast<FunctionSymbol>(sym)) {
-            std::vector<std::shared_ptr<Type>> paramTypes;
-            for (const auto &p : funcSym->getParamTypes())
-                paramTypes.push_back(toTypedType(p));
-            type = TypeFactory::getFunction(toTypedType(funcSym->getReturnType()), paramTypes);
+            type = TypeFactory::getFunction(funcSym->getReturnType(), funcSym->getParamTypes());
         } else if (auto overloadSet = std::dynamic_pointer_cast<OverloadSet>(sym)) {
             auto firstOverload = overloadSet->getFunctions().front();
-            std::vector<std::shared_ptr<Type>> paramTypes;
-            for (const auto &p : firstOverload->getParamTypes())
-                paramTypes.push_back(toTypedType(p));
-            type = TypeFactory::getFunction(toTypedType(firstOverload->getReturnType()), paramTypes);
+            type = TypeFactory::getFunction(firstOverload->getReturnType(), firstOverload->getParamTypes());
         } else if (auto varSym = std::dynamic_pointer_cast<VariableSymbol>(sym)) {
-            type = toTypedType(varSym->getType());
+            type = varSym->getType();
         } else {
-            type = TypeFactory::getPrimitive("unknown");
+            type = TypeFactory::getUnknown();
         }
 
         auto typedNode = std::make_shared<TypedIdentifierNode>(name, type);
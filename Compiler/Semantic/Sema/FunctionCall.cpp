@@ -16,22 +16,22 @@ namespace Ryntra::Compiler::Semantic {
             typedArgs.push_back(typedArg);
         }
 
-        TypePtr stReturnType;
+        TypePtr returnType;
         std::vector<TypePtr> expectedParamTypes;
 
         if (!sym) {
             ErrorHandler::getInstance().makeError(
                 "[RCE008]: Function '" + funcName + "' is not defined.",
                 node.getLocation());
-            stReturnType = makeSTType("unknown");
+            returnType = makeType("unknown");
         } else if (auto overloadSet = std::dynamic_pointer_cast<OverloadSet>(sym)) {
             bool found = false;
 
             if (funcName == "__builtin_scan" && expectedReturnType) {
                 for (const auto &overload : overloadSet->getFunctions()) {
-                    auto overloadRetTyped = toTypedType(overload->getReturnType());
-                    if (overloadRetTyped->equals(*expectedReturnType)) {
-                        stReturnType = overload->getReturnType();
+                    auto overloadRetType = overload->getReturnType();
+                    if (overloadRetType == expectedReturnType) {
+                        returnType = overload->getReturnType();
                         expectedParamTypes = overload->getParamTypes();
                         found = true;
                         break;
@@ -50,16 +50,16 @@ namespace Ryntra::Compiler::Semantic {
                             match = false;
                             break;
                         }
-                        auto expectedTyped = toTypedType(overload->getParamTypes()[i]);
-                        if (!expectedTyped->equals(*typedArgs[i]->getType()) &&
-                            typedArgs[i]->getType()->toString() != "unknown") {
+                        auto expectedType = overload->getParamTypes()[i];
+                        if (expectedType != typedArgs[i]->getType() &&
+                            typedArgs[i]->getType() != TypeFactory::getUnknown()) {
                             match = false;
                             break;
                         }
                     }
 
                     if (match) {
-                        stReturnType = overload->getReturnType();
+                        returnType = overload->getReturnType();
                         expectedParamTypes = overload->getParamTypes();
                         found = true;
                         break;
@@ -71,30 +71,28 @@ namespace Ryntra::Compiler::Semantic {
                 for (const auto &overload : overloadSet->getFunctions()) {
                     if (!expectedTypes.empty())
                         expectedTypes += " or ";
-                    expectedTypes += "'" + toTypedType(overload->getParamTypes()[0])->toString() + "'";
+                    expectedTypes += "'" + overload->getParamTypes()[0]->toString() + "'";
                 }
                 ErrorHandler::getInstance().makeError(
                     "[RCE009]: No matching overload for function '" + funcName +
                         "'. Expected " + expectedTypes + " argument, but got '" +
                         (typedArgs.empty() || !typedArgs[0] ? "unknown" : typedArgs[0]->getType()->toString()) + "'.",
                     node.getLocation());
-                stReturnType = makeSTType("unknown");
+                returnType = makeType("unknown");
                 if (!overloadSet->getFunctions().empty()) {
                     expectedParamTypes = overloadSet->getFunctions()[0]->getParamTypes();
                 }
             }
         } else if (auto funcSym = std::dynamic_pointer_cast<FunctionSymbol>(sym)) {
-            stReturnType = funcSym->getReturnType();
+            returnType = funcSym->getReturnType();
             expectedParamTypes = funcSym->getParamTypes();
         } else {
             ErrorHandler::getInstance().makeError(
                 "[RCE010]: '" + funcName + "' is not a function.",
                 node.getLocation());
-            stReturnType = makeSTType("unknown");
+            returnType = makeType("unknown");
         }
 
-        auto returnType = toTypedType(stReturnType);
-
         if (sym && args.size() != expectedParamTypes.size() &&
             !std::dynamic_pointer_cast<OverloadSet>(sym)) {
             ErrorHandler::getInstance().makeError(
@@ -110,23 +108,20 @@ namespace Ryntra::Compiler::Semantic {
                 continue;
 
             if (i < expectedParamTypes.size()) {
-                auto expectedTyped = toTypedType(expectedParamTypes[i]);
+                auto expectedType = expectedParamTypes[i];
                 auto actualType = typedArg->getType();
-                if (!expectedTyped->equals(*actualType) &&
-                    actualType->toString() != "unknown") {
+                if (expectedType != actualType &&
+                    actualType != TypeFactory::getUnknown()) {
                     ErrorHandler::getInstance().makeError(
                         "[RCE012]: Argument " + std::to_string(i + 1) +
-                            " expects type '" + expectedTyped->toString() +
+                            " expects type '" + expectedType->toString() +
                             "', but got '" + actualType->toString() + "'.",
                         args[i]->getLocation());
                 }
             }
         }
 
-        std::vector<std::shared_ptr<Type>> paramTypeObjs;
-        for (const auto &pt : expectedParamTypes)
-            paramTypeObjs.push_back(toTypedType(pt));
-        auto funcType = TypeFactory::getFunction(returnType, paramTypeObjs);
+        auto funcType = TypeFactory::getFunction(returnType, expectedParamTypes);
 
         auto typedFuncName = std::make_shared<TypedIdentifierNode>(funcName, funcType);
         typedFuncName->setLocation(funcNameNode->getLocation());
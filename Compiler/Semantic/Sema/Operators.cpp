@@ -10,12 +10,12 @@ namespace Ryntra::Compiler::Semantic {
             return;
         }
 
-        auto intType = TypeFactory::getPrimitive("int");
-        auto longType = TypeFactory::getPrimitive("long");
-        auto boolType = TypeFactory::getPrimitive("bool");
+        auto intType = TypeFactory::getInt();
+        auto longType = TypeFactory::getLong();
+        auto boolType = TypeFactory::getBool();
 
         if (node.getOp() == UnaryOpType::LogicalNot) {
-            if (!typedOperand->getType()->equals(*boolType)) {
+            if (typedOperand->getType() != boolType) {
                 ErrorHandler::getInstance().makeError(
                     "[RCE020]: Unary operator '!' requires 'bool' operand, but got '" +
                         typedOperand->getType()->toString() + "'.",
@@ -28,8 +28,8 @@ namespace Ryntra::Compiler::Semantic {
             return;
         }
 
-        bool isInt = typedOperand->getType()->equals(*intType);
-        bool isLong = typedOperand->getType()->equals(*longType);
+        bool isInt = typedOperand->getType() == intType;
+        bool isLong = typedOperand->getType() == longType;
 
         if (node.getOp() == UnaryOpType::Negate) {
             if (!isInt && !isLong) {
@@ -78,24 +78,24 @@ namespace Ryntra::Compiler::Semantic {
         bool rightIsPtr = rightType->getKind() == TypeKind::POINTER;
 
         if ((leftIsPtr || rightIsPtr) && (node.getOp() == BinaryOpType::Add || node.getOp() == BinaryOpType::Sub)) {
-            auto intType = TypeFactory::getPrimitive("int");
-            auto longType = TypeFactory::getPrimitive("long");
+            auto intType = TypeFactory::getInt();
+            auto longType = TypeFactory::getLong();
             bool offsetIsInt = false;
             bool offsetIsLong = false;
 
             if (node.getOp() == BinaryOpType::Add) {
-                if (leftIsPtr && (typedRight->getType()->equals(*intType) || typedRight->getType()->equals(*longType))) {
-                    offsetIsInt = typedRight->getType()->equals(*intType);
-                    offsetIsLong = typedRight->getType()->equals(*longType);
+                if (leftIsPtr && (typedRight->getType() == intType || typedRight->getType() == longType)) {
+                    offsetIsInt = typedRight->getType() == intType;
+                    offsetIsLong = typedRight->getType() == longType;
                     std::string ptrVarName = getPtrVarName(typedLeft, node.getLeft()->getLocation());
                     if (ptrVarName.empty()) { lastNode = nullptr; return; }
                     auto typedOffset = std::make_shared<TypedPtrOffsetNode>(ptrVarName, typedRight, true, leftType);
                     typedOffset->setLocation(node.getLocation());
                     lastNode = typedOffset;
                     return;
-                } else if (rightIsPtr && (typedLeft->getType()->equals(*intType) || typedLeft->getType()->equals(*longType))) {
-                    offsetIsInt = typedLeft->getType()->equals(*intType);
-                    offsetIsLong = typedLeft->getType()->equals(*longType);
+                } else if (rightIsPtr && (typedLeft->getType() == intType || typedLeft->getType() == longType)) {
+                    offsetIsInt = typedLeft->getType() == intType;
+                    offsetIsLong = typedLeft->getType() == longType;
                     std::string ptrVarName = getPtrVarName(typedRight, node.getRight()->getLocation());
                     if (ptrVarName.empty()) { lastNode = nullptr; return; }
                     auto typedOffset = std::make_shared<TypedPtrOffsetNode>(ptrVarName, typedLeft, true, rightType);
@@ -106,7 +106,7 @@ namespace Ryntra::Compiler::Semantic {
             }
 
             if (node.getOp() == BinaryOpType::Sub && leftIsPtr && !rightIsPtr) {
-                if (typedRight->getType()->equals(*intType) || typedRight->getType()->equals(*longType)) {
+                if (typedRight->getType() == intType || typedRight->getType() == longType) {
                     std::string ptrVarName = getPtrVarName(typedLeft, node.getLeft()->getLocation());
                     if (ptrVarName.empty()) { lastNode = nullptr; return; }
                     auto typedOffset = std::make_shared<TypedPtrOffsetNode>(ptrVarName, typedRight, false, leftType);
@@ -117,7 +117,7 @@ namespace Ryntra::Compiler::Semantic {
             }
 
             if (node.getOp() == BinaryOpType::Sub && leftIsPtr && rightIsPtr) {
-                if (leftType->equals(*rightType)) {
+                if (leftType == rightType) {
                     std::string leftPtrName = getPtrVarName(typedLeft, node.getLeft()->getLocation());
                     std::string rightPtrName = getPtrVarName(typedRight, node.getRight()->getLocation());
                     if (leftPtrName.empty() || rightPtrName.empty()) { lastNode = nullptr; return; }
@@ -136,12 +136,12 @@ namespace Ryntra::Compiler::Semantic {
             }
         }
 
-        auto intType = TypeFactory::getPrimitive("int");
-        auto longType = TypeFactory::getPrimitive("long");
-        bool leftIsInt = typedLeft->getType()->equals(*intType);
-        bool rightIsInt = typedRight->getType()->equals(*intType);
-        bool leftIsLong = typedLeft->getType()->equals(*longType);
-        bool rightIsLong = typedRight->getType()->equals(*longType);
+        auto intType = TypeFactory::getInt();
+        auto longType = TypeFactory::getLong();
+        bool leftIsInt = typedLeft->getType() == intType;
+        bool rightIsInt = typedRight->getType() == intType;
+        bool leftIsLong = typedLeft->getType() == longType;
+        bool rightIsLong = typedRight->getType() == longType;
 
         if (!leftIsInt && !leftIsLong) {
             ErrorHandler::getInstance().makeError(
@@ -156,13 +156,13 @@ namespace Ryntra::Compiler::Semantic {
                 node.getRight()->getLocation());
         }
 
-        std::shared_ptr<Type> resultType;
+        TypePtr resultType;
         if ((leftIsLong || rightIsLong) && (leftIsInt || leftIsLong) && (rightIsInt || rightIsLong)) {
             resultType = longType;
         } else if (leftIsInt && rightIsInt) {
             resultType = intType;
         } else {
-            resultType = TypeFactory::getPrimitive("unknown");
+            resultType = TypeFactory::getUnknown();
         }
 
         auto typedBinOp = std::make_shared<TypedBinaryOpNode>(typedLeft, node.getOp(), typedRight, resultType);
@@ -179,40 +179,39 @@ namespace Ryntra::Compiler::Semantic {
         }
 
         node.getTargetType()->accept(*this);
-        auto targetSTType = lastType;
-        if (!targetSTType) {
+        auto targetType = lastType;
+        if (!targetType) {
             lastNode = nullptr;
             return;
         }
 
-        auto targetTyped = toTypedType(targetSTType);
         auto operandType = typedOperand->getType();
 
-        auto intType = TypeFactory::getPrimitive("int");
-        auto longType = TypeFactory::getPrimitive("long");
+        auto intType = TypeFactory::getInt();
+        auto longType = TypeFactory::getLong();
 
         bool castValid = false;
-        if (operandType->equals(*intType) && targetTyped->equals(*longType))
+        if (operandType == intType && targetType == longType)
             castValid = true;
-        else if (operandType->equals(*longType) && targetTyped->equals(*intType))
+        else if (operandType == longType && targetType == intType)
             castValid = true;
-        else if (operandType->equals(*targetTyped))
+        else if (operandType == targetType)
             castValid = true;
 
-        if (!castValid && operandType->toString() != "unknown") {
+        if (!castValid && operandType != TypeFactory::getUnknown()) {
             ErrorHandler::getInstance().makeError(
                 "[RCE020]: Cannot cast from '" + operandType->toString() +
-                    "' to '" + targetTyped->toString() + "'.",
+                    "' to '" + targetType->toString() + "'.",
                 node.getLocation());
         }
 
-        if (operandType->equals(*longType) && targetTyped->equals(*intType)) {
+        if (operandType == longType && targetType == intType) {
             ErrorHandler::getInstance().makeWarning(
                 "[RCW002]: Result of this casting operation will be truncated.",
                 node.getLocation());
         }
 
-        auto typedCast = std::make_shared<TypedCastNode>(typedOperand, targetTyped);
+        auto typedCast = std::make_shared<TypedCastNode>(typedOperand, targetType);
         typedCast->setLocation(node.getLocation());
         lastNode = typedCast;
     }
@@ -233,8 +232,8 @@ namespace Ryntra::Compiler::Semantic {
         auto rightType = typedRight->getType();
         bool leftIsPtr = leftType->getKind() == TypeKind::POINTER;
         bool rightIsPtr = rightType->getKind() == TypeKind::POINTER;
-        bool leftIsNull = leftType->toString() == "null";
-        bool rightIsNull = rightType->toString() == "null";
+        bool leftIsNull = leftType == TypeFactory::getNull();
+        bool rightIsNull = rightType == TypeFactory::getNull();
 
         if (leftIsPtr || rightIsPtr || leftIsNull || rightIsNull) {
             if (leftIsNull && rightIsNull) {
@@ -251,19 +250,19 @@ namespace Ryntra::Compiler::Semantic {
                 lastNode = nullptr;
                 return;
             }
-            auto boolType = TypeFactory::getPrimitive("bool");
+            auto boolType = TypeFactory::getBool();
             auto typedCmp = std::make_shared<TypedComparisonNode>(typedLeft, node.getOp(), typedRight, boolType);
             typedCmp->setLocation(node.getLocation());
             lastNode = typedCmp;
             return;
         }
 
-        auto intType = TypeFactory::getPrimitive("int");
-        auto longType = TypeFactory::getPrimitive("long");
-        bool leftIsInt = typedLeft->getType()->equals(*intType);
-        bool rightIsInt = typedRight->getType()->equals(*intType);
-        bool leftIsLong = typedLeft->getType()->equals(*longType);
-        bool rightIsLong = typedRight->getType()->equals(*longType);
+        auto intType = TypeFactory::getInt();
+        auto longType = TypeFactory::getLong();
+        bool leftIsInt = typedLeft->getType() == intType;
+        bool rightIsInt = typedRight->getType() == intType;
+        bool leftIsLong = typedLeft->getType() == longType;
+        bool rightIsLong = typedRight->getType() == longType;
 
         if (!leftIsInt && !leftIsLong) {
             ErrorHandler::getInstance().makeError(
@@ -278,7 +277,7 @@ namespace Ryntra::Compiler::Semantic {
                 node.getRight()->getLocation());
         }
 
-        auto boolType = TypeFactory::getPrimitive("bool");
+        auto boolType = TypeFactory::getBool();
         auto typedCmp = std::make_shared<TypedComparisonNode>(typedLeft, node.getOp(), typedRight, boolType);
         typedCmp->setLocation(node.getLocation());
         lastNode = typedCmp;
@@ -296,16 +295,16 @@ namespace Ryntra::Compiler::Semantic {
             return;
         }
 
-        auto boolType = TypeFactory::getPrimitive("bool");
+        auto boolType = TypeFactory::getBool();
 
-        if (!typedLeft->getType()->equals(*boolType)) {
+        if (typedLeft->getType() != boolType) {
             ErrorHandler::getInstance().makeError(
                 "[RCE064]: Left operand of '&&' must be 'bool', but got '" +
                     typedLeft->getType()->toString() + "'.",
                 node.getLeft()->getLocation());
         }
 
-        if (!typedRight->getType()->equals(*boolType)) {
+        if (typedRight->getType() != boolType) {
             ErrorHandler::getInstance().makeError(
                 "[RCE065]: Right operand of '&&' must be 'bool', but got '" +
                     typedRight->getType()->toString() + "'.",
@@ -329,16 +328,16 @@ namespace Ryntra::Compiler::Semantic {
             return;
         }
 
-        auto boolType = TypeFactory::getPrimitive("bool");
+        auto boolType = TypeFactory::getBool();
 
-        if (!typedLeft->getType()->equals(*boolType)) {
+        if (typedLeft->getType() != boolType) {
             ErrorHandler::getInstance().makeError(
                 "[RCE066]: Left operand of '||' must be 'bool', but got '" +
                     typedLeft->getType()->toString() + "'.",
                 node.getLeft()->getLocation());
         }
 
-        if (!typedRight->getType()->equals(*boolType)) {
+        if (typedRight->getType() != boolType) {
             ErrorHandler::getInstance().makeError(
                 "[RCE067]: Right operand of '||' must be 'bool', but got '" +
                     typedRight->getType()->toString() + "'.",
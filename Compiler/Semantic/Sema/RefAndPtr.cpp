@@ -100,12 +100,11 @@ namespace Ryntra::Compiler::Semantic {
         }
 
         node.getPtrType()->accept(*this);
-        auto elemSTType = lastType;
-        if (!elemSTType) {
+        auto elemType = lastType;
+        if (!elemType) {
             lastNode = nullptr;
             return;
         }
-        auto elemType = toTypedType(elemSTType);
         auto ptrType = TypeFactory::getPointer(elemType);
 
         node.getInit()->accept(*this);
@@ -124,7 +123,7 @@ namespace Ryntra::Compiler::Semantic {
             return;
         }
 
-        if (!elemType->equals(*std::dynamic_pointer_cast<PointerType>(initType)->getElementType())) {
+        if (elemType != static_cast<const PointerType *>(initType)->getElementType()) {
             ErrorHandler::getInstance().makeError(
                 "[RCE063]: Pointer type mismatch in 'fixed' initializer.",
                 node.getInit()->getLocation());
@@ -133,9 +132,8 @@ namespace Ryntra::Compiler::Semantic {
         }
 
         auto varName = node.getName()->getName();
-        auto ptrSTType = std::make_shared<STType::PointerType>(elemSTType);
         symbolTable.enterScope();
-        symbolTable.define(std::make_shared<VariableSymbol>(varName, ptrSTType), node.getLocation());
+        symbolTable.define(std::make_shared<VariableSymbol>(varName, ptrType), node.getLocation());
 
         node.getBody()->accept(*this);
 
@@ -168,7 +166,7 @@ namespace Ryntra::Compiler::Semantic {
         }
 
         auto ptrExprType = typedPtrExpr->getType();
-        if (ptrExprType->getKind() != TypeKind::POINTER && ptrExprType->toString() != "unknown") {
+        if (ptrExprType->getKind() != TypeKind::POINTER && ptrExprType != TypeFactory::getUnknown()) {
             ErrorHandler::getInstance().makeError(
                 "[RCE049]: '.load()' requires a pointer expression, but got '" +
                     ptrExprType->toString() + "'.",
@@ -190,7 +188,7 @@ namespace Ryntra::Compiler::Semantic {
             return;
         }
 
-        auto elemType = std::dynamic_pointer_cast<PointerType>(ptrExprType)->getElementType();
+        auto elemType = static_cast<const PointerType *>(ptrExprType)->getElementType();
         auto typedPtrLoad = std::make_shared<TypedPtrLoadNode>(ptrVarName, elemType);
         typedPtrLoad->setLocation(node.getLocation());
         lastNode = typedPtrLoad;
@@ -213,7 +211,7 @@ namespace Ryntra::Compiler::Semantic {
         }
 
         auto ptrExprType = typedPtrExpr->getType();
-        if (ptrExprType->getKind() != TypeKind::POINTER && ptrExprType->toString() != "unknown") {
+        if (ptrExprType->getKind() != TypeKind::POINTER && ptrExprType != TypeFactory::getUnknown()) {
             ErrorHandler::getInstance().makeError(
                 "[RCE052]: '.store()' requires a pointer expression, but got '" +
                     ptrExprType->toString() + "'.",
@@ -235,7 +233,7 @@ namespace Ryntra::Compiler::Semantic {
             return;
         }
 
-        auto elemType = std::dynamic_pointer_cast<PointerType>(ptrExprType)->getElementType();
+        auto elemType = static_cast<const PointerType *>(ptrExprType)->getElementType();
 
         node.getValue()->accept(*this);
         auto typedValue = std::dynamic_pointer_cast<TypedExpressionNode>(lastNode);
@@ -244,16 +242,16 @@ namespace Ryntra::Compiler::Semantic {
             return;
         }
 
-        bool isAssignable = elemType->equals(*typedValue->getType()) ||
-                            (typedValue->getType()->toString() == "int" && elemType->toString() == "long");
-        if (!isAssignable && typedValue->getType()->toString() != "unknown") {
+        bool isAssignable = elemType == typedValue->getType() ||
+                            (typedValue->getType() == TypeFactory::getInt() && elemType == TypeFactory::getLong());
+        if (!isAssignable && typedValue->getType() != TypeFactory::getUnknown()) {
             ErrorHandler::getInstance().makeError(
                 "[RCE054]: Cannot store value of type '" + typedValue->getType()->toString() +
                     "' to pointer of type '" + elemType->toString() + "'.",
                 node.getValue()->getLocation());
         }
 
-        auto resultType = isAssignable ? elemType : TypeFactory::getPrimitive("unknown");
+        auto resultType = isAssignable ? elemType : TypeFactory::getUnknown();
         auto typedPtrStore = std::make_shared<TypedPtrStoreNode>(ptrVarName, typedValue, resultType);
         typedPtrStore->setLocation(node.getLocation());
         lastNode = typedPtrStore;
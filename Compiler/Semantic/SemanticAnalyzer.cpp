@@ -5,26 +5,24 @@
 #include <stdexcept>
 
 namespace Ryntra::Compiler::Semantic {
-    TypePtr SemanticAnalyzer::makeSTType(const std::string &name) {
+    TypePtr SemanticAnalyzer::makeType(const std::string &name) {
         if (name == "void")
-            return std::make_shared<STType::VoidType>();
+            return TypeFactory::getVoid();
         if (name == "string")
-            return std::make_shared<STType::StringType>();
+            return TypeFactory::getString();
         if (name == "long")
-            return std::make_shared<STType::Int64Type>();
+            return TypeFactory::getLong();
         if (name == "bool")
-            return std::make_shared<STType::BoolType>();
+            return TypeFactory::getBool();
         if (name.rfind("ref<", 0) == 0 && name.size() > 5 && name.back() == '>') {
             auto innerName = name.substr(4, name.size() - 5);
-            auto innerType = makeSTType(innerName);
-            return std::make_shared<STType::ReferenceType>(innerType);
+            return TypeFactory::getReference(makeType(innerName));
         }
         if (name.rfind("ptr<", 0) == 0 && name.size() > 5 && name.back() == '>') {
             auto innerName = name.substr(4, name.size() - 5);
-            auto innerType = makeSTType(innerName);
-            return std::make_shared<STType::PointerType>(innerType);
+            return TypeFactory::getPointer(makeType(innerName));
         }
-        return std::make_shared<STType::Int32Type>();
+        return TypeFactory::getInt();
     }
 
     std::string SemanticAnalyzer::getPtrVarName(const std::shared_ptr<TypedExpressionNode> &expr,
@@ -44,37 +42,6 @@ namespace Ryntra::Compiler::Semantic {
         return "";
     }
 
-    std::shared_ptr<Type> SemanticAnalyzer::toTypedType(const TypePtr &stType) {
-        if (!stType)
-            return TypeFactory::getPrimitive("unknown");
-        switch (stType->getKind()) {
-        case STType::TypeKind::Void:
-            return TypeFactory::getVoid();
-        case STType::TypeKind::String:
-            return TypeFactory::getPrimitive("string");
-        case STType::TypeKind::Int32:
-            return TypeFactory::getPrimitive("int");
-        case STType::TypeKind::Int64:
-            return TypeFactory::getPrimitive("long");
-        case STType::TypeKind::Bool:
-            return TypeFactory::getPrimitive("bool");
-        case STType::TypeKind::Array: {
-            auto &arrSTType = static_cast<const STType::ArrayType &>(*stType);
-            return TypeFactory::getArray(toTypedType(arrSTType.getElementType()));
-        }
-        case STType::TypeKind::Reference: {
-            auto &refSTType = static_cast<const STType::ReferenceType &>(*stType);
-            return TypeFactory::getReference(toTypedType(refSTType.getElementType()));
-        }
-        case STType::TypeKind::Pointer: {
-            auto &ptrSTType = static_cast<const STType::PointerType &>(*stType);
-            return TypeFactory::getPointer(toTypedType(ptrSTType.getElementType()));
-        }
-        default:
-            return TypeFactory::getPrimitive("unknown");
-        }
-    }
-
     void SemanticAnalyzer::analyze(const std::shared_ptr<IASTNode> &root) {
         if (!root)
             return;
@@ -64,17 +64,14 @@ namespace Ryntra::Compiler::Semantic {
 
         // Intermediate state for building the Typed AST
         std::shared_ptr<ITypedASTNode> lastNode;
-        TypePtr lastType;                         // STType::Type result from TypeSpecifierNode
-        TypePtr currentFunctionReturnType;        // STType::Type of the current function
-        std::shared_ptr<Type> expectedReturnType; // Expected return type from context (for __builtin_scan)
-        int loopDepth_ = 0;                       // Current loop nesting depth
-        int unsafeDepth_ = 0;                     // Current unsafe block nesting depth
+        TypePtr lastType = nullptr;                  // Result of the last TypeSpecifierNode
+        TypePtr currentFunctionReturnType = nullptr; // Return type of the current function
+        TypePtr expectedReturnType = nullptr;        // Expected return type from context (for __builtin_scan)
+        int loopDepth_ = 0;                          // Current loop nesting depth
+        int unsafeDepth_ = 0;                        // Current unsafe block nesting depth
 
-        // Convert STType::Type -> TypeSystem::Type (for TypedAST nodes)
-        static std::shared_ptr<Type> toTypedType(const TypePtr &stType);
-
-        // Build a TypePtr from a type-name string
-        static TypePtr makeSTType(const std::string &name);
+        // Build a type from a type-name string
+        static TypePtr makeType(const std::string &name);
 
         // Extract variable name from a typed expression (for pointer operations)
         static std::string getPtrVarName(const std::shared_ptr<TypedExpressionNode> &expr,
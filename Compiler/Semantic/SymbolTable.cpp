@@ -11,11 +11,11 @@ namespace Ryntra::Compiler::Semantic {
     SymbolTable::SymbolTable() {
         enterScope(); // Global scope
 
-        auto voidType = std::make_shared<STType::VoidType>();
-        auto int32Type = std::make_shared<STType::Int32Type>();
-        auto int64Type = std::make_shared<STType::Int64Type>();
-        auto stringType = std::make_shared<STType::StringType>();
-        auto boolType = std::make_shared<STType::BoolType>();
+        auto voidType = TypeFactory::getVoid();
+        auto int32Type = TypeFactory::getInt();
+        auto int64Type = TypeFactory::getLong();
+        auto stringType = TypeFactory::getString();
+        auto boolType = TypeFactory::getBool();
 
         auto overloadSet = std::make_shared<OverloadSet>("__builtin_print");
         {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "SourceLocation/SourceLocation.h"
+#include "TypeSystem.h"
 #include <memory>
 #include <stdexcept>
 #include <string>
@@ -8,111 +9,6 @@
 #include <vector>
 
 namespace Ryntra::Compiler::Semantic {
-    namespace STType {
-        // clang-format off
-        enum class TypeKind {
-            Void,
-            Bool,                     // i1
-            Char,                     // unsigned i16, implicitly cast from int or to int is not allowed
-            Int8,                     // byte
-            Int16,
-            Int32,                    // int or long (depends on the platform that vm runs on)
-            Int64,                    // long long
-
-            UnsignedInt8,
-            UnsignedInt16,
-            UnsignedInt32,
-            UnsignedInt64,
-
-            Float32,                  // float
-            Float64,                  // double
-            Float128,                 // decimal
-
-            String,
-            Array,
-            Reference,
-            Pointer
-        };
-        // clang-format on
-
-        class Type {
-        public:
-            virtual ~Type() = default;
-            virtual TypeKind getKind() const = 0;
-
-            bool isNumeric() const {
-                TypeKind k = this->getKind();
-                return (k >= TypeKind::Int8 && k <= TypeKind::Float128);
-            }
-
-            bool isIntegral() const {
-                TypeKind k = this->getKind();
-                return (k >= TypeKind::Int8 && k <= TypeKind::UnsignedInt64);
-            }
-
-            bool isCharacter() const {
-                TypeKind k = this->getKind();
-                return k == TypeKind::Char;
-            }
-
-            // Maybe there's more in the future
-        };
-
-        class VoidType : public Type {
-        public:
-            TypeKind getKind() const override { return TypeKind::Void; }
-        };
-
-        class Int32Type : public Type {
-        public:
-            TypeKind getKind() const override { return TypeKind::Int32; }
-        };
-
-        class Int64Type : public Type {
-        public:
-            TypeKind getKind() const override { return TypeKind::Int64; }
-        };
-
-        class StringType : public Type {
-        public:
-            TypeKind getKind() const override { return TypeKind::String; }
-        };
-
-        class BoolType : public Type {
-        public:
-            TypeKind getKind() const override { return TypeKind::Bool; }
-        };
-
-        class ArrayType : public Type {
-        public:
-            ArrayType(std::shared_ptr<Type> elementType) : elementType(std::move(elementType)) {}
-            TypeKind getKind() const override { return TypeKind::Array; }
-            const std::shared_ptr<Type> &getElementType() const { return elementType; }
-        private:
-            std::shared_ptr<Type> elementType;
-        };
-
-        class ReferenceType : public Type {
-        public:
-            ReferenceType(std::shared_ptr<Type> elementType) : elementType(std::move(elementType)) {}
-            TypeKind getKind() const override { return TypeKind::Reference; }
-            const std::shared_ptr<Type> &getElementType() const { return elementType; }
-        private:
-            std::shared_ptr<Type> elementType;
-        };
-
-        class PointerType : public Type {
-        public:
-            PointerType(std::shared_ptr<Type> elementType) : elementType(std::move(elementType)) {}
-            TypeKind getKind() const override { return TypeKind::Pointer; }
-            const std::shared_ptr<Type> &getElementType() const { return elementType; }
-        private:
-            std::shared_ptr<Type> elementType;
-        };
-    } // namespace STType
-
-    using TypePtr = std::shared_ptr<STType::Type>;
-
     enum class SymbolKind {
         Variable,
         Function,
@@ -136,9 +32,9 @@ namespace Ryntra::Compiler::Semantic {
     class FunctionSymbol : public Symbol {
     public:
         FunctionSymbol(std::string name, TypePtr returnType, std::vector<TypePtr> paramTypes)
-            : Symbol(std::move(name)), returnType(std::move(returnType)), paramTypes(std::move(paramTypes)) {}
+            : Symbol(std::move(name)), returnType(returnType), paramTypes(std::move(paramTypes)) {}
 
-        const TypePtr &getReturnType() const { return returnType; }
+        TypePtr getReturnType() const { return returnType; }
         const std::vector<TypePtr> &getParamTypes() const { return paramTypes; }
         SymbolKind getKind() const override { return SymbolKind::Function; }
 
@@ -150,9 +46,9 @@ namespace Ryntra::Compiler::Semantic {
     class VariableSymbol : public Symbol {
     public:
         VariableSymbol(std::string name, TypePtr type)
-            : Symbol(std::move(name)), type(std::move(type)) {}
+            : Symbol(std::move(name)), type(type) {}
 
-        const TypePtr &getType() const { return type; }
+        TypePtr getType() const { return type; }
         SymbolKind getKind() const override { return SymbolKind::Variable; }
 
     private:
@@ -0,0 +1,95 @@
+#include "TypeSystem.h"
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace Ryntra::Compiler::Semantic {
+    namespace {
+        // Structural types built so far. Guarded by a mutex: --batch analyzes scripts on several threads.
+        struct TypeTable {
+            std::mutex mutex;
+            std::unordered_map<TypePtr, std::unique_ptr<ArrayType>> arrays;
+            std::unordered_map<TypePtr, std::unique_ptr<ReferenceType>> references;
+            std::unordered_map<TypePtr, std::unique_ptr<PointerType>> pointers;
+            // Keyed by the return type followed by the parameter types
+            std::map<std::vector<TypePtr>, std::unique_ptr<FunctionType>> functions;
+        };
+
+        TypeTable &getTable() {
+            static TypeTable table;
+            return table;
+        }
+
+        template <typename T>
+        const T *intern(std::unordered_map<TypePtr, std::unique_ptr<T>> &types, TypePtr elementType) {
+            std::lock_guard lock(getTable().mutex);
+            auto &type = types[elementType];
+            if (!type)
+                type = std::make_unique<T>(elementType);
+            return type.get();
+        }
+    } // namespace
+
+    const PrimitiveType *TypeFactory::getInt() {
+        static const PrimitiveType type("int");
+        return &type;
+    }
+
+    const PrimitiveType *TypeFactory::getLong() {
+        static const PrimitiveType type("long");
+        return &type;
+    }
+
+    const PrimitiveType *TypeFactory::getBool() {
+        static const PrimitiveType type("bool");
+        return &type;
+    }
+
+    const PrimitiveType *TypeFactory::getString() {
+        static const PrimitiveType type("string");
+        return &type;
+    }
+
+    const PrimitiveType *TypeFactory::getNull() {
+        static const PrimitiveType type("null");
+        return &type;
+    }
+
+    const PrimitiveType *TypeFactory::getUnknown() {
+        static const PrimitiveType type("unknown");
+        return &type;
+    }
+
+    const VoidType *TypeFactory::getVoid() {
+        static const VoidType type;
+        return &type;
+    }
+
+    const FunctionType *TypeFactory::getFunction(TypePtr ret, const std::vector<TypePtr> &params) {
+        std::vector<TypePtr> key;
+        key.reserve(params.size() + 1);
+        key.push_back(ret);
+        key.insert(key.end(), params.begin(), params.end());
+
+        auto &table = getTable();
+        std::lock_guard lock(table.mutex);
+        auto &type = table.functions[std::move(key)];
+        if (!type)
+            type = std::make_unique<FunctionType>(ret, params);
+        return type.get();
+    }
+
+    const ArrayType *TypeFactory::getArray(TypePtr elementType) {
+        return intern(getTable().arrays, elementType);
+    }
+
+    const ReferenceType *TypeFactory::getReference(TypePtr elementType) {
+        return intern(getTable().references, elementType);
+    }
+
+    const PointerType *TypeFactory::getPointer(TypePtr elementType) {
+        return intern(getTable().pointers, elementType);
+    }
+} // namespace Ryntra::Compiler::Semantic
@@ -1,8 +1,7 @@
 #pragma once
 
-#include <iostream>
-#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace Ryntra::Compiler::Semantic {
@@ -17,14 +16,23 @@ namespace Ryntra::Compiler::Semantic {
         POINTER
     };
 
+    // Types are interned by TypeFactory: each one is created once per process and shared by the
+    // symbol table and the typed AST, so two types are equal exactly when their pointers are.
+    // Nothing else should construct a Type.
     class Type {
     public:
+        Type() = default;
         virtual ~Type() = default;
+
+        Type(const Type &) = delete;
+        Type &operator=(const Type &) = delete;
+
         virtual TypeKind getKind() const = 0;
         virtual std::string toString() const = 0;
-        virtual bool equals(const Type &other) const = 0;
     };
 
+    using TypePtr = const Type *;
+
     class PrimitiveType : public Type {
     public:
         explicit PrimitiveType(std::string name) : name(std::move(name)) {}
@@ -33,12 +41,6 @@ namespace Ryntra::Compiler::Semantic {
 
         std::string toString() const override { return name; }
 
-        bool equals(const Type &other) const override {
-            if (other.getKind() != TypeKind::PRIMITIVE)
-                return false;
-            return name == static_cast<const PrimitiveType &>(other).name;
-        }
-
         const std::string &getName() const { return name; }
 
     private:
@@ -47,7 +49,7 @@ namespace Ryntra::Compiler::Semantic {
 
     class ArrayType : public Type {
     public:
-        ArrayType(std::shared_ptr<Type> elementType) : elementType(std::move(elementType)) {}
+        ArrayType(TypePtr elementType) : elementType(elementType) {}
 
         TypeKind getKind() const override { return TypeKind::ARRAY; }
 
@@ -55,21 +57,15 @@ namespace Ryntra::Compiler::Semantic {
             return elementType->toString() + "[]";
         }
 
-        bool equals(const Type &other) const override {
-            if (other.getKind() != TypeKind::ARRAY)
-                return false;
-            return elementType->equals(*static_cast<const ArrayType &>(other).elementType);
-        }
-
-        std::shared_ptr<Type> getElementType() const { return elementType; }
+        TypePtr getElementType() const { return elementType; }
 
     private:
-        std::shared_ptr<Type> elementType;
+        TypePtr elementType;
     };
 
     class ReferenceType : public Type {
     public:
-        ReferenceType(std::shared_ptr<Type> elementType) : elementType(std::move(elementType)) {}
+        ReferenceType(TypePtr elementType) : elementType(elementType) {}
 
         TypeKind getKind() const override { return TypeKind::REFERENCE; }
 
@@ -77,21 +73,15 @@ namespace Ryntra::Compiler::Semantic {
             return "ref<" + elementType->toString() + ">";
         }
 
-        bool equals(const Type &other) const override {
-            if (other.getKind() != TypeKind::REFERENCE)
-                return false;
-            return elementType->equals(*static_cast<const ReferenceType &>(other).elementType);
-        }
-
-        std::shared_ptr<Type> getElementType() const { return elementType; }
+        TypePtr getElementType() const { return elementType; }
 
     private:
-        std::shared_ptr<Type> elementType;
+        TypePtr elementType;
     };
 
     class PointerType : public Type {
     public:
-        PointerType(std::shared_ptr<Type> elementType) : elementType(std::move(elementType)) {}
+        PointerType(TypePtr elementType) : elementType(elementType) {}
 
         TypeKind getKind() const override { return TypeKind::POINTER; }
 
@@ -99,31 +89,22 @@ namespace Ryntra::Compiler::Semantic {
             return "ptr<" + elementType->toString() + ">";
         }
 
-        bool equals(const Type &other) const override {
-            if (other.getKind() != TypeKind::POINTER)
-                return false;
-            return elementType->equals(*static_cast<const PointerType &>(other).elementType);
-        }
-
-        std::shared_ptr<Type> getElementType() const { return elementType; }
+        TypePtr getElementType() const { return elementType; }
 
     private:
-        std::shared_ptr<Type> elementType;
+        TypePtr elementType;
     };
 
     class VoidType : public Type {
     public:
         TypeKind getKind() const override { return TypeKind::VOID; }
         std::string toString() const override { return "void"; }
-        bool equals(const Type &other) const override {
-            return other.getKind() == TypeKind::VOID;
-        }
     };
 
     class FunctionType : public Type {
     public:
-        FunctionType(std::shared_ptr<Type> returnType, std::vector<std::shared_ptr<Type>> paramTypes)
-            : returnType(std::move(returnType)), paramTypes(std::move(paramTypes)) {}
+        FunctionType(TypePtr returnType, std::vector<TypePtr> paramTypes)
+            : returnType(returnType), paramTypes(std::move(paramTypes)) {}
 
         TypeKind getKind() const override { return TypeKind::FUNCTION; }
 
@@ -138,50 +119,29 @@ namespace Ryntra::Compiler::Semantic {
             return s;
         }
 
-        bool equals(const Type &other) const override {
-            if (other.getKind() != TypeKind::FUNCTION)
-                return false;
-            const auto &ft = static_cast<const FunctionType &>(other);
-            if (!returnType->equals(*ft.returnType))
-                return false;
-            if (paramTypes.size() != ft.paramTypes.size())
-                return false;
-            for (size_t i = 0; i < paramTypes.size(); ++i) {
-                if (!paramTypes[i]->equals(*ft.paramTypes[i]))
-                    return false;
-            }
-            return true;
-        }
-
-        std::shared_ptr<Type> getReturnType() const { return returnType; }
-        const std::vector<std::shared_ptr<Type>> &getParamTypes() const { return paramTypes; }
+        TypePtr getReturnType() const { return returnType; }
+        const std::vector<TypePtr> &getParamTypes() const { return paramTypes; }
 
     private:
-        std::shared_ptr<Type> returnType;
-        std::vector<std::shared_ptr<Type>> paramTypes;
+        TypePtr returnType;
+        std::vector<TypePtr> paramTypes;
     };
 
-    // Helper to create types
+    // The interned type table. Types live until the process exits.
     class TypeFactory {
     public:
-        static std::shared_ptr<PrimitiveType> getPrimitive(const std::string &name) {
-            return std::make_shared<PrimitiveType>(name);
-        }
-        static std::shared_ptr<VoidType> getVoid() {
-            return std::make_shared<VoidType>();
-        }
-        static std::shared_ptr<FunctionType> getFunction(std::shared_ptr<Type> ret, std::vector<std::shared_ptr<Type>> params) {
-            return std::make_shared<FunctionType>(std::move(ret), std::move(params));
-        }
-        static std::shared_ptr<ArrayType> getArray(std::shared_ptr<Type> elementType) {
-            return std::make_shared<ArrayType>(std::move(elementType));
-        }
-        static std::shared_ptr<ReferenceType> getReference(std::shared_ptr<Type> elementType) {
-            return std::make_shared<ReferenceType>(std::move(elementType));
-        }
-        static std::shared_ptr<PointerType> getPointer(std::shared_ptr<Type> elementType) {
-            return std::make_shared<PointerType>(std::move(elementType));
-        }
+        static const PrimitiveType *getInt();
+        static const PrimitiveType *getLong();
+        static const PrimitiveType *getBool();
+        static const PrimitiveType *getString();
+        static const PrimitiveType *getNull();    // Type of the 'null' literal
+        static const PrimitiveType *getUnknown(); // Type of an expression that failed to check
+        static const VoidType *getVoid();
+
+        static const FunctionType *getFunction(TypePtr ret, const std::vector<TypePtr> &params);
+        static const ArrayType *getArray(TypePtr elementType);
+        static const ReferenceType *getReference(TypePtr elementType);
+        static const PointerType *getPointer(TypePtr elementType);
     };
 
 } // namespace Ryntra::Compiler::Semantic
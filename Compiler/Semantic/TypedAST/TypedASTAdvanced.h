@@ -6,7 +6,7 @@ namespace Ryntra::Compiler::Semantic {
 
     class TypedRefCreateNode : public TypedExpressionNode {
     public:
-        TypedRefCreateNode(std::string variableName, std::shared_ptr<Type> type)
+        TypedRefCreateNode(std::string variableName, TypePtr type)
             : TypedExpressionNode(std::move(type)), variableName(std::move(variableName)) {}
 
         const std::string &getVariableName() const { return variableName; }
@@ -24,7 +24,7 @@ namespace Ryntra::Compiler::Semantic {
 
     class TypedRefLoadNode : public TypedExpressionNode {
     public:
-        TypedRefLoadNode(std::string variableName, std::shared_ptr<Type> type)
+        TypedRefLoadNode(std::string variableName, TypePtr type)
             : TypedExpressionNode(std::move(type)), variableName(std::move(variableName)) {}
 
         const std::string &getVariableName() const { return variableName; }
@@ -42,7 +42,7 @@ namespace Ryntra::Compiler::Semantic {
 
     class TypedRefAssignNode : public TypedExpressionNode {
     public:
-        TypedRefAssignNode(std::string variableName, std::shared_ptr<TypedExpressionNode> rhs, std::shared_ptr<Type> type)
+        TypedRefAssignNode(std::string variableName, std::shared_ptr<TypedExpressionNode> rhs, TypePtr type)
             : TypedExpressionNode(std::move(type)), variableName(std::move(variableName)), rhs(std::move(rhs)) {}
 
         const std::string &getVariableName() const { return variableName; }
@@ -103,7 +103,7 @@ namespace Ryntra::Compiler::Semantic {
 
     class TypedPtrCreateNode : public TypedExpressionNode {
     public:
-        TypedPtrCreateNode(std::string variableName, std::shared_ptr<Type> type)
+        TypedPtrCreateNode(std::string variableName, TypePtr type)
             : TypedExpressionNode(std::move(type)), variableName(std::move(variableName)) {}
 
         const std::string &getVariableName() const { return variableName; }
@@ -121,7 +121,7 @@ namespace Ryntra::Compiler::Semantic {
 
     class TypedPtrLoadNode : public TypedExpressionNode {
     public:
-        TypedPtrLoadNode(std::string ptrVarName, std::shared_ptr<Type> type)
+        TypedPtrLoadNode(std::string ptrVarName, TypePtr type)
             : TypedExpressionNode(std::move(type)), ptrVarName(std::move(ptrVarName)) {}
 
         const std::string &getPtrVarName() const { return ptrVarName; }
@@ -139,7 +139,7 @@ namespace Ryntra::Compiler::Semantic {
 
     class TypedPtrStoreNode : public TypedExpressionNode {
     public:
-        TypedPtrStoreNode(std::string ptrVarName, std::shared_ptr<TypedExpressionNode> rhs, std::shared_ptr<Type> type)
+        TypedPtrStoreNode(std::string ptrVarName, std::shared_ptr<TypedExpressionNode> rhs, TypePtr type)
             : TypedExpressionNode(std::move(type)), ptrVarName(std::move(ptrVarName)), rhs(std::move(rhs)) {}
 
         const std::string &getPtrVarName() const { return ptrVarName; }
@@ -162,7 +162,7 @@ namespace Ryntra::Compiler::Semantic {
 
     class TypedNullLiteralNode : public TypedExpressionNode {
     public:
-        explicit TypedNullLiteralNode(std::shared_ptr<Type> type)
+        explicit TypedNullLiteralNode(TypePtr type)
             : TypedExpressionNode(std::move(type)) {}
 
         void accept(ITypedVisitor &visitor) override { visitor.visit(*this); }
@@ -175,14 +175,14 @@ namespace Ryntra::Compiler::Semantic {
 
     class TypedNewNode : public TypedExpressionNode {
     public:
-        TypedNewNode(std::shared_ptr<Type> elementType,
+        TypedNewNode(TypePtr elementType,
                       std::shared_ptr<TypedExpressionNode> initializer,
-                      std::shared_ptr<Type> type)
+                      TypePtr type)
             : TypedExpressionNode(std::move(type)),
               elementType(std::move(elementType)),
               initializer(std::move(initializer)) {}
 
-        std::shared_ptr<Type> getElementType() const { return elementType; }
+        TypePtr getElementType() const { return elementType; }
         std::shared_ptr<TypedExpressionNode> getInitializer() const { return initializer; }
 
         void accept(ITypedVisitor &visitor) override { visitor.visit(*this); }
@@ -200,7 +200,7 @@ namespace Ryntra::Compiler::Semantic {
         }
 
     private:
-        std::shared_ptr<Type> elementType;
+        TypePtr elementType;
         std::shared_ptr<TypedExpressionNode> initializer;
     };
 
@@ -228,14 +228,14 @@ namespace Ryntra::Compiler::Semantic {
     class TypedFixedNode : public TypedStatementNode {
     public:
         TypedFixedNode(std::string varName,
-                        std::shared_ptr<Type> ptrType,
+                        TypePtr ptrType,
                         std::shared_ptr<TypedExpressionNode> initExpr,
                         std::shared_ptr<TypedBlockNode> body)
             : varName(std::move(varName)), ptrType(std::move(ptrType)),
               initExpr(std::move(initExpr)), body(std::move(body)) {}
 
         const std::string &getVarName() const { return varName; }
-        std::shared_ptr<Type> getPtrType() const { return ptrType; }
+        TypePtr getPtrType() const { return ptrType; }
         std::shared_ptr<TypedExpressionNode> getInitExpr() const { return initExpr; }
         std::shared_ptr<TypedBlockNode> getBody() const { return body; }
 
@@ -254,7 +254,7 @@ namespace Ryntra::Compiler::Semantic {
 
     private:
         std::string varName;
-        std::shared_ptr<Type> ptrType;
+        TypePtr ptrType;
         std::shared_ptr<TypedExpressionNode> initExpr;
         std::shared_ptr<TypedBlockNode> body;
     };
@@ -263,7 +263,7 @@ namespace Ryntra::Compiler::Semantic {
     public:
         TypedPtrIndexAccessNode(std::shared_ptr<TypedExpressionNode> ptrExpr,
                                  std::shared_ptr<TypedExpressionNode> index,
-                                 std::shared_ptr<Type> type)
+                                 TypePtr type)
             : TypedExpressionNode(std::move(type)), ptrExpr(std::move(ptrExpr)), index(std::move(index)) {}
 
         std::shared_ptr<TypedExpressionNode> getPtrExpr() const { return ptrExpr; }
@@ -292,7 +292,7 @@ namespace Ryntra::Compiler::Semantic {
         TypedPtrIndexAssignmentNode(std::shared_ptr<TypedExpressionNode> ptrExpr,
                                      std::shared_ptr<TypedExpressionNode> index,
                                      std::shared_ptr<TypedExpressionNode> value,
-                                     std::shared_ptr<Type> type)
+                                     TypePtr type)
             : TypedExpressionNode(std::move(type)), ptrExpr(std::move(ptrExpr)), index(std::move(index)), value(std::move(value)) {}
 
         std::shared_ptr<TypedExpressionNode> getPtrExpr() const { return ptrExpr; }
@@ -323,7 +323,7 @@ namespace Ryntra::Compiler::Semantic {
 
     class TypedPtrFromArrayNode : public TypedExpressionNode {
     public:
-        TypedPtrFromArrayNode(std::string arrayName, std::shared_ptr<Type> type)
+        TypedPtrFromArrayNode(std::string arrayName, TypePtr type)
             : TypedExpressionNode(std::move(type)), arrayName(std::move(arrayName)) {}
 
         const std::string &getArrayName() const { return arrayName; }
@@ -341,7 +341,7 @@ namespace Ryntra::Compiler::Semantic {
 
     class TypedPtrOffsetNode : public TypedExpressionNode {
     public:
-        TypedPtrOffsetNode(std::string ptrVarName, std::shared_ptr<TypedExpressionNode> offset, bool isAdd, std::shared_ptr<Type> type)
+        TypedPtrOffsetNode(std::string ptrVarName, std::shared_ptr<TypedExpressionNode> offset, bool isAdd, TypePtr type)
             : TypedExpressionNode(std::move(type)), ptrVarName(std::move(ptrVarName)), offset(std::move(offset)), isAdd(isAdd) {}
 
         const std::string &getPtrVarName() const { return ptrVarName; }
@@ -366,7 +366,7 @@ namespace Ryntra::Compiler::Semantic {
 
     class TypedPtrDiffNode : public TypedExpressionNode {
     public:
-        TypedPtrDiffNode(std::string leftPtrName, std::string rightPtrName, std::shared_ptr<Type> type)
+        TypedPtrDiffNode(std::string leftPtrName, std::string rightPtrName, TypePtr type)
             : TypedExpressionNode(std::move(type)), leftPtrName(std::move(leftPtrName)), rightPtrName(std::move(rightPtrName)) {}
 
         const std::string &getLeftPtrName() const { return leftPtrName; }
@@ -514,12 +514,12 @@ namespace Ryntra::Compiler::Semantic {
     class TypedFunctionDefinitionNode : public ITypedASTNode {
     public:
         TypedFunctionDefinitionNode(std::string name,
-                                     std::shared_ptr<Type> returnType,
+                                     TypePtr returnType,
                                      std::shared_ptr<TypedBlockNode> body)
             : name(std::move(name)), returnType(std::move(returnType)), body(std::move(body)) {}
 
         const std::string &getName() const { return name; }
-        std::shared_ptr<Type> getReturnType() const { return returnType; }
+        TypePtr getReturnType() const { return returnType; }
         std::shared_ptr<TypedBlockNode> getBody() const { return body; }
 
         void accept(ITypedVisitor &visitor) override { visitor.visit(*this); }
@@ -532,7 +532,7 @@ namespace Ryntra::Compiler::Semantic {
 
     private:
         std::string name;
-        std::shared_ptr<Type> returnType;
+        TypePtr returnType;
         std::shared_ptr<TypedBlockNode> body;
     };
 
@@ -131,11 +131,11 @@ namespace Ryntra::Compiler::Semantic {
 
     class TypedExpressionNode : public ITypedASTNode {
     public:
-        explicit TypedExpressionNode(std::shared_ptr<Type> type) : type(std::move(type)) {}
-        std::shared_ptr<Type> getType() const { return type; }
+        explicit TypedExpressionNode(TypePtr type) : type(std::move(type)) {}
+        TypePtr getType() const { return type; }
 
     protected:
-        std::shared_ptr<Type> type;
+        TypePtr type;
     };
 
     class TypedStatementNode : public ITypedASTNode {};
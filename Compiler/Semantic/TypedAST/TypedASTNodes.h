@@ -7,7 +7,7 @@
 namespace Ryntra::Compiler::Semantic {
     class TypedStringLiteralNode : public TypedExpressionNode {
     public:
-        TypedStringLiteralNode(std::string value, std::shared_ptr<Type> type)
+        TypedStringLiteralNode(std::string value, TypePtr type)
             : TypedExpressionNode(std::move(type)), value(std::move(value)) {}
 
         const std::string &getValue() const { return value; }
@@ -24,7 +24,7 @@ namespace Ryntra::Compiler::Semantic {
 
     class TypedBoolLiteralNode : public TypedExpressionNode {
     public:
-        TypedBoolLiteralNode(bool value, std::shared_ptr<Type> type)
+        TypedBoolLiteralNode(bool value, TypePtr type)
             : TypedExpressionNode(std::move(type)), value(value) {}
 
         bool getValue() const { return value; }
@@ -41,7 +41,7 @@ namespace Ryntra::Compiler::Semantic {
 
     class TypedIntegerLiteralNode : public TypedExpressionNode {
     public:
-        TypedIntegerLiteralNode(int value, std::shared_ptr<Type> type)
+        TypedIntegerLiteralNode(int value, TypePtr type)
             : TypedExpressionNode(std::move(type)), value(value) {}
 
         int getValue() const { return value; }
@@ -58,7 +58,7 @@ namespace Ryntra::Compiler::Semantic {
 
     class TypedLongLiteralNode : public TypedExpressionNode {
     public:
-        TypedLongLiteralNode(int64_t value, std::shared_ptr<Type> type)
+        TypedLongLiteralNode(int64_t value, TypePtr type)
             : TypedExpressionNode(std::move(type)), value(value) {}
 
         int64_t getValue() const { return value; }
@@ -75,7 +75,7 @@ namespace Ryntra::Compiler::Semantic {
 
     class TypedIdentifierNode : public TypedExpressionNode {
     public:
-        TypedIdentifierNode(std::string name, std::shared_ptr<Type> type)
+        TypedIdentifierNode(std::string name, TypePtr type)
             : TypedExpressionNode(std::move(type)), name(std::move(name)) {}
 
         const std::string &getName() const { return name; }
@@ -94,7 +94,7 @@ namespace Ryntra::Compiler::Semantic {
     public:
         TypedFunctionCallNode(std::shared_ptr<TypedIdentifierNode> funcName,
                                std::vector<std::shared_ptr<TypedExpressionNode>> args,
-                               std::shared_ptr<Type> type)
+                               TypePtr type)
             : TypedExpressionNode(std::move(type)), functionName(std::move(funcName)), arguments(std::move(args)) {}
 
         std::shared_ptr<TypedIdentifierNode> getFunctionName() const { return functionName; }
@@ -121,7 +121,7 @@ namespace Ryntra::Compiler::Semantic {
 
     class TypedVariableNode : public TypedExpressionNode {
     public:
-        TypedVariableNode(std::string name, std::shared_ptr<Type> type)
+        TypedVariableNode(std::string name, TypePtr type)
             : TypedExpressionNode(std::move(type)), name(std::move(name)) {}
 
         const std::string &getName() const { return name; }
@@ -174,11 +174,11 @@ namespace Ryntra::Compiler::Semantic {
 
     class TypedVariableDeclarationNode : public TypedStatementNode {
     public:
-        TypedVariableDeclarationNode(std::string name, std::shared_ptr<Type> type, std::shared_ptr<TypedExpressionNode> init)
+        TypedVariableDeclarationNode(std::string name, TypePtr type, std::shared_ptr<TypedExpressionNode> init)
             : name(std::move(name)), type(std::move(type)), initializer(std::move(init)) {}
 
         const std::string &getName() const { return name; }
-        std::shared_ptr<Type> getType() const { return type; }
+        TypePtr getType() const { return type; }
         std::shared_ptr<TypedExpressionNode> getInitializer() const { return initializer; }
 
         void accept(ITypedVisitor &visitor) override { visitor.visit(*this); }
@@ -193,19 +193,19 @@ namespace Ryntra::Compiler::Semantic {
 
     private:
         std::string name;
-        std::shared_ptr<Type> type;
+        TypePtr type;
         std::shared_ptr<TypedExpressionNode> initializer;
     };
 
     class TypedArrayDeclarationNode : public TypedStatementNode {
     public:
         TypedArrayDeclarationNode(std::string name,
-                                    std::shared_ptr<Type> elementType,
+                                    TypePtr elementType,
                                     std::shared_ptr<TypedExpressionNode> size)
             : name(std::move(name)), elementType(std::move(elementType)), size(std::move(size)) {}
 
         const std::string &getName() const { return name; }
-        std::shared_ptr<Type> getElementType() const { return elementType; }
+        TypePtr getElementType() const { return elementType; }
         std::shared_ptr<TypedExpressionNode> getSize() const { return size; }
 
         void accept(ITypedVisitor &visitor) override { visitor.visit(*this); }
@@ -222,7 +222,7 @@ namespace Ryntra::Compiler::Semantic {
 
     private:
         std::string name;
-        std::shared_ptr<Type> elementType;
+        TypePtr elementType;
         std::shared_ptr<TypedExpressionNode> size;
     };
 
@@ -230,7 +230,7 @@ namespace Ryntra::Compiler::Semantic {
     public:
         TypedArrayIndexAccessNode(std::string arrayName,
                                    std::shared_ptr<TypedExpressionNode> index,
-                                   std::shared_ptr<Type> type)
+                                   TypePtr type)
             : TypedExpressionNode(std::move(type)), arrayName(std::move(arrayName)), index(std::move(index)) {}
 
         const std::string &getArrayName() const { return arrayName; }
@@ -256,7 +256,7 @@ namespace Ryntra::Compiler::Semantic {
         TypedArrayIndexAssignmentNode(std::string arrayName,
                                        std::shared_ptr<TypedExpressionNode> index,
                                        std::shared_ptr<TypedExpressionNode> value,
-                                       std::shared_ptr<Type> type)
+                                       TypePtr type)
             : TypedExpressionNode(std::move(type)), arrayName(std::move(arrayName)), index(std::move(index)), value(std::move(value)) {}
 
         const std::string &getArrayName() const { return arrayName; }
@@ -284,7 +284,7 @@ namespace Ryntra::Compiler::Semantic {
 
     class TypedBinaryOpNode : public TypedExpressionNode {
     public:
-        TypedBinaryOpNode(std::shared_ptr<TypedExpressionNode> left, BinaryOpType op, std::shared_ptr<TypedExpressionNode> right, std::shared_ptr<Type> type)
+        TypedBinaryOpNode(std::shared_ptr<TypedExpressionNode> left, BinaryOpType op, std::shared_ptr<TypedExpressionNode> right, TypePtr type)
             : TypedExpressionNode(std::move(type)), left(std::move(left)), op(op), right(std::move(right)) {}
 
         std::shared_ptr<TypedExpressionNode> getLeft() const { return left; }
@@ -347,7 +347,7 @@ namespace Ryntra::Compiler::Semantic {
 
     class TypedUnaryOpNode : public TypedExpressionNode {
     public:
-        TypedUnaryOpNode(UnaryOpType op, std::shared_ptr<TypedExpressionNode> operand, std::shared_ptr<Type> type)
+        TypedUnaryOpNode(UnaryOpType op, std::shared_ptr<TypedExpressionNode> operand, TypePtr type)
             : TypedExpressionNode(std::move(type)), op(op), operand(std::move(operand)) {}
 
         UnaryOpType getOp() const { return op; }
@@ -381,7 +381,7 @@ namespace Ryntra::Compiler::Semantic {
 
     class TypedPrefixOpNode : public TypedExpressionNode {
     public:
-        TypedPrefixOpNode(std::string variableName, IncDecOpType op, std::shared_ptr<Type> type)
+        TypedPrefixOpNode(std::string variableName, IncDecOpType op, TypePtr type)
             : TypedExpressionNode(std::move(type)), variableName(std::move(variableName)), op(op) {}
 
         const std::string &getVariableName() const { return variableName; }
@@ -404,7 +404,7 @@ namespace Ryntra::Compiler::Semantic {
 
     class TypedPostfixOpNode : public TypedExpressionNode {
     public:
-        TypedPostfixOpNode(std::string variableName, IncDecOpType op, std::shared_ptr<Type> type)
+        TypedPostfixOpNode(std::string variableName, IncDecOpType op, TypePtr type)
             : TypedExpressionNode(std::move(type)), variableName(std::move(variableName)), op(op) {}
 
         const std::string &getVariableName() const { return variableName; }
@@ -427,7 +427,7 @@ namespace Ryntra::Compiler::Semantic {
 
     class TypedCastNode : public TypedExpressionNode {
     public:
-        TypedCastNode(std::shared_ptr<TypedExpressionNode> operand, std::shared_ptr<Type> targetType)
+        TypedCastNode(std::shared_ptr<TypedExpressionNode> operand, TypePtr targetType)
             : TypedExpressionNode(std::move(targetType)), operand(std::move(operand)) {}
 
         std::shared_ptr<TypedExpressionNode> getOperand() const { return operand; }
@@ -448,7 +448,7 @@ namespace Ryntra::Compiler::Semantic {
 
     class TypedComparisonNode : public TypedExpressionNode {
     public:
-        TypedComparisonNode(std::shared_ptr<TypedExpressionNode> left, ComparisonOpType op, std::shared_ptr<TypedExpressionNode> right, std::shared_ptr<Type> type)
+        TypedComparisonNode(std::shared_ptr<TypedExpressionNode> left, ComparisonOpType op, std::shared_ptr<TypedExpressionNode> right, TypePtr type)
             : TypedExpressionNode(std::move(type)), left(std::move(left)), op(op), right(std::move(right)) {}
 
         std::shared_ptr<TypedExpressionNode> getLeft() const { return left; }
@@ -487,7 +487,7 @@ namespace Ryntra::Compiler::Semantic {
 
     class TypedConditionalAndNode : public TypedExpressionNode {
     public:
-        TypedConditionalAndNode(std::shared_ptr<TypedExpressionNode> left, std::shared_ptr<TypedExpressionNode> right, std::shared_ptr<Type> type)
+        TypedConditionalAndNode(std::shared_ptr<TypedExpressionNode> left, std::shared_ptr<TypedExpressionNode> right, TypePtr type)
             : TypedExpressionNode(std::move(type)), left(std::move(left)), right(std::move(right)) {}
 
         std::shared_ptr<TypedExpressionNode> getLeft() const { return left; }
@@ -513,7 +513,7 @@ namespace Ryntra::Compiler::Semantic {
 
     class TypedConditionalOrNode : public TypedExpressionNode {
     public:
-        TypedConditionalOrNode(std::shared_ptr<TypedExpressionNode> left, std::shared_ptr<TypedExpressionNode> right, std::shared_ptr<Type> type)
+        TypedConditionalOrNode(std::shared_ptr<TypedExpressionNode> left, std::shared_ptr<TypedExpressionNode> right, TypePtr type)
             : TypedExpressionNode(std::move(type)), left(std::move(left)), right(std::move(right)) {}
 
         std::shared_ptr<TypedExpressionNode> getLeft() const { return left; }
@@ -539,7 +539,7 @@ namespace Ryntra::Compiler::Semantic {
 
     class TypedAssignmentNode : public TypedExpressionNode {
     public:
-        TypedAssignmentNode(std::string variableName, std::shared_ptr<TypedExpressionNode> rhs, std::shared_ptr<Type> type)
+        TypedAssignmentNode(std::string variableName, std::shared_ptr<TypedExpressionNode> rhs, TypePtr type)
             : TypedExpressionNode(std::move(type)), variableName(std::move(variableName)), rhs(std::move(rhs)) {}
 
         const std::string &getVariableName() const { return variableName; }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <vector>
@@ -37,6 +38,7 @@ namespace Ryntra::VM {
             LoadLocal,      // Load value from local variable slot onto stack
             Jmp,            // Unconditional jump to instruction offset
             Jz,             // Pop value, jump if zero to instruction offset
+            Jnz,            // Pop value, jump if nonzero to instruction offset
             NewArray,       // Pop size, create array, push reference
             ArrGet,         // Pop index, pop array, push element
             ArrSet,         // Pop value, pop index, pop array, set element
@@ -53,10 +55,15 @@ namespace Ryntra::VM {
             PinArray,       // Pop ptr, pin array (no-op currently)
             UnpinArray,     // Pop ptr, unpin array (no-op currently)
             PtrFromArray,   // Pop array value, create pointer to element 0
+            Snapshot,       // Write a snapshot if enabled, push bool: 0 normally, 1 once restored
             Halt            // Stop execution
     };
     // clang-format on
 
+    inline constexpr size_t kOpCodeCount = static_cast<size_t>(OpCode::Halt) + 1; // Halt must stay last
+
+    const char *getOpCodeName(OpCode op);
+
     struct Instruction {
         OpCode opcode;
         int32_t operand; // Index into constant pool or other data
@@ -65,10 +72,79 @@ namespace Ryntra::VM {
             : opcode(op), operand(operand) {}
     };
 
+    // Maps bytecode offsets to source lines. It lives beside the instruction stream, so the
+    // interpreter loop never touches it. A row is only added when the line changes and is
+    // stored as two LEB128 varints: the offset delta and the zig-zag encoded line delta.
+    class LineTable {
+    public:
+        LineTable() = default;
+
+        // A table restored from its encoded rows (see getData()); it is only meant to be read
+        explicit LineTable(std::vector<uint8_t> data) : data_(std::move(data)) {}
+
+        // Offsets must be added in increasing order; line 0 means "unknown" and is skipped
+        void addEntry(size_t offset, int line) {
+            if (line <= 0 || line == lastLine_)
+                return;
+            writeVarint(offset - lastOffset_);
+            int64_t delta = static_cast<int64_t>(line) - lastLine_;
+            writeVarint(static_cast<uint64_t>((delta << 1) ^ (delta >> 63)));
+            lastOffset_ = offset;
+            lastLine_ = line;
+        }
+
+        // Returns the line of the instruction at offset, or 0 if unknown
+        int getLine(size_t offset) const {
+            size_t pos = 0;
+            size_t rowOffset = 0;
+            int line = 0;
+            while (pos < data_.size()) {
+                size_t nextOffset = rowOffset + static_cast<size_t>(readVarint(pos));
+                uint64_t zigzag = readVarint(pos);
+                auto delta = static_cast<int64_t>(zigzag >> 1) ^ -static_cast<int64_t>(zigzag & 1);
+                if (nextOffset > offset)
+                    break;
+                rowOffset = nextOffset;
+                line = static_cast<int>(line + delta);
+            }
+            return line;
+        }
+
+        bool empty() const { return data_.empty(); }
+        const std::vector<uint8_t> &getData() const { return data_; }
+
+    private:
+        void writeVarint(uint64_t value) {
+            while (value >= 0x80) {
+                data_.push_back(static_cast<uint8_t>(value | 0x80));
+                value >>= 7;
+            }
+            data_.push_back(static_cast<uint8_t>(value));
+        }
+
+        uint64_t readVarint(size_t &pos) const {
+            uint64_t value = 0;
+            int shift = 0;
+            while (pos < data_.size()) {
+                uint8_t byte = data_[pos++];
+                value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+                if (!(byte & 0x80))
+                    break;
+                shift += 7;
+            }
+            return value;
+        }
+
+        std::vector<uint8_t> data_;
+        size_t lastOffset_ = 0;
+        int lastLine_ = 0;
+    };
+
     class BytecodeFunction {
     public:
         std::string name;
         std::vector<Instruction> instructions;
+        LineTable lineTable; // debug info only, never read while executing
         bool isExternal;
         int32_t paramCount; // number of parameters this function expects
 
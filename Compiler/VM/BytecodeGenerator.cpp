@@ -1,11 +1,102 @@
 #include "BytecodeGenerator.h"
+#include "Compiler/IR/Analysis/LoopInfo.h"
 #include "Compiler/IR/Constant.h"
 #include "Compiler/IR/Function.h"
 #include "Compiler/IR/ImmediateValue.h"
 #include "Compiler/IR/Instruction.h"
+#include "Compiler/IR/UndefValue.h"
+#include <algorithm>
+#include <array>
+#include <optional>
 #include <stdexcept>
+#include <string_view>
 
 namespace Ryntra::VM {
+    namespace {
+        // A call whose result nothing reads gets no slot; the result is popped instead
+        bool isDiscardedCall(const IR::Instruction &inst) {
+            return inst.getOpcode() == IR::Instruction::Opcode::Call && !inst.getType()->isVoid() && !inst.hasUsers();
+        }
+
+        // Rotates every loop whose header tests the exit so the header comes right after its
+        // latch: an iteration then ends in one conditional jump back instead of a jump to the
+        // header followed by the header's test. Only done when the loop's blocks are contiguous
+        // and the exit follows them, so the header's exit edge stays a fallthrough.
+        void rotateLoops(const IR::ControlFlowGraph &cfg, std::vector<size_t> &order) {
+            IR::DominatorTree domTree(cfg);
+            IR::LoopInfo loopInfo(cfg, domTree);
+            std::vector<size_t> position(cfg.size());
+            for (const auto &loop : loopInfo.getLoops()) {
+                for (size_t i = 0; i < order.size(); ++i)
+                    position[order[i]] = i;
+
+                const auto &successors = cfg.getSuccessors(loop.header);
+                if (loop.header == 0 || loop.latches.size() != 1 || successors.size() != 2 ||
+                    loop.contains[successors[0]] == loop.contains[successors[1]])
+                    continue;
+                size_t exit = loop.contains[successors[0]] ? successors[1] : successors[0];
+                size_t latch = loop.latches[0];
+                if (latch == loop.header || cfg.getSuccessors(latch).size() != 1)
+                    continue;
+
+                size_t first = position[loop.header];
+                size_t end = first + loop.blocks.size();
+                if (end >= order.size() || order[end] != exit || position[latch] != end - 1)
+                    continue;
+                if (!std::all_of(order.begin() + first, order.begin() + end,
+                                 [&](size_t block) { return loop.contains[block]; }))
+                    continue;
+                std::rotate(order.begin() + first, order.begin() + first + 1, order.begin() + end);
+            }
+        }
+
+        // The order blocks are emitted in: reverse post-order, visiting each block's first
+        // successor last so it lands right after the block (a condbr's true block, a br's
+        // target), then unreachable blocks. A last block without a terminator returns by falling
+        // off the end, so it stays last; in a single-block function that block is also the entry.
+        std::vector<size_t> layoutBlocks(const IR::Function &function) {
+            IR::ControlFlowGraph cfg(function);
+            size_t last = cfg.size() - 1;
+            bool pinLast = IR::ControlFlowGraph::getTerminatorIndex(*cfg.getBlock(last)) ==
+                           cfg.getBlock(last)->getInstructions().size();
+
+            std::vector<bool> visited(cfg.size(), false);
+            std::vector<std::pair<size_t, size_t>> stack; // (block, successors visited)
+            std::vector<size_t> postOrder;
+            stack.emplace_back(0, 0);
+            visited[0] = true;
+            while (!stack.empty()) {
+                auto &[block, next] = stack.back();
+                const auto &successors = cfg.getSuccessors(block);
+                if (next < successors.size()) {
+                    size_t successor = successors[successors.size() - 1 - next++];
+                    if (!visited[successor]) {
+                        visited[successor] = true;
+                        stack.emplace_back(successor, 0);
+                    }
+                    continue;
+                }
+                postOrder.push_back(block);
+                stack.pop_back();
+            }
+
+            std::vector<size_t> order;
+            for (auto block = postOrder.rbegin(); block != postOrder.rend(); ++block) {
+                if (!pinLast || *block != last)
+                    order.push_back(*block);
+            }
+            for (size_t block = 0; block < cfg.size(); ++block) {
+                if (!visited[block] && (!pinLast || block != last))
+                    order.push_back(block);
+            }
+            if (pinLast)
+                order.push_back(last);
+
+            rotateLoops(cfg, order);
+            return order;
+        }
+    } // namespace
+
     BytecodeGenerator::BytecodeGenerator() = default;
 
     std::vector<std::shared_ptr<BytecodeFunction>> BytecodeGenerator::generate(
@@ -35,10 +126,8 @@ namespace Ryntra::VM {
         return functions_;
     }
 
-    void BytecodeGenerator::generateFunction(const std::shared_ptr<IR::Function> &func) {
-        instructionSlots_.clear();
-        allocaSlotMap_.clear();
-        nextSlot_ = 0;
+    void BytecodeGenerator::generateFunction(IR::Function *func) {
+        assignSlots(*func);
 
         // Find the matching BytecodeFunction index
         int32_t idx = getFunctionIndex(func->getName());
@@ -46,10 +135,43 @@ namespace Ryntra::VM {
 
         blockOffsets_.clear();
         fixups_.clear();
-
-        for (const auto &block : func->getBasicBlocks()) {
+        blocksByName_.clear();
+        for (const auto &block : func->getBasicBlocks())
+            blocksByName_[block->getName()] = block;
+
+        const auto &blocks = func->getBasicBlocks();
+        if (blocks.empty())
+            return;
+        auto order = layoutBlocks(*func);
+        stubs_.clear();
+        for (size_t i = 0; i < order.size(); ++i) {
+            const auto &block = blocks[order[i]];
             blockOffsets_[block->getName()] = static_cast<int32_t>(currentFunction_->instructions.size());
-            generateBasicBlock(block);
+            nextBlockName_ = i + 1 < order.size() ? blocks[order[i + 1]]->getName() : "";
+            generateBasicBlock(block, order[i] + 1 < blocks.size() ? blocks[order[i] + 1]->getName() : "");
+        }
+
+        // Edge stubs go behind the last block. If that one returns by falling off the end, it
+        // now has to jump past them.
+        if (!stubs_.empty()) {
+            const auto &lastBlock = *blocks[order.back()];
+            std::optional<size_t> endJmpIdx;
+            if (IR::ControlFlowGraph::getTerminatorIndex(lastBlock) == lastBlock.getInstructions().size() &&
+                order.back() + 1 == blocks.size()) {
+                endJmpIdx = currentFunction_->instructions.size();
+                currentFunction_->addInstruction(OpCode::Jmp, 0);
+            }
+            nextBlockName_.clear();
+            for (const auto &stub : stubs_) {
+                currentBlock_ = stub.from;
+                currentFunction_->instructions[stub.jumpIndex].operand =
+                    static_cast<int32_t>(currentFunction_->instructions.size());
+                emitPhiCopies(stub.targetBlockName);
+                emitJump(stub.targetBlockName);
+            }
+            if (endJmpIdx)
+                currentFunction_->instructions[*endJmpIdx].operand =
+                    static_cast<int32_t>(currentFunction_->instructions.size());
         }
 
         // Resolve fixups: patch branch target offsets
@@ -61,14 +183,106 @@ namespace Ryntra::VM {
         }
     }
 
-    void BytecodeGenerator::generateBasicBlock(const std::shared_ptr<IR::BasicBlock> &block) {
+    void BytecodeGenerator::assignSlots(const IR::Function &func) {
+        // Slots are handed out in layout order before any code is emitted, so a phi already has
+        // one when a predecessor laid out ahead of it stores into it
+        instructionSlots_.clear();
+        allocaSlotMap_.clear();
+        nextSlot_ = 0;
+        for (const auto &block : func.getBasicBlocks()) {
+            for (const auto &inst : block->getInstructions()) {
+                if (inst->getOpcode() == IR::Instruction::Opcode::Alloca)
+                    allocaSlotMap_[inst] = nextSlot_++;
+                else if (inst->getOpcode() != IR::Instruction::Opcode::Constant && !inst->getType()->isVoid() &&
+                         !isDiscardedCall(*inst))
+                    instructionSlots_[inst] = nextSlot_++;
+            }
+        }
+    }
+
+    void BytecodeGenerator::generateBasicBlock(IR::BasicBlock *block,
+                                               const std::string &fallthroughBlockName) {
+        currentBlock_ = block;
+        // Nothing behind the terminator runs, and a branch to the next block emits no jump
+        // that would skip it
         for (const auto &inst : block->getInstructions()) {
             generateInstruction(inst);
+            if (inst->isTerminator())
+                return;
+        }
+        // Falling through into the next block is an edge too, and may need a jump now that the
+        // layout can put another block there
+        if (!fallthroughBlockName.empty()) {
+            emitPhiCopies(fallthroughBlockName);
+            emitJump(fallthroughBlockName);
+        }
+    }
+
+    void BytecodeGenerator::emitJump(const std::string &targetBlockName) {
+        if (targetBlockName == nextBlockName_)
+            return;
+        size_t instIdx = currentFunction_->instructions.size();
+        currentFunction_->addInstruction(OpCode::Jmp, 0);
+        fixups_.push_back({instIdx, targetBlockName});
+    }
+
+    void BytecodeGenerator::emitConditionalJump(OpCode opcode, const std::string &targetBlockName) {
+        size_t instIdx = currentFunction_->instructions.size();
+        currentFunction_->addInstruction(opcode, 0);
+        // Copies for this edge must not run on the other one, so they get their own stub
+        if (hasPhiCopies(targetBlockName))
+            stubs_.push_back({instIdx, targetBlockName, currentBlock_});
+        else
+            fixups_.push_back({instIdx, targetBlockName});
+    }
+
+    bool BytecodeGenerator::hasPhiCopies(const std::string &targetBlockName) const {
+        auto it = blocksByName_.find(targetBlockName);
+        if (it == blocksByName_.end())
+            return false;
+        for (const auto &inst : it->second->getInstructions()) {
+            if (inst->getOpcode() != IR::Instruction::Opcode::Phi)
+                break;
+            for (size_t i = 0; i < inst->getIncomingCount(); ++i) {
+                if (inst->getIncomingBlock(i) == currentBlock_->getName()) {
+                    if (!dynamic_cast<IR::UndefValue *>(inst->getIncomingValue(i)))
+                        return true;
+                    break;
+                }
+            }
         }
+        return false;
     }
 
-    void BytecodeGenerator::pushOperandValue(const std::shared_ptr<IR::Value> &operand) {
-        if (auto imm = std::dynamic_pointer_cast<IR::ImmediateValue>(operand)) {
+    bool BytecodeGenerator::emitPhiCopies(const std::string &targetBlockName) {
+        auto it = blocksByName_.find(targetBlockName);
+        if (it == blocksByName_.end())
+            return false;
+
+        std::vector<int32_t> slots;
+        for (const auto &inst : it->second->getInstructions()) {
+            if (inst->getOpcode() != IR::Instruction::Opcode::Phi)
+                break;
+            for (size_t i = 0; i < inst->getIncomingCount(); ++i) {
+                if (inst->getIncomingBlock(i) != currentBlock_->getName())
+                    continue;
+                if (!dynamic_cast<IR::UndefValue *>(inst->getIncomingValue(i))) {
+                    pushOperandValue(inst->getIncomingValue(i));
+                    slots.push_back(instructionSlots_.at(inst));
+                }
+                break;
+            }
+        }
+
+        // Every incoming value is on the stack before the first store, so phis that read each
+        // other (a swap in a loop) see the values from before the edge
+        for (auto slot = slots.rbegin(); slot != slots.rend(); ++slot)
+            currentFunction_->addInstruction(OpCode::StoreLocal, *slot);
+        return !slots.empty();
+    }
+
+    void BytecodeGenerator::pushOperandValue(IR::Value *operand) {
+        if (auto imm = dynamic_cast<IR::ImmediateValue *>(operand)) {
             VMValue val;
             if (imm->getType()->isInt32()) {
                 std::string repr = imm->toString();
@@ -91,13 +305,16 @@ namespace Ryntra::VM {
             }
             int32_t poolIdx = addConstant(val);
             currentFunction_->addInstruction(OpCode::LoadConst, poolIdx);
-        } else if (auto argInst = std::dynamic_pointer_cast<IR::Instruction>(operand)) {
+        } else if (dynamic_cast<IR::UndefValue *>(operand)) {
+            // Reading a variable before it was assigned: what an unwritten local slot holds
+            currentFunction_->addInstruction(OpCode::LoadConst, addConstant(VMValue()));
+        } else if (auto argInst = dynamic_cast<IR::Instruction *>(operand)) {
             if (argInst->getOpcode() == IR::Instruction::Opcode::Constant) {
                 if (!argInst->getOperands().empty()) {
                     pushOperandValue(argInst->getOperands()[0]);
                 }
             } else {
-                auto it = instructionSlots_.find(argInst.get());
+                auto it = instructionSlots_.find(argInst);
                 if (it != instructionSlots_.end()) {
                     currentFunction_->addInstruction(OpCode::LoadLocal, it->second);
                 }
@@ -105,21 +322,25 @@ namespace Ryntra::VM {
         }
     }
 
-    void BytecodeGenerator::generateInstruction(const std::shared_ptr<IR::Instruction> &inst) {
+    void BytecodeGenerator::generateInstruction(IR::Instruction *inst) {
         const auto &operands = inst->getOperands();
 
-        // Assign a local slot for instructions that produce a runtime value
-        bool needsSlot = inst->getOpcode() != IR::Instruction::Opcode::Constant && !inst->getType()->isVoid();
+        // Everything emitted below belongs to this instruction's source line
+        currentFunction_->lineTable.addEntry(currentFunction_->instructions.size(), inst->getLocation().line);
+
+        // Instructions that produce a runtime value store it in their slot; a phi's slot is
+        // written by its predecessors instead
         int32_t slot = -1;
-        if (needsSlot) {
-            slot = nextSlot_++;
-            instructionSlots_[inst.get()] = slot;
+        if (inst->getOpcode() != IR::Instruction::Opcode::Phi) {
+            auto it = instructionSlots_.find(inst);
+            if (it != instructionSlots_.end())
+                slot = it->second;
         }
 
         switch (inst->getOpcode()) {
         case IR::Instruction::Opcode::LoadConstant: {
             if (!operands.empty()) {
-                auto constant = std::dynamic_pointer_cast<IR::Constant>(operands[0]);
+                auto constant = dynamic_cast<IR::Constant *>(operands[0]);
                 if (constant) {
                     VMValue val;
                     if (constant->getType()->isInt32()) {
@@ -145,10 +366,13 @@ namespace Ryntra::VM {
 
         case IR::Instruction::Opcode::Call: {
             if (!operands.empty()) {
-                auto callee = std::dynamic_pointer_cast<IR::Function>(operands[0]);
+                auto callee = dynamic_cast<IR::Function *>(operands[0]);
                 if (callee) {
                     const std::string &name = callee->getName();
-                    if (name.rfind("__builtin_", 0) == 0) {
+                    if (name == "__builtin_snapshot") {
+                        // Not a host builtin: it captures the interpreter's own state
+                        currentFunction_->addInstruction(OpCode::Snapshot);
+                    } else if (name.rfind("__builtin_", 0) == 0) {
                         // Push argument values onto the stack before the call
                         for (size_t i = 1; i < operands.size(); ++i) {
                             pushOperandValue(operands[i]);
@@ -279,16 +503,16 @@ namespace Ryntra::VM {
             break;
         }
 
-        case IR::Instruction::Opcode::Alloca: {
-            int32_t slotNum = nextSlot_++;
-            allocaSlotMap_[inst.get()] = slotNum;
+        case IR::Instruction::Opcode::Alloca:
+        case IR::Instruction::Opcode::Phi: {
+            // Slots were assigned up front
             break;
         }
 
         case IR::Instruction::Opcode::Load: {
-            auto allocaInst = std::dynamic_pointer_cast<IR::Instruction>(operands[0]);
+            auto allocaInst = dynamic_cast<IR::Instruction *>(operands[0]);
             if (allocaInst) {
-                int32_t slotNum = allocaSlotMap_[allocaInst.get()];
+                int32_t slotNum = allocaSlotMap_[allocaInst];
                 currentFunction_->addInstruction(OpCode::LoadLocal, slotNum);
             }
             // Don't push operands — LoadLocal pushes the value directly
@@ -299,32 +523,34 @@ namespace Ryntra::VM {
         case IR::Instruction::Opcode::Store: {
             // operands[0] = value to store, operands[1] = alloca instruction
             pushOperandValue(operands[0]);
-            auto allocaInst = std::dynamic_pointer_cast<IR::Instruction>(operands[1]);
+            auto allocaInst = dynamic_cast<IR::Instruction *>(operands[1]);
             if (allocaInst) {
-                int32_t slotNum = allocaSlotMap_[allocaInst.get()];
+                int32_t slotNum = allocaSlotMap_[allocaInst];
                 currentFunction_->addInstruction(OpCode::StoreLocal, slotNum);
             }
             break;
         }
 
         case IR::Instruction::Opcode::Br: {
-            auto targetName = std::dynamic_pointer_cast<IR::ImmediateValue>(operands[0])->getLiteralValue();
-            size_t instIdx = currentFunction_->instructions.size();
-            currentFunction_->addInstruction(OpCode::Jmp, 0);
-            fixups_.push_back({instIdx, targetName});
+            auto targetName = dynamic_cast<IR::ImmediateValue *>(operands[0])->getLiteralValue();
+            emitPhiCopies(targetName);
+            emitJump(targetName);
             break;
         }
 
         case IR::Instruction::Opcode::CondBr: {
             pushOperandValue(operands[0]);
-            auto falseName = std::dynamic_pointer_cast<IR::ImmediateValue>(operands[2])->getLiteralValue();
-            size_t jzIdx = currentFunction_->instructions.size();
-            currentFunction_->addInstruction(OpCode::Jz, 0);
-            fixups_.push_back({jzIdx, falseName});
-            auto trueName = std::dynamic_pointer_cast<IR::ImmediateValue>(operands[1])->getLiteralValue();
-            size_t jmpIdx = currentFunction_->instructions.size();
-            currentFunction_->addInstruction(OpCode::Jmp, 0);
-            fixups_.push_back({jmpIdx, trueName});
+            auto trueName = dynamic_cast<IR::ImmediateValue *>(operands[1])->getLiteralValue();
+            auto falseName = dynamic_cast<IR::ImmediateValue *>(operands[2])->getLiteralValue();
+            if (falseName == nextBlockName_ && trueName != nextBlockName_) {
+                // Inverted, so the false block is reached by falling through
+                emitConditionalJump(OpCode::Jnz, trueName);
+                emitPhiCopies(falseName);
+                break;
+            }
+            emitConditionalJump(OpCode::Jz, falseName);
+            emitPhiCopies(trueName);
+            emitJump(trueName);
             break;
         }
 
@@ -354,9 +580,9 @@ namespace Ryntra::VM {
 
         case IR::Instruction::Opcode::RefCreate: {
             // operands[0] = alloca instruction
-            auto allocaInst = std::dynamic_pointer_cast<IR::Instruction>(operands[0]);
+            auto allocaInst = dynamic_cast<IR::Instruction *>(operands[0]);
             if (allocaInst) {
-                int32_t slotNum = allocaSlotMap_[allocaInst.get()];
+                int32_t slotNum = allocaSlotMap_[allocaInst];
                 // Push the slot index as a constant, then create ref
                 currentFunction_->addInstruction(OpCode::LoadConst, addConstant(VMValue(slotNum)));
                 currentFunction_->addInstruction(OpCode::RefCreate, 0);
@@ -381,10 +607,10 @@ namespace Ryntra::VM {
 
         case IR::Instruction::Opcode::PtrCreate: {
             // operands[0] = alloca instruction or computed slot value
-            auto allocaInst = std::dynamic_pointer_cast<IR::Instruction>(operands[0]);
-            if (allocaInst && allocaSlotMap_.count(allocaInst.get())) {
+            auto allocaInst = dynamic_cast<IR::Instruction *>(operands[0]);
+            if (allocaInst && allocaSlotMap_.count(allocaInst)) {
                 // alloca operand: emit the slot index directly
-                int32_t slotNum = allocaSlotMap_[allocaInst.get()];
+                int32_t slotNum = allocaSlotMap_[allocaInst];
                 currentFunction_->addInstruction(OpCode::LoadConst, addConstant(VMValue(slotNum)));
                 currentFunction_->addInstruction(OpCode::PtrCreate, 0);
             } else {
@@ -467,6 +693,10 @@ namespace Ryntra::VM {
 
         if (slot >= 0) {
             currentFunction_->addInstruction(OpCode::StoreLocal, slot);
+        } else if (isDiscardedCall(*inst)) {
+            // Pop leaves an empty stack alone, so a callee that fell off its end without
+            // returning a value is fine here
+            currentFunction_->addInstruction(OpCode::Pop);
         }
     }
 
@@ -484,7 +714,8 @@ namespace Ryntra::VM {
     }
 
     int32_t BytecodeGenerator::getBuiltinIndex(const std::string &name) {
-        static const std::vector<std::string> builtinTable = {
+        // Constant-initialized, so concurrent generators (--batch) never race on first use
+        static constexpr std::array<std::string_view, 8> builtinTable = {
             "__builtin_print",          // 0
             "__builtin_print_i32",      // 1 (int32 print)
             "__builtin_print_i64",      // 2 (int64 print)
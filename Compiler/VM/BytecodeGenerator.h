@@ -17,11 +17,24 @@ namespace Ryntra::VM {
         const std::vector<VMValue> &getConstantPool() const { return constantPool_; }
 
     private:
-        void generateFunction(const std::shared_ptr<IR::Function> &func);
-        void generateBasicBlock(const std::shared_ptr<IR::BasicBlock> &block);
-        void generateInstruction(const std::shared_ptr<IR::Instruction> &inst);
+        void generateFunction(IR::Function *func);
+        void assignSlots(const IR::Function &func);
+        // fallthroughBlockName is where the block continues if it has no terminator
+        void generateBasicBlock(IR::BasicBlock *block,
+                                const std::string &fallthroughBlockName);
+        void generateInstruction(IR::Instruction *inst);
 
-        void pushOperandValue(const std::shared_ptr<IR::Value> &operand);
+        // Phi elimination: on the edge from the current block to target, store each of target's
+        // phis' incoming values into the phi's slot. Returns false if target has no phis.
+        bool emitPhiCopies(const std::string &targetBlockName);
+        bool hasPhiCopies(const std::string &targetBlockName) const;
+
+        // A jump to target, or nothing if target is laid out next
+        void emitJump(const std::string &targetBlockName);
+        // Jz / Jnz to target; an edge with phi copies jumps to a stub emitted after the last block
+        void emitConditionalJump(OpCode opcode, const std::string &targetBlockName);
+
+        void pushOperandValue(IR::Value *operand);
 
         int32_t addConstant(const VMValue &value);
         int32_t getFunctionIndex(const std::string &name);
@@ -32,6 +45,12 @@ namespace Ryntra::VM {
             std::string targetBlockName;
         };
 
+        struct EdgeStub {
+            size_t jumpIndex;
+            std::string targetBlockName;
+            const IR::BasicBlock *from;
+        };
+
         std::vector<VMValue> constantPool_;
         std::vector<std::shared_ptr<BytecodeFunction>> functions_;
         std::unordered_map<std::string, int32_t> functionIndices_;
@@ -41,6 +60,10 @@ namespace Ryntra::VM {
         std::unordered_map<const IR::Value *, int32_t> allocaSlotMap_;
         int32_t nextSlot_;
         std::unordered_map<std::string, int32_t> blockOffsets_;
+        std::unordered_map<std::string, const IR::BasicBlock *> blocksByName_;
+        const IR::BasicBlock *currentBlock_ = nullptr;
+        std::string nextBlockName_; // laid out right after currentBlock_
         std::vector<Fixup> fixups_;
+        std::vector<EdgeStub> stubs_;
     };
 } // namespace Ryntra::VM
@@ -0,0 +1,977 @@
+#include "ExecutionContext.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace Ryntra::VM {
+    std::string Trap::getMessage() const {
+        static constexpr const char *kindNames[] = {"heap cells", "array elements", "call depth", "output bytes"};
+        return std::string("Resource limit exceeded: ") + kindNames[static_cast<size_t>(kind)] + " (limit " +
+               std::to_string(limit) + ")";
+    }
+
+    ExecutionContext::ExecutionContext(std::shared_ptr<const Program> program)
+        : program_(std::move(program)) {}
+
+    const BytecodeFunction *ExecutionContext::findEntry(const std::string &entryPoint) {
+        const BytecodeFunction *func = program_->getFunction(entryPoint);
+        if (!func) {
+            throw std::runtime_error("Entry point not found: " + entryPoint);
+        }
+        stack_.clear();
+        locals_.clear();
+        heap_.clear();
+        restoredHeapSize_ = 0;
+        restoredHeap_.clear();
+        loadHeapCell_ = nullptr;
+        snapshotArrays_.reset();
+        return func;
+    }
+
+    VMValue ExecutionContext::execute(const std::string &entryPoint) {
+        start(findEntry(entryPoint), 0, UnlimitedBudget);
+        NullTracer tracer;
+        return valueOrThrow(interpret(tracer));
+    }
+
+    VMValue ExecutionContext::execute(const std::string &entryPoint, Profiler &profiler) {
+        start(findEntry(entryPoint), 0, UnlimitedBudget);
+        return valueOrThrow(interpret(profiler));
+    }
+
+    VMValue ExecutionContext::execute(const std::string &entryPoint, SamplingProfiler &sampler) {
+        start(findEntry(entryPoint), 0, UnlimitedBudget);
+        sampler.start();
+        try {
+            VMValue result = interpret(sampler);
+            sampler.stop();
+            return valueOrThrow(std::move(result));
+        } catch (...) {
+            sampler.stop();
+            throw;
+        }
+    }
+
+    VMValue ExecutionContext::resume(const std::shared_ptr<const Snapshot> &snapshot) {
+        if (snapshot->getProgram() != program_)
+            throw std::runtime_error("Snapshot was taken from a different program");
+        auto restored = snapshot->restore();
+        stack_ = std::move(restored.frame.stack);
+        heap_.clear();
+        restoredHeapSize_ = restored.heapSize;
+        restoredHeap_.clear();
+        loadHeapCell_ = std::move(restored.loadHeapCell);
+        snapshotArrays_ = std::move(restored.arrays);
+        start(restored.frame.function, restored.frame.ip, UnlimitedBudget);
+        locals_ = std::move(restored.frame.locals);
+        for (auto &caller : restored.frame.callers)
+            frames_.push_back({caller.function, caller.returnIp, std::move(caller.locals)});
+        NullTracer tracer;
+        return valueOrThrow(interpret(tracer));
+    }
+
+    ExecutionResult ExecutionContext::run(const std::string &entryPoint, uint64_t budget) {
+        start(findEntry(entryPoint), 0, budget);
+        NullTracer tracer;
+        return makeResult(interpret(tracer));
+    }
+
+    ExecutionResult ExecutionContext::resume(uint64_t budget) {
+        if (!suspended_)
+            throw std::runtime_error("No suspended run to resume");
+        budget_ = budget;
+        NullTracer tracer;
+        return makeResult(interpret(tracer));
+    }
+
+    ExecutionResult ExecutionContext::makeResult(VMValue value) {
+        if (trap_)
+            return {ExecutionStatus::Trapped, {}, trap_};
+        return {suspended_ ? ExecutionStatus::Suspended : ExecutionStatus::Completed, std::move(value), std::nullopt};
+    }
+
+    VMValue ExecutionContext::valueOrThrow(VMValue value) const {
+        if (trap_)
+            throw RuntimeError(trap_->getMessage(), trap_->functionName, trap_->offset, trap_->line);
+        return value;
+    }
+
+    void ExecutionContext::writeOutput(std::string_view text) {
+        if (outputExceeded_ || text.size() > limits_.maxOutputBytes - outputBytes_) {
+            outputExceeded_ = true;
+            return;
+        }
+        outputBytes_ += text.size();
+        getIO().write(text);
+    }
+
+    void ExecutionContext::start(const BytecodeFunction *func, size_t ip, uint64_t budget) {
+        frames_.clear();
+        locals_.clear();
+        function_ = func;
+        ip_ = ip;
+        budget_ = budget;
+        suspended_ = false;
+        arrayElements_ = std::make_shared<uint64_t>(0);
+        outputBytes_ = 0;
+        outputExceeded_ = false;
+        trap_.reset();
+    }
+
+    template <typename Tracer>
+    VMValue ExecutionContext::interpret(Tracer &tracer) {
+        const auto &constantPool = program_->getConstantPool();
+        const auto &builtins = program_->getBuiltins();
+        const BytecodeFunction *func = function_;
+        size_t ip = ip_;
+        // Where the running frame last passed a budget check. Control only moves backwards at
+        // a check (a call, a return or a backward jump), so at most ip - segmentStart + 1
+        // instructions have run since then, and that is what the next check charges.
+        size_t segmentStart = ip;
+
+        // Charges cost to the budget; once it runs out, parks the run at ip for resume(uint64_t)
+        auto exhausted = [&](uint64_t cost) {
+            if (cost < budget_) {
+                budget_ -= cost;
+                return false;
+            }
+            budget_ = 0;
+            function_ = func;
+            ip_ = ip;
+            suspended_ = true;
+            return true;
+        };
+
+        // Pops func's frame; true once the entry function itself has returned
+        auto leave = [&](VMValue &result) {
+            tracer.leaveFunction(func);
+            if (frames_.empty())
+                return true;
+            auto &caller = frames_.back();
+            func = caller.function;
+            ip = caller.returnIp;
+            segmentStart = ip;
+            locals_ = std::move(caller.locals);
+            frames_.pop_back();
+            if (!result.isVoid())
+                push(result);
+            return false;
+        };
+
+        // Drops every active frame, telling the tracer each one was left
+        auto unwind = [&] {
+            tracer.leaveFunction(func);
+            while (!frames_.empty()) {
+                tracer.leaveFunction(frames_.back().function);
+                frames_.pop_back();
+            }
+        };
+
+        // Ends the run at ip with a trap instead of an error
+        auto trap = [&](TrapKind kind, uint64_t limit) {
+            trap_ = Trap{kind, limit, func->name, ip, func->lineTable.getLine(ip)};
+            unwind();
+        };
+
+        // A suspended run re-enters the frames it left, so only a fresh one is announced
+        bool resuming = suspended_;
+        suspended_ = false;
+        if (!resuming)
+            tracer.enterFunction(func);
+
+        try {
+            while (true) {
+                if (ip >= func->instructions.size()) {
+                    // Falling off the end returns void
+                    VMValue result;
+                    uint64_t cost = ip - segmentStart;
+                    if (leave(result))
+                        return result;
+                    if (exhausted(cost))
+                        return VMValue();
+                    continue;
+                }
+                const auto &inst = func->instructions[ip];
+                tracer.step(ip, inst.opcode);
+
+                switch (inst.opcode) {
+                case OpCode::LoadConst: {
+                    if (inst.operand >= 0 && inst.operand < static_cast<int32_t>(constantPool.size())) {
+                        push(constantPool[inst.operand]);
+                    }
+                    break;
+                }
+
+                case OpCode::Call: {
+                    if (inst.operand < 0 || static_cast<size_t>(inst.operand) >= program_->getFunctionCount()) {
+                        throw std::runtime_error("Invalid function index: " + std::to_string(inst.operand));
+                    }
+                    const auto *callee = program_->getFunction(static_cast<size_t>(inst.operand));
+
+                    // The callee's declared parameter count is taken off the stack; it starts with fresh locals
+                    for (int i = 0; i < callee->paramCount; ++i) {
+                        pop();
+                    }
+
+                    tracer.safepoint(ip);
+                    if (frames_.size() + 1 >= limits_.maxCallDepth) {
+                        trap(TrapKind::CallDepth, limits_.maxCallDepth);
+                        return VMValue();
+                    }
+                    uint64_t cost = ip - segmentStart + 1;
+                    frames_.push_back({func, ip + 1, std::move(locals_)});
+                    locals_.clear();
+                    func = callee;
+                    ip = 0;
+                    segmentStart = 0;
+                    tracer.enterFunction(func);
+                    if (exhausted(cost))
+                        return VMValue();
+                    continue;
+                }
+
+                case OpCode::BCall: {
+                    if (inst.operand < 0 || inst.operand >= static_cast<int32_t>(builtins.size())) {
+                        throw std::runtime_error("Invalid builtin index: " + std::to_string(inst.operand));
+                    }
+                    const auto &builtin = builtins[inst.operand];
+                    size_t argCount = static_cast<size_t>(builtin.argCount);
+                    std::vector<VMValue> callArgs(argCount);
+                    for (int i = static_cast<int>(argCount) - 1; i >= 0; --i) {
+                        callArgs[i] = pop();
+                    }
+                    VMValue result = builtin.function(*this, callArgs);
+                    if (outputExceeded_) {
+                        trap(TrapKind::OutputBytes, limits_.maxOutputBytes);
+                        return VMValue();
+                    }
+                    if (!result.isVoid())
+                        push(result);
+                    break;
+                }
+
+                case OpCode::Return: {
+                    VMValue result = stack_.empty() ? VMValue() : pop();
+                    uint64_t cost = ip - segmentStart + 1;
+                    if (leave(result))
+                        return result;
+                    if (exhausted(cost))
+                        return VMValue();
+                    continue;
+                }
+
+                case OpCode::Add: {
+                    auto b = pop();
+                    auto a = pop();
+                    if (a.isInt64() && b.isInt64())
+                        push(VMValue(a.asInt64() + b.asInt64()));
+                    else if (a.isInt32() && b.isInt32())
+                        push(VMValue(a.asInt32() + b.asInt32()));
+                    else if (a.isPointer() && b.isInt32()) {
+                        if (a.isArrayPointer()) {
+                            VMValue result;
+                            result.setArrayPointer(a.getPointerSlot() + b.asInt32(), a.getArrayPointerData());
+                            push(result);
+                        } else {
+                            push(VMValue(a.getPointerSlot() + b.asInt32()));
+                        }
+                    } else if (a.isPointer() && b.isInt64()) {
+                        auto offset = static_cast<int32_t>(b.asInt64());
+                        if (a.isArrayPointer()) {
+                            VMValue result;
+                            result.setArrayPointer(a.getPointerSlot() + offset, a.getArrayPointerData());
+                            push(result);
+                        } else {
+                            push(VMValue(a.getPointerSlot() + offset));
+                        }
+                    } else if (a.isInt32() && b.isPointer()) {
+                        if (b.isArrayPointer()) {
+                            VMValue result;
+                            result.setArrayPointer(a.asInt32() + b.getPointerSlot(), b.getArrayPointerData());
+                            push(result);
+                        } else {
+                            push(VMValue(a.asInt32() + b.getPointerSlot()));
+                        }
+                    } else if (a.isHeapPointer() && b.isInt32()) {
+                        VMValue result;
+                        result.setHeapPointerSlot(a.getHeapPointerSlot() + b.asInt32());
+                        push(result);
+                    } else if (a.isHeapPointer() && b.isInt64()) {
+                        VMValue result;
+                        result.setHeapPointerSlot(a.getHeapPointerSlot() + static_cast<int32_t>(b.asInt64()));
+                        push(result);
+                    } else if (a.isInt32() && b.isHeapPointer()) {
+                        VMValue result;
+                        result.setHeapPointerSlot(a.asInt32() + b.getHeapPointerSlot());
+                        push(result);
+                    }
+                    break;
+                }
+                case OpCode::Sub: {
+                    auto b = pop();
+                    auto a = pop();
+                    if (a.isInt64() && b.isInt64())
+                        push(VMValue(a.asInt64() - b.asInt64()));
+                    else if (a.isInt32() && b.isInt32())
+                        push(VMValue(a.asInt32() - b.asInt32()));
+                    else if (a.isPointer() && b.isInt32()) {
+                        if (a.isArrayPointer()) {
+                            VMValue result;
+                            result.setArrayPointer(a.getPointerSlot() - b.asInt32(), a.getArrayPointerData());
+                            push(result);
+                        } else {
+                            push(VMValue(a.getPointerSlot() - b.asInt32()));
+                        }
+                    } else if (a.isPointer() && b.isPointer())
+                        push(VMValue(a.getPointerSlot() - b.getPointerSlot()));
+                    else if (a.isHeapPointer() && b.isInt32()) {
+                        VMValue result;
+                        result.setHeapPointerSlot(a.getHeapPointerSlot() - b.asInt32());
+                        push(result);
+                    } else if (a.isHeapPointer() && b.isHeapPointer())
+                        push(VMValue(a.getHeapPointerSlot() - b.getHeapPointerSlot()));
+                    break;
+                }
+                case OpCode::Mul: {
+                    auto b = pop();
+                    auto a = pop();
+                    if (a.isInt64() && b.isInt64())
+                        push(VMValue(a.asInt64() * b.asInt64()));
+                    else if (a.isInt32() && b.isInt32())
+                        push(VMValue(a.asInt32() * b.asInt32()));
+                    break;
+                }
+                case OpCode::Div: {
+                    auto b = pop();
+                    auto a = pop();
+                    if (a.isInt64() && b.isInt64() && b.asInt64() != 0)
+                        push(VMValue(a.asInt64() / b.asInt64()));
+                    else if (a.isInt32() && b.isInt32() && b.asInt32() != 0)
+                        push(VMValue(a.asInt32() / b.asInt32()));
+                    break;
+                }
+                case OpCode::Mod: {
+                    auto b = pop();
+                    auto a = pop();
+                    if (a.isInt64() && b.isInt64() && b.asInt64() != 0)
+                        push(VMValue(a.asInt64() % b.asInt64()));
+                    else if (a.isInt32() && b.isInt32() && b.asInt32() != 0)
+                        push(VMValue(a.asInt32() % b.asInt32()));
+                    break;
+                }
+
+                case OpCode::BitNot: {
+                    auto a = pop();
+                    if (a.isInt64())
+                        push(VMValue(~a.asInt64()));
+                    else if (a.isInt32())
+                        push(VMValue(~a.asInt32()));
+                    break;
+                }
+                case OpCode::LogicalNot: {
+                    auto a = pop();
+                    if (a.isInt32())
+                        push(VMValue(a.asInt32() == 0 ? 1 : 0));
+                    else if (a.isInt64())
+                        push(VMValue(a.asInt64() == 0 ? 1 : 0));
+                    break;
+                }
+                case OpCode::BitAnd: {
+                    auto b = pop();
+                    auto a = pop();
+                    if (a.isInt64() && b.isInt64())
+                        push(VMValue(a.asInt64() & b.asInt64()));
+                    else if (a.isInt32() && b.isInt32())
+                        push(VMValue(a.asInt32() & b.asInt32()));
+                    break;
+                }
+                case OpCode::BitOr: {
+                    auto b = pop();
+                    auto a = pop();
+                    if (a.isInt64() && b.isInt64())
+                        push(VMValue(a.asInt64() | b.asInt64()));
+                    else if (a.isInt32() && b.isInt32())
+                        push(VMValue(a.asInt32() | b.asInt32()));
+                    break;
+                }
+                case OpCode::BitXor: {
+                    auto b = pop();
+                    auto a = pop();
+                    if (a.isInt64() && b.isInt64())
+                        push(VMValue(a.asInt64() ^ b.asInt64()));
+                    else if (a.isInt32() && b.isInt32())
+                        push(VMValue(a.asInt32() ^ b.asInt32()));
+                    break;
+                }
+                case OpCode::Shl: {
+                    auto b = pop();
+                    auto a = pop();
+                    if (a.isInt64() && b.isInt64())
+                        push(VMValue(a.asInt64() << (b.asInt64() & 63)));
+                    else if (a.isInt32() && b.isInt32())
+                        push(VMValue(a.asInt32() << (b.asInt32() & 31)));
+                    break;
+                }
+                case OpCode::Shr: {
+                    auto b = pop();
+                    auto a = pop();
+                    if (a.isInt64() && b.isInt64())
+                        push(VMValue(a.asInt64() >> (b.asInt64() & 63)));
+                    else if (a.isInt32() && b.isInt32())
+                        push(VMValue(a.asInt32() >> (b.asInt32() & 31)));
+                    break;
+                }
+
+                case OpCode::SExt: {
+                    auto a = pop();
+                    if (a.isInt32()) {
+                        push(VMValue(static_cast<int64_t>(a.asInt32())));
+                    } else {
+                        push(a);
+                    }
+                    break;
+                }
+
+                case OpCode::Trunc: {
+                    auto a = pop();
+                    if (a.isInt64()) {
+                        push(VMValue(static_cast<int32_t>(a.asInt64())));
+                    } else {
+                        push(a);
+                    }
+                    break;
+                }
+
+                case OpCode::Eq: {
+                    auto b = pop();
+                    auto a = pop();
+                    if (a.isInt64() && b.isInt64())
+                        push(VMValue(static_cast<int32_t>(a.asInt64() == b.asInt64())));
+                    else if (a.isInt32() && b.isInt32())
+                        push(VMValue(static_cast<int32_t>(a.asInt32() == b.asInt32())));
+                    else if (a.isPointer() && b.isInt32())
+                        push(VMValue(static_cast<int32_t>(a.getPointerSlot() == b.asInt32())));
+                    else if (a.isInt32() && b.isPointer())
+                        push(VMValue(static_cast<int32_t>(a.asInt32() == b.getPointerSlot())));
+                    else if (a.isPointer() && b.isPointer()) {
+                        if (a.isArrayPointer() && b.isArrayPointer()) {
+                            bool eq = (a.getArrayPointerData() == b.getArrayPointerData()) &&
+                                      (a.getPointerSlot() == b.getPointerSlot());
+                            push(VMValue(static_cast<int32_t>(eq)));
+                        } else if (!a.isArrayPointer() && !b.isArrayPointer()) {
+                            push(VMValue(static_cast<int32_t>(a.getPointerSlot() == b.getPointerSlot())));
+                        } else {
+                            push(VMValue(static_cast<int32_t>(0)));
+                        }
+                    } else if (a.isHeapPointer() && b.isInt32())
+                        push(VMValue(static_cast<int32_t>(a.getHeapPointerSlot() == b.asInt32())));
+                    else if (a.isInt32() && b.isHeapPointer())
+                        push(VMValue(static_cast<int32_t>(a.asInt32() == b.getHeapPointerSlot())));
+                    else if (a.isHeapPointer() && b.isHeapPointer())
+                        push(VMValue(static_cast<int32_t>(a.getHeapPointerSlot() == b.getHeapPointerSlot())));
+                    break;
+                }
+                case OpCode::Ne: {
+                    auto b = pop();
+                    auto a = pop();
+                    if (a.isInt64() && b.isInt64())
+                        push(VMValue(static_cast<int32_t>(a.asInt64() != b.asInt64())));
+                    else if (a.isInt32() && b.isInt32())
+                        push(VMValue(static_cast<int32_t>(a.asInt32() != b.asInt32())));
+                    else if (a.isPointer() && b.isInt32())
+                        push(VMValue(static_cast<int32_t>(a.getPointerSlot() != b.asInt32())));
+                    else if (a.isInt32() && b.isPointer())
+                        push(VMValue(static_cast<int32_t>(a.asInt32() != b.getPointerSlot())));
+                    else if (a.isPointer() && b.isPointer()) {
+                        if (a.isArrayPointer() && b.isArrayPointer()) {
+                            bool ne = (a.getArrayPointerData() != b.getArrayPointerData()) ||
+                                      (a.getPointerSlot() != b.getPointerSlot());
+                            push(VMValue(static_cast<int32_t>(ne)));
+                        } else if (!a.isArrayPointer() && !b.isArrayPointer()) {
+                            push(VMValue(static_cast<int32_t>(a.getPointerSlot() != b.getPointerSlot())));
+                        } else {
+                            push(VMValue(static_cast<int32_t>(1)));
+                        }
+                    } else if (a.isHeapPointer() && b.isInt32())
+                        push(VMValue(static_cast<int32_t>(a.getHeapPointerSlot() != b.asInt32())));
+                    else if (a.isInt32() && b.isHeapPointer())
+                        push(VMValue(static_cast<int32_t>(a.asInt32() != b.getHeapPointerSlot())));
+                    else if (a.isHeapPointer() && b.isHeapPointer())
+                        push(VMValue(static_cast<int32_t>(a.getHeapPointerSlot() != b.getHeapPointerSlot())));
+                    break;
+                }
+                case OpCode::Lt: {
+                    auto b = pop();
+                    auto a = pop();
+                    if (a.isInt64() && b.isInt64())
+                        push(VMValue(static_cast<int32_t>(a.asInt64() < b.asInt64())));
+                    else if (a.isInt32() && b.isInt32())
+                        push(VMValue(static_cast<int32_t>(a.asInt32() < b.asInt32())));
+                    break;
+                }
+                case OpCode::Gt: {
+                    auto b = pop();
+                    auto a = pop();
+                    if (a.isInt64() && b.isInt64())
+                        push(VMValue(static_cast<int32_t>(a.asInt64() > b.asInt64())));
+                    else if (a.isInt32() && b.isInt32())
+                        push(VMValue(static_cast<int32_t>(a.asInt32() > b.asInt32())));
+                    break;
+                }
+                case OpCode::Le: {
+                    auto b = pop();
+                    auto a = pop();
+                    if (a.isInt64() && b.isInt64())
+                        push(VMValue(static_cast<int32_t>(a.asInt64() <= b.asInt64())));
+                    else if (a.isInt32() && b.isInt32())
+                        push(VMValue(static_cast<int32_t>(a.asInt32() <= b.asInt32())));
+                    break;
+                }
+                case OpCode::Ge: {
+                    auto b = pop();
+                    auto a = pop();
+                    if (a.isInt64() && b.isInt64())
+                        push(VMValue(static_cast<int32_t>(a.asInt64() >= b.asInt64())));
+                    else if (a.isInt32() && b.isInt32())
+                        push(VMValue(static_cast<int32_t>(a.asInt32() >= b.asInt32())));
+                    break;
+                }
+                case OpCode::Dup: {
+                    if (!stack_.empty()) {
+                        push(stack_.back());
+                    }
+                    break;
+                }
+
+                case OpCode::Pop:
+                    if (!stack_.empty())
+                        pop();
+                    break;
+
+                case OpCode::StoreLocal: {
+                    auto val = pop();
+                    int32_t idx = inst.operand;
+                    if (idx >= static_cast<int32_t>(locals_.size()))
+                        locals_.resize(idx + 1);
+                    locals_[idx] = val;
+                    break;
+                }
+
+                case OpCode::LoadLocal: {
+                    int32_t idx = inst.operand;
+                    if (idx >= 0 && idx < static_cast<int32_t>(locals_.size()))
+                        push(locals_[idx]);
+                    break;
+                }
+
+                case OpCode::Jmp: {
+                    size_t target = static_cast<size_t>(inst.operand);
+                    if (target <= ip) {
+                        tracer.safepoint(ip); // backward jump
+                        uint64_t cost = ip - segmentStart + 1;
+                        ip = target;
+                        segmentStart = ip;
+                        if (exhausted(cost))
+                            return VMValue();
+                        continue;
+                    }
+                    ip = target;
+                    continue;
+                }
+
+                case OpCode::Jz: {
+                    auto val = pop();
+                    if ((val.isInt32() && val.asInt32() == 0) || (val.isInt64() && val.asInt64() == 0)) {
+                        size_t target = static_cast<size_t>(inst.operand);
+                        if (target <= ip) {
+                            tracer.safepoint(ip); // backward jump
+                            uint64_t cost = ip - segmentStart + 1;
+                            ip = target;
+                            segmentStart = ip;
+                            if (exhausted(cost))
+                                return VMValue();
+                            continue;
+                        }
+                        ip = target;
+                        continue;
+                    }
+                    break;
+                }
+
+                case OpCode::Jnz: {
+                    // Exactly the values Jz falls through on, so either can test a condbr
+                    auto val = pop();
+                    if (!((val.isInt32() && val.asInt32() == 0) || (val.isInt64() && val.asInt64() == 0))) {
+                        size_t target = static_cast<size_t>(inst.operand);
+                        if (target <= ip) {
+                            tracer.safepoint(ip); // backward jump
+                            uint64_t cost = ip - segmentStart + 1;
+                            ip = target;
+                            segmentStart = ip;
+                            if (exhausted(cost))
+                                return VMValue();
+                            continue;
+                        }
+                        ip = target;
+                        continue;
+                    }
+                    break;
+                }
+
+                case OpCode::NewArray: {
+                    auto sizeVal = pop();
+                    int32_t size = 0;
+                    if (sizeVal.isInt32())
+                        size = sizeVal.asInt32();
+                    else if (sizeVal.isInt64())
+                        size = static_cast<int32_t>(sizeVal.asInt64());
+                    uint64_t count = static_cast<uint64_t>(std::max(size, 0));
+                    if (count > limits_.maxArrayElements - *arrayElements_) {
+                        trap(TrapKind::ArrayElements, limits_.maxArrayElements);
+                        return VMValue();
+                    }
+                    *arrayElements_ += count;
+                    auto arrData = std::make_shared<ArrayData>();
+                    arrData->liveElements = arrayElements_;
+                    arrData->countedElements = count;
+                    arrData->elements.resize(size, VMValue(static_cast<int32_t>(0)));
+                    push(VMValue(arrData));
+                    break;
+                }
+
+                case OpCode::ArrGet: {
+                    auto idxVal = pop();
+                    auto arrVal = pop();
+                    if (!arrVal.isArray()) {
+                        throw std::runtime_error("ArrGet on non-array value");
+                    }
+                    auto arrData = arrVal.asArray();
+                    int32_t idx = 0;
+                    if (idxVal.isInt32())
+                        idx = idxVal.asInt32();
+                    else if (idxVal.isInt64())
+                        idx = static_cast<int32_t>(idxVal.asInt64());
+                    auto &elements = arrData->getElements();
+                    if (idx < 0 || static_cast<size_t>(idx) >= elements.size())
+                        throw std::runtime_error("Array index out of bounds: " + std::to_string(idx));
+                    push(elements[idx]);
+                    break;
+                }
+
+                case OpCode::ArrSet: {
+                    auto val = pop();
+                    auto idxVal = pop();
+                    auto arrVal = pop();
+                    if (!arrVal.isArray()) {
+                        throw std::runtime_error("ArrSet on non-array value");
+                    }
+                    auto arrData = arrVal.asArray();
+                    int32_t idx = 0;
+                    if (idxVal.isInt32())
+                        idx = idxVal.asInt32();
+                    else if (idxVal.isInt64())
+                        idx = static_cast<int32_t>(idxVal.asInt64());
+                    auto &elements = arrData->getElements();
+                    if (idx < 0 || static_cast<size_t>(idx) >= elements.size())
+                        throw std::runtime_error("Array index out of bounds: " + std::to_string(idx));
+                    elements[idx] = val;
+                    break;
+                }
+
+                case OpCode::Halt: {
+                    VMValue result;
+                    if (leave(result))
+                        return result;
+                    continue;
+                }
+
+                case OpCode::RefCreate: {
+                    auto slotVal = pop();
+                    if (!slotVal.isInt32()) {
+                        throw std::runtime_error("RefCreate requires an int32 slot index");
+                    }
+                    VMValue refVal;
+                    refVal.setReferenceSlot(slotVal.asInt32());
+                    push(refVal);
+                    break;
+                }
+
+                case OpCode::RefLoad: {
+                    auto refVal = pop();
+                    if (refVal.isArrayElementRef()) {
+                        auto elemRef = refVal.asArrayElementRef();
+                        auto &elements = elemRef.array->getElements();
+                        if (elemRef.index >= 0 && static_cast<size_t>(elemRef.index) < elements.size()) {
+                            push(elements[elemRef.index]);
+                        } else {
+                            throw std::runtime_error("RefLoad: invalid array element ref index");
+                        }
+                    } else if (refVal.isReference()) {
+                        int32_t slot = refVal.getReferenceSlot();
+                        if (slot >= 0 && slot < static_cast<int32_t>(locals_.size())) {
+                            push(locals_[slot]);
+                        } else {
+                            throw std::runtime_error("RefLoad: invalid reference slot");
+                        }
+                    } else {
+                        throw std::runtime_error("RefLoad on non-reference value");
+                    }
+                    break;
+                }
+
+                case OpCode::RefStore: {
+                    auto val = pop();
+                    auto refVal = pop();
+                    if (refVal.isArrayElementRef()) {
+                        auto elemRef = refVal.asArrayElementRef();
+                        auto &elements = elemRef.array->getElements();
+                        if (elemRef.index >= 0 && static_cast<size_t>(elemRef.index) < elements.size()) {
+                            elements[elemRef.index] = val;
+                        } else {
+                            throw std::runtime_error("RefStore: invalid array element ref index");
+                        }
+                    } else if (refVal.isReference()) {
+                        int32_t slot = refVal.getReferenceSlot();
+                        if (slot >= 0 && slot < static_cast<int32_t>(locals_.size())) {
+                            locals_[slot] = val;
+                        } else {
+                            throw std::runtime_error("RefStore: invalid reference slot");
+                        }
+                    } else {
+                        throw std::runtime_error("RefStore on non-reference value");
+                    }
+                    break;
+                }
+
+                case OpCode::PtrCreate: {
+                    auto slotVal = pop();
+                    if (!slotVal.isInt32()) {
+                        throw std::runtime_error("PtrCreate requires an int32 slot index");
+                    }
+                    VMValue ptrVal;
+                    ptrVal.setPointerSlot(slotVal.asInt32());
+                    push(ptrVal);
+                    break;
+                }
+
+                case OpCode::PtrLoad: {
+                    auto ptrVal = pop();
+                    if (ptrVal.isHeapPointer()) {
+                        int32_t slot = ptrVal.getHeapPointerSlot();
+                        if (slot >= 0 && static_cast<size_t>(slot) < heapSize()) {
+                            push(heapCell(slot));
+                        } else {
+                            throw std::runtime_error("PtrLoad: invalid heap pointer slot");
+                        }
+                    } else if (ptrVal.isPointer()) {
+                        if (ptrVal.isArrayPointer()) {
+                            auto arrData = ptrVal.getArrayPointerData();
+                            int32_t index = ptrVal.getPointerSlot();
+                            auto &elements = arrData->getElements();
+                            if (index >= 0 && static_cast<size_t>(index) < elements.size()) {
+                                push(elements[index]);
+                            } else {
+                                throw std::runtime_error("PtrLoad: invalid array element index");
+                            }
+                        } else {
+                            int32_t slot = ptrVal.getPointerSlot();
+                            if (slot >= 0 && slot < static_cast<int32_t>(locals_.size())) {
+                                push(locals_[slot]);
+                            } else {
+                                throw std::runtime_error("PtrLoad: invalid pointer slot");
+                            }
+                        }
+                    } else {
+                        throw std::runtime_error("PtrLoad on non-pointer value");
+                    }
+                    break;
+                }
+
+                case OpCode::PtrStore: {
+                    auto val = pop();
+                    auto ptrVal = pop();
+                    if (ptrVal.isHeapPointer()) {
+                        int32_t slot = ptrVal.getHeapPointerSlot();
+                        if (slot >= 0 && static_cast<size_t>(slot) < heapSize()) {
+                            heapCellToOverwrite(slot) = val;
+                        } else {
+                            throw std::runtime_error("PtrStore: invalid heap pointer slot");
+                        }
+                    } else if (ptrVal.isPointer()) {
+                        if (ptrVal.isArrayPointer()) {
+                            auto arrData = ptrVal.getArrayPointerData();
+                            int32_t index = ptrVal.getPointerSlot();
+                            auto &elements = arrData->getElements();
+                            if (index >= 0 && static_cast<size_t>(index) < elements.size()) {
+                                elements[index] = val;
+                            } else {
+                                throw std::runtime_error("PtrStore: invalid array element index");
+                            }
+                        } else {
+                            int32_t slot = ptrVal.getPointerSlot();
+                            if (slot >= 0 && slot < static_cast<int32_t>(locals_.size())) {
+                                locals_[slot] = val;
+                            } else {
+                                throw std::runtime_error("PtrStore: invalid pointer slot");
+                            }
+                        }
+                    } else {
+                        throw std::runtime_error("PtrStore on non-pointer value");
+                    }
+                    break;
+                }
+
+                case OpCode::New: {
+                    auto initVal = pop();
+                    // Freed cells are never reused, so the heap's size is the number allocated
+                    if (heapSize() >= limits_.maxHeapCells) {
+                        trap(TrapKind::HeapCells, limits_.maxHeapCells);
+                        return VMValue();
+                    }
+                    heap_.push_back(initVal);
+                    VMValue heapPtr;
+                    heapPtr.setHeapPointerSlot(static_cast<int32_t>(heapSize() - 1));
+                    push(heapPtr);
+                    break;
+                }
+
+                case OpCode::Delete: {
+                    auto ptrVal = pop();
+                    if (ptrVal.isHeapPointer()) {
+                        int32_t slot = ptrVal.getHeapPointerSlot();
+                        if (slot >= 0 && static_cast<size_t>(slot) < heapSize()) {
+                            heapCellToOverwrite(slot) = VMValue(); // mark as freed
+                        }
+                    }
+                    break;
+                }
+
+                case OpCode::ArrRef: {
+                    auto indexVal = pop();
+                    auto arrVal = pop();
+                    if (!arrVal.isArray()) {
+                        throw std::runtime_error("ArrRef on non-array value");
+                    }
+                    auto arrData = arrVal.asArray();
+                    int32_t idx = 0;
+                    if (indexVal.isInt32())
+                        idx = indexVal.asInt32();
+                    else if (indexVal.isInt64())
+                        idx = static_cast<int32_t>(indexVal.asInt64());
+                    auto &elements = arrData->getElements();
+                    if (idx < 0 || static_cast<size_t>(idx) >= elements.size())
+                        throw std::runtime_error("ArrRef: array index out of bounds: " + std::to_string(idx));
+                    VMValue refVal;
+                    refVal = VMValue(ArrayElementRef{arrData, idx});
+                    push(refVal);
+                    break;
+                }
+
+                case OpCode::PtrIndexRef: {
+                    auto indexVal = pop();
+                    auto ptrVal = pop();
+                    int32_t idx = 0;
+                    if (indexVal.isInt32())
+                        idx = indexVal.asInt32();
+                    else if (indexVal.isInt64())
+                        idx = static_cast<int32_t>(indexVal.asInt64());
+
+                    if (ptrVal.isHeapPointer()) {
+                        int32_t slot = ptrVal.getHeapPointerSlot();
+                        int32_t targetSlot = slot + idx;
+                        if (targetSlot >= 0 && static_cast<size_t>(targetSlot) < heapSize()) {
+                            VMValue refVal;
+                            // TODO: Heap pointer isn't implement
+                            throw std::runtime_error("PtrIndexRef for heap pointers not yet implemented");
+                        }
+                    } else if (ptrVal.isPointer()) {
+                        if (ptrVal.isArrayPointer()) {
+                            int32_t index = ptrVal.getPointerSlot() + idx;
+                            VMValue refVal(ArrayElementRef{ptrVal.getArrayPointerData(), index});
+                            push(refVal);
+                        } else {
+                            int32_t slot = ptrVal.getPointerSlot();
+                            int32_t targetSlot = slot + idx;
+                            VMValue refVal;
+                            refVal.setReferenceSlot(targetSlot);
+                            push(refVal);
+                        }
+                    } else {
+                        throw std::runtime_error("PtrIndexRef on non-pointer value");
+                    }
+                    break;
+                }
+
+                case OpCode::PinArray:
+                case OpCode::UnpinArray: {
+                    // TODO: No GC yet
+                    pop();
+                    break;
+                }
+
+                case OpCode::PtrFromArray: {
+                    auto arrVal = pop();
+                    if (!arrVal.isArray()) {
+                        throw std::runtime_error("PtrFromArray on non-array value");
+                    }
+                    auto arrData = arrVal.asArray();
+                    VMValue ptrVal;
+                    ptrVal.setArrayPointer(0, arrData);
+                    push(ptrVal);
+                    break;
+                }
+
+                case OpCode::Snapshot: {
+                    if (snapshotPath_.empty()) {
+                        push(VMValue(static_cast<int32_t>(0)));
+                        break;
+                    }
+                    SnapshotFrame captured{func, ip + 1, locals_, stack_, {}};
+                    captured.stack.push_back(VMValue(static_cast<int32_t>(1)));
+                    for (const auto &caller : frames_)
+                        captured.callers.push_back({caller.function, caller.returnIp, caller.locals});
+                    if (restoredHeapSize_ == 0) {
+                        writeSnapshot(snapshotPath_, *program_, captured, heap_);
+                        return VMValue();
+                    }
+                    // Cells of the restored heap that were never touched are decoded straight
+                    // into the copy, not kept
+                    std::vector<VMValue> heap;
+                    heap.reserve(heapSize());
+                    for (size_t slot = 0; slot < restoredHeapSize_; ++slot) {
+                        auto touched = restoredHeap_.find(slot);
+                        heap.push_back(touched != restoredHeap_.end() ? touched->second : loadHeapCell_(slot));
+                    }
+                    heap.insert(heap.end(), heap_.begin(), heap_.end());
+                    writeSnapshot(snapshotPath_, *program_, captured, heap);
+                    return VMValue();
+                }
+
+                default:
+                    break;
+                }
+
+                ++ip;
+            }
+        } catch (const std::runtime_error &e) {
+            // Unwind every active frame so the tracer sees a leave for each enter
+            std::string functionName = func->name;
+            int line = func->lineTable.getLine(ip);
+            unwind();
+            if (dynamic_cast<const RuntimeError *>(&e))
+                throw;
+            throw RuntimeError(e.what(), functionName, ip, line);
+        }
+    }
+
+    void ExecutionContext::push(const VMValue &value) {
+        stack_.push_back(value);
+    }
+
+    VMValue ExecutionContext::pop() {
+        if (stack_.empty())
+            throw std::runtime_error("Stack underflow");
+        VMValue v = stack_.back();
+        stack_.pop_back();
+        return v;
+    }
+} // namespace Ryntra::VM
@@ -0,0 +1,214 @@
+#pragma once
+
+#include "HostIO.h"
+#include "Profiler.h"
+#include "Program.h"
+#include "SamplingProfiler.h"
+#include "Snapshot.h"
+#include "VMValue.h"
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace Ryntra::VM {
+    // Error raised while executing bytecode, attributed to the frame that raised it.
+    // The line comes from the function's line table and is 0 when no debug info exists.
+    class RuntimeError : public std::runtime_error {
+    public:
+        RuntimeError(const std::string &message, const std::string &functionName, size_t offset, int line)
+            : std::runtime_error(message + " (at " + functionName +
+                                 (line > 0 ? ", line " + std::to_string(line) : "+" + std::to_string(offset)) + ")"),
+              message_(message), functionName_(functionName), offset_(offset), line_(line) {}
+
+        const std::string &getMessage() const { return message_; }
+        const std::string &getFunctionName() const { return functionName_; }
+        size_t getOffset() const { return offset_; }
+        int getLine() const { return line_; }
+
+    private:
+        std::string message_;
+        std::string functionName_;
+        size_t offset_;
+        int line_;
+    };
+
+    // Per-run caps for untrusted scripts. Each is checked with a counter at the one instruction
+    // that can grow it, and a run that would go past one stops with a Trap.
+    struct ResourceLimits {
+        static constexpr uint64_t Unlimited = std::numeric_limits<uint64_t>::max();
+
+        uint64_t maxHeapCells = Unlimited;     // cells allocated by New
+        uint64_t maxArrayElements = Unlimited; // elements of live arrays made by NewArray
+        uint64_t maxCallDepth = Unlimited;     // frames on the call stack, the entry function's included
+        uint64_t maxOutputBytes = Unlimited;   // bytes written by the print builtins
+    };
+
+    enum class TrapKind { HeapCells, ArrayElements, CallDepth, OutputBytes };
+
+    // Why and where a run was stopped by its ResourceLimits
+    struct Trap {
+        TrapKind kind;
+        uint64_t limit; // the limit that would have been exceeded
+        std::string functionName;
+        size_t offset;
+        int line; // 0 when the function has no line table
+
+        std::string getMessage() const;
+    };
+
+    enum class ExecutionStatus {
+        Completed, // the entry function returned; the result holds its value
+        Suspended, // the budget ran out; resume(uint64_t) continues where the run stopped
+        Trapped,   // a resource limit was hit; the result holds the trap and the run can't continue
+    };
+
+    struct ExecutionResult {
+        ExecutionStatus status = ExecutionStatus::Completed;
+        VMValue value;
+        std::optional<Trap> trap;
+    };
+
+    // The mutable half of the VM: operand stack, locals, heap and I/O streams for one run of
+    // a shared Program. A context is cheap to create and must only be used by one thread at
+    // a time; run scripts concurrently by giving each thread its own context.
+    class ExecutionContext {
+    public:
+        explicit ExecutionContext(std::shared_ptr<const Program> program);
+
+        // Each call starts from an empty stack and heap. A trap is thrown as a RuntimeError.
+        VMValue execute(const std::string &entryPoint = "main");
+
+        // Same as execute(), but runs the instrumented interpreter and records into profiler
+        VMValue execute(const std::string &entryPoint, Profiler &profiler);
+
+        // Runs the sampling interpreter; the sampler's timer runs for the duration of the call
+        VMValue execute(const std::string &entryPoint, SamplingProfiler &sampler);
+
+        // Continues a run captured by the Snapshot instruction, where that instruction now yields true.
+        // The context must run the snapshot's own program (snapshot->getProgram()).
+        VMValue resume(const std::shared_ptr<const Snapshot> &snapshot);
+
+        // Runs entryPoint for about budget instructions. The budget is only checked at calls,
+        // returns and backward jumps, each charging the straight-line stretch of the running
+        // frame since the previous check, which is never less than what actually ran. A run can
+        // therefore overshoot by at most one such stretch (bounded by its function's length) and
+        // never stops before budget instructions have been charged. A run that runs out is
+        // suspended with its frames, stack and heap intact.
+        static constexpr uint64_t UnlimitedBudget = std::numeric_limits<uint64_t>::max();
+        ExecutionResult run(const std::string &entryPoint, uint64_t budget);
+
+        // Continues a suspended run with a fresh budget. Throws if no run is suspended.
+        ExecutionResult resume(uint64_t budget);
+        bool isSuspended() const { return suspended_; }
+
+        // Applies to every run started afterwards
+        void setLimits(const ResourceLimits &limits) { limits_ = limits; }
+        const ResourceLimits &getLimits() const { return limits_; }
+
+        const Program &getProgram() const { return *program_; }
+
+        // Arms the Snapshot instruction: the first one reached writes the run's state (every
+        // active frame, the stack and the heap) to path and ends the run. Unarmed, Snapshot just
+        // yields false.
+        void setSnapshotPath(std::string path) { snapshotPath_ = std::move(path); }
+
+        // Where the print / scan builtins write and read; std::cout / std::cin by default.
+        // A host-registered HostIO must outlive the runs that use it.
+        void setIO(HostIO &io) { io_ = &io; }
+        HostIO &getIO() { return io_ ? *io_ : streamIO_; }
+
+        // Output path of the print builtins: counts the bytes against maxOutputBytes and, past the
+        // limit, drops the text and traps the run once the builtin returns
+        void writeOutput(std::string_view text);
+
+        // Shorthands that point the default StreamIO at other streams and make it current again
+        void setOutput(std::ostream &output) {
+            streamIO_.setOutput(output);
+            io_ = nullptr;
+        }
+        void setInput(std::istream &input) {
+            streamIO_.setInput(input);
+            io_ = nullptr;
+        }
+
+    private:
+        // A caller waiting for its callee to return
+        struct Frame {
+            const BytecodeFunction *function;
+            size_t returnIp;
+            std::vector<VMValue> locals;
+        };
+
+        const BytecodeFunction *findEntry(const std::string &entryPoint);
+        void start(const BytecodeFunction *func, size_t ip, uint64_t budget);
+
+        // Runs from function_ / ip_ until the entry function returns or the budget runs out
+        template <typename Tracer>
+        VMValue interpret(Tracer &tracer);
+
+        ExecutionResult makeResult(VMValue value);
+        VMValue valueOrThrow(VMValue value) const;
+
+        std::shared_ptr<const Program> program_;
+        StreamIO streamIO_;
+        HostIO *io_ = nullptr; // nullptr selects streamIO_
+
+        std::vector<VMValue> stack_;
+        std::vector<VMValue> locals_;
+        std::vector<VMValue> heap_; // cells made by this run, from slot restoredHeapSize_ on
+        // A heap restored by resume() takes slots [0, restoredHeapSize_). Its cells stay in the
+        // snapshot until first touched, so only those ever get a VMValue in restoredHeap_.
+        // Every heap access goes through heapSize(), heapCell() or heapCellToOverwrite().
+        size_t restoredHeapSize_ = 0;
+        std::unordered_map<size_t, VMValue> restoredHeap_;
+        std::function<VMValue(size_t)> loadHeapCell_;
+        std::vector<Frame> frames_; // callers of the running function, outermost first
+
+        const BytecodeFunction *function_ = nullptr; // where interpret() starts or a suspended run stopped
+        size_t ip_ = 0;
+        uint64_t budget_ = UnlimitedBudget;
+        bool suspended_ = false;
+
+        ResourceLimits limits_;
+        // Elements of this run's NewArray arrays that are still alive. Each array holds the
+        // counter and gives its elements back when destroyed, so it is shared with them and a
+        // new run starts a fresh one rather than resetting it.
+        std::shared_ptr<uint64_t> arrayElements_;
+        uint64_t outputBytes_ = 0;   // written through writeOutput() this run
+        bool outputExceeded_ = false;
+        std::optional<Trap> trap_;
+
+        std::string snapshotPath_;
+        std::shared_ptr<void> snapshotArrays_; // keeps arrays restored by resume() shared
+
+        void push(const VMValue &value);
+        VMValue pop();
+
+        size_t heapSize() const { return restoredHeapSize_ + heap_.size(); }
+
+        // The heap cell at slot (in range), decoded first if it is restored and not yet touched
+        VMValue &heapCell(size_t slot) {
+            if (slot < restoredHeapSize_) [[unlikely]] {
+                if (auto touched = restoredHeap_.find(slot); touched != restoredHeap_.end())
+                    return touched->second;
+                return restoredHeap_.emplace(slot, loadHeapCell_(slot)).first->second;
+            }
+            return heap_[slot - restoredHeapSize_];
+        }
+
+        // For a cell about to be overwritten, whose snapshot value is never needed
+        VMValue &heapCellToOverwrite(size_t slot) {
+            if (slot < restoredHeapSize_) [[unlikely]]
+                return restoredHeap_[slot];
+            return heap_[slot - restoredHeapSize_];
+        }
+    };
+} // namespace Ryntra::VM
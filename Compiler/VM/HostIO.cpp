@@ -0,0 +1,17 @@
+#include "HostIO.h"
+#include <iostream>
+
+namespace Ryntra::VM {
+    StreamIO::StreamIO() : output_(&std::cout), input_(&std::cin) {}
+
+    void StreamIO::write(std::string_view text) {
+        output_->write(text.data(), static_cast<std::streamsize>(text.size()));
+    }
+
+    std::optional<std::string> StreamIO::readToken() {
+        std::string token;
+        if (!(*input_ >> token))
+            return std::nullopt;
+        return token;
+    }
+} // namespace Ryntra::VM
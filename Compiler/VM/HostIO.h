@@ -0,0 +1,38 @@
+#pragma once
+
+#include <iosfwd>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace Ryntra::VM {
+    // Where a running script's print / scan builtins go. Embedders implement this to route
+    // script I/O into their own buffers, sockets or logs instead of the process std streams.
+    class HostIO {
+    public:
+        virtual ~HostIO() = default;
+
+        // Text produced by one print builtin; no newline is appended
+        virtual void write(std::string_view text) = 0;
+
+        // The next whitespace-separated input token, or nullopt when input is exhausted
+        virtual std::optional<std::string> readToken() = 0;
+    };
+
+    // HostIO over a pair of standard streams; std::cout / std::cin unless told otherwise
+    class StreamIO : public HostIO {
+    public:
+        StreamIO();
+        StreamIO(std::ostream &output, std::istream &input) : output_(&output), input_(&input) {}
+
+        void write(std::string_view text) override;
+        std::optional<std::string> readToken() override;
+
+        void setOutput(std::ostream &output) { output_ = &output; }
+        void setInput(std::istream &input) { input_ = &input; }
+
+    private:
+        std::ostream *output_;
+        std::istream *input_;
+    };
+} // namespace Ryntra::VM
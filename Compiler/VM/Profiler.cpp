@@ -0,0 +1,168 @@
+#include "Profiler.h"
+#include <algorithm>
+#include <iomanip>
+#include <ostream>
+#include <string>
+
+namespace Ryntra::VM {
+    Profiler::Profiler(bool trackPairs)
+        : trackPairs_(trackPairs) {
+        if (trackPairs_) {
+            pairCounts_.resize(kOpCodeCount * kOpCodeCount, 0);
+        }
+    }
+
+    void Profiler::enterFunction(const BytecodeFunction *func) {
+        auto &stats = functions_[func];
+        if (!stats.function) {
+            stats.function = func;
+            stats.offsets.resize(func->instructions.size());
+        }
+        ++stats.calls;
+        callStack_.push_back(&stats);
+        current_ = &stats;
+    }
+
+    void Profiler::leaveFunction([[maybe_unused]] const BytecodeFunction *func) {
+        callStack_.pop_back();
+        current_ = callStack_.empty() ? nullptr : callStack_.back();
+        if (!current_) {
+            flushPending();
+        }
+    }
+
+    void Profiler::flushPending() {
+        if (!pending_)
+            return;
+        uint64_t delta = readCycleCounter() - lastStamp_;
+        opCycles_[static_cast<size_t>(pendingOp_)] += delta;
+        pending_->cycles += delta;
+        pending_->offsets[pendingOffset_].cycles += delta;
+        pending_ = nullptr;
+    }
+
+    static double percent(uint64_t part, uint64_t total) {
+        return total == 0 ? 0.0 : 100.0 * static_cast<double>(part) / static_cast<double>(total);
+    }
+
+    void Profiler::report(std::ostream &os, size_t topN) const {
+        uint64_t totalCount = 0;
+        uint64_t totalCycles = 0;
+        for (size_t i = 0; i < kOpCodeCount; ++i) {
+            totalCount += opCounts_[i];
+            totalCycles += opCycles_[i];
+        }
+
+#ifdef RYNTRA_HAS_RDTSC
+        const char *unit = "cycles";
+#else
+        const char *unit = "ticks";
+#endif
+
+        auto flags = os.flags();
+        auto precision = os.precision();
+        os << std::fixed << std::setprecision(2);
+
+        os << "==== VM profile: " << totalCount << " instructions, " << totalCycles << " " << unit << " ====\n";
+
+        // Per-opcode table
+        std::vector<size_t> ops;
+        for (size_t i = 0; i < kOpCodeCount; ++i) {
+            if (opCounts_[i] != 0)
+                ops.push_back(i);
+        }
+        std::sort(ops.begin(), ops.end(), [&](size_t a, size_t b) {
+            return opCycles_[a] != opCycles_[b] ? opCycles_[a] > opCycles_[b] : opCounts_[a] > opCounts_[b];
+        });
+
+        os << "\nOpcodes:\n";
+        os << "  " << std::left << std::setw(14) << "opcode" << std::right
+           << std::setw(14) << "count" << std::setw(9) << "%"
+           << std::setw(18) << unit << std::setw(9) << "%"
+           << std::setw(12) << "avg" << "\n";
+        for (size_t i : ops) {
+            os << "  " << std::left << std::setw(14) << getOpCodeName(static_cast<OpCode>(i)) << std::right
+               << std::setw(14) << opCounts_[i] << std::setw(9) << percent(opCounts_[i], totalCount)
+               << std::setw(18) << opCycles_[i] << std::setw(9) << percent(opCycles_[i], totalCycles)
+               << std::setw(12) << static_cast<double>(opCycles_[i]) / static_cast<double>(opCounts_[i]) << "\n";
+        }
+
+        // Per-function table, self time only
+        std::vector<const FunctionStats *> funcs;
+        for (const auto &[func, stats] : functions_) {
+            funcs.push_back(&stats);
+        }
+        std::sort(funcs.begin(), funcs.end(), [](const FunctionStats *a, const FunctionStats *b) {
+            return a->cycles != b->cycles ? a->cycles > b->cycles : a->function->name < b->function->name;
+        });
+
+        os << "\nFunctions (self):\n";
+        os << "  " << std::left << std::setw(24) << "function" << std::right
+           << std::setw(10) << "calls" << std::setw(14) << "instructions"
+           << std::setw(18) << unit << std::setw(9) << "%" << "\n";
+        for (const auto *stats : funcs) {
+            os << "  " << std::left << std::setw(24) << stats->function->name << std::right
+               << std::setw(10) << stats->calls << std::setw(14) << stats->instructions
+               << std::setw(18) << stats->cycles << std::setw(9) << percent(stats->cycles, totalCycles) << "\n";
+        }
+
+        // Hottest bytecode offsets across all functions
+        struct HotOffset {
+            const FunctionStats *stats;
+            size_t offset;
+        };
+        std::vector<HotOffset> offsets;
+        for (const auto *stats : funcs) {
+            for (size_t i = 0; i < stats->offsets.size(); ++i) {
+                if (stats->offsets[i].count != 0)
+                    offsets.push_back({stats, i});
+            }
+        }
+        auto offsetEnd = offsets.begin() + static_cast<std::ptrdiff_t>(std::min(topN, offsets.size()));
+        std::partial_sort(offsets.begin(), offsetEnd, offsets.end(), [](const HotOffset &a, const HotOffset &b) {
+            return a.stats->offsets[a.offset].cycles > b.stats->offsets[b.offset].cycles;
+        });
+
+        os << "\nHot offsets:\n";
+        os << "  " << std::left << std::setw(28) << "function+offset" << std::setw(14) << "opcode" << std::right
+           << std::setw(8) << "line" << std::setw(14) << "count" << std::setw(18) << unit << std::setw(9) << "%" << "\n";
+        for (auto it = offsets.begin(); it != offsetEnd; ++it) {
+            const auto &entry = it->stats->offsets[it->offset];
+            OpCode op = it->stats->function->instructions[it->offset].opcode;
+            int line = it->stats->function->lineTable.getLine(it->offset);
+            os << "  " << std::left << std::setw(28) << (it->stats->function->name + "+" + std::to_string(it->offset))
+               << std::setw(14) << getOpCodeName(op) << std::right
+               << std::setw(8) << (line > 0 ? std::to_string(line) : "?")
+               << std::setw(14) << entry.count << std::setw(18) << entry.cycles
+               << std::setw(9) << percent(entry.cycles, totalCycles) << "\n";
+        }
+
+        if (trackPairs_) {
+            std::vector<size_t> pairs;
+            uint64_t totalPairs = 0;
+            for (size_t i = 0; i < pairCounts_.size(); ++i) {
+                if (pairCounts_[i] != 0) {
+                    pairs.push_back(i);
+                    totalPairs += pairCounts_[i];
+                }
+            }
+            auto pairEnd = pairs.begin() + static_cast<std::ptrdiff_t>(std::min(topN, pairs.size()));
+            std::partial_sort(pairs.begin(), pairEnd, pairs.end(), [&](size_t a, size_t b) {
+                return pairCounts_[a] > pairCounts_[b];
+            });
+
+            os << "\nOpcode pairs:\n";
+            os << "  " << std::left << std::setw(30) << "first -> second" << std::right
+               << std::setw(14) << "count" << std::setw(9) << "%" << "\n";
+            for (auto it = pairs.begin(); it != pairEnd; ++it) {
+                std::string name = std::string(getOpCodeName(static_cast<OpCode>(*it / kOpCodeCount))) + " -> " +
+                                   getOpCodeName(static_cast<OpCode>(*it % kOpCodeCount));
+                os << "  " << std::left << std::setw(30) << name << std::right
+                   << std::setw(14) << pairCounts_[*it] << std::setw(9) << percent(pairCounts_[*it], totalPairs) << "\n";
+            }
+        }
+
+        os.flags(flags);
+        os.precision(precision);
+    }
+} // namespace Ryntra::VM
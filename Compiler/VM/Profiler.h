@@ -0,0 +1,115 @@
+#pragma once
+
+#include "Bytecode.h"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <unordered_map>
+#include <vector>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define RYNTRA_HAS_RDTSC 1
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define RYNTRA_HAS_RDTSC 1
+#endif
+
+namespace Ryntra::VM {
+    // Tracer for the default interpreter instantiation. All hooks are empty, so the
+    // normal dispatch loop compiles exactly as if no tracer existed.
+    //
+    // Tracer hooks:
+    //   enterFunction / leaveFunction  - around every call frame
+    //   step(ip, op)                   - before every dispatched instruction
+    //   safepoint(ip)                  - at calls and backward jumps only
+    struct NullTracer {
+        void enterFunction(const BytecodeFunction *) {}
+        void leaveFunction(const BytecodeFunction *) {}
+        void step(size_t, OpCode) {}
+        void safepoint(size_t) {}
+    };
+
+    // Exact execution profiler used by the --profile interpreter instantiation.
+    // Every dispatched instruction is counted, and the time until the next dispatch is
+    // charged to it (per OpCode, per BytecodeFunction and per bytecode offset).
+    class Profiler {
+    public:
+        explicit Profiler(bool trackPairs = false);
+
+        void enterFunction(const BytecodeFunction *func);
+        void leaveFunction(const BytecodeFunction *func);
+
+        void step(size_t ip, OpCode op) {
+            uint64_t now = readCycleCounter();
+            if (pending_) {
+                uint64_t delta = now - lastStamp_;
+                opCycles_[static_cast<size_t>(pendingOp_)] += delta;
+                pending_->cycles += delta;
+                pending_->offsets[pendingOffset_].cycles += delta;
+            }
+
+            auto opIndex = static_cast<size_t>(op);
+            ++opCounts_[opIndex];
+            ++current_->instructions;
+            ++current_->offsets[ip].count;
+            if (trackPairs_ && havePrevOp_) {
+                ++pairCounts_[static_cast<size_t>(prevOp_) * kOpCodeCount + opIndex];
+            }
+            prevOp_ = op;
+            havePrevOp_ = true;
+
+            pending_ = current_;
+            pendingOffset_ = ip;
+            pendingOp_ = op;
+            // Re-read so that the bookkeeping above is not charged to the instruction
+            lastStamp_ = readCycleCounter();
+        }
+
+        void safepoint(size_t) {}
+
+        // Prints the sorted report; \p topN bounds the offset and pair tables.
+        void report(std::ostream &os, size_t topN = 20) const;
+
+        static uint64_t readCycleCounter() {
+#ifdef RYNTRA_HAS_RDTSC
+            return __rdtsc();
+#else
+            return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+        }
+
+    private:
+        struct OffsetStats {
+            uint64_t count = 0;
+            uint64_t cycles = 0;
+        };
+
+        struct FunctionStats {
+            const BytecodeFunction *function = nullptr;
+            uint64_t calls = 0;
+            uint64_t instructions = 0;
+            uint64_t cycles = 0; // self time, callees are excluded
+            std::vector<OffsetStats> offsets;
+        };
+
+        void flushPending();
+
+        bool trackPairs_;
+        std::array<uint64_t, kOpCodeCount> opCounts_{};
+        std::array<uint64_t, kOpCodeCount> opCycles_{};
+        std::vector<uint64_t> pairCounts_;
+
+        std::unordered_map<const BytecodeFunction *, FunctionStats> functions_; // node-based, pointers stay valid
+        std::vector<FunctionStats *> callStack_;
+        FunctionStats *current_ = nullptr;
+
+        FunctionStats *pending_ = nullptr;
+        size_t pendingOffset_ = 0;
+        OpCode pendingOp_ = OpCode::Halt;
+        OpCode prevOp_ = OpCode::Halt;
+        bool havePrevOp_ = false;
+        uint64_t lastStamp_ = 0;
+    };
+} // namespace Ryntra::VM
@@ -0,0 +1,195 @@
+#include "Program.h"
+#include "ExecutionContext.h"
+#include <algorithm>
+#include <charconv>
+#include <ostream>
+#include <string_view>
+
+namespace Ryntra::VM {
+    namespace {
+        // Strings are stored NUL-padded; print up to the first NUL
+        std::string_view printable(const std::string &s) {
+            return std::string_view(s.data(), std::min(s.find('\0'), s.size()));
+        }
+
+        // Integer token in the manner of `std::cin >> value`: 0 when the token is missing or malformed
+        template <typename T>
+        T scanInteger(ExecutionContext &context) {
+            auto token = context.getIO().readToken();
+            T value = 0;
+            if (token)
+                std::from_chars(token->data(), token->data() + token->size(), value);
+            return value;
+        }
+
+        std::vector<Builtin> makeBuiltins() {
+            return {
+                // 0: __builtin_print (generic, handles all types at runtime)
+                {1, [](ExecutionContext &context, const std::vector<VMValue> &args) -> VMValue {
+                    if (!args.empty()) {
+                        if (args[0].isString()) {
+                            context.writeOutput(printable(args[0].asString()));
+                        } else if (args[0].isInt32()) {
+                            context.writeOutput(std::to_string(args[0].asInt32()));
+                        } else if (args[0].isInt64()) {
+                            context.writeOutput(std::to_string(args[0].asInt64()));
+                        }
+                    }
+                    return {};
+                }},
+                // 1: __builtin_print_i32 — prints int32
+                {1, [](ExecutionContext &context, const std::vector<VMValue> &args) -> VMValue {
+                    if (!args.empty() && args[0].isInt32()) {
+                        context.writeOutput(std::to_string(args[0].asInt32()));
+                    }
+                    return {};
+                }},
+                // 2: __builtin_print_i64 — prints int64
+                {1, [](ExecutionContext &context, const std::vector<VMValue> &args) -> VMValue {
+                    if (!args.empty() && args[0].isInt64()) {
+                        context.writeOutput(std::to_string(args[0].asInt64()));
+                    }
+                    return {};
+                }},
+                // 3: __builtin_print_bool — prints "true" or "false"
+                {1, [](ExecutionContext &context, const std::vector<VMValue> &args) -> VMValue {
+                    if (!args.empty() && args[0].isInt32()) {
+                        context.writeOutput(args[0].asInt32() ? "true" : "false");
+                    }
+                    return {};
+                }},
+                // 4: __builtin_print_string — prints string
+                {1, [](ExecutionContext &context, const std::vector<VMValue> &args) -> VMValue {
+                    if (!args.empty() && args[0].isString()) {
+                        context.writeOutput(printable(args[0].asString()));
+                    }
+                    return VMValue();
+                }},
+                // 5: __builtin_scan_bool — reads bool from the host input
+                {0, [](ExecutionContext &context, const std::vector<VMValue> &args) -> VMValue {
+                    std::string input = context.getIO().readToken().value_or("");
+                    std::transform(input.begin(), input.end(), input.begin(), ::tolower);
+                    if (input == "true") {
+                        return VMValue(static_cast<int32_t>(1));
+                    } else if (input == "false") {
+                        return VMValue(static_cast<int32_t>(0));
+                    } else {
+                        try {
+                            int32_t val = std::stoi(input);
+                            return VMValue(val != 0 ? static_cast<int32_t>(1) : static_cast<int32_t>(0));
+                        } catch (...) {
+                            return VMValue(static_cast<int32_t>(0));
+                        }
+                    }
+                }},
+                // 6: __builtin_scan_i32 — reads int32 from the host input
+                {0, [](ExecutionContext &context, const std::vector<VMValue> &args) -> VMValue {
+                    return VMValue(scanInteger<int32_t>(context));
+                }},
+                // 7: __builtin_scan_i64 — reads int64 from the host input
+                {0, [](ExecutionContext &context, const std::vector<VMValue> &args) -> VMValue {
+                    return VMValue(scanInteger<int64_t>(context));
+                }},
+            };
+        }
+    } // namespace
+
+    Program::Program(std::vector<std::shared_ptr<BytecodeFunction>> functions, std::vector<VMValue> constantPool)
+        : functions_(functions.begin(), functions.end()), constantPool_(std::move(constantPool)), builtins_(makeBuiltins()) {
+        for (const auto &f : functions_) {
+            functionMap_[f->name] = f.get();
+        }
+    }
+
+    const BytecodeFunction *Program::getFunction(const std::string &name) const {
+        auto it = functionMap_.find(name);
+        return it == functionMap_.end() ? nullptr : it->second;
+    }
+
+    static const char *opcodeNames[] = {
+        "LoadConst",
+        "Call",
+        "BCall",
+        "Return",
+        "Add",
+        "Sub",
+        "Mul",
+        "Div",
+        "Mod",
+        "BitNot",
+        "LogicalNot",
+        "BitAnd",
+        "BitOr",
+        "BitXor",
+        "Shl",
+        "Shr",
+        "SExt",
+        "Trunc",
+        "Eq",
+        "Ne",
+        "Lt",
+        "Gt",
+        "Le",
+        "Ge",
+        "Dup",
+        "Pop",
+        "StoreLocal",
+        "LoadLocal",
+        "Jmp",
+        "Jz",
+        "Jnz",
+        "NewArray",
+        "ArrGet",
+        "ArrSet",
+        "RefCreate",
+        "RefLoad",
+        "RefStore",
+        "PtrCreate",
+        "PtrLoad",
+        "PtrStore",
+        "New",
+        "Delete",
+        "ArrRef",
+        "PtrIndexRef",
+        "PinArray",
+        "UnpinArray",
+        "PtrFromArray",
+        "Snapshot",
+        "Halt",
+    };
+
+    const char *getOpCodeName(OpCode op) {
+        auto idx = static_cast<size_t>(op);
+        return idx < sizeof(opcodeNames) / sizeof(opcodeNames[0]) ? opcodeNames[idx] : "???";
+    }
+
+    void Program::disassemble(std::ostream &os) const {
+        for (const auto &func : functions_) {
+            os << "function " << func->name
+               << " (paramCount=" << func->paramCount
+               << ", external=" << (func->isExternal ? "true" : "false") << "):\n";
+            if (func->instructions.empty()) {
+                os << "  (no instructions)\n";
+            } else {
+                for (size_t i = 0; i < func->instructions.size(); ++i) {
+                    const auto &inst = func->instructions[i];
+                    os << "  " << i << ": " << getOpCodeName(inst.opcode);
+                    if (inst.opcode == OpCode::LoadConst ||
+                        inst.opcode == OpCode::StoreLocal ||
+                        inst.opcode == OpCode::LoadLocal ||
+                        inst.opcode == OpCode::Jmp ||
+                        inst.opcode == OpCode::Jz ||
+                        inst.opcode == OpCode::Jnz ||
+                        inst.opcode == OpCode::RefCreate ||
+                        inst.opcode == OpCode::PtrCreate) {
+                        os << " " << inst.operand;
+                    } else if (inst.opcode == OpCode::Call || inst.opcode == OpCode::BCall) {
+                        os << " " << inst.operand;
+                    }
+                    os << "\n";
+                }
+            }
+            os << "\n";
+        }
+    }
+} // namespace Ryntra::VM
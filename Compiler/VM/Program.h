@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Bytecode.h"
+#include "VMValue.h"
+#include <functional>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Ryntra::VM {
+    class ExecutionContext;
+
+    // Builtins get the calling context so they can reach its I/O streams
+    using NativeFunction = std::function<VMValue(ExecutionContext &, const std::vector<VMValue> &)>;
+
+    struct Builtin {
+        int32_t argCount;
+        NativeFunction function;
+    };
+
+    // A loaded program image: bytecode, constants and the builtin table. It is immutable once
+    // constructed, so one image can be shared (as std::shared_ptr<const Program>) by any number
+    // of ExecutionContexts running on different threads.
+    class Program {
+    public:
+        Program(std::vector<std::shared_ptr<BytecodeFunction>> functions, std::vector<VMValue> constantPool);
+
+        // nullptr if there is no function with that name
+        const BytecodeFunction *getFunction(const std::string &name) const;
+        const BytecodeFunction *getFunction(size_t index) const { return functions_[index].get(); }
+        size_t getFunctionCount() const { return functions_.size(); }
+
+        const std::vector<VMValue> &getConstantPool() const { return constantPool_; }
+        const std::vector<Builtin> &getBuiltins() const { return builtins_; }
+
+        void disassemble(std::ostream &os) const;
+
+    private:
+        std::vector<std::shared_ptr<const BytecodeFunction>> functions_;
+        std::unordered_map<std::string, const BytecodeFunction *> functionMap_;
+        std::vector<VMValue> constantPool_;
+        std::vector<Builtin> builtins_; // index matches BytecodeGenerator::getBuiltinIndex
+    };
+} // namespace Ryntra::VM
@@ -0,0 +1,136 @@
+#include "SamplingProfiler.h"
+#include <algorithm>
+#include <ostream>
+#include <stdexcept>
+
+#ifndef _WIN32
+#include <csignal>
+#include <sys/time.h>
+#endif
+
+namespace Ryntra::VM {
+    std::atomic<bool> SamplingProfiler::sampleRequested_{false};
+    std::atomic<bool> SamplingProfiler::active_{false};
+
+#ifndef _WIN32
+    namespace {
+        std::atomic<bool> *gSampleFlag = nullptr;
+
+        void onProfilingTimer(int) {
+            // Only async-signal-safe work here: the interpreter does the rest
+            if (gSampleFlag)
+                gSampleFlag->store(true, std::memory_order_relaxed);
+        }
+    } // namespace
+#endif
+
+    SamplingProfiler::SamplingProfiler(std::chrono::microseconds interval)
+        : interval_(interval) {
+        if (interval_.count() <= 0) {
+            throw std::runtime_error("Sampling interval must be positive");
+        }
+    }
+
+    SamplingProfiler::~SamplingProfiler() {
+        stop();
+    }
+
+    void SamplingProfiler::start() {
+        if (running_)
+            return;
+        bool expected = false;
+        if (!active_.compare_exchange_strong(expected, true)) {
+            throw std::runtime_error("Another sampling profiler is already running");
+        }
+        sampleRequested_.store(false, std::memory_order_relaxed);
+        running_ = true;
+
+#ifdef _WIN32
+        stopTimer_ = false;
+        timerThread_ = std::thread([this] {
+            std::unique_lock lock(timerMutex_);
+            while (!timerCv_.wait_for(lock, interval_, [this] { return stopTimer_; })) {
+                sampleRequested_.store(true, std::memory_order_relaxed);
+            }
+        });
+#else
+        gSampleFlag = &sampleRequested_;
+        struct sigaction action {};
+        action.sa_handler = onProfilingTimer;
+        sigemptyset(&action.sa_mask);
+        action.sa_flags = SA_RESTART;
+        if (sigaction(SIGPROF, &action, nullptr) != 0) {
+            running_ = false;
+            active_.store(false);
+            throw std::runtime_error("Failed to install SIGPROF handler");
+        }
+
+        struct itimerval timer {};
+        timer.it_interval.tv_sec = static_cast<time_t>(interval_.count() / 1000000);
+        timer.it_interval.tv_usec = static_cast<suseconds_t>(interval_.count() % 1000000);
+        timer.it_value = timer.it_interval;
+        if (setitimer(ITIMER_PROF, &timer, nullptr) != 0) {
+            signal(SIGPROF, SIG_DFL);
+            running_ = false;
+            active_.store(false);
+            throw std::runtime_error("Failed to start profiling timer");
+        }
+#endif
+    }
+
+    void SamplingProfiler::stop() {
+        if (!running_)
+            return;
+
+#ifdef _WIN32
+        {
+            std::lock_guard lock(timerMutex_);
+            stopTimer_ = true;
+        }
+        timerCv_.notify_one();
+        timerThread_.join();
+#else
+        struct itimerval timer {};
+        setitimer(ITIMER_PROF, &timer, nullptr);
+        signal(SIGPROF, SIG_DFL);
+        gSampleFlag = nullptr;
+#endif
+
+        sampleRequested_.store(false, std::memory_order_relaxed);
+        running_ = false;
+        active_.store(false);
+    }
+
+    void SamplingProfiler::takeSample() {
+        sampleRequested_.store(false, std::memory_order_relaxed);
+        if (frames_.empty())
+            return;
+
+        std::string stack;
+        for (const auto &frame : frames_) {
+            if (!stack.empty())
+                stack += ';';
+            stack += frame.function->name;
+            if (int line = frame.function->lineTable.getLine(frame.ip); line > 0) {
+                stack += ':';
+                stack += std::to_string(line);
+            }
+        }
+        ++stacks_[stack];
+        ++sampleCount_;
+    }
+
+    void SamplingProfiler::writeFolded(std::ostream &os) const {
+        // Sorted so that repeated runs produce diffable output
+        std::vector<const std::pair<const std::string, uint64_t> *> entries;
+        for (const auto &entry : stacks_) {
+            entries.push_back(&entry);
+        }
+        std::sort(entries.begin(), entries.end(), [](const auto *a, const auto *b) {
+            return a->first < b->first;
+        });
+        for (const auto *entry : entries) {
+            os << entry->first << ' ' << entry->second << '\n';
+        }
+    }
+} // namespace Ryntra::VM
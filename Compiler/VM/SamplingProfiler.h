@@ -0,0 +1,81 @@
+#pragma once
+
+#include "Bytecode.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <iosfwd>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace Ryntra::VM {
+    // Low-overhead statistical profiler. A timer (SIGPROF via setitimer on POSIX, a
+    // helper thread on Windows) only raises a flag; the interpreter looks at the flag at
+    // safepoints (calls and backward jumps) and the VM call stack is captured there.
+    // Samples are aggregated as folded stacks ("main:12;foo:30;bar:7 42") for flamegraph.pl,
+    // each frame being the function name plus the source line of its current safepoint.
+    //
+    // The timer is process-wide, so only one SamplingProfiler may be running at a time.
+    class SamplingProfiler {
+    public:
+        explicit SamplingProfiler(std::chrono::microseconds interval = std::chrono::microseconds(1000));
+        ~SamplingProfiler();
+
+        SamplingProfiler(const SamplingProfiler &) = delete;
+        SamplingProfiler &operator=(const SamplingProfiler &) = delete;
+
+        void start();
+        void stop();
+
+        void enterFunction(const BytecodeFunction *func) {
+            frames_.push_back({func, 0});
+            if (sampleRequested_.load(std::memory_order_relaxed))
+                takeSample();
+        }
+
+        void leaveFunction([[maybe_unused]] const BytecodeFunction *func) {
+            frames_.pop_back();
+        }
+
+        void step(size_t, OpCode) {}
+
+        void safepoint(size_t ip) {
+            frames_.back().ip = ip;
+            if (sampleRequested_.load(std::memory_order_relaxed))
+                takeSample();
+        }
+
+        // Writes one "frame;frame;frame count" line per distinct stack.
+        void writeFolded(std::ostream &os) const;
+
+        uint64_t getSampleCount() const { return sampleCount_; }
+
+    private:
+        struct Frame {
+            const BytecodeFunction *function;
+            size_t ip; // offset of the last safepoint reached in this frame
+        };
+
+        void takeSample();
+
+        static std::atomic<bool> sampleRequested_;
+        static std::atomic<bool> active_;
+
+        std::chrono::microseconds interval_;
+        bool running_ = false;
+        std::vector<Frame> frames_;
+        std::unordered_map<std::string, uint64_t> stacks_;
+        uint64_t sampleCount_ = 0;
+
+#ifdef _WIN32
+        std::thread timerThread_;
+        std::mutex timerMutex_;
+        std::condition_variable timerCv_;
+        bool stopTimer_ = false;
+#endif
+    };
+} // namespace Ryntra::VM
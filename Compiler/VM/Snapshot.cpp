@@ -0,0 +1,455 @@
+#include "Snapshot.h"
+#include "MappedFile/MappedFile.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <unordered_map>
+
+// File layout, in host byte order:
+//   Header
+//   functions     name, paramCount, isExternal, instructions and line table of each function
+//   constants     one Cell per constant pool entry
+//   locals        Cells of the captured frame's locals
+//   stack         Cells of the operand stack
+//   callers       one CallerEntry per frame waiting on the captured one, outermost first
+//   callerLocals  the locals of every caller, each caller contiguous
+//   heap          one Cell per heap slot
+//   arrays        one ArrayEntry per array, indexed by array id
+//   arrayCells    the elements of every array, each array contiguous
+//   strings       the bytes of every string value
+// Cells have a fixed size, so any of them can be decoded without reading what comes before.
+
+namespace Ryntra::VM {
+    namespace {
+        constexpr char kMagic[8] = {'R', 'Y', 'N', 'S', 'N', 'A', 'P', '\0'};
+        constexpr uint32_t kVersion = 3; // bumped whenever the layout or the opcode numbering changes
+        constexpr uint32_t kByteOrderMark = 0x01020304;
+
+        struct Section {
+            uint64_t offset = 0;
+            uint64_t size = 0; // in bytes
+        };
+
+        struct Header {
+            char magic[8];
+            uint32_t version;
+            uint32_t byteOrder;
+            uint32_t function; // the captured frame's, as an index into the program's functions
+            uint32_t functionCount;
+            uint64_t resumeIp;
+            Section functions, constants, locals, stack, callers, callerLocals, heap, arrays, arrayCells, strings;
+        };
+
+        // One VMValue. `slot` holds int32 payloads, `payload` int64 values, string offsets and array ids.
+        struct Cell {
+            uint8_t type;
+            uint8_t reserved[3];
+            int32_t slot;
+            int64_t payload;
+        };
+        static_assert(sizeof(Cell) == 16);
+
+        struct ArrayEntry {
+            uint64_t firstCell; // index into arrayCells
+            uint64_t count;
+        };
+
+        struct CallerEntry {
+            uint32_t function;
+            uint32_t reserved;
+            uint64_t returnIp;
+            uint64_t firstLocal; // index into callerLocals
+            uint64_t localCount;
+        };
+
+        [[noreturn]] void corrupt(const std::string &what) {
+            throw std::runtime_error("Corrupt snapshot: " + what);
+        }
+
+        template <typename T>
+        void append(std::string &out, const T &value) {
+            out.append(reinterpret_cast<const char *>(&value), sizeof(T));
+        }
+
+        // Bounds-checked sequential reads from the mapping
+        class Reader {
+        public:
+            Reader(const std::byte *data, size_t size, size_t offset) : data_(data), size_(size), pos_(offset) {}
+
+            template <typename T>
+            T read() {
+                T value;
+                std::memcpy(&value, bytes(sizeof(T)), sizeof(T));
+                return value;
+            }
+
+            const std::byte *bytes(size_t count) {
+                if (count > size_ - pos_)
+                    corrupt("unexpected end of data");
+                const std::byte *p = data_ + pos_;
+                pos_ += count;
+                return p;
+            }
+
+        private:
+            const std::byte *data_;
+            size_t size_;
+            size_t pos_;
+        };
+
+        class Writer {
+        public:
+            Cell encode(const VMValue &value) {
+                Cell cell{static_cast<uint8_t>(value.getType()), {}, 0, 0};
+                switch (value.getType()) {
+                case VMValue::Type::Void:
+                    break;
+                case VMValue::Type::Int32:
+                    cell.slot = value.asInt32();
+                    break;
+                case VMValue::Type::Int64:
+                    cell.payload = value.asInt64();
+                    break;
+                case VMValue::Type::String:
+                    cell.slot = static_cast<int32_t>(value.asString().size());
+                    cell.payload = static_cast<int64_t>(strings.size());
+                    strings += value.asString();
+                    break;
+                case VMValue::Type::Array:
+                    cell.payload = static_cast<int64_t>(arrayId(value.asArray()));
+                    break;
+                case VMValue::Type::Reference:
+                    cell.slot = value.getReferenceSlot();
+                    break;
+                case VMValue::Type::Pointer:
+                    cell.slot = value.getPointerSlot();
+                    if (value.isArrayPointer())
+                        cell.payload = static_cast<int64_t>(arrayId(value.getArrayPointerData())) + 1;
+                    break;
+                case VMValue::Type::HeapPointer:
+                    cell.slot = value.getHeapPointerSlot();
+                    break;
+                case VMValue::Type::ArrayElementRef:
+                    cell.slot = value.asArrayElementRef().index;
+                    cell.payload = static_cast<int64_t>(arrayId(value.asArrayElementRef().array));
+                    break;
+                case VMValue::Type::FunctionPtr:
+                    throw std::runtime_error("Cannot snapshot a function pointer value");
+                }
+                return cell;
+            }
+
+            std::string encode(const std::vector<VMValue> &values) {
+                std::string out;
+                for (const auto &value : values)
+                    append(out, encode(value));
+                return out;
+            }
+
+            // Encodes every array met so far, including the ones found while doing so
+            void encodeArrays() {
+                for (size_t id = 0; id < arrayList.size(); ++id) {
+                    // Encode first: it may register more arrays and grow arrayList
+                    std::string cells = encode(arrayList[id]->getElements());
+                    append(arrays, ArrayEntry{arrayCells.size() / sizeof(Cell), cells.size() / sizeof(Cell)});
+                    arrayCells += cells;
+                }
+            }
+
+            std::string strings;
+            std::string arrays;
+            std::string arrayCells;
+
+        private:
+            uint64_t arrayId(const std::shared_ptr<ArrayData> &array) {
+                auto [it, inserted] = arrayIds.try_emplace(array.get(), arrayList.size());
+                if (inserted)
+                    arrayList.push_back(array);
+                return it->second;
+            }
+
+            std::unordered_map<const ArrayData *, uint64_t> arrayIds;
+            std::vector<std::shared_ptr<ArrayData>> arrayList;
+        };
+
+        std::string encodeFunctions(const Program &program) {
+            std::string out;
+            for (size_t i = 0; i < program.getFunctionCount(); ++i) {
+                const auto *function = program.getFunction(i);
+                append(out, static_cast<uint32_t>(function->name.size()));
+                out += function->name;
+                append(out, function->paramCount);
+                append(out, static_cast<uint8_t>(function->isExternal));
+                append(out, static_cast<uint64_t>(function->instructions.size()));
+                for (const auto &inst : function->instructions) {
+                    append(out, static_cast<uint8_t>(inst.opcode));
+                    append(out, inst.operand);
+                }
+                const auto &lines = function->lineTable.getData();
+                append(out, static_cast<uint64_t>(lines.size()));
+                out.append(reinterpret_cast<const char *>(lines.data()), lines.size());
+            }
+            return out;
+        }
+    } // namespace
+
+    void writeSnapshot(const std::string &path, const Program &program, const SnapshotFrame &frame,
+                       const std::vector<VMValue> &heap) {
+        Header header{};
+        std::memcpy(header.magic, kMagic, sizeof(kMagic));
+        header.version = kVersion;
+        header.byteOrder = kByteOrderMark;
+        header.functionCount = static_cast<uint32_t>(program.getFunctionCount());
+        auto indexOf = [&](const BytecodeFunction *function) {
+            for (uint32_t i = 0; i < header.functionCount; ++i) {
+                if (program.getFunction(i) == function)
+                    return i;
+            }
+            throw std::runtime_error("Snapshot frame does not belong to the program");
+        };
+        header.function = indexOf(frame.function);
+        header.resumeIp = frame.ip;
+
+        Writer writer;
+        std::string callers, callerLocals;
+        for (const auto &caller : frame.callers) {
+            std::string locals = writer.encode(caller.locals);
+            append(callers, CallerEntry{indexOf(caller.function), 0, caller.returnIp,
+                                        callerLocals.size() / sizeof(Cell), locals.size() / sizeof(Cell)});
+            callerLocals += locals;
+        }
+
+        constexpr size_t kSectionCount = 10;
+        std::string sections[kSectionCount] = {
+            encodeFunctions(program),
+            writer.encode(program.getConstantPool()),
+            writer.encode(frame.locals),
+            writer.encode(frame.stack),
+            std::move(callers),
+            std::move(callerLocals),
+            writer.encode(heap),
+        };
+        writer.encodeArrays();
+        sections[7] = std::move(writer.arrays);
+        sections[8] = std::move(writer.arrayCells);
+        sections[9] = std::move(writer.strings);
+
+        Section *layout[kSectionCount] = {&header.functions, &header.constants, &header.locals,
+                                          &header.stack, &header.callers, &header.callerLocals,
+                                          &header.heap, &header.arrays, &header.arrayCells, &header.strings};
+        uint64_t offset = sizeof(Header);
+        for (size_t i = 0; i < kSectionCount; ++i) {
+            offset = (offset + 7) & ~uint64_t{7};
+            *layout[i] = Section{offset, sections[i].size()};
+            offset += sections[i].size();
+        }
+
+        // Written next to the target and renamed, so a reader never maps a half-written file
+        std::string tempPath = path + ".tmp";
+        {
+            std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+            if (!file)
+                throw std::runtime_error("Cannot write snapshot " + path);
+            file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+            for (size_t i = 0; i < kSectionCount; ++i) {
+                std::string padding(layout[i]->offset - static_cast<uint64_t>(file.tellp()), '\0');
+                file << padding << sections[i];
+            }
+            if (!file)
+                throw std::runtime_error("Cannot write snapshot " + path);
+        }
+        std::filesystem::rename(tempPath, path);
+    }
+
+    struct Snapshot::ArrayTable {
+        std::vector<std::shared_ptr<ArrayData>> arrays;
+    };
+
+    Snapshot::Snapshot(std::unique_ptr<Compiler::MappedFile> file) : file_(std::move(file)) {}
+
+    Snapshot::~Snapshot() = default;
+
+    std::shared_ptr<const Snapshot> Snapshot::open(const std::string &path) {
+        auto snapshot = std::shared_ptr<Snapshot>(new Snapshot(std::make_unique<Compiler::MappedFile>(path)));
+        snapshot->decodeProgram();
+        return snapshot;
+    }
+
+    void Snapshot::decodeProgram() {
+        if (file_->size() < sizeof(Header))
+            corrupt("file too small");
+        Header header;
+        std::memcpy(&header, file_->data(), sizeof(Header));
+        if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0)
+            throw std::runtime_error(file_->getPath() + " is not a Ryntra snapshot");
+        if (header.version != kVersion || header.byteOrder != kByteOrderMark)
+            throw std::runtime_error(file_->getPath() + " was written by an incompatible VM");
+        for (const Section *section : {&header.functions, &header.constants, &header.locals, &header.stack,
+                                       &header.callers, &header.callerLocals, &header.heap, &header.arrays,
+                                       &header.arrayCells, &header.strings}) {
+            if (section->offset > file_->size() || section->size > file_->size() - section->offset)
+                corrupt("section out of range");
+        }
+
+        Reader reader(file_->data(), header.functions.offset + header.functions.size, header.functions.offset);
+        std::vector<std::shared_ptr<BytecodeFunction>> functions;
+        for (uint32_t i = 0; i < header.functionCount; ++i) {
+            auto nameSize = reader.read<uint32_t>();
+            std::string name(reinterpret_cast<const char *>(reader.bytes(nameSize)), nameSize);
+            auto paramCount = reader.read<int32_t>();
+            auto isExternal = reader.read<uint8_t>() != 0;
+            auto function = std::make_shared<BytecodeFunction>(name, isExternal, paramCount);
+
+            auto instructionCount = reader.read<uint64_t>();
+            function->instructions.reserve(instructionCount);
+            for (uint64_t j = 0; j < instructionCount; ++j) {
+                auto opcode = reader.read<uint8_t>();
+                if (opcode >= kOpCodeCount)
+                    corrupt("unknown opcode");
+                function->addInstruction(static_cast<OpCode>(opcode), reader.read<int32_t>());
+            }
+            auto lineTableSize = reader.read<uint64_t>();
+            const auto *lines = reinterpret_cast<const uint8_t *>(reader.bytes(lineTableSize));
+            function->lineTable = LineTable(std::vector<uint8_t>(lines, lines + lineTableSize));
+            functions.push_back(std::move(function));
+        }
+        if (header.function >= functions.size())
+            corrupt("function out of range");
+        function_ = functions[header.function].get();
+        resumeIp_ = header.resumeIp;
+
+        locals_ = {header.locals.offset, header.locals.size};
+        stack_ = {header.stack.offset, header.stack.size};
+        callers_ = {header.callers.offset, header.callers.size};
+        callerLocals_ = {header.callerLocals.offset, header.callerLocals.size};
+        heap_ = {header.heap.offset, header.heap.size};
+        arrays_ = {header.arrays.offset, header.arrays.size};
+        arrayCells_ = {header.arrayCells.offset, header.arrayCells.size};
+        strings_ = {header.strings.offset, header.strings.size};
+
+        auto constants = decodeValues(header.constants.offset, header.constants.size, makeArrayTable());
+        // Program shares ownership of the same functions, so function_ stays valid
+        program_ = std::make_shared<const Program>(std::move(functions), std::move(constants));
+    }
+
+    std::shared_ptr<Snapshot::ArrayTable> Snapshot::makeArrayTable() const {
+        auto table = std::make_shared<ArrayTable>();
+        table->arrays.resize(arrays_.second / sizeof(ArrayEntry));
+        return table;
+    }
+
+    Snapshot::Restored Snapshot::restore() const {
+        auto arrays = makeArrayTable();
+        Restored restored;
+        restored.frame.function = function_;
+        restored.frame.ip = resumeIp_;
+        restored.frame.locals = decodeValues(locals_.first, locals_.second, arrays);
+        restored.frame.stack = decodeValues(stack_.first, stack_.second, arrays);
+
+        uint64_t localCount = callerLocals_.second / sizeof(Cell);
+        for (uint64_t at = 0; at + sizeof(CallerEntry) <= callers_.second; at += sizeof(CallerEntry)) {
+            CallerEntry entry;
+            std::memcpy(&entry, file_->data() + callers_.first + at, sizeof(CallerEntry));
+            if (entry.function >= program_->getFunctionCount())
+                corrupt("caller function out of range");
+            if (entry.firstLocal > localCount || entry.localCount > localCount - entry.firstLocal)
+                corrupt("caller locals out of range");
+            restored.frame.callers.push_back(SnapshotCaller{
+                program_->getFunction(entry.function), entry.returnIp,
+                decodeValues(callerLocals_.first + entry.firstLocal * sizeof(Cell), entry.localCount * sizeof(Cell),
+                             arrays)});
+        }
+        restored.heapSize = heap_.second / sizeof(Cell);
+        restored.loadHeapCell = [self = shared_from_this(), arrays](size_t slot) {
+            return self->decodeValue(self->heap_.first + slot * sizeof(Cell), arrays);
+        };
+        restored.arrays = std::move(arrays);
+        return restored;
+    }
+
+    std::vector<VMValue> Snapshot::decodeValues(uint64_t offset, uint64_t size,
+                                                const std::shared_ptr<ArrayTable> &arrays) const {
+        std::vector<VMValue> values;
+        values.reserve(size / sizeof(Cell));
+        for (uint64_t cell = 0; cell + sizeof(Cell) <= size; cell += sizeof(Cell))
+            values.push_back(decodeValue(offset + cell, arrays));
+        return values;
+    }
+
+    VMValue Snapshot::decodeValue(uint64_t offset, const std::shared_ptr<ArrayTable> &arrays) const {
+        Cell cell;
+        std::memcpy(&cell, file_->data() + offset, sizeof(Cell));
+
+        VMValue value;
+        switch (static_cast<VMValue::Type>(cell.type)) {
+        case VMValue::Type::Void:
+            break;
+        case VMValue::Type::Int32:
+            value = VMValue(cell.slot);
+            break;
+        case VMValue::Type::Int64:
+            value = VMValue(static_cast<int64_t>(cell.payload));
+            break;
+        case VMValue::Type::String: {
+            auto start = static_cast<uint64_t>(cell.payload);
+            auto size = static_cast<uint64_t>(static_cast<uint32_t>(cell.slot));
+            if (start > strings_.second || size > strings_.second - start)
+                corrupt("string out of range");
+            value = VMValue(std::string(reinterpret_cast<const char *>(file_->data() + strings_.first + start), size));
+            break;
+        }
+        case VMValue::Type::Array:
+            value = VMValue(getArray(static_cast<uint64_t>(cell.payload), arrays));
+            break;
+        case VMValue::Type::Reference:
+            value.setReferenceSlot(cell.slot);
+            break;
+        case VMValue::Type::Pointer:
+            if (cell.payload != 0)
+                value.setArrayPointer(cell.slot, getArray(static_cast<uint64_t>(cell.payload) - 1, arrays));
+            else
+                value.setPointerSlot(cell.slot);
+            break;
+        case VMValue::Type::HeapPointer:
+            value.setHeapPointerSlot(cell.slot);
+            break;
+        case VMValue::Type::ArrayElementRef:
+            value = VMValue(ArrayElementRef{getArray(static_cast<uint64_t>(cell.payload), arrays), cell.slot});
+            break;
+        default:
+            corrupt("unknown value type");
+        }
+        return value;
+    }
+
+    // Each array is created once per restore, so aliases keep sharing it. Its elements stay in
+    // the mapping until the interpreter first asks for them.
+    std::shared_ptr<ArrayData> Snapshot::getArray(uint64_t id, const std::shared_ptr<ArrayTable> &arrays) const {
+        if (id >= arrays->arrays.size())
+            corrupt("array id out of range");
+        auto &array = arrays->arrays[id];
+        if (array)
+            return array;
+
+        // The table owns the arrays, so a pending array only holds it weakly. Once the restored
+        // state is dropped a late load still works, it just no longer shares aliases.
+        array = std::make_shared<ArrayData>();
+        array->loader = [self = shared_from_this(), id, weakTable = std::weak_ptr<ArrayTable>(arrays)](
+                            std::vector<VMValue> &elements) {
+            auto table = weakTable.lock();
+            self->loadArray(id, elements, table ? table : self->makeArrayTable());
+        };
+        return array;
+    }
+
+    void Snapshot::loadArray(uint64_t id, std::vector<VMValue> &elements,
+                             const std::shared_ptr<ArrayTable> &arrays) const {
+        ArrayEntry entry;
+        std::memcpy(&entry, file_->data() + arrays_.first + id * sizeof(ArrayEntry), sizeof(ArrayEntry));
+        uint64_t cellCount = arrayCells_.second / sizeof(Cell);
+        if (entry.firstCell > cellCount || entry.count > cellCount - entry.firstCell)
+            corrupt("array out of range");
+        elements = decodeValues(arrayCells_.first + entry.firstCell * sizeof(Cell), entry.count * sizeof(Cell), arrays);
+    }
+} // namespace Ryntra::VM
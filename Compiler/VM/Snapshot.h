@@ -0,0 +1,83 @@
+#pragma once
+
+#include "Program.h"
+#include "VMValue.h"
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Ryntra::Compiler {
+    class MappedFile;
+}
+
+namespace Ryntra::VM {
+    // A caller waiting for the captured frame (or for another caller) to return
+    struct SnapshotCaller {
+        const BytecodeFunction *function = nullptr;
+        size_t returnIp = 0;
+        std::vector<VMValue> locals;
+    };
+
+    // The running frame of a run as captured by the Snapshot instruction, with its callers
+    struct SnapshotFrame {
+        const BytecodeFunction *function = nullptr;
+        size_t ip = 0; // where execution continues once restored
+        std::vector<VMValue> locals;
+        std::vector<VMValue> stack;          // the operand stack, which every frame shares
+        std::vector<SnapshotCaller> callers; // outermost first
+    };
+
+    // Writes program, frame and heap (with every array reachable from them) to path.
+    // Throws std::runtime_error if the file can't be written or a value can't be stored.
+    void writeSnapshot(const std::string &path, const Program &program, const SnapshotFrame &frame,
+                       const std::vector<VMValue> &heap);
+
+    // A snapshot file mapped into memory. The program image is decoded when the file is
+    // opened and the frame by each restore(); every heap cell and array is only decoded when a
+    // script first touches it, so a restore reads the pages it needs rather than the whole
+    // heap. A Snapshot is immutable and can warm-start any number of contexts.
+    class Snapshot : public std::enable_shared_from_this<Snapshot> {
+    public:
+        // Throws std::runtime_error if the file is missing, truncated or not a snapshot
+        static std::shared_ptr<const Snapshot> open(const std::string &path);
+
+        ~Snapshot();
+
+        const std::shared_ptr<const Program> &getProgram() const { return program_; }
+
+        struct Restored {
+            SnapshotFrame frame;
+            // The heap's cell count; loadHeapCell(slot) decodes one cell, at most once per slot
+            size_t heapSize = 0;
+            std::function<VMValue(size_t)> loadHeapCell;
+            // Arrays decoded so far, by id. Arrays that are still pending only hold a weak
+            // reference to it, so keep it for as long as the restored state is in use.
+            std::shared_ptr<void> arrays;
+        };
+
+        Restored restore() const;
+
+    private:
+        struct ArrayTable;
+
+        explicit Snapshot(std::unique_ptr<Compiler::MappedFile> file);
+
+        void decodeProgram();
+        std::shared_ptr<ArrayTable> makeArrayTable() const;
+        VMValue decodeValue(uint64_t offset, const std::shared_ptr<ArrayTable> &arrays) const;
+        std::vector<VMValue> decodeValues(uint64_t offset, uint64_t size,
+                                          const std::shared_ptr<ArrayTable> &arrays) const;
+        std::shared_ptr<ArrayData> getArray(uint64_t id, const std::shared_ptr<ArrayTable> &arrays) const;
+        void loadArray(uint64_t id, std::vector<VMValue> &elements, const std::shared_ptr<ArrayTable> &arrays) const;
+
+        std::unique_ptr<Compiler::MappedFile> file_;
+        std::shared_ptr<const Program> program_;
+        const BytecodeFunction *function_ = nullptr; // the captured frame's function
+        size_t resumeIp_ = 0;
+
+        // Sections read after open(), as (offset, size in bytes) pairs of the mapping
+        std::pair<uint64_t, uint64_t> locals_, stack_, callers_, callerLocals_, heap_, arrays_, arrayCells_, strings_;
+    };
+} // namespace Ryntra::VM
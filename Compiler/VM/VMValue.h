@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
 #include <variant>
@@ -10,6 +11,29 @@ namespace Ryntra::VM {
     class VMValue;
     struct ArrayData {
         std::vector<VMValue> elements;
+
+        // Set on arrays restored from a snapshot until the elements are first needed, so a
+        // restore only reads the parts of the snapshot a script actually touches
+        std::function<void(std::vector<VMValue> &)> loader;
+
+        // Set on arrays made by NewArray: the live-element count of the run that made the array,
+        // which this array's elements are taken off again when it is destroyed
+        std::shared_ptr<uint64_t> liveElements;
+        uint64_t countedElements = 0;
+
+        ~ArrayData() {
+            if (liveElements)
+                *liveElements -= countedElements;
+        }
+
+        std::vector<VMValue> &getElements() {
+            if (loader) [[unlikely]] {
+                auto load = std::move(loader);
+                loader = nullptr;
+                load(elements);
+            }
+            return elements;
+        }
     };
     struct ArrayElementRef {
         std::shared_ptr<ArrayData> array;
@@ -1,876 +1,55 @@
 #include "VirtualMachine.h"
-#include <algorithm>
 #include <iostream>
 #include <stdexcept>
 
 namespace Ryntra::VM {
-    VirtualMachine::VirtualMachine() {
-        // Builtin table - index must match BytecodeGenerator::getBuiltinIndex
-        builtins_ = {
-            // 0: __builtin_print (generic, handles all types at runtime)
-            [](const std::vector<VMValue> &args) -> VMValue {
-                if (!args.empty()) {
-                    if (args[0].isString()) {
-                        const std::string &s = args[0].asString();
-                        for (char c : s) {
-                            if (c == '\0')
-                                break;
-                            std::cout << c;
-                        }
-                    } else if (args[0].isInt32()) {
-                        std::cout << args[0].asInt32();
-                    } else if (args[0].isInt64()) {
-                        std::cout << args[0].asInt64();
-                    }
-                }
-                return {};
-            },
-            // 1: __builtin_print_i32 — prints int32
-            [](const std::vector<VMValue> &args) -> VMValue {
-                if (!args.empty() && args[0].isInt32()) {
-                    std::cout << args[0].asInt32();
-                }
-                return {};
-            },
-            // 2: __builtin_print_i64 — prints int64
-            [](const std::vector<VMValue> &args) -> VMValue {
-                if (!args.empty() && args[0].isInt64()) {
-                    std::cout << args[0].asInt64();
-                }
-                return {};
-            },
-            // 3: __builtin_print_bool — prints "true" or "false"
-            [](const std::vector<VMValue> &args) -> VMValue {
-                if (!args.empty() && args[0].isInt32()) {
-                    std::cout << (args[0].asInt32() ? "true" : "false");
-                }
-                return {};
-            },
-            // 4: __builtin_print_string — prints string
-            [](const std::vector<VMValue> &args) -> VMValue {
-                if (!args.empty() && args[0].isString()) {
-                    const std::string &s = args[0].asString();
-                    for (char c : s) {
-                        if (c == '\0')
-                            break;
-                        std::cout << c;
-                    }
-                }
-                return VMValue();
-            },
-            // 5: __builtin_scan_bool — reads bool from stdin
-            [](const std::vector<VMValue> &args) -> VMValue {
-                std::string input;
-                std::cin >> input;
-                std::transform(input.begin(), input.end(), input.begin(), ::tolower);
-                if (input == "true") {
-                    return VMValue(static_cast<int32_t>(1));
-                } else if (input == "false") {
-                    return VMValue(static_cast<int32_t>(0));
-                } else {
-                    try {
-                        int32_t val = std::stoi(input);
-                        return VMValue(val != 0 ? static_cast<int32_t>(1) : static_cast<int32_t>(0));
-                    } catch (...) {
-                        return VMValue(static_cast<int32_t>(0));
-                    }
-                }
-            },
-            // 6: __builtin_scan_i32 — reads int32 from stdin
-            [](const std::vector<VMValue> &args) -> VMValue {
-                int32_t val;
-                std::cin >> val;
-                return VMValue(val);
-            },
-            // 7: __builtin_scan_i64 — reads int64 from stdin
-            [](const std::vector<VMValue> &args) -> VMValue {
-                int64_t val;
-                std::cin >> val;
-                return VMValue(val);
-            },
-        };
-
-        builtinArgCounts_ = {1, 1, 1, 1, 1, 0, 0, 0}; // arg count per builtin index
-    }
-
     void VirtualMachine::load(const std::vector<std::shared_ptr<BytecodeFunction>> &funcs,
                               const std::vector<VMValue> &constantPool) {
-        functionList_ = funcs;
-        constantPool_ = constantPool;
-        functionMap_.clear();
-        for (const auto &f : funcs) {
-            functionMap_[f->name] = f;
-        }
+        load(std::make_shared<const Program>(funcs, constantPool));
     }
 
-    VMValue VirtualMachine::execute(const std::string &entryPoint) {
-        auto it = functionMap_.find(entryPoint);
-        if (it == functionMap_.end()) {
-            throw std::runtime_error("Entry point not found: " + entryPoint);
-        }
-        return executeFunction(it->second.get(), {});
+    void VirtualMachine::load(std::shared_ptr<const Program> program) {
+        program_ = std::move(program);
+        context_ = std::make_unique<ExecutionContext>(program_);
+        context_->setLimits(limits_);
     }
 
-    VMValue VirtualMachine::executeFunction(BytecodeFunction *func,
-                                            [[maybe_unused]] const std::vector<VMValue> &args) {
-        locals_.clear();
-        size_t ip = 0;
-        while (ip < func->instructions.size()) {
-            const auto &inst = func->instructions[ip];
-
-            switch (inst.opcode) {
-            case OpCode::LoadConst: {
-                if (inst.operand >= 0 && inst.operand < static_cast<int32_t>(constantPool_.size())) {
-                    push(constantPool_[inst.operand]);
-                }
-                break;
-            }
-
-            case OpCode::Call: {
-                if (inst.operand < 0 || inst.operand >= static_cast<int32_t>(functionList_.size())) {
-                    throw std::runtime_error("Invalid function index: " + std::to_string(inst.operand));
-                }
-                auto *callee = functionList_[inst.operand].get();
-
-                // Collect arguments based on the callee's declared parameter count
-                size_t argCount = static_cast<size_t>(callee->paramCount);
-
-                std::vector<VMValue> callArgs(argCount);
-                for (int i = static_cast<int>(argCount) - 1; i >= 0; --i) {
-                    callArgs[i] = pop();
-                }
-
-                VMValue result = executeFunction(callee, callArgs);
-                if (!result.isVoid()) {
-                    push(result);
-                }
-                break;
-            }
-
-            case OpCode::BCall: {
-                if (inst.operand < 0 || inst.operand >= static_cast<int32_t>(builtins_.size())) {
-                    throw std::runtime_error("Invalid builtin index: " + std::to_string(inst.operand));
-                }
-                size_t argCount = static_cast<size_t>(builtinArgCounts_[inst.operand]);
-                std::vector<VMValue> callArgs(argCount);
-                for (int i = static_cast<int>(argCount) - 1; i >= 0; --i) {
-                    callArgs[i] = pop();
-                }
-                VMValue result = builtins_[inst.operand](callArgs);
-                if (!result.isVoid())
-                    push(result);
-                break;
-            }
-
-            case OpCode::Return: {
-                if (!stack_.empty()) {
-                    return pop();
-                }
-                return {};
-            }
-
-            case OpCode::Add: {
-                auto b = pop();
-                auto a = pop();
-                if (a.isInt64() && b.isInt64())
-                    push(VMValue(a.asInt64() + b.asInt64()));
-                else if (a.isInt32() && b.isInt32())
-                    push(VMValue(a.asInt32() + b.asInt32()));
-                else if (a.isPointer() && b.isInt32()) {
-                    if (a.isArrayPointer()) {
-                        VMValue result;
-                        result.setArrayPointer(a.getPointerSlot() + b.asInt32(), a.getArrayPointerData());
-                        push(result);
-                    } else {
-                        push(VMValue(a.getPointerSlot() + b.asInt32()));
-                    }
-                } else if (a.isPointer() && b.isInt64()) {
-                    auto offset = static_cast<int32_t>(b.asInt64());
-                    if (a.isArrayPointer()) {
-                        VMValue result;
-                        result.setArrayPointer(a.getPointerSlot() + offset, a.getArrayPointerData());
-                        push(result);
-                    } else {
-                        push(VMValue(a.getPointerSlot() + offset));
-                    }
-                } else if (a.isInt32() && b.isPointer()) {
-                    if (b.isArrayPointer()) {
-                        VMValue result;
-                        result.setArrayPointer(a.asInt32() + b.getPointerSlot(), b.getArrayPointerData());
-                        push(result);
-                    } else {
-                        push(VMValue(a.asInt32() + b.getPointerSlot()));
-                    }
-                } else if (a.isHeapPointer() && b.isInt32()) {
-                    VMValue result;
-                    result.setHeapPointerSlot(a.getHeapPointerSlot() + b.asInt32());
-                    push(result);
-                } else if (a.isHeapPointer() && b.isInt64()) {
-                    VMValue result;
-                    result.setHeapPointerSlot(a.getHeapPointerSlot() + static_cast<int32_t>(b.asInt64()));
-                    push(result);
-                } else if (a.isInt32() && b.isHeapPointer()) {
-                    VMValue result;
-                    result.setHeapPointerSlot(a.asInt32() + b.getHeapPointerSlot());
-                    push(result);
-                }
-                break;
-            }
-            case OpCode::Sub: {
-                auto b = pop();
-                auto a = pop();
-                if (a.isInt64() && b.isInt64())
-                    push(VMValue(a.asInt64() - b.asInt64()));
-                else if (a.isInt32() && b.isInt32())
-                    push(VMValue(a.asInt32() - b.asInt32()));
-                else if (a.isPointer() && b.isInt32()) {
-                    if (a.isArrayPointer()) {
-                        VMValue result;
-                        result.setArrayPointer(a.getPointerSlot() - b.asInt32(), a.getArrayPointerData());
-                        push(result);
-                    } else {
-                        push(VMValue(a.getPointerSlot() - b.asInt32()));
-                    }
-                } else if (a.isPointer() && b.isPointer())
-                    push(VMValue(a.getPointerSlot() - b.getPointerSlot()));
-                else if (a.isHeapPointer() && b.isInt32()) {
-                    VMValue result;
-                    result.setHeapPointerSlot(a.getHeapPointerSlot() - b.asInt32());
-                    push(result);
-                } else if (a.isHeapPointer() && b.isHeapPointer())
-                    push(VMValue(a.getHeapPointerSlot() - b.getHeapPointerSlot()));
-                break;
-            }
-            case OpCode::Mul: {
-                auto b = pop();
-                auto a = pop();
-                if (a.isInt64() && b.isInt64())
-                    push(VMValue(a.asInt64() * b.asInt64()));
-                else if (a.isInt32() && b.isInt32())
-                    push(VMValue(a.asInt32() * b.asInt32()));
-                break;
-            }
-            case OpCode::Div: {
-                auto b = pop();
-                auto a = pop();
-                if (a.isInt64() && b.isInt64() && b.asInt64() != 0)
-                    push(VMValue(a.asInt64() / b.asInt64()));
-                else if (a.isInt32() && b.isInt32() && b.asInt32() != 0)
-                    push(VMValue(a.asInt32() / b.asInt32()));
-                break;
-            }
-            case OpCode::Mod: {
-                auto b = pop();
-                auto a = pop();
-                if (a.isInt64() && b.isInt64() && b.asInt64() != 0)
-                    push(VMValue(a.asInt64() % b.asInt64()));
-                else if (a.isInt32() && b.isInt32() && b.asInt32() != 0)
-                    push(VMValue(a.asInt32() % b.asInt32()));
-                break;
-            }
-
-            case OpCode::BitNot: {
-                auto a = pop();
-                if (a.isInt64())
-                    push(VMValue(~a.asInt64()));
-                else if (a.isInt32())
-                    push(VMValue(~a.asInt32()));
-                break;
-            }
-            case OpCode::LogicalNot: {
-                auto a = pop();
-                if (a.isInt32())
-                    push(VMValue(a.asInt32() == 0 ? 1 : 0));
-                else if (a.isInt64())
-                    push(VMValue(a.asInt64() == 0 ? 1 : 0));
-                break;
-            }
-            case OpCode::BitAnd: {
-                auto b = pop();
-                auto a = pop();
-                if (a.isInt64() && b.isInt64())
-                    push(VMValue(a.asInt64() & b.asInt64()));
-                else if (a.isInt32() && b.isInt32())
-                    push(VMValue(a.asInt32() & b.asInt32()));
-                break;
-            }
-            case OpCode::BitOr: {
-                auto b = pop();
-                auto a = pop();
-                if (a.isInt64() && b.isInt64())
-                    push(VMValue(a.asInt64() | b.asInt64()));
-                else if (a.isInt32() && b.isInt32())
-                    push(VMValue(a.asInt32() | b.asInt32()));
-                break;
-            }
-            case OpCode::BitXor: {
-                auto b = pop();
-                auto a = pop();
-                if (a.isInt64() && b.isInt64())
-                    push(VMValue(a.asInt64() ^ b.asInt64()));
-                else if (a.isInt32() && b.isInt32())
-                    push(VMValue(a.asInt32() ^ b.asInt32()));
-                break;
-            }
-            case OpCode::Shl: {
-                auto b = pop();
-                auto a = pop();
-                if (a.isInt64() && b.isInt64())
-                    push(VMValue(a.asInt64() << (b.asInt64() & 63)));
-                else if (a.isInt32() && b.isInt32())
-                    push(VMValue(a.asInt32() << (b.asInt32() & 31)));
-                break;
-            }
-            case OpCode::Shr: {
-                auto b = pop();
-                auto a = pop();
-                if (a.isInt64() && b.isInt64())
-                    push(VMValue(a.asInt64() >> (b.asInt64() & 63)));
-                else if (a.isInt32() && b.isInt32())
-                    push(VMValue(a.asInt32() >> (b.asInt32() & 31)));
-                break;
-            }
-
-            case OpCode::SExt: {
-                auto a = pop();
-                if (a.isInt32()) {
-                    push(VMValue(static_cast<int64_t>(a.asInt32())));
-                } else {
-                    push(a);
-                }
-                break;
-            }
-
-            case OpCode::Trunc: {
-                auto a = pop();
-                if (a.isInt64()) {
-                    push(VMValue(static_cast<int32_t>(a.asInt64())));
-                } else {
-                    push(a);
-                }
-                break;
-            }
-
-            case OpCode::Eq: {
-                auto b = pop();
-                auto a = pop();
-                if (a.isInt64() && b.isInt64())
-                    push(VMValue(static_cast<int32_t>(a.asInt64() == b.asInt64())));
-                else if (a.isInt32() && b.isInt32())
-                    push(VMValue(static_cast<int32_t>(a.asInt32() == b.asInt32())));
-                else if (a.isPointer() && b.isInt32())
-                    push(VMValue(static_cast<int32_t>(a.getPointerSlot() == b.asInt32())));
-                else if (a.isInt32() && b.isPointer())
-                    push(VMValue(static_cast<int32_t>(a.asInt32() == b.getPointerSlot())));
-                else if (a.isPointer() && b.isPointer()) {
-                    if (a.isArrayPointer() && b.isArrayPointer()) {
-                        bool eq = (a.getArrayPointerData() == b.getArrayPointerData()) &&
-                                  (a.getPointerSlot() == b.getPointerSlot());
-                        push(VMValue(static_cast<int32_t>(eq)));
-                    } else if (!a.isArrayPointer() && !b.isArrayPointer()) {
-                        push(VMValue(static_cast<int32_t>(a.getPointerSlot() == b.getPointerSlot())));
-                    } else {
-                        push(VMValue(static_cast<int32_t>(0)));
-                    }
-                } else if (a.isHeapPointer() && b.isInt32())
-                    push(VMValue(static_cast<int32_t>(a.getHeapPointerSlot() == b.asInt32())));
-                else if (a.isInt32() && b.isHeapPointer())
-                    push(VMValue(static_cast<int32_t>(a.asInt32() == b.getHeapPointerSlot())));
-                else if (a.isHeapPointer() && b.isHeapPointer())
-                    push(VMValue(static_cast<int32_t>(a.getHeapPointerSlot() == b.getHeapPointerSlot())));
-                break;
-            }
-            case OpCode::Ne: {
-                auto b = pop();
-                auto a = pop();
-                if (a.isInt64() && b.isInt64())
-                    push(VMValue(static_cast<int32_t>(a.asInt64() != b.asInt64())));
-                else if (a.isInt32() && b.isInt32())
-                    push(VMValue(static_cast<int32_t>(a.asInt32() != b.asInt32())));
-                else if (a.isPointer() && b.isInt32())
-                    push(VMValue(static_cast<int32_t>(a.getPointerSlot() != b.asInt32())));
-                else if (a.isInt32() && b.isPointer())
-                    push(VMValue(static_cast<int32_t>(a.asInt32() != b.getPointerSlot())));
-                else if (a.isPointer() && b.isPointer()) {
-                    if (a.isArrayPointer() && b.isArrayPointer()) {
-                        bool ne = (a.getArrayPointerData() != b.getArrayPointerData()) ||
-                                  (a.getPointerSlot() != b.getPointerSlot());
-                        push(VMValue(static_cast<int32_t>(ne)));
-                    } else if (!a.isArrayPointer() && !b.isArrayPointer()) {
-                        push(VMValue(static_cast<int32_t>(a.getPointerSlot() != b.getPointerSlot())));
-                    } else {
-                        push(VMValue(static_cast<int32_t>(1)));
-                    }
-                } else if (a.isHeapPointer() && b.isInt32())
-                    push(VMValue(static_cast<int32_t>(a.getHeapPointerSlot() != b.asInt32())));
-                else if (a.isInt32() && b.isHeapPointer())
-                    push(VMValue(static_cast<int32_t>(a.asInt32() != b.getHeapPointerSlot())));
-                else if (a.isHeapPointer() && b.isHeapPointer())
-                    push(VMValue(static_cast<int32_t>(a.getHeapPointerSlot() != b.getHeapPointerSlot())));
-                break;
-            }
-            case OpCode::Lt: {
-                auto b = pop();
-                auto a = pop();
-                if (a.isInt64() && b.isInt64())
-                    push(VMValue(static_cast<int32_t>(a.asInt64() < b.asInt64())));
-                else if (a.isInt32() && b.isInt32())
-                    push(VMValue(static_cast<int32_t>(a.asInt32() < b.asInt32())));
-                break;
-            }
-            case OpCode::Gt: {
-                auto b = pop();
-                auto a = pop();
-                if (a.isInt64() && b.isInt64())
-                    push(VMValue(static_cast<int32_t>(a.asInt64() > b.asInt64())));
-                else if (a.isInt32() && b.isInt32())
-                    push(VMValue(static_cast<int32_t>(a.asInt32() > b.asInt32())));
-                break;
-            }
-            case OpCode::Le: {
-                auto b = pop();
-                auto a = pop();
-                if (a.isInt64() && b.isInt64())
-                    push(VMValue(static_cast<int32_t>(a.asInt64() <= b.asInt64())));
-                else if (a.isInt32() && b.isInt32())
-                    push(VMValue(static_cast<int32_t>(a.asInt32() <= b.asInt32())));
-                break;
-            }
-            case OpCode::Ge: {
-                auto b = pop();
-                auto a = pop();
-                if (a.isInt64() && b.isInt64())
-                    push(VMValue(static_cast<int32_t>(a.asInt64() >= b.asInt64())));
-                else if (a.isInt32() && b.isInt32())
-                    push(VMValue(static_cast<int32_t>(a.asInt32() >= b.asInt32())));
-                break;
-            }
-            case OpCode::Dup: {
-                if (!stack_.empty()) {
-                    push(stack_.back());
-                }
-                break;
-            }
-
-            case OpCode::Pop:
-                if (!stack_.empty())
-                    pop();
-                break;
-
-            case OpCode::StoreLocal: {
-                auto val = pop();
-                int32_t idx = inst.operand;
-                if (idx >= static_cast<int32_t>(locals_.size()))
-                    locals_.resize(idx + 1);
-                locals_[idx] = val;
-                break;
-            }
-
-            case OpCode::LoadLocal: {
-                int32_t idx = inst.operand;
-                if (idx >= 0 && idx < static_cast<int32_t>(locals_.size()))
-                    push(locals_[idx]);
-                break;
-            }
-
-            case OpCode::Jmp:
-                ip = static_cast<size_t>(inst.operand);
-                continue;
-
-            case OpCode::Jz: {
-                auto val = pop();
-                if (val.isInt32() && val.asInt32() == 0) {
-                    ip = static_cast<size_t>(inst.operand);
-                    continue;
-                }
-                if (val.isInt64() && val.asInt64() == 0) {
-                    ip = static_cast<size_t>(inst.operand);
-                    continue;
-                }
-                break;
-            }
-
-            case OpCode::NewArray: {
-                auto sizeVal = pop();
-                int32_t size = 0;
-                if (sizeVal.isInt32())
-                    size = sizeVal.asInt32();
-                else if (sizeVal.isInt64())
-                    size = static_cast<int32_t>(sizeVal.asInt64());
-                auto arrData = std::make_shared<ArrayData>();
-                arrData->elements.resize(size, VMValue(static_cast<int32_t>(0)));
-                push(VMValue(arrData));
-                break;
-            }
-
-            case OpCode::ArrGet: {
-                auto idxVal = pop();
-                auto arrVal = pop();
-                if (!arrVal.isArray()) {
-                    throw std::runtime_error("ArrGet on non-array value");
-                }
-                auto arrData = arrVal.asArray();
-                int32_t idx = 0;
-                if (idxVal.isInt32())
-                    idx = idxVal.asInt32();
-                else if (idxVal.isInt64())
-                    idx = static_cast<int32_t>(idxVal.asInt64());
-                if (idx < 0 || static_cast<size_t>(idx) >= arrData->elements.size())
-                    throw std::runtime_error("Array index out of bounds: " + std::to_string(idx));
-                push(arrData->elements[idx]);
-                break;
-            }
-
-            case OpCode::ArrSet: {
-                auto val = pop();
-                auto idxVal = pop();
-                auto arrVal = pop();
-                if (!arrVal.isArray()) {
-                    throw std::runtime_error("ArrSet on non-array value");
-                }
-                auto arrData = arrVal.asArray();
-                int32_t idx = 0;
-                if (idxVal.isInt32())
-                    idx = idxVal.asInt32();
-                else if (idxVal.isInt64())
-                    idx = static_cast<int32_t>(idxVal.asInt64());
-                if (idx < 0 || static_cast<size_t>(idx) >= arrData->elements.size())
-                    throw std::runtime_error("Array index out of bounds: " + std::to_string(idx));
-                arrData->elements[idx] = val;
-                break;
-            }
-
-            case OpCode::Halt:
-                return VMValue();
-
-            case OpCode::RefCreate: {
-                auto slotVal = pop();
-                if (!slotVal.isInt32()) {
-                    throw std::runtime_error("RefCreate requires an int32 slot index");
-                }
-                VMValue refVal;
-                refVal.setReferenceSlot(slotVal.asInt32());
-                push(refVal);
-                break;
-            }
-
-            case OpCode::RefLoad: {
-                auto refVal = pop();
-                if (refVal.isArrayElementRef()) {
-                    auto elemRef = refVal.asArrayElementRef();
-                    if (elemRef.index >= 0 && static_cast<size_t>(elemRef.index) < elemRef.array->elements.size()) {
-                        push(elemRef.array->elements[elemRef.index]);
-                    } else {
-                        throw std::runtime_error("RefLoad: invalid array element ref index");
-                    }
-                } else if (refVal.isReference()) {
-                    int32_t slot = refVal.getReferenceSlot();
-                    if (slot >= 0 && slot < static_cast<int32_t>(locals_.size())) {
-                        push(locals_[slot]);
-                    } else {
-                        throw std::runtime_error("RefLoad: invalid reference slot");
-                    }
-                } else {
-                    throw std::runtime_error("RefLoad on non-reference value");
-                }
-                break;
-            }
-
-            case OpCode::RefStore: {
-                auto val = pop();
-                auto refVal = pop();
-                if (refVal.isArrayElementRef()) {
-                    auto elemRef = refVal.asArrayElementRef();
-                    if (elemRef.index >= 0 && static_cast<size_t>(elemRef.index) < elemRef.array->elements.size()) {
-                        elemRef.array->elements[elemRef.index] = val;
-                    } else {
-                        throw std::runtime_error("RefStore: invalid array element ref index");
-                    }
-                } else if (refVal.isReference()) {
-                    int32_t slot = refVal.getReferenceSlot();
-                    if (slot >= 0 && slot < static_cast<int32_t>(locals_.size())) {
-                        locals_[slot] = val;
-                    } else {
-                        throw std::runtime_error("RefStore: invalid reference slot");
-                    }
-                } else {
-                    throw std::runtime_error("RefStore on non-reference value");
-                }
-                break;
-            }
-
-            case OpCode::PtrCreate: {
-                auto slotVal = pop();
-                if (!slotVal.isInt32()) {
-                    throw std::runtime_error("PtrCreate requires an int32 slot index");
-                }
-                VMValue ptrVal;
-                ptrVal.setPointerSlot(slotVal.asInt32());
-                push(ptrVal);
-                break;
-            }
-
-            case OpCode::PtrLoad: {
-                auto ptrVal = pop();
-                if (ptrVal.isHeapPointer()) {
-                    int32_t slot = ptrVal.getHeapPointerSlot();
-                    if (slot >= 0 && slot < static_cast<int32_t>(heap_.size())) {
-                        push(heap_[slot]);
-                    } else {
-                        throw std::runtime_error("PtrLoad: invalid heap pointer slot");
-                    }
-                } else if (ptrVal.isPointer()) {
-                    if (ptrVal.isArrayPointer()) {
-                        auto arrData = ptrVal.getArrayPointerData();
-                        int32_t index = ptrVal.getPointerSlot();
-                        if (index >= 0 && static_cast<size_t>(index) < arrData->elements.size()) {
-                            push(arrData->elements[index]);
-                        } else {
-                            throw std::runtime_error("PtrLoad: invalid array element index");
-                        }
-                    } else {
-                        int32_t slot = ptrVal.getPointerSlot();
-                        if (slot >= 0 && slot < static_cast<int32_t>(locals_.size())) {
-                            push(locals_[slot]);
-                        } else {
-                            throw std::runtime_error("PtrLoad: invalid pointer slot");
-                        }
-                    }
-                } else {
-                    throw std::runtime_error("PtrLoad on non-pointer value");
-                }
-                break;
-            }
-
-            case OpCode::PtrStore: {
-                auto val = pop();
-                auto ptrVal = pop();
-                if (ptrVal.isHeapPointer()) {
-                    int32_t slot = ptrVal.getHeapPointerSlot();
-                    if (slot >= 0 && slot < static_cast<int32_t>(heap_.size())) {
-                        heap_[slot] = val;
-                    } else {
-                        throw std::runtime_error("PtrStore: invalid heap pointer slot");
-                    }
-                } else if (ptrVal.isPointer()) {
-                    if (ptrVal.isArrayPointer()) {
-                        auto arrData = ptrVal.getArrayPointerData();
-                        int32_t index = ptrVal.getPointerSlot();
-                        if (index >= 0 && static_cast<size_t>(index) < arrData->elements.size()) {
-                            arrData->elements[index] = val;
-                        } else {
-                            throw std::runtime_error("PtrStore: invalid array element index");
-                        }
-                    } else {
-                        int32_t slot = ptrVal.getPointerSlot();
-                        if (slot >= 0 && slot < static_cast<int32_t>(locals_.size())) {
-                            locals_[slot] = val;
-                        } else {
-                            throw std::runtime_error("PtrStore: invalid pointer slot");
-                        }
-                    }
-                } else {
-                    throw std::runtime_error("PtrStore on non-pointer value");
-                }
-                break;
-            }
-
-            case OpCode::New: {
-                auto initVal = pop();
-                heap_.push_back(initVal);
-                VMValue heapPtr;
-                heapPtr.setHeapPointerSlot(static_cast<int32_t>(heap_.size() - 1));
-                push(heapPtr);
-                break;
-            }
-
-            case OpCode::Delete: {
-                auto ptrVal = pop();
-                if (ptrVal.isHeapPointer()) {
-                    int32_t slot = ptrVal.getHeapPointerSlot();
-                    if (slot >= 0 && slot < static_cast<int32_t>(heap_.size())) {
-                        heap_[slot] = VMValue(); // mark as freed
-                    }
-                }
-                break;
-            }
-
-            case OpCode::ArrRef: {
-                auto indexVal = pop();
-                auto arrVal = pop();
-                if (!arrVal.isArray()) {
-                    throw std::runtime_error("ArrRef on non-array value");
-                }
-                auto arrData = arrVal.asArray();
-                int32_t idx = 0;
-                if (indexVal.isInt32())
-                    idx = indexVal.asInt32();
-                else if (indexVal.isInt64())
-                    idx = static_cast<int32_t>(indexVal.asInt64());
-                if (idx < 0 || static_cast<size_t>(idx) >= arrData->elements.size())
-                    throw std::runtime_error("ArrRef: array index out of bounds: " + std::to_string(idx));
-                VMValue refVal;
-                refVal = VMValue(ArrayElementRef{arrData, idx});
-                push(refVal);
-                break;
-            }
-
-            case OpCode::PtrIndexRef: {
-                auto indexVal = pop();
-                auto ptrVal = pop();
-                int32_t idx = 0;
-                if (indexVal.isInt32())
-                    idx = indexVal.asInt32();
-                else if (indexVal.isInt64())
-                    idx = static_cast<int32_t>(indexVal.asInt64());
-
-                if (ptrVal.isHeapPointer()) {
-                    int32_t slot = ptrVal.getHeapPointerSlot();
-                    int32_t targetSlot = slot + idx;
-                    if (targetSlot >= 0 && targetSlot < static_cast<int32_t>(heap_.size())) {
-                        VMValue refVal;
-                        // TODO: Heap pointer isn't implement
-                        throw std::runtime_error("PtrIndexRef for heap pointers not yet implemented");
-                    }
-                } else if (ptrVal.isPointer()) {
-                    if (ptrVal.isArrayPointer()) {
-                        int32_t index = ptrVal.getPointerSlot() + idx;
-                        VMValue refVal(ArrayElementRef{ptrVal.getArrayPointerData(), index});
-                        push(refVal);
-                    } else {
-                        int32_t slot = ptrVal.getPointerSlot();
-                        int32_t targetSlot = slot + idx;
-                        VMValue refVal;
-                        refVal.setReferenceSlot(targetSlot);
-                        push(refVal);
-                    }
-                } else {
-                    throw std::runtime_error("PtrIndexRef on non-pointer value");
-                }
-                break;
-            }
-
-            case OpCode::PinArray:
-            case OpCode::UnpinArray: {
-                // TODO: No GC yet
-                pop();
-                break;
-            }
-
-            case OpCode::PtrFromArray: {
-                auto arrVal = pop();
-                if (!arrVal.isArray()) {
-                    throw std::runtime_error("PtrFromArray on non-array value");
-                }
-                auto arrData = arrVal.asArray();
-                VMValue ptrVal;
-                ptrVal.setArrayPointer(0, arrData);
-                push(ptrVal);
-                break;
-            }
-
-            default:
-                break;
-            }
+    void VirtualMachine::setLimits(const ResourceLimits &limits) {
+        limits_ = limits;
+        if (context_)
+            context_->setLimits(limits_);
+    }
 
-            ++ip;
+    ExecutionContext &VirtualMachine::getContext() {
+        if (!context_) {
+            throw std::runtime_error("No program loaded");
         }
+        return *context_;
+    }
+
+    VMValue VirtualMachine::execute(const std::string &entryPoint) {
+        return getContext().execute(entryPoint);
+    }
 
-        return VMValue();
+    VMValue VirtualMachine::execute(const std::string &entryPoint, Profiler &profiler) {
+        return getContext().execute(entryPoint, profiler);
     }
 
-    static const char *opcodeNames[] = {
-        "LoadConst",
-        "Call",
-        "BCall",
-        "Return",
-        "Add",
-        "Sub",
-        "Mul",
-        "Div",
-        "Mod",
-        "BitNot",
-        "LogicalNot",
-        "BitAnd",
-        "BitOr",
-        "BitXor",
-        "Shl",
-        "Shr",
-        "SExt",
-        "Trunc",
-        "Eq",
-        "Ne",
-        "Lt",
-        "Gt",
-        "Le",
-        "Ge",
-        "Dup",
-        "Pop",
-        "StoreLocal",
-        "LoadLocal",
-        "Jmp",
-        "Jz",
-        "NewArray",
-        "ArrGet",
-        "ArrSet",
-        "RefCreate",
-        "RefLoad",
-        "RefStore",
-        "PtrCreate",
-        "PtrLoad",
-        "PtrStore",
-        "New",
-        "Delete",
-        "ArrRef",
-        "PtrIndexRef",
-        "PinArray",
-        "UnpinArray",
-        "PtrFromArray",
-        "Halt",
-    };
+    VMValue VirtualMachine::execute(const std::string &entryPoint, SamplingProfiler &sampler) {
+        return getContext().execute(entryPoint, sampler);
+    }
 
-    void VirtualMachine::disassemble() const {
-        for (const auto &func : functionList_) {
-            std::cout << "function " << func->name
-                      << " (paramCount=" << func->paramCount
-                      << ", external=" << (func->isExternal ? "true" : "false") << "):\n";
-            if (func->instructions.empty()) {
-                std::cout << "  (no instructions)\n";
-            } else {
-                for (size_t i = 0; i < func->instructions.size(); ++i) {
-                    const auto &inst = func->instructions[i];
-                    uint8_t idx = static_cast<uint8_t>(inst.opcode);
-                    const char *name = (idx < sizeof(opcodeNames) / sizeof(opcodeNames[0]))
-                                           ? opcodeNames[idx]
-                                           : "???";
-                    std::cout << "  " << i << ": " << name;
-                    if (inst.opcode == OpCode::LoadConst ||
-                        inst.opcode == OpCode::StoreLocal ||
-                        inst.opcode == OpCode::LoadLocal ||
-                        inst.opcode == OpCode::Jmp ||
-                        inst.opcode == OpCode::Jz ||
-                        inst.opcode == OpCode::RefCreate ||
-                        inst.opcode == OpCode::PtrCreate) {
-                        std::cout << " " << inst.operand;
-                    } else if (inst.opcode == OpCode::Call || inst.opcode == OpCode::BCall) {
-                        std::cout << " " << inst.operand;
-                    }
-                    std::cout << "\n";
-                }
-            }
-            std::cout << "\n";
-        }
+    ExecutionResult VirtualMachine::run(const std::string &entryPoint, uint64_t budget) {
+        return getContext().run(entryPoint, budget);
     }
 
-    void VirtualMachine::push(const VMValue &value) {
-        stack_.push_back(value);
+    ExecutionResult VirtualMachine::resume(uint64_t budget) {
+        return getContext().resume(budget);
     }
 
-    VMValue VirtualMachine::pop() {
-        if (stack_.empty())
-            throw std::runtime_error("Stack underflow");
-        VMValue v = stack_.back();
-        stack_.pop_back();
-        return v;
+    void VirtualMachine::disassemble() const {
+        if (program_) {
+            program_->disassemble(std::cout);
+        }
     }
 } // namespace Ryntra::VM
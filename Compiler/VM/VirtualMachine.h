@@ -1,40 +1,52 @@
 #pragma once
 
 #include "Bytecode.h"
+#include "ExecutionContext.h"
+#include "Profiler.h"
+#include "Program.h"
+#include "SamplingProfiler.h"
 #include "VMValue.h"
-#include <functional>
 #include <memory>
-#include <unordered_map>
+#include <string>
 #include <vector>
 
 namespace Ryntra::VM {
-    using NativeFunction = std::function<VMValue(const std::vector<VMValue> &)>;
-
+    // Convenience pairing of one Program with one ExecutionContext for single-threaded hosts.
+    // Multi-threaded hosts share a Program and create an ExecutionContext per thread instead.
     class VirtualMachine {
     public:
-        VirtualMachine();
+        VirtualMachine() = default;
 
         void load(const std::vector<std::shared_ptr<BytecodeFunction>> &funcs,
                   const std::vector<VMValue> &constantPool);
 
+        // Runs an already loaded image without copying it
+        void load(std::shared_ptr<const Program> program);
+
+        const std::shared_ptr<const Program> &getProgram() const { return program_; }
+
+        // Kept across load() calls; see ResourceLimits
+        void setLimits(const ResourceLimits &limits);
+        const ResourceLimits &getLimits() const { return limits_; }
+        ExecutionContext &getContext();
+
         VMValue execute(const std::string &entryPoint = "main");
 
-        void disassemble() const;
+        // Same as execute(), but runs the instrumented interpreter and records into profiler
+        VMValue execute(const std::string &entryPoint, Profiler &profiler);
 
-    private:
-        VMValue executeFunction(BytecodeFunction *func, const std::vector<VMValue> &args);
+        // Runs the sampling interpreter; the sampler's timer runs for the duration of the call
+        VMValue execute(const std::string &entryPoint, SamplingProfiler &sampler);
 
-        std::vector<VMValue> stack_;
-        std::vector<VMValue> constantPool_;
-        std::vector<std::shared_ptr<BytecodeFunction>> functionList_;
-        std::unordered_map<std::string, std::shared_ptr<BytecodeFunction>> functionMap_;
+        // Budgeted runs that suspend instead of running to completion; see ExecutionContext::run()
+        ExecutionResult run(const std::string &entryPoint, uint64_t budget);
+        ExecutionResult resume(uint64_t budget);
 
-        std::vector<VMValue> locals_;
-        std::vector<VMValue> heap_; // Separate heap storage — index matches BytecodeGenerator::getBuiltinIndex
-        std::vector<NativeFunction> builtins_;
-        std::vector<int> builtinArgCounts_;
+        void disassemble() const;
 
-        void push(const VMValue &value);
-        VMValue pop();
+    private:
+        std::shared_ptr<const Program> program_;
+        std::unique_ptr<ExecutionContext> context_;
+        ResourceLimits limits_;
     };
 } // namespace Ryntra::VM
@@ -0,0 +1,54 @@
+#include "Ryntra.h"
+#include "Driver/Driver.h"
+#include "PhaseTimer/PhaseTimer.h"
+
+namespace Ryntra {
+    namespace {
+        std::string formatDiagnostics(const std::vector<Diagnostic> &diagnostics) {
+            std::string text;
+            for (const auto &diagnostic : diagnostics) {
+                if (!text.empty())
+                    text += "\n";
+                switch (diagnostic.type) {
+                    case Compiler::kHint: text += "[Hint] "; break;
+                    case Compiler::kWarning: text += "[Warning] "; break;
+                    case Compiler::kError: text += "[Error] "; break;
+                }
+                text += "(l: " + std::to_string(diagnostic.location.line) +
+                        ", c: " + std::to_string(diagnostic.location.column) + ") " + diagnostic.description;
+            }
+            return text.empty() ? "compilation failed" : text;
+        }
+    } // namespace
+
+    CompileError::CompileError(std::vector<Diagnostic> diagnostics)
+        : std::runtime_error(formatDiagnostics(diagnostics)), diagnostics_(std::move(diagnostics)) {}
+
+    VMValue Program::run(const std::string &entryPoint, HostIO &io) const {
+        VM::ExecutionContext context(image_);
+        context.setIO(io);
+        return context.execute(entryPoint);
+    }
+
+    VMValue Program::run(const std::string &entryPoint) const {
+        VM::ExecutionContext context(image_);
+        return context.execute(entryPoint);
+    }
+
+    Program compile(const std::string &source, const std::string &moduleName) {
+        // Diagnostics are collected per thread; take them out so nothing leaks into the next compile
+        auto &errors = Compiler::ErrorHandler::getInstance();
+        errors.clear();
+        Compiler::PhaseTimer timer(false);
+        auto compiled = Compiler::compileSource(source, timer, moduleName);
+        std::vector<Diagnostic> diagnostics = errors.getErrorObjects();
+        bool failed = errors.hasError() || !compiled;
+        errors.clear();
+
+        if (failed)
+            throw CompileError(std::move(diagnostics));
+        auto image = std::make_shared<const VM::Program>(std::move(compiled->functions),
+                                                         std::move(compiled->constantPool));
+        return Program(std::move(image), std::move(diagnostics));
+    }
+} // namespace Ryntra
@@ -0,0 +1,71 @@
+#pragma once
+
+// The embedding API of the ryntra library: compile a source once, then run it as many times
+// as needed, from as many threads as needed, with the script's I/O routed to the host.
+//
+//     auto program = Ryntra::compile(source);
+//     MyRequestIO io(request);            // implements Ryntra::HostIO
+//     program.run("main", io);
+//
+// compile() throws CompileError; run() throws RuntimeError (or std::runtime_error for a
+// missing entry point). Neither touches std::cout / std::cin unless asked to.
+
+#include "ErrorHandler/ErrorHandler.h"
+#include "VM/ExecutionContext.h"
+#include "VM/HostIO.h"
+#include "VM/Program.h"
+#include "VM/VMValue.h"
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace Ryntra {
+    using VM::HostIO;
+    using VM::RuntimeError;
+    using VM::StreamIO;
+    using VM::VMValue;
+    using Diagnostic = Compiler::ErrorObject;
+
+    class Program;
+
+    // Lex, parse, analyse and generate bytecode for source. Safe to call from several threads.
+    Program compile(const std::string &source, const std::string &moduleName = "main");
+
+    // The source did not compile. what() lists every diagnostic, one per line.
+    class CompileError : public std::runtime_error {
+    public:
+        explicit CompileError(std::vector<Diagnostic> diagnostics);
+
+        const std::vector<Diagnostic> &getDiagnostics() const { return diagnostics_; }
+
+    private:
+        std::vector<Diagnostic> diagnostics_;
+    };
+
+    // A compiled script. Copies share the same immutable image, and run() keeps all of its
+    // state in a fresh ExecutionContext, so one Program may be run concurrently.
+    class Program {
+    public:
+        // Runs entryPoint with the script's print / scan builtins going through io
+        VMValue run(const std::string &entryPoint, HostIO &io) const;
+
+        // Same, on the process std::cout / std::cin
+        VMValue run(const std::string &entryPoint = "main") const;
+
+        // Warnings and hints reported while compiling
+        const std::vector<Diagnostic> &getDiagnostics() const { return diagnostics_; }
+
+        // The bytecode image, e.g. to drive an ExecutionContext directly or disassemble it
+        const std::shared_ptr<const VM::Program> &getImage() const { return image_; }
+
+    private:
+        friend Program compile(const std::string &source, const std::string &moduleName);
+
+        Program(std::shared_ptr<const VM::Program> image, std::vector<Diagnostic> diagnostics)
+            : image_(std::move(image)), diagnostics_(std::move(diagnostics)) {}
+
+        std::shared_ptr<const VM::Program> image_;
+        std::vector<Diagnostic> diagnostics_;
+    };
+} // namespace Ryntra
@@ -10,7 +10,7 @@
 
 namespace Ryntra::Compiler {
     ErrorHandler &ErrorHandler::getInstance() {
-        static ErrorHandler instance;
+        static thread_local ErrorHandler instance;
         return instance;
     }
 
@@ -26,17 +26,29 @@ namespace Ryntra::Compiler {
         errorObjects.emplace_back(kWarning, location, desc);
     }
 
+    bool ErrorHandler::hasError() const {
+        for (const auto &i : errorObjects) {
+            if (i.type == kError)
+                return true;
+        }
+        return false;
+    }
+
     void ErrorHandler::print() const {
+        print(std::cout);
+    }
+
+    void ErrorHandler::print(std::ostream &os) const {
         for (const auto &i : errorObjects) {
             if (i.type == kError) {
-                std::cout << "[" << COLORED_TEXT_RED << "Error" << COLORED_TEXT_DEFAULT << "]: "
-                          << "(l: " << i.location.line << ", c: " << i.location.column << ") " << i.description << std::endl;
+                os << "[" << COLORED_TEXT_RED << "Error" << COLORED_TEXT_DEFAULT << "]: "
+                   << "(l: " << i.location.line << ", c: " << i.location.column << ") " << i.description << std::endl;
             } else if (i.type == kWarning) {
-                std::cout << "[" << COLORED_TEXT_YELLOW << "Warning" << COLORED_TEXT_DEFAULT << "]: "
-                          << "(l: " << i.location.line << ", c: " << i.location.column << ") " << i.description << std::endl;
+                os << "[" << COLORED_TEXT_YELLOW << "Warning" << COLORED_TEXT_DEFAULT << "]: "
+                   << "(l: " << i.location.line << ", c: " << i.location.column << ") " << i.description << std::endl;
             } else if (i.type == kHint) {
-                std::cout << "[" << COLORED_TEXT_CYAN << "Hint" << COLORED_TEXT_DEFAULT << "]: "
-                          << "(l: " << i.location.line << ", c: " << i.location.column << ") " << i.description << std::endl;
+                os << "[" << COLORED_TEXT_CYAN << "Hint" << COLORED_TEXT_DEFAULT << "]: "
+                   << "(l: " << i.location.line << ", c: " << i.location.column << ") " << i.description << std::endl;
             }
         }
     }
@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <iosfwd>
 #include <string>
 #include <utility>
 #include <vector>
@@ -35,10 +36,10 @@ namespace Ryntra::Compiler {
     };
 
     /// \brief The error handler itself, which is a singleton class that make sures there's only one instance
-    /// in the context.
+    /// in the context. The instance is per thread, so sources can be compiled concurrently.
     class ErrorHandler {
     public:
-        /// \brief Static instance. Use it as \code ErrorHandler::getInstance() \endcode
+        /// \brief Static instance of the calling thread. Use it as \code ErrorHandler::getInstance() \endcode
         static ErrorHandler &getInstance();
 
         /// \brief Make a warning object then push into the error object list.
@@ -60,6 +61,20 @@ namespace Ryntra::Compiler {
         /// \code [TYPE] (l: LINE, c: COL) DESC \endcode
         void print() const;
 
+        /// \brief Same as \c print(), but into the given stream. The color codes are only written
+        /// when \p os is \c std::cout or \c std::cerr (see \c ConsoleTextManager::setColor), so a
+        /// string stream gets plain text.
+        /// \param os The output stream
+        void print(std::ostream &os) const;
+
+        /// \brief Drop every error object in the list, e.g. before compiling another source in-process.
+        void clear() {
+            errorObjects.clear();
+        }
+
+        /// \brief Whether any object in the list is a \c kError.
+        [[nodiscard]] bool hasError() const;
+
         ErrorHandler(const ErrorHandler &) = delete;
         ErrorHandler &operator=(const ErrorHandler &) = delete;
         ErrorHandler(ErrorHandler &&) = delete;
@@ -0,0 +1,213 @@
+// ========== Json.cpp ================================================ *- C++ -* //
+// Copyright (c) 2026 Remimwen Studio (Ryan "NvKopres" Almond).
+// Licensed under Apache-2.0 License. See LICENSE for more info.
+// ============================================================================== //
+
+#include "Json.h"
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+
+namespace Ryntra::Compiler {
+    namespace {
+        class JsonParser {
+        public:
+            explicit JsonParser(const std::string &text) : text(text) {}
+
+            JsonValue parseDocument() {
+                JsonValue value = parseValue();
+                skipWhitespace();
+                if (pos != text.size())
+                    fail("unexpected trailing characters");
+                return value;
+            }
+
+        private:
+            [[noreturn]] void fail(const std::string &what) const {
+                throw std::runtime_error("JSON parse error at offset " + std::to_string(pos) + ": " + what);
+            }
+
+            void skipWhitespace() {
+                while (pos < text.size() && (text[pos] == ' ' || text[pos] == '\t' || text[pos] == '\n' || text[pos] == '\r'))
+                    ++pos;
+            }
+
+            bool consume(const char *literal) {
+                size_t length = std::char_traits<char>::length(literal);
+                if (text.compare(pos, length, literal) != 0)
+                    return false;
+                pos += length;
+                return true;
+            }
+
+            void expect(char c) {
+                skipWhitespace();
+                if (pos >= text.size() || text[pos] != c)
+                    fail(std::string("expected '") + c + "'");
+                ++pos;
+            }
+
+            JsonValue parseValue() {
+                skipWhitespace();
+                if (pos >= text.size())
+                    fail("unexpected end of input");
+                char c = text[pos];
+                if (c == '{')
+                    return parseObject();
+                if (c == '[')
+                    return parseArray();
+                if (c == '"')
+                    return JsonValue(parseString());
+                if (consume("true"))
+                    return JsonValue(true);
+                if (consume("false"))
+                    return JsonValue(false);
+                if (consume("null"))
+                    return {};
+                return parseNumber();
+            }
+
+            JsonValue parseObject() {
+                JsonValue::Object object;
+                expect('{');
+                skipWhitespace();
+                if (pos < text.size() && text[pos] == '}') {
+                    ++pos;
+                    return JsonValue(std::move(object));
+                }
+                while (true) {
+                    skipWhitespace();
+                    if (pos >= text.size() || text[pos] != '"')
+                        fail("expected a member name");
+                    std::string key = parseString();
+                    expect(':');
+                    object[key] = parseValue();
+                    skipWhitespace();
+                    if (pos < text.size() && text[pos] == ',') {
+                        ++pos;
+                        continue;
+                    }
+                    expect('}');
+                    return JsonValue(std::move(object));
+                }
+            }
+
+            JsonValue parseArray() {
+                JsonValue::Array array;
+                expect('[');
+                skipWhitespace();
+                if (pos < text.size() && text[pos] == ']') {
+                    ++pos;
+                    return JsonValue(std::move(array));
+                }
+                while (true) {
+                    array.push_back(parseValue());
+                    skipWhitespace();
+                    if (pos < text.size() && text[pos] == ',') {
+                        ++pos;
+                        continue;
+                    }
+                    expect(']');
+                    return JsonValue(std::move(array));
+                }
+            }
+
+            std::string parseString() {
+                ++pos; // opening quote
+                std::string out;
+                while (pos < text.size() && text[pos] != '"') {
+                    char c = text[pos++];
+                    if (c != '\\') {
+                        out += c;
+                        continue;
+                    }
+                    if (pos >= text.size())
+                        fail("unterminated escape");
+                    char e = text[pos++];
+                    switch (e) {
+                    case '"': out += '"'; break;
+                    case '\\': out += '\\'; break;
+                    case '/': out += '/'; break;
+                    case 'b': out += '\b'; break;
+                    case 'f': out += '\f'; break;
+                    case 'n': out += '\n'; break;
+                    case 'r': out += '\r'; break;
+                    case 't': out += '\t'; break;
+                    case 'u': {
+                        if (pos + 4 > text.size())
+                            fail("truncated \\u escape");
+                        auto code = static_cast<unsigned>(std::strtoul(text.substr(pos, 4).c_str(), nullptr, 16));
+                        pos += 4;
+                        // UTF-8 encode; surrogate pairs are not combined
+                        if (code < 0x80) {
+                            out += static_cast<char>(code);
+                        } else if (code < 0x800) {
+                            out += static_cast<char>(0xC0 | (code >> 6));
+                            out += static_cast<char>(0x80 | (code & 0x3F));
+                        } else {
+                            out += static_cast<char>(0xE0 | (code >> 12));
+                            out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+                            out += static_cast<char>(0x80 | (code & 0x3F));
+                        }
+                        break;
+                    }
+                    default:
+                        fail("invalid escape");
+                    }
+                }
+                if (pos >= text.size())
+                    fail("unterminated string");
+                ++pos; // closing quote
+                return out;
+            }
+
+            JsonValue parseNumber() {
+                const char *begin = text.c_str() + pos;
+                char *end = nullptr;
+                double value = std::strtod(begin, &end);
+                if (end == begin)
+                    fail("unexpected character");
+                pos += static_cast<size_t>(end - begin);
+                return JsonValue(value);
+            }
+
+            const std::string &text;
+            size_t pos = 0;
+        };
+    } // namespace
+
+    const JsonValue *JsonValue::find(const std::string &key) const {
+        if (!isObject())
+            return nullptr;
+        const auto &object = asObject();
+        auto it = object.find(key);
+        return it == object.end() ? nullptr : &it->second;
+    }
+
+    JsonValue JsonValue::parse(const std::string &text) {
+        return JsonParser(text).parseDocument();
+    }
+
+    std::string quoteJson(const std::string &text) {
+        std::string out = "\"";
+        for (char c : text) {
+            switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char buffer[8];
+                    std::snprintf(buffer, sizeof(buffer), "\\u%04x", static_cast<unsigned>(static_cast<unsigned char>(c)));
+                    out += buffer;
+                } else {
+                    out += c;
+                }
+            }
+        }
+        out += '"';
+        return out;
+    }
+} // namespace Ryntra::Compiler
@@ -0,0 +1,58 @@
+// ========== Json.h ================================================== *- C++ -* //
+// Copyright (c) 2026 Remimwen Studio (Ryan "NvKopres" Almond).
+// Licensed under Apache-2.0 License. See LICENSE for more info.
+// ============================================================================== //
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace Ryntra::Compiler {
+    /// \brief A parsed JSON value. Just enough JSON for test manifests and tool output,
+    /// numbers are kept as \c double.
+    class JsonValue {
+    public:
+        using Array = std::vector<JsonValue>;
+        using Object = std::map<std::string, JsonValue>;
+
+        JsonValue() = default;
+        explicit JsonValue(bool value) : data(value) {}
+        explicit JsonValue(double value) : data(value) {}
+        explicit JsonValue(std::string value) : data(std::move(value)) {}
+        explicit JsonValue(const char *value) : data(std::string(value)) {}
+        explicit JsonValue(Array value) : data(std::move(value)) {}
+        explicit JsonValue(Object value) : data(std::move(value)) {}
+
+        [[nodiscard]] bool isNull() const { return std::holds_alternative<std::monostate>(data); }
+        [[nodiscard]] bool isBool() const { return std::holds_alternative<bool>(data); }
+        [[nodiscard]] bool isNumber() const { return std::holds_alternative<double>(data); }
+        [[nodiscard]] bool isString() const { return std::holds_alternative<std::string>(data); }
+        [[nodiscard]] bool isArray() const { return std::holds_alternative<Array>(data); }
+        [[nodiscard]] bool isObject() const { return std::holds_alternative<Object>(data); }
+
+        [[nodiscard]] bool asBool() const { return std::get<bool>(data); }
+        [[nodiscard]] double asNumber() const { return std::get<double>(data); }
+        [[nodiscard]] const std::string &asString() const { return std::get<std::string>(data); }
+        [[nodiscard]] const Array &asArray() const { return std::get<Array>(data); }
+        [[nodiscard]] const Object &asObject() const { return std::get<Object>(data); }
+
+        /// \brief Look up a member of an object.
+        /// \return The member, or \c nullptr if this isn't an object or has no such key
+        [[nodiscard]] const JsonValue *find(const std::string &key) const;
+
+        /// \brief Parse a JSON document.
+        /// \param text The JSON source
+        /// \throw std::runtime_error with the byte offset if the text isn't valid JSON
+        static JsonValue parse(const std::string &text);
+
+    private:
+        std::variant<std::monostate, bool, double, std::string, Array, Object> data;
+    };
+
+    /// \brief Quote and escape a string for JSON output, e.g. \c a"b becomes \c "a\"b"
+    std::string quoteJson(const std::string &text);
+} // namespace Ryntra::Compiler
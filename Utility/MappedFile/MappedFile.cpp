@@ -0,0 +1,84 @@
+// ========== MappedFile.cpp ========================================== *- C++ -* //
+// Copyright (c) 2026 Remimwen Studio (Ryan "NvKopres" Almond).
+// Licensed under Apache-2.0 License. See LICENSE for more info.
+// ============================================================================== //
+
+#include "MappedFile.h"
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Ryntra::Compiler {
+#ifdef _WIN32
+    MappedFile::MappedFile(const std::string &path) : path(path) {
+        fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                 FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (fileHandle == INVALID_HANDLE_VALUE) {
+            fileHandle = nullptr;
+            throw std::runtime_error("Cannot open " + path);
+        }
+        LARGE_INTEGER fileSize{};
+        if (!GetFileSizeEx(fileHandle, &fileSize)) {
+            CloseHandle(fileHandle);
+            throw std::runtime_error("Cannot read the size of " + path);
+        }
+        mappedSize = static_cast<size_t>(fileSize.QuadPart);
+        if (mappedSize == 0)
+            return;
+
+        mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        void *view = mappingHandle ? MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0) : nullptr;
+        if (!view) {
+            if (mappingHandle)
+                CloseHandle(mappingHandle);
+            CloseHandle(fileHandle);
+            throw std::runtime_error("Cannot map " + path);
+        }
+        mappedData = static_cast<const std::byte *>(view);
+    }
+
+    MappedFile::~MappedFile() {
+        if (mappedData)
+            UnmapViewOfFile(mappedData);
+        if (mappingHandle)
+            CloseHandle(mappingHandle);
+        if (fileHandle)
+            CloseHandle(fileHandle);
+    }
+#else
+    MappedFile::MappedFile(const std::string &path) : path(path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            throw std::runtime_error("Cannot open " + path);
+        struct stat info{};
+        if (fstat(fd, &info) != 0) {
+            ::close(fd);
+            throw std::runtime_error("Cannot read the size of " + path);
+        }
+        mappedSize = static_cast<size_t>(info.st_size);
+        if (mappedSize == 0) {
+            ::close(fd);
+            return;
+        }
+
+        // The mapping keeps its own reference to the file, so the descriptor can go right away
+        void *view = mmap(nullptr, mappedSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (view == MAP_FAILED)
+            throw std::runtime_error("Cannot map " + path);
+        mappedData = static_cast<const std::byte *>(view);
+    }
+
+    MappedFile::~MappedFile() {
+        if (mappedData)
+            munmap(const_cast<std::byte *>(mappedData), mappedSize);
+    }
+#endif
+} // namespace Ryntra::Compiler
@@ -0,0 +1,37 @@
+// ========== MappedFile.h ============================================ *- C++ -* //
+// Copyright (c) 2026 Remimwen Studio (Ryan "NvKopres" Almond).
+// Licensed under Apache-2.0 License. See LICENSE for more info.
+// ============================================================================== //
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace Ryntra::Compiler {
+    /// \brief A read-only memory mapping of a whole file. Pages are only read from disk when
+    /// they are first touched, so opening a large file costs the same as opening a small one.
+    class MappedFile {
+    public:
+        /// \brief Map the file at \c path. Throws \c std::runtime_error if it can't be opened or mapped.
+        /// \param path The file to map
+        explicit MappedFile(const std::string &path);
+        ~MappedFile();
+
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        [[nodiscard]] const std::byte *data() const { return mappedData; }
+        [[nodiscard]] size_t size() const { return mappedSize; }
+        [[nodiscard]] const std::string &getPath() const { return path; }
+
+    private:
+        std::string path;
+        const std::byte *mappedData = nullptr;
+        size_t mappedSize = 0;
+#ifdef _WIN32
+        void *fileHandle = nullptr;
+        void *mappingHandle = nullptr;
+#endif
+    };
+} // namespace Ryntra::Compiler
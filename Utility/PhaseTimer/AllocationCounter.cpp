@@ -0,0 +1,31 @@
+// ========== AllocationCounter.cpp =================================== *- C++ -* //
+// Copyright (c) 2026 Remimwen Studio (Ryan "NvKopres" Almond).
+// Licensed under Apache-2.0 License. See LICENSE for more info.
+// ============================================================================== //
+
+// Replaces the global allocation functions so PhaseTimer can count every allocation (ANTLR,
+// the AST, the IR and the VM all allocate through them). This TU is not part of the ryntra
+// library: a program embedding the library keeps its own operator new, and only the front
+// ends that link the ryntra_alloc_counter object library get allocation counts.
+
+#include "PhaseTimer.h"
+#include <cstdlib>
+#include <new>
+
+namespace {
+    void *countedAllocate(std::size_t size) {
+        Ryntra::Compiler::PhaseTimer::recordAllocation(size);
+        if (size == 0)
+            size = 1;
+        if (void *p = std::malloc(size))
+            return p;
+        throw std::bad_alloc();
+    }
+} // namespace
+
+void *operator new(std::size_t size) { return countedAllocate(size); }
+void *operator new[](std::size_t size) { return countedAllocate(size); }
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
@@ -0,0 +1,139 @@
+// ========== PhaseTimer.cpp ========================================== *- C++ -* //
+// Copyright (c) 2026 Remimwen Studio (Ryan "NvKopres" Almond).
+// Licensed under Apache-2.0 License. See LICENSE for more info.
+// ============================================================================== //
+
+#include "PhaseTimer.h"
+#include <atomic>
+#include <iomanip>
+#include <ostream>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace {
+    // Constant-initialized, so the counters are usable by allocations made during static
+    // initialization
+    std::atomic<uint64_t> gAllocationCount{0};
+    std::atomic<uint64_t> gAllocatedBytes{0};
+} // namespace
+
+namespace Ryntra::Compiler {
+    void PhaseTimer::recordAllocation(std::size_t bytes) {
+        gAllocationCount.fetch_add(1, std::memory_order_relaxed);
+        gAllocatedBytes.fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    uint64_t PhaseTimer::getAllocationCount() {
+        return gAllocationCount.load(std::memory_order_relaxed);
+    }
+
+    uint64_t PhaseTimer::getAllocatedBytes() {
+        return gAllocatedBytes.load(std::memory_order_relaxed);
+    }
+
+    uint64_t PhaseTimer::getPeakRss() {
+#ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS counters{};
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+            return static_cast<uint64_t>(counters.PeakWorkingSetSize);
+        return 0;
+#else
+        rusage usage{};
+        if (getrusage(RUSAGE_SELF, &usage) != 0)
+            return 0;
+#ifdef __APPLE__
+        return static_cast<uint64_t>(usage.ru_maxrss); // bytes on macOS
+#else
+        return static_cast<uint64_t>(usage.ru_maxrss) * 1024; // kilobytes elsewhere
+#endif
+#endif
+    }
+
+    void PhaseTimer::begin(const std::string &name) {
+        if (!enabled)
+            return;
+        if (running)
+            end();
+        running = true;
+        currentName = name;
+        startPeakRss = getPeakRss();
+        startAllocations = getAllocationCount();
+        startBytes = getAllocatedBytes();
+        startTime = std::chrono::steady_clock::now();
+    }
+
+    void PhaseTimer::end() {
+        if (!enabled || !running)
+            return;
+        auto endTime = std::chrono::steady_clock::now();
+        uint64_t allocations = getAllocationCount() - startAllocations;
+        uint64_t bytes = getAllocatedBytes() - startBytes;
+        uint64_t peakRss = getPeakRss();
+        running = false;
+
+        records.push_back(PhaseRecord{
+            currentName,
+            std::chrono::duration<double, std::milli>(endTime - startTime).count(),
+            allocations,
+            bytes,
+            static_cast<int64_t>(peakRss) - static_cast<int64_t>(startPeakRss),
+        });
+    }
+
+    void PhaseTimer::print(std::ostream &os) const {
+        auto flags = os.flags();
+        auto precision = os.precision();
+
+        double totalMs = 0;
+        uint64_t totalAllocations = 0;
+        uint64_t totalBytes = 0;
+        int64_t totalRss = 0;
+
+        os << std::left << std::setw(16) << "phase" << std::right
+           << std::setw(12) << "wall (ms)" << std::setw(14) << "allocations"
+           << std::setw(16) << "alloc bytes" << std::setw(16) << "peak RSS +KB" << "\n";
+        os << std::fixed << std::setprecision(3);
+        for (const auto &record : records) {
+            os << std::left << std::setw(16) << record.name << std::right
+               << std::setw(12) << record.wallMilliseconds << std::setw(14) << record.allocations
+               << std::setw(16) << record.allocatedBytes << std::setw(16) << record.peakRssDeltaBytes / 1024 << "\n";
+            totalMs += record.wallMilliseconds;
+            totalAllocations += record.allocations;
+            totalBytes += record.allocatedBytes;
+            totalRss += record.peakRssDeltaBytes;
+        }
+        os << std::left << std::setw(16) << "total" << std::right
+           << std::setw(12) << totalMs << std::setw(14) << totalAllocations
+           << std::setw(16) << totalBytes << std::setw(16) << totalRss / 1024 << "\n";
+
+        os.flags(flags);
+        os.precision(precision);
+    }
+
+    void PhaseTimer::printJson(std::ostream &os) const {
+        auto flags = os.flags();
+        auto precision = os.precision();
+
+        os << "{\"phases\":[";
+        os << std::fixed << std::setprecision(3);
+        for (size_t i = 0; i < records.size(); ++i) {
+            const auto &record = records[i];
+            if (i != 0)
+                os << ",";
+            os << "{\"name\":\"" << record.name << "\""
+               << ",\"wallMs\":" << record.wallMilliseconds
+               << ",\"allocations\":" << record.allocations
+               << ",\"allocatedBytes\":" << record.allocatedBytes
+               << ",\"peakRssDeltaBytes\":" << record.peakRssDeltaBytes << "}";
+        }
+        os << "]}\n";
+
+        os.flags(flags);
+        os.precision(precision);
+    }
+} // namespace Ryntra::Compiler
@@ -0,0 +1,87 @@
+// ========== PhaseTimer.h ============================================ *- C++ -* //
+// Copyright (c) 2026 Remimwen Studio (Ryan "NvKopres" Almond).
+// Licensed under Apache-2.0 License. See LICENSE for more info.
+// ============================================================================== //
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace Ryntra::Compiler {
+    /// \brief Measurements of one compiler / VM phase.
+    struct PhaseRecord {
+        std::string name;
+        double wallMilliseconds;
+        uint64_t allocations;      ///< Calls to global operator new during the phase (0 if not counted)
+        uint64_t allocatedBytes;   ///< Bytes requested through global operator new
+        int64_t peakRssDeltaBytes; ///< Growth of the process peak RSS during the phase
+    };
+
+    /// \brief Collects wall time, allocation count and peak RSS growth per phase.
+    /// A disabled timer ignores \c begin() / \c end() so callers don't need to branch.
+    class PhaseTimer {
+    public:
+        /// \brief Constructor.
+        /// \param enabled Whether phases are recorded at all
+        explicit PhaseTimer(bool enabled = true) : enabled(enabled) {}
+
+        /// \brief Start measuring a phase. Phases don't nest; an open phase is ended first.
+        /// \param name The phase name shown in the report
+        void begin(const std::string &name);
+
+        /// \brief Finish the phase started by \c begin() and record it.
+        void end();
+
+        /// \brief RAII helper that ends the current phase when it goes out of scope.
+        class Scope {
+        public:
+            Scope(PhaseTimer &timer, const std::string &name) : timer(timer) { timer.begin(name); }
+            ~Scope() { timer.end(); }
+
+            Scope(const Scope &) = delete;
+            Scope &operator=(const Scope &) = delete;
+
+        private:
+            PhaseTimer &timer;
+        };
+
+        [[nodiscard]] bool isEnabled() const { return enabled; }
+        [[nodiscard]] const std::vector<PhaseRecord> &getRecords() const { return records; }
+        void clear() { records.clear(); }
+
+        /// \brief Print the records as an aligned table, followed by a total row.
+        void print(std::ostream &os) const;
+
+        /// \brief Print the records as a JSON object of the form
+        /// \code {"phases":[{"name":..,"wallMs":..,"allocations":..,"allocatedBytes":..,"peakRssDeltaBytes":..}]} \endcode
+        void printJson(std::ostream &os) const;
+
+        /// \brief Count one allocation of \p bytes. Called by the operator new replacement in
+        /// AllocationCounter.cpp; without it linked in, the allocation columns stay zero.
+        static void recordAllocation(std::size_t bytes);
+
+        /// \brief Number of global operator new calls since process start.
+        static uint64_t getAllocationCount();
+
+        /// \brief Bytes requested through global operator new since process start.
+        static uint64_t getAllocatedBytes();
+
+        /// \brief Peak resident set size of the process in bytes, or 0 if unavailable.
+        static uint64_t getPeakRss();
+
+    private:
+        bool enabled;
+        bool running = false;
+        std::string currentName;
+        std::chrono::steady_clock::time_point startTime;
+        uint64_t startAllocations = 0;
+        uint64_t startBytes = 0;
+        uint64_t startPeakRss = 0;
+        std::vector<PhaseRecord> records;
+    };
+} // namespace Ryntra::Compiler
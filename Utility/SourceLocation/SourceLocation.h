@@ -8,8 +8,8 @@
 namespace Ryntra::Compiler {
     /// \brief A simple structure represents the location in the source file.
     struct SourceLocation {
-        int line;
-        int column;
+        int line = 0;   ///< 0 means "unknown"
+        int column = 0;
 
         /// \brief Constructor. Use default behavior.
         SourceLocation() = default;
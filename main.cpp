@@ -1,21 +1,116 @@
-#include "AST/ASTBuilder.h"
+#include "Driver/Batch.h"
+#include "Driver/Driver.h"
 #include "ErrorHandler/ErrorHandler.h"
-#include "ErrorHandler/LexParseErrorHandler.h"
-#include "IR/IRGenerator.h"
-#include "Semantic/SemanticAnalyzer.h"
-#include "VM/BytecodeGenerator.h"
+#include "PhaseTimer/PhaseTimer.h"
 #include "VM/VirtualMachine.h"
-#include <antlr/RyntraLexer.h>
-#include <antlr/RyntraParser.h>
-#include <antlr4-runtime.h>
+#include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <stdexcept>
+#include <string_view>
 
 int main(int argc, char **argv) {
     try {
         std::string Source;
+        std::string sourcePath;
+        bool profile = false;
+        bool profilePairs = false;
+        std::string samplePath;
+        long sampleInterval = 1000; // microseconds
+        bool timePasses = false;
+        bool timePassesJson = false;
+        std::string batchPath;
+        std::string snapshotPath;
+        std::string restorePath;
+        Ryntra::Compiler::BatchOptions batchOptions;
+        Ryntra::Compiler::CompileOptions compileOptions;
+
+        for (int i = 1; i < argc; ++i) {
+            std::string_view arg = argv[i];
+            if (arg == "--profile") {
+                profile = true;
+            } else if (arg == "--profile=pairs") {
+                profile = true;
+                profilePairs = true;
+            } else if (arg.starts_with("--sample=")) {
+                samplePath = std::string(arg.substr(9));
+            } else if (arg.starts_with("--sample-interval=")) {
+                sampleInterval = std::stol(std::string(arg.substr(18)));
+            } else if (arg == "--time-passes") {
+                timePasses = true;
+            } else if (arg == "--time-passes=json") {
+                timePasses = true;
+                timePassesJson = true;
+            } else if (arg == "-O0") {
+                compileOptions.optimizationLevel = Ryntra::IR::OptimizationLevel::O0;
+            } else if (arg == "-O1") {
+                compileOptions.optimizationLevel = Ryntra::IR::OptimizationLevel::O1;
+            } else if (arg == "-O2") {
+                compileOptions.optimizationLevel = Ryntra::IR::OptimizationLevel::O2;
+            } else if (arg.starts_with("-O")) {
+                throw std::invalid_argument("Unknown optimization level '" + std::string(arg) + "' (use -O0, -O1 or -O2)");
+            } else if (arg.starts_with("--print-after=")) {
+                compileOptions.printAfter.emplace_back(arg.substr(14));
+            } else if (arg.starts_with("--batch=")) {
+                batchPath = std::string(arg.substr(8));
+            } else if (arg.starts_with("--batch-manifest=")) {
+                batchOptions.manifest = std::string(arg.substr(17));
+            } else if (arg.starts_with("--batch-output=")) {
+                batchOptions.output = std::string(arg.substr(15));
+            } else if (arg.starts_with("--snapshot=")) {
+                snapshotPath = std::string(arg.substr(11));
+            } else if (arg.starts_with("--restore=")) {
+                restorePath = std::string(arg.substr(10));
+            } else if (arg.starts_with("--batch-timeout=")) {
+                batchOptions.timeoutSeconds = std::stod(std::string(arg.substr(16)));
+            } else if (arg.starts_with("--jobs=")) {
+                batchOptions.jobs = static_cast<unsigned>(std::stoul(std::string(arg.substr(7))));
+            } else {
+                sourcePath = arg;
+            }
+        }
+
+        // --batch=<dir> runs every .rynt file below dir (checked against dir/Result/Result.json if
+        // present); --batch=<file.json> runs a manifest. --batch-timeout=0 lifts the 10 s limit.
+        if (!batchPath.empty()) {
+            if (std::filesystem::is_directory(batchPath))
+                batchOptions.root = batchPath;
+            else
+                batchOptions.manifest = batchPath;
+            return Ryntra::Compiler::runBatch(batchOptions);
+        }
+
+        Ryntra::Compiler::PhaseTimer timer(timePasses);
+        auto reportTimer = [&] {
+            if (!timer.isEnabled())
+                return;
+            if (timePassesJson)
+                timer.printJson(std::cerr);
+            else
+                timer.print(std::cerr);
+        };
+
+        // --restore=<file> continues a run saved by __builtin_snapshot(); no source is needed
+        if (!restorePath.empty()) {
+            timer.begin("restore");
+            auto snapshot = Ryntra::VM::Snapshot::open(restorePath);
+            Ryntra::VM::ExecutionContext context(snapshot->getProgram());
+            timer.begin("execute");
+            context.resume(snapshot);
+            timer.end();
+            reportTimer();
+            return 0;
+        }
 
-        std::ifstream sourceFile(argv[1]);
+        // Opened before compiling, so an unwritable --sample path fails before the run rather than after it
+        std::ofstream foldedFile;
+        if (!samplePath.empty()) {
+            foldedFile.open(samplePath);
+            if (!foldedFile.is_open())
+                throw std::runtime_error("Cannot write sample file " + samplePath);
+        }
+
+        std::ifstream sourceFile(sourcePath);
         if (sourceFile.is_open()) {
             Source = std::string((std::istreambuf_iterator<char>(sourceFile)),
                                  std::istreambuf_iterator<char>());
@@ -26,63 +121,36 @@ int main(int argc, char **argv) {
         //
         // std::cout << "====================================================" << std::endl;
 
-        antlr4::ANTLRInputStream input(Source);
-        Ryntra::antlr::RyntraLexer lexer(&input);
-        antlr4::CommonTokenStream tokens(&lexer);
-        tokens.fill();
-        Ryntra::antlr::RyntraParser parser(&tokens);
-
-        parser.removeErrorListeners();
-        parser.addErrorListener(new Ryntra::Compiler::LexParseErrorHandler());
-
-        auto tree = parser.program();
-
-        // std::cout << tree->toStringTree(&parser) << std::endl;
-        // std::cout << std::endl;
-
-        Ryntra::Compiler::ASTBuilder builder;
-        auto ast = builder.visitProgram(tree);
-        // std::cout << std::endl;
-        // std::cout << ast->toString() << std::endl;
-        // std::cout << std::endl;
-        // std::cout << "====================================================" << std::endl;
-        // std::cout << std::endl;
-
-        Ryntra::Compiler::Semantic::SemanticAnalyzer analyzer;
-        analyzer.analyze(ast);
+        auto program = Ryntra::Compiler::compileSource(Source, timer, "HelloWorld", compileOptions);
 
         Ryntra::Compiler::ErrorHandler::getInstance().print();
-        bool hasError = false;
-        for (const auto &error : Ryntra::Compiler::ErrorHandler::getInstance().getErrorObjects()) {
-            if (error.type == Ryntra::Compiler::kError) {
-                hasError = true;
-                break;
-            }
-        }
 
-        if (hasError) {
+        if (Ryntra::Compiler::ErrorHandler::getInstance().hasError()) {
             std::cout << "Semantic Analysis Failed." << std::endl;
         } else {
             // std::cout << "Semantic Analysis Passed." << std::endl;
-            if (auto typedAST = analyzer.getTypedAST()) {
-                // std::cout << "Typed AST:" << std::endl;
-                // typedAST->dump();
-                // std::cout << std::endl;
-                // std::cout << "====================================================" << std::endl;
-
-                Ryntra::IR::IRGenerator irGen;
-                auto module = irGen.generate(*typedAST, "HelloWorld");
-                // std::cout << module->toString() << std::endl;
-                // std::cout << "====================================================" << std::endl;
-
-                // Generate bytecode and execute
-                Ryntra::VM::BytecodeGenerator bcGen;
-                auto bytecode = bcGen.generate(module);
-
+            if (program) {
                 // std::cout << "Executing VM..." << std::endl;
                 Ryntra::VM::VirtualMachine vm;
-                vm.load(bytecode, bcGen.getConstantPool());
-                auto result = vm.execute("main");
+                vm.load(program->functions, program->constantPool);
+                vm.getContext().setSnapshotPath(snapshotPath);
+                Ryntra::VM::VMValue result;
+                timer.begin("execute");
+                if (profile) {
+                    Ryntra::VM::Profiler profiler(profilePairs);
+                    result = vm.execute("main", profiler);
+                    profiler.report(std::cerr);
+                } else if (!samplePath.empty()) {
+                    Ryntra::VM::SamplingProfiler sampler{std::chrono::microseconds(sampleInterval)};
+                    result = vm.execute("main", sampler);
+                    sampler.writeFolded(foldedFile);
+                    foldedFile.close();
+                    if (!foldedFile)
+                        throw std::runtime_error("Cannot write sample file " + samplePath);
+                } else {
+                    result = vm.execute("main");
+                }
+                timer.end();
 
                 // vm.disassemble();
 
@@ -95,6 +163,8 @@ int main(int argc, char **argv) {
             }
         }
 
+        reportTimer();
+
         // std::cout << std::endl;
         return 0;
     } catch (const std::exception &e) {